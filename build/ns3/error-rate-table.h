@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#ifndef ERROR_RATE_TABLE_H
+#define ERROR_RATE_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+#include "wifi-mode.h"
+#include "ns3/callback.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * \brief Lookup tables of chunk success rates, one per WifiMode.
+ *
+ * All the error rate models of this module compute the success rate
+ * of a chunk of nbits bits as \f$ s(snr)^{nbits} \f$, where s is the
+ * success rate of a single bit.  The table therefore only needs to be
+ * indexed by SNR: for each mode it stores \f$ \ln(-\ln s) \f$ on a
+ * regular grid in dB, which is a smooth and slowly varying function
+ * over the whole waterfall region, and interpolates it linearly.  The
+ * nbits dimension is then exact: an error e on \f$ \ln(-\ln s) \f$
+ * moves \f$ s^{nbits} \f$ by at most e/exp(1), whatever nbits.
+ *
+ * The table of a mode is built the first time the mode is looked up,
+ * by evaluating the analytical model on the grid and at the middle of
+ * each cell.  The cells where linear interpolation is off by more than
+ * MAX_ERROR, such as those containing the SNR threshold of a model or
+ * the point where it saturates, are left to the analytical model, as
+ * are the SNRs outside of the grid.
+ */
+class ErrorRateTable
+{
+public:
+  /**
+   * Analytical chunk success rate, as in
+   * ErrorRateModel::GetChunkSuccessRate.
+   */
+  typedef Callback<double, WifiMode, double, uint32_t> ChunkSuccessRateCallback;
+
+  ErrorRateTable ();
+
+  /**
+   * \param mode the Wi-Fi mode the chunk is sent
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   * \param analytical the model the table approximates
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits,
+                              ChunkSuccessRateCallback const &analytical);
+
+  /**
+   * \brief Drop all the tables; they are rebuilt on the next lookups.
+   */
+  void Clear (void);
+
+  /// lowest SNR of the grid, in dB
+  static const double MIN_SNR_DB;
+  /// highest SNR of the grid, in dB
+  static const double MAX_SNR_DB;
+  /// grid step, in dB
+  static const double STEP_DB;
+  /// largest interpolation error on ln(-ln s) allowed in a cell
+  static const double MAX_ERROR;
+
+private:
+  /**
+   * \brief The table of a mode
+   */
+  struct Table
+  {
+    std::vector<double> y;          //!< ln(-ln s) at the grid points
+    std::vector<bool> analytical;   //!< whether each cell must use the analytical model
+  };
+
+  /**
+   * \param mode the Wi-Fi mode
+   * \param analytical the model the table approximates
+   * \return the table of the mode, built if needed
+   */
+  Table const & GetTable (WifiMode mode, ChunkSuccessRateCallback const &analytical);
+
+  std::vector<Table> m_tables; //!< tables indexed by mode uid
+};
+
+} //namespace ns3
+
+#endif /* ERROR_RATE_TABLE_H */
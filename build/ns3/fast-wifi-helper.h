@@ -0,0 +1,51 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef FAST_WIFI_HELPER_H
+#define FAST_WIFI_HELPER_H
+
+#include "yans-wifi-helper.h"
+
+namespace ns3 {
+
+/**
+ * \brief Make it easy to create and manage FastWifiPhy objects.
+ *
+ * The PHY objects created by this helper are FastWifiPhy objects
+ * attached to a YansWifiChannel.  Apart from the type of the PHY, this
+ * helper is configured and used exactly like YansWifiPhyHelper.
+ */
+class FastWifiPhyHelper : public YansWifiPhyHelper
+{
+public:
+  /**
+   * Create a phy helper without any parameter set. The user must set
+   * them all to be able to call Install later.
+   */
+  FastWifiPhyHelper ();
+
+  /**
+   * Create a phy helper in a default working state, with a
+   * NistErrorRateModel using its lookup table.
+   * \returns a default FastWifiPhyHelper
+   */
+  static FastWifiPhyHelper Default (void);
+};
+
+} //namespace ns3
+
+#endif /* FAST_WIFI_HELPER_H */
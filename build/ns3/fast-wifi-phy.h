@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef FAST_WIFI_PHY_H
+#define FAST_WIFI_PHY_H
+
+#include "yans-wifi-phy.h"
+
+namespace ns3 {
+
+/**
+ * \brief 802.11 PHY layer model with a deterministic capture rule
+ * \ingroup wifi
+ *
+ * This PHY is meant for large MAC-level studies, such as the saturation
+ * throughput of a large BSS, where only collisions and capture matter.
+ * It behaves like YansWifiPhy, with the same channel, state machine and
+ * CCA, except for the error rate of the frames being received: instead
+ * of integrating the SINR of every chunk of a frame, the strongest sum
+ * of the other signals seen during the frame is taken as interference
+ * for the whole frame.
+ *
+ * - if the frame is not CaptureThreshold dB stronger than this
+ *   interference, it is lost;
+ * - otherwise, its error rate is that of a single chunk at the
+ *   resulting SINR.
+ *
+ * This is pessimistic for frames with short overlaps, and exact for
+ * frames received without any interference.  The error rate model is
+ * evaluated once for the PLCP header and once for the payload, so it
+ * should use a lookup table (see the UseLookupTable attribute of the
+ * NistErrorRateModel and YansErrorRateModel).
+ */
+class FastWifiPhy : public YansWifiPhy
+{
+public:
+  static TypeId GetTypeId (void);
+
+  FastWifiPhy ();
+  virtual ~FastWifiPhy ();
+
+  /**
+   * \param threshold the minimum ratio (dB) between the power of a frame
+   *        and the interference for the frame to be received
+   */
+  void SetCaptureThreshold (double threshold);
+  /**
+   * \return the minimum ratio (dB) between the power of a frame and the
+   *         interference for the frame to be received
+   */
+  double GetCaptureThreshold (void) const;
+
+
+protected:
+  virtual struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event);
+  virtual struct InterferenceHelper::SnrPer CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event);
+
+
+private:
+  /**
+   * \param event the event of the frame being received
+   * \param mode the mode of the part of the frame
+   * \param duration the duration of the part of the frame
+   *
+   * \return the SNR and PER of a part of the frame
+   */
+  struct InterferenceHelper::SnrPer CalculateSnrPer (Ptr<InterferenceHelper::Event> event,
+                                                     WifiMode mode, Time duration) const;
+
+  double m_captureThresholdDb; //!< capture threshold (dB)
+  double m_captureRatio;       //!< capture threshold (linear)
+};
+
+} //namespace ns3
+
+#endif /* FAST_WIFI_PHY_H */
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_WORKSPACE_H
+#define FF_MAC_SCHEDULER_WORKSPACE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Per-TTI working state of the downlink of a FF MAC scheduler
+ *
+ * The schedulers build the same temporary structures at every TTI: the
+ * set of the RNTIs already served by a HARQ retransmission, the RBGs
+ * allocated to each RNTI and the RBGs of the DCI of a retransmission.
+ * This class keeps them in flat buffers owned by the scheduler, which are
+ * cleared by Reset () without releasing their memory, so that after the
+ * first TTIs the scheduling of a subframe does not allocate memory for
+ * them anymore.
+ *
+ * The allocations are kept sorted by RNTI, i.e., in the order in which
+ * the schedulers used to iterate over their std::map of allocations.
+ */
+class FfMacSchedulerWorkspace
+{
+public:
+  FfMacSchedulerWorkspace ();
+
+  /**
+   * \brief Start the scheduling of a new TTI
+   *
+   * Forget the allocated RNTIs and the allocations of the previous TTI.
+   */
+  void Reset ();
+
+  /**
+   * \brief Mark a RNTI as already allocated in this TTI
+   * \param rnti the RNTI
+   */
+  void MarkRntiAllocated (uint16_t rnti);
+
+  /**
+   * \param rnti the RNTI
+   * \return true if the RNTI has been marked as allocated in this TTI
+   */
+  bool IsRntiAllocated (uint16_t rnti) const
+  {
+    return (m_rntiAllocated[rnti >> 5] & (1u << (rnti & 0x1F))) != 0;
+  }
+
+  /**
+   * \brief Create the allocation of a RNTI, without any RBG
+   *
+   * Nothing is done if the RNTI already has an allocation in this TTI.
+   *
+   * \param rnti the RNTI
+   */
+  void AddAllocation (uint16_t rnti);
+
+  /**
+   * \brief Allocate a RBG to a RNTI
+   *
+   * The RBGs of a RNTI are stored in the order of their allocation.
+   *
+   * \param rnti the RNTI
+   * \param rbg the index of the RBG
+   * \return the RBGs allocated to the RNTI, valid until the next
+   *         allocation of a RBG
+   */
+  const std::vector<uint16_t>& AllocateRbg (uint16_t rnti, uint16_t rbg);
+
+  /**
+   * \brief Take back the last RBG allocated to a RNTI
+   *
+   * The RNTI keeps its allocation, possibly without any RBG.
+   *
+   * \param rnti the RNTI
+   */
+  void DeallocateLastRbg (uint16_t rnti);
+
+  /// \return the number of RNTIs with an allocation in this TTI
+  uint32_t GetNAllocations () const
+  {
+    return m_nAllocations;
+  }
+
+  /**
+   * \param i the index of the allocation, in increasing order of RNTI
+   * \return the RNTI of the allocation
+   */
+  uint16_t GetAllocationRnti (uint32_t i) const
+  {
+    return m_allocations[m_sortedAllocations[i]].rnti;
+  }
+
+  /**
+   * \param i the index of the allocation, in increasing order of RNTI
+   * \return the RBGs of the allocation
+   */
+  const std::vector<uint16_t>& GetAllocationRbgs (uint32_t i) const
+  {
+    return m_allocations[m_sortedAllocations[i]].rbgs;
+  }
+
+  /**
+   * \param nLayer the number of layers of the UE
+   * \return the subband CQIs to be used for a UE without CQI reports
+   *         (i.e., the lowest CQI for each layer)
+   */
+  const std::vector<uint8_t>& GetDefaultSbCqi (int nLayer) const;
+
+  /**
+   * \return a cleared buffer for the RBGs of the DCI of a HARQ
+   *         retransmission
+   */
+  std::vector<int>& GetDciRbgBuffer ()
+  {
+    m_dciRbg.clear ();
+    return m_dciRbg;
+  }
+
+  /// \return a buffer for a copy of the RBG map of the TTI
+  std::vector<bool>& GetRbgMapBuffer ()
+  {
+    return m_rbgMapCopy;
+  }
+
+private:
+  /// RBGs allocated to a RNTI
+  struct Allocation
+  {
+    uint16_t rnti;              ///< the RNTI
+    std::vector<uint16_t> rbgs; ///< the allocated RBGs
+  };
+
+  /**
+   * \param rnti the RNTI
+   * \return the allocation of the RNTI, created without any RBG if needed
+   */
+  Allocation& FindOrCreateAllocation (uint16_t rnti);
+
+  /// one bit per RNTI, set if the RNTI has already been allocated
+  std::vector<uint32_t> m_rntiAllocated;
+  /// RNTIs whose bit is set in m_rntiAllocated
+  std::vector<uint16_t> m_markedRntis;
+  /// allocations of the TTI, the entries beyond m_nAllocations are unused
+  std::vector<Allocation> m_allocations;
+  /// indices in m_allocations of the allocations, sorted by RNTI
+  std::vector<uint32_t> m_sortedAllocations;
+  /// number of allocations of the TTI
+  uint32_t m_nAllocations;
+  /// default subband CQIs for 1 and 2 layers
+  std::vector<uint8_t> m_defaultSbCqi[2];
+  /// buffer of GetDciRbgBuffer ()
+  std::vector<int> m_dciRbg;
+  /// buffer of GetRbgMapBuffer ()
+  std::vector<bool> m_rbgMapCopy;
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_WORKSPACE_H */
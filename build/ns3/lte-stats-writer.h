@@ -0,0 +1,202 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_STATS_WRITER_H
+#define LTE_STATS_WRITER_H
+
+#include <ns3/core-config.h>
+#include <ns3/ptr.h>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#endif /* HAVE_PTHREAD_H */
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Output file of a stats calculator, which stays open between records.
+ *
+ * The file has a fixed list of columns and the values of a record are
+ * added in the order of the columns; the record ends with the value of
+ * its last column. In the text format, the file starts with a header
+ * line and holds one record per line, the values being separated by tabs.
+ * The values of a list column are each followed by the separator of the
+ * column, and no tab is added after the list.
+ *
+ * In the binary format, the records are stored in blocks, where the
+ * values of each column are contiguous and stored in the native byte
+ * order. A block is written by a background thread while the next one is
+ * filled, when threads are available. ConvertToText () turns a binary
+ * file into the text file that would have been written for the same
+ * records.
+ */
+class LteStatsWriter
+{
+public:
+  /// Type of the values of a column
+  enum ColumnType
+  {
+    UINT8 = 0,
+    UINT16,
+    UINT32,
+    UINT64,
+    INT64,
+    DOUBLE,
+    DOUBLE_LIST ///< any number of doubles
+  };
+
+  LteStatsWriter ();
+  ~LteStatsWriter ();
+
+  /**
+   * \param header the first line of the text format, without the end of line
+   */
+  void SetHeader (std::string header);
+
+  /**
+   * Add a column after the existing ones, before the file is opened.
+   *
+   * \param type the type of the values of the column
+   * \param separator the character following each value of a list column
+   */
+  void AddColumn (ColumnType type, char separator = '\t');
+
+  /**
+   * Open the file, truncating it, and write its header.
+   *
+   * \param filename the name of the file
+   * \param binary whether to use the binary format
+   * \return true if the file could be opened
+   */
+  bool Open (std::string filename, bool binary);
+
+  /**
+   * \return true if the file is open
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * Write the pending records and close the file.
+   */
+  void Close (void);
+
+  /**
+   * \param value the value of the next column, of an unsigned type
+   */
+  void AddUint (uint64_t value);
+
+  /**
+   * \param value the value of the next column, of type INT64
+   */
+  void AddInt (int64_t value);
+
+  /**
+   * \param value the value of the next column, of type DOUBLE
+   */
+  void AddDouble (double value);
+
+  /**
+   * \param begin the first value of the next column, of type DOUBLE_LIST
+   * \param end past the last value of the next column
+   */
+  void AddDoubles (std::vector<double>::const_iterator begin,
+                   std::vector<double>::const_iterator end);
+
+  /**
+   * Write the text format of a binary file.
+   *
+   * \param filename the name of a file written in the binary format
+   * \param os the stream where the text is written
+   */
+  static void ConvertToText (std::string filename, std::ostream &os);
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  LteStatsWriter (const LteStatsWriter &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  LteStatsWriter & operator = (const LteStatsWriter &);
+
+  /// A column of the file
+  struct Column
+  {
+    ColumnType type;             //!< the type of the values
+    char separator;              //!< the character following each value of a list
+    std::vector<uint8_t> values; //!< the values of the current block
+    std::vector<uint8_t> counts; //!< the number of values of each record of a list
+  };
+
+  /**
+   * \return the column of the next value
+   */
+  Column & NextColumn (void);
+
+  /**
+   * \param column the column
+   * \param bytes the binary value
+   * \param size the number of bytes of the value
+   */
+  void AppendValue (Column &column, const void *bytes, uint32_t size);
+
+  /**
+   * Terminate the value of the current column and move to the next one.
+   */
+  void EndValue (void);
+
+  /**
+   * Hand the current block over to the writing thread.
+   */
+  void FlushBlock (void);
+
+  /**
+   * Write m_pendingBlock to the file, in the background thread.
+   */
+  void WritePendingBlock (void);
+
+  /**
+   * Wait for the block being written, if any.
+   */
+  void JoinWriter (void);
+
+  std::string m_header;          //!< the first line of the text format
+  std::vector<Column> m_columns; //!< the columns
+  std::ofstream m_file;          //!< the file
+  bool m_binary;                 //!< whether the binary format is used
+  uint32_t m_column;             //!< index of the column of the next value
+  uint32_t m_records;            //!< number of records of the current block
+  uint32_t m_blockSize;          //!< number of bytes of the current block
+  std::vector<uint8_t> m_pendingBlock; //!< the block being written
+#ifdef HAVE_PTHREAD_H
+  Ptr<SystemThread> m_writer;    //!< the thread writing m_pendingBlock
+#endif /* HAVE_PTHREAD_H */
+};
+
+} // namespace ns3
+
+#endif /* LTE_STATS_WRITER_H */
@@ -0,0 +1,153 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Giuseppe Piro  <g.piro@poliba.it>
+ *         Marco Miozzo <mmiozzo@cttc.es>
+ */
+
+
+#ifndef TRACE_FADING_LOSS_MODEL_H
+#define TRACE_FADING_LOSS_MODEL_H
+
+
+#include <ns3/object.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <map>
+#include <vector>
+#include "ns3/random-variable-stream.h"
+#include <ns3/nstime.h>
+
+namespace ns3 {
+
+
+class MobilityModel;
+class TraceFadingData;
+
+
+/**
+ * \ingroup lte
+ *
+ * \brief fading loss model based on precalculated fading traces
+ *
+ * The samples of a trace are loaded once per process and shared by all
+ * the instances using the same file. A trace previously converted with
+ * ConvertTraceToBinary () is mapped read-only in memory instead of being
+ * parsed, so that its pages are also shared by all the processes using it
+ * (e.g., the ranks of a distributed simulation). Where memory mapping is
+ * not available, the binary samples are read into the shared buffer.
+ */
+class TraceFadingLossModel : public SpectrumPropagationLossModel
+{
+public:
+  TraceFadingLossModel ();
+  virtual ~TraceFadingLossModel ();
+
+  static TypeId GetTypeId ();
+  
+  virtual void DoInitialize (void);
+
+  /**
+   * \brief The couple of mobility mnode that form a fading channel realization
+   */
+  typedef std::pair<Ptr<const MobilityModel>, Ptr<const MobilityModel> > ChannelRealizationId_t;
+
+ /**
+  * Assign a fixed random variable stream number to the random variables
+  * used by this model.  Return the number of streams (possibly zero) that
+  * have been assigned.
+  *
+  * \param stream first stream index to use
+  * \return the number of stream indices assigned by this model
+  */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * Convert an ASCII fading trace to the binary format that
+   * TraceFadingLossModel maps in memory. The binary file starts with a
+   * 16 byte header (the magic string "ns3fad01", then the number of RBs
+   * and the number of samples as native-endian uint32_t) followed by the
+   * linear power gains as native-endian doubles, one row of samples per RB.
+   *
+   * \param asciiFile the name of the ASCII trace (values in dB)
+   * \param binaryFile the name of the binary trace to be written
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   */
+  static void ConvertTraceToBinary (std::string asciiFile, std::string binaryFile,
+                                    uint8_t rbNum, uint32_t samplesNum);
+
+  
+private:
+  /**
+   * \param txPsd set of values vs frequency representing the
+   *              transmission power. See SpectrumChannel for details.
+   * \param a sender mobility
+   * \param b receiver mobility
+   * \return set of values vs frequency representing the received
+   *         power in the same units used for the txPsd parameter.
+   */
+  Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity (Ptr<const SpectrumValue> txPsd,
+                                                   Ptr<const MobilityModel> a,
+                                                   Ptr<const MobilityModel> b) const;
+                                                   
+  /**
+  * \brief Get the value for a particular sub channel and a given speed
+  * \param subChannel the sub channel for which a value is requested
+  * \param speed the relative speed of the two devices
+  * \return the loss for a particular sub channel
+  */
+  double GetValue (int subChannel, double speed);
+  
+  void SetTraceFileName (std::string fileName);
+  void SetTraceLength (Time t);
+  
+  void LoadTrace ();
+
+  /**
+   * Index of each channel realization in m_windowOffsets. Indices follow
+   * the order of creation, which is also the order in which the offsets
+   * are redrawn at each window update.
+   */
+  mutable std::map <ChannelRealizationId_t, uint32_t> m_channelRealizations;
+
+  /// Start offset in the trace (in ms) of each channel realization.
+  mutable std::vector<int> m_windowOffsets;
+
+  /// Draws the start offsets of all the channel realizations.
+  Ptr<UniformRandomVariable> m_startVariable;
+  
+  std::string m_traceFile;
+  
+  /// Samples of the trace as linear power gains, shared with other instances.
+  Ptr<TraceFadingData> m_fadingTrace;
+
+  
+  Time m_traceLength;
+  uint32_t m_samplesNum;
+  Time m_windowSize;
+  uint8_t m_rbNum;
+  mutable Time m_lastWindowUpdate;
+  uint8_t m_timeGranularity;
+  uint64_t m_streamSetSize;
+  
+};
+
+
+
+} // namespace ns3
+
+#endif /* TRACE_FADING_LOSS_MODEL_H */
@@ -0,0 +1,495 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#ifndef OPEN_HASH_MAP_H
+#define OPEN_HASH_MAP_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <functional>
+
+/**
+ * \file
+ * \ingroup hash
+ * ns3::OpenHashMap declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup hash
+ *
+ * \brief Default hash functor for OpenHashMap.
+ *
+ * The generic version handles the integral and enum types by value;
+ * OpenHashMap mixes the bits itself, so a plain conversion is enough.
+ * Other key types must provide their own functor (for instance
+ * Ipv4AddressHash or Mac48AddressHash).
+ */
+template <typename T>
+struct OpenHash
+{
+  /**
+   * \param x the key
+   * \returns the hash of the key
+   */
+  size_t operator() (T const &x) const
+  {
+    return static_cast<size_t> (x);
+  }
+};
+
+/**
+ * \ingroup hash
+ *
+ * \brief OpenHash specialization for std::pair keys.
+ */
+template <typename A, typename B>
+struct OpenHash<std::pair<A, B> >
+{
+  /**
+   * \param x the key
+   * \returns the combined hash of both members
+   */
+  size_t operator() (std::pair<A, B> const &x) const
+  {
+    size_t h = OpenHash<A> () (x.first);
+    return h ^ (OpenHash<B> () (x.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+  }
+};
+
+/**
+ * \ingroup hash
+ *
+ * \brief An associative container using open addressing.
+ *
+ * The elements are stored inline in a single power-of-two sized
+ * array and collisions are resolved by linear probing, so a lookup
+ * usually touches one or two adjacent cache lines and an insertion
+ * does not allocate unless the table grows.  Erasure shifts the
+ * following elements of the probe sequence back instead of leaving
+ * tombstones.  The table is kept at most half full.
+ *
+ * The interface is a subset of std::map.  Unlike std::map, the
+ * insertion of a new key and erasure invalidate all the iterators,
+ * pointers and references to the elements, and the iteration order is
+ * unspecified.  Looking up or inserting a key that is already present
+ * does not invalidate them.
+ * Callers that must hold on to an element across insertions should
+ * store an index into a separate pool as the value.
+ *
+ * Key and Value must be default constructible and assignable.
+ *
+ * \tparam Key the key type
+ * \tparam Value the mapped type
+ * \tparam Hash the hash functor
+ * \tparam Equal the key equality functor
+ */
+template <typename Key, typename Value,
+          typename Hash = OpenHash<Key>,
+          typename Equal = std::equal_to<Key> >
+class OpenHashMap
+{
+public:
+  /** Type of the elements */
+  typedef std::pair<Key, Value> value_type;
+  /** Key type */
+  typedef Key key_type;
+  /** Mapped type */
+  typedef Value mapped_type;
+
+private:
+  /** A slot of the table */
+  struct Slot
+  {
+    Slot () : used (false) {}
+    bool used;        //!< whether the slot holds an element
+    value_type value; //!< the element
+  };
+
+public:
+  /**
+   * \brief Forward iterator over the used slots.
+   * \tparam S the slot type, possibly const
+   * \tparam V the element type, possibly const
+   */
+  template <typename S, typename V>
+  class Iterator
+  {
+public:
+    Iterator () : m_slot (0), m_end (0) {}
+    /**
+     * \param slot the slot to point to
+     * \param end one past the last slot
+     * \param skip whether to move forward to the first used slot
+     */
+    Iterator (S *slot, S *end, bool skip) : m_slot (slot), m_end (end)
+    {
+      if (skip)
+        {
+          Skip ();
+        }
+    }
+    /**
+     * Conversion from iterator to const_iterator.
+     * \param o the iterator to convert
+     */
+    template <typename S2, typename V2>
+    Iterator (Iterator<S2, V2> const &o) : m_slot (o.m_slot), m_end (o.m_end) {}
+    /** \returns the element */
+    V & operator* () const { return m_slot->value; }
+    /** \returns a pointer to the element */
+    V * operator-> () const { return &m_slot->value; }
+    /** \returns this iterator, advanced to the next element */
+    Iterator & operator++ ()
+    {
+      ++m_slot;
+      Skip ();
+      return *this;
+    }
+    /** \returns a copy of this iterator before advancing it */
+    Iterator operator++ (int)
+    {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    /**
+     * \param o the other iterator
+     * \returns true if both point to the same slot
+     */
+    template <typename S2, typename V2>
+    bool operator== (Iterator<S2, V2> const &o) const { return m_slot == o.m_slot; }
+    /**
+     * \param o the other iterator
+     * \returns true if they point to different slots
+     */
+    template <typename S2, typename V2>
+    bool operator!= (Iterator<S2, V2> const &o) const { return m_slot != o.m_slot; }
+
+    S *m_slot; //!< current slot
+    S *m_end;  //!< one past the last slot
+private:
+    /** Move forward to the next used slot, or to the end. */
+    void Skip (void)
+    {
+      while (m_slot != m_end && !m_slot->used)
+        {
+          ++m_slot;
+        }
+    }
+  };
+
+  /** Iterator */
+  typedef Iterator<Slot, value_type> iterator;
+  /** Const iterator */
+  typedef Iterator<const Slot, const value_type> const_iterator;
+
+  OpenHashMap () : m_size (0), m_shift (64) {}
+
+  /** \returns an iterator to the first element */
+  iterator begin (void)
+  {
+    return iterator (Data (), Data () + m_slots.size (), true);
+  }
+  /** \returns a past-the-end iterator */
+  iterator end (void)
+  {
+    return iterator (Data () + m_slots.size (), Data () + m_slots.size (), false);
+  }
+  /** \returns an iterator to the first element */
+  const_iterator begin (void) const
+  {
+    return const_iterator (Data (), Data () + m_slots.size (), true);
+  }
+  /** \returns a past-the-end iterator */
+  const_iterator end (void) const
+  {
+    return const_iterator (Data () + m_slots.size (), Data () + m_slots.size (), false);
+  }
+
+  /** \returns the number of elements */
+  size_t size (void) const { return m_size; }
+  /** \returns true if there are no elements */
+  bool empty (void) const { return m_size == 0; }
+
+  /**
+   * \brief Remove all the elements, keeping the allocated table.
+   */
+  void clear (void)
+  {
+    for (typename std::vector<Slot>::iterator i = m_slots.begin (); i != m_slots.end (); ++i)
+      {
+        if (i->used)
+          {
+            *i = Slot ();
+          }
+      }
+    m_size = 0;
+  }
+
+  /**
+   * \brief Make room for n elements without further growth.
+   * \param n the number of elements
+   */
+  void reserve (size_t n)
+  {
+    size_t nSlots = m_slots.empty () ? 8 : m_slots.size ();
+    while (nSlots < 2 * n)
+      {
+        nSlots *= 2;
+      }
+    if (nSlots != m_slots.size ())
+      {
+        Rehash (nSlots);
+      }
+  }
+
+  /**
+   * \param key the key
+   * \returns an iterator to the element, or end ()
+   */
+  iterator find (Key const &key)
+  {
+    if (m_size == 0)
+      {
+        return end ();
+      }
+    size_t i = FindSlot (key);
+    if (!m_slots[i].used)
+      {
+        return end ();
+      }
+    return iterator (Data () + i, Data () + m_slots.size (), false);
+  }
+  /**
+   * \param key the key
+   * \returns an iterator to the element, or end ()
+   */
+  const_iterator find (Key const &key) const
+  {
+    if (m_size == 0)
+      {
+        return end ();
+      }
+    size_t i = FindSlot (key);
+    if (!m_slots[i].used)
+      {
+        return end ();
+      }
+    return const_iterator (Data () + i, Data () + m_slots.size (), false);
+  }
+  /**
+   * \param key the key
+   * \returns 1 if the key is present, 0 otherwise
+   */
+  size_t count (Key const &key) const
+  {
+    return find (key) == end () ? 0 : 1;
+  }
+
+  /**
+   * \brief Insert an element unless its key is already present.
+   * \param value the element
+   * \returns an iterator to the element with that key, and whether
+   *          the insertion took place
+   */
+  std::pair<iterator, bool> insert (value_type const &value)
+  {
+    std::pair<size_t, bool> slot = InsertSlot (value.first);
+    if (slot.second)
+      {
+        m_slots[slot.first].value.second = value.second;
+      }
+    return std::make_pair (iterator (Data () + slot.first, Data () + m_slots.size (), false),
+                           slot.second);
+  }
+  /**
+   * \param key the key
+   * \returns a reference to the value for that key, inserting a
+   *          default-constructed one if needed
+   */
+  Value & operator[] (Key const &key)
+  {
+    return m_slots[InsertSlot (key).first].value.second;
+  }
+
+  /**
+   * \param key the key of the element to remove
+   * \returns the number of elements removed
+   */
+  size_t erase (Key const &key)
+  {
+    if (m_size == 0)
+      {
+        return 0;
+      }
+    size_t i = FindSlot (key);
+    if (!m_slots[i].used)
+      {
+        return 0;
+      }
+    EraseSlot (i);
+    return 1;
+  }
+  /**
+   * \param it the element to remove
+   */
+  void erase (iterator it)
+  {
+    EraseSlot (it.m_slot - Data ());
+  }
+
+  /**
+   * \param o the map to exchange contents with
+   */
+  void swap (OpenHashMap &o)
+  {
+    m_slots.swap (o.m_slots);
+    std::swap (m_size, o.m_size);
+    std::swap (m_shift, o.m_shift);
+  }
+
+private:
+  /** \returns the first slot */
+  Slot * Data (void)
+  {
+    return m_slots.empty () ? 0 : &m_slots[0];
+  }
+  /** \returns the first slot */
+  const Slot * Data (void) const
+  {
+    return m_slots.empty () ? 0 : &m_slots[0];
+  }
+  /**
+   * \param key the key
+   * \returns the home slot of the key
+   */
+  size_t HomeSlot (Key const &key) const
+  {
+    // Fibonacci hashing spreads the weak hashes of sequential keys
+    // (such as the addresses of a subnet) over the whole table.
+    return static_cast<size_t> ((static_cast<uint64_t> (m_hash (key)) * 0x9E3779B97F4A7C15ULL) >> m_shift);
+  }
+  /**
+   * \param key the key
+   * \returns the slot holding the key, or the free slot where it
+   *          would be inserted
+   */
+  size_t FindSlot (Key const &key) const
+  {
+    size_t mask = m_slots.size () - 1;
+    size_t i = HomeSlot (key);
+    while (m_slots[i].used && !m_equal (m_slots[i].value.first, key))
+      {
+        i = (i + 1) & mask;
+      }
+    return i;
+  }
+  /**
+   * \brief Find the slot of a key, claiming a free slot for it if the
+   * key is absent.
+   *
+   * The table only grows when the key is absent, so that looking up an
+   * existing key never moves the elements.  A claimed slot holds the
+   * key and a default-constructed value.
+   *
+   * \param key the key
+   * \returns the slot index, and whether the slot was claimed
+   */
+  std::pair<size_t, bool> InsertSlot (Key const &key)
+  {
+    if (m_size != 0)
+      {
+        size_t i = FindSlot (key);
+        if (m_slots[i].used)
+          {
+            return std::make_pair (i, false);
+          }
+      }
+    if (2 * (m_size + 1) > m_slots.size ())
+      {
+        Rehash (m_slots.empty () ? 8 : 2 * m_slots.size ());
+      }
+    size_t i = FindSlot (key);
+    m_slots[i].used = true;
+    m_slots[i].value.first = key;
+    m_size++;
+    return std::make_pair (i, true);
+  }
+  /**
+   * \brief Remove the element of a slot, shifting back the following
+   * elements of its probe sequence.
+   * \param i the slot index
+   */
+  void EraseSlot (size_t i)
+  {
+    size_t mask = m_slots.size () - 1;
+    size_t j = i;
+    for (;;)
+      {
+        j = (j + 1) & mask;
+        if (!m_slots[j].used)
+          {
+            break;
+          }
+        size_t home = HomeSlot (m_slots[j].value.first);
+        // leave the element at j if its home lies cyclically in (i, j]
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays)
+          {
+            m_slots[i] = m_slots[j];
+            i = j;
+          }
+      }
+    m_slots[i] = Slot ();
+    m_size--;
+  }
+  /**
+   * \param nSlots the new number of slots, a power of two
+   */
+  void Rehash (size_t nSlots)
+  {
+    std::vector<Slot> old (nSlots);
+    old.swap (m_slots);
+    m_shift = 64;
+    for (size_t n = nSlots; n > 1; n >>= 1)
+      {
+        m_shift--;
+      }
+    for (typename std::vector<Slot>::iterator i = old.begin (); i != old.end (); ++i)
+      {
+        if (i->used)
+          {
+            m_slots[FindSlot (i->value.first)] = *i;
+          }
+      }
+  }
+
+  std::vector<Slot> m_slots; //!< the table
+  size_t m_size;             //!< number of elements
+  uint32_t m_shift;          //!< 64 - log2 (number of slots)
+  Hash m_hash;               //!< hash functor
+  Equal m_equal;             //!< equality functor
+};
+
+} // namespace ns3
+
+#endif /* OPEN_HASH_MAP_H */
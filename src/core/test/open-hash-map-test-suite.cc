@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include <map>
+
+#include "ns3/test.h"
+#include "ns3/open-hash-map.h"
+
+using namespace ns3;
+
+/**
+ * OpenHashMap against std::map under a random mix of insertions,
+ * lookups and erasures.
+ */
+class OpenHashMapRandomTestCase : public TestCase
+{
+public:
+  OpenHashMapRandomTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+OpenHashMapRandomTestCase::OpenHashMapRandomTestCase ()
+  : TestCase ("Check OpenHashMap against std::map")
+{
+}
+
+void
+OpenHashMapRandomTestCase::DoRun (void)
+{
+  OpenHashMap<uint32_t, uint32_t> map;
+  std::map<uint32_t, uint32_t> ref;
+  uint32_t state = 12345;
+  for (uint32_t step = 0; step < 100000; step++)
+    {
+      // small key range so that erasures hit long probe sequences
+      state = state * 1664525 + 1013904223;
+      uint32_t key = (state >> 8) % 2048;
+      switch ((state >> 24) % 4)
+        {
+        case 0:
+        case 1:
+          {
+            std::pair<OpenHashMap<uint32_t, uint32_t>::iterator, bool> ret = map.insert (std::make_pair (key, step));
+            NS_TEST_ASSERT_MSG_EQ (ret.second, ref.insert (std::make_pair (key, step)).second,
+                                   "insert disagrees for key " << key);
+            NS_TEST_ASSERT_MSG_EQ (ret.first->first, key, "insert returned the wrong element");
+            NS_TEST_ASSERT_MSG_EQ (ret.first->second, ref[key], "insert returned the wrong element");
+          }
+          break;
+        case 2:
+          NS_TEST_ASSERT_MSG_EQ (map.erase (key), ref.erase (key),
+                                 "erase disagrees for key " << key);
+          break;
+        default:
+          NS_TEST_ASSERT_MSG_EQ (map.count (key), ref.count (key),
+                                 "count disagrees for key " << key);
+          if (ref.count (key))
+            {
+              NS_TEST_ASSERT_MSG_EQ (map.find (key)->second, ref[key],
+                                     "value disagrees for key " << key);
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (map.size (), ref.size (), "size disagrees at step " << step);
+    }
+
+  uint32_t n = 0;
+  for (OpenHashMap<uint32_t, uint32_t>::const_iterator i = map.begin (); i != map.end (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (i->second, ref[i->first], "iteration disagrees for key " << i->first);
+      n++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (n, ref.size (), "iteration missed elements");
+
+  while (!map.empty ())
+    {
+      map.erase (map.begin ());
+    }
+  NS_TEST_ASSERT_MSG_EQ ((map.find (ref.begin ()->first) == map.end ()), true, "erase by iterator left elements");
+}
+
+/**
+ * OpenHashMap with std::pair keys, operator[] and clear.
+ */
+class OpenHashMapPairTestCase : public TestCase
+{
+public:
+  OpenHashMapPairTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+OpenHashMapPairTestCase::OpenHashMapPairTestCase ()
+  : TestCase ("Check OpenHashMap with pair keys")
+{
+}
+
+void
+OpenHashMapPairTestCase::DoRun (void)
+{
+  typedef std::pair<uint64_t, uint8_t> Key;
+  OpenHashMap<Key, uint16_t> map;
+  for (uint64_t i = 0; i < 64; i++)
+    {
+      for (uint8_t proto = 0; proto < 4; proto++)
+        {
+          map[Key (i << 32, proto)] += proto + 1;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (map.size (), 256, "wrong size");
+  NS_TEST_ASSERT_MSG_EQ (map[Key (5ULL << 32, 3)], 4, "wrong value");
+  map[Key (5ULL << 32, 3)]++;
+  NS_TEST_ASSERT_MSG_EQ (map.find (Key (5ULL << 32, 3))->second, 5, "operator[] did not update in place");
+  NS_TEST_ASSERT_MSG_EQ (map.count (Key (5ULL << 32, 4)), 0, "unexpected key");
+
+  // at the growth threshold, hits must not move the elements
+  OpenHashMap<uint32_t, uint32_t> small;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      small[i] = i;
+    }
+  uint32_t &a = small.find (0)->second;
+  small[3] = a + 10;
+  small.insert (std::make_pair (2U, 0U));
+  NS_TEST_ASSERT_MSG_EQ (&a, &small[0], "lookup of an existing key moved the elements");
+  NS_TEST_ASSERT_MSG_EQ (small[3], 10, "operator[] did not update in place");
+  NS_TEST_ASSERT_MSG_EQ (small[2], 2, "insert overwrote an existing key");
+
+  map.clear ();
+  NS_TEST_ASSERT_MSG_EQ (map.size (), 0, "clear left elements");
+  NS_TEST_ASSERT_MSG_EQ ((map.begin () == map.end ()), true, "clear left elements");
+  NS_TEST_ASSERT_MSG_EQ (map.count (Key (5ULL << 32, 3)), 0, "clear left elements");
+}
+
+/**
+ * OpenHashMap test suite
+ */
+class OpenHashMapTestSuite : public TestSuite
+{
+public:
+  OpenHashMapTestSuite ();
+};
+
+OpenHashMapTestSuite::OpenHashMapTestSuite ()
+  : TestSuite ("open-hash-map", UNIT)
+{
+  AddTestCase (new OpenHashMapRandomTestCase, QUICK);
+  AddTestCase (new OpenHashMapPairTestCase, QUICK);
+}
+
+static OpenHashMapTestSuite g_openHashMapTestSuite;
@@ -30,6 +30,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "csma-net-device.h"
 #include "csma-channel.h"
 
@@ -521,7 +522,13 @@ CsmaNetDevice::TransmitStart (void)
           m_txMachineState = BUSY;
           m_phyTxBeginTrace (m_currentPkt);
 
-          Time tEvent = m_bps.CalculateBytesTxTime (m_currentPkt->GetSize ());
+          //
+          // An offloaded super-segment holds the channel for the whole train
+          // of frames it stands for, including the gaps between them.
+          //
+          uint32_t nPackets = SegmentationOffloadTag::GetWirePackets (m_currentPkt);
+          Time tEvent = m_bps.CalculateBytesTxTime (SegmentationOffloadTag::GetWireSize (m_currentPkt))
+            + m_tInterframeGap * static_cast<int64_t> (nPackets - 1);
           NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << tEvent.GetSeconds () << "sec");
           Simulator::Schedule (tEvent, &CsmaNetDevice::TransmitCompleteEvent, this);
         }
@@ -17,6 +17,7 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include <algorithm>
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -36,6 +37,7 @@ NS_LOG_COMPONENT_DEFINE ("ArpCache");
 
 NS_OBJECT_ENSURE_REGISTERED (ArpCache);
 
+
 TypeId 
 ArpCache::GetTypeId (void)
 {
@@ -74,6 +76,14 @@ ArpCache::GetTypeId (void)
                    UintegerValue (3),
                    MakeUintegerAccessor (&ArpCache::m_pendingQueueSize),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("SweepInterval",
+                   "Interval between two sweeps removing the expired "
+                   "ALIVE and DEAD entries from the cache. "
+                   "Zero disables the sweep, in which case entries "
+                   "only expire when they are looked up.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&ArpCache::m_sweepInterval),
+                   MakeTimeChecker ())
     .AddTraceSource ("Drop",
                      "Packet dropped due to ArpCache entry "
                      "in WaitReply expiring.",
@@ -190,16 +200,40 @@ ArpCache::StartWaitReplyTimer (void)
     }
 }
 
+void
+ArpCache::StartSweepTimer (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_sweepInterval.IsStrictlyPositive () && !m_sweepTimer.IsRunning ())
+    {
+      NS_LOG_LOGIC ("Starting SweepTimer at " << Simulator::Now () << " for " <<
+                    m_sweepInterval);
+      m_sweepTimer = Simulator::Schedule (m_sweepInterval,
+                                          &ArpCache::HandleSweep, this);
+    }
+}
+
+void
+ArpCache::HandleSweep (void)
+{
+  NS_LOG_FUNCTION (this);
+  Sweep ();
+  if (!m_arpCache.empty ())
+    {
+      StartSweepTimer ();
+    }
+}
+
 void
 ArpCache::HandleWaitReplyTimeout (void)
 {
   NS_LOG_FUNCTION (this);
   ArpCache::Entry* entry;
   bool restartWaitReplyTimer = false;
-  for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++) 
+  for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++)
     {
-      entry = (*i).second;
-      if (entry != 0 && entry->IsWaitReply ())
+      entry = &m_entries[i->second];
+      if (entry->IsWaitReply ())
         {
           if (entry->GetRetries () < m_maxRetries)
             {
@@ -241,16 +275,46 @@ void
 ArpCache::Flush (void)
 {
   NS_LOG_FUNCTION (this);
-  for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++) 
-    {
-      delete (*i).second;
-    }
-  m_arpCache.erase (m_arpCache.begin (), m_arpCache.end ());
+  m_arpCache.clear ();
+  m_entries.clear ();
+  m_freeEntries.clear ();
   if (m_waitReplyTimer.IsRunning ())
     {
       NS_LOG_LOGIC ("Stopping WaitReplyTimer at " << Simulator::Now ().GetSeconds () << " due to ArpCache flush");
       m_waitReplyTimer.Cancel ();
     }
+  m_sweepTimer.Cancel ();
+}
+
+uint32_t
+ArpCache::Sweep (void)
+{
+  NS_LOG_FUNCTION (this);
+  // erasing invalidates the iterators: collect the keys first
+  m_expired.clear ();
+  for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++)
+    {
+      ArpCache::Entry *entry = &m_entries[i->second];
+      if (!entry->IsWaitReply () && entry->IsExpired ())
+        {
+          NS_LOG_LOGIC ("Removing expired entry for " << i->first);
+          entry->Reset (Ipv4Address ());
+          m_freeEntries.push_back (i->second);
+          m_expired.push_back (i->first);
+        }
+    }
+  for (std::vector<Ipv4Address>::const_iterator i = m_expired.begin (); i != m_expired.end (); i++)
+    {
+      m_arpCache.erase (*i);
+    }
+  return m_expired.size ();
+}
+
+uint32_t
+ArpCache::GetNEntries (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_arpCache.size ();
 }
 
 void
@@ -261,6 +325,7 @@ ArpCache::PrintArpCache (Ptr<OutputStreamWrapper> stream)
 
   for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++)
     {
+      Entry *entry = &m_entries[i->second];
       *os << i->first << " dev ";
       std::string found = Names::FindName (m_device);
       if (Names::FindName (m_device) != "")
@@ -272,13 +337,13 @@ ArpCache::PrintArpCache (Ptr<OutputStreamWrapper> stream)
           *os << static_cast<int> (m_device->GetIfIndex ());
         }
 
-      *os << " lladdr " << i->second->GetMacAddress ();
+      *os << " lladdr " << entry->GetMacAddress ();
 
-      if (i->second->IsAlive ())
+      if (entry->IsAlive ())
         {
           *os << " REACHABLE\n";
         }
-      else if (i->second->IsWaitReply ())
+      else if (entry->IsWaitReply ())
         {
           *os << " DELAY\n";
         }
@@ -293,10 +358,10 @@ ArpCache::Entry *
 ArpCache::Lookup (Ipv4Address to)
 {
   NS_LOG_FUNCTION (this << to);
-  if (m_arpCache.find (to) != m_arpCache.end ()) 
+  CacheI it = m_arpCache.find (to);
+  if (it != m_arpCache.end ())
     {
-      ArpCache::Entry *entry = m_arpCache[to];
-      return entry;
+      return &m_entries[it->second];
     }
   return 0;
 }
@@ -307,20 +372,53 @@ ArpCache::Add (Ipv4Address to)
   NS_LOG_FUNCTION (this << to);
   NS_ASSERT (m_arpCache.find (to) == m_arpCache.end ());
 
-  ArpCache::Entry *entry = new ArpCache::Entry (this);
-  m_arpCache[to] = entry;
-  entry->SetIpv4Address (to);
+  uint32_t index;
+  if (!m_freeEntries.empty ())
+    {
+      index = m_freeEntries.back ();
+      m_freeEntries.pop_back ();
+    }
+  else
+    {
+      index = m_entries.size ();
+      m_entries.push_back (ArpCache::Entry (this));
+    }
+  ArpCache::Entry *entry = &m_entries[index];
+  entry->Reset (to);
+
+  m_arpCache.insert (std::make_pair (to, index));
+
+  StartSweepTimer ();
   return entry;
 }
 
 ArpCache::Entry::Entry (ArpCache *arp)
   : m_arp (arp),
     m_state (ALIVE),
+    m_pendingHead (0),
+    m_pendingCount (0),
     m_retries (0)
 {
   NS_LOG_FUNCTION (this << arp);
 }
 
+void
+ArpCache::Entry::Reset (Ipv4Address destination)
+{
+  NS_LOG_FUNCTION (this << destination);
+  for (; m_pendingCount > 0; m_pendingCount--)
+    {
+      m_pending[m_pendingHead] = 0;
+      m_pendingHead = (m_pendingHead + 1) % m_pending.size ();
+    }
+  m_pendingHead = 0;
+  m_state = ALIVE;
+  m_lastSeen = Time ();
+  m_macAddress = Address ();
+  m_ipv4Address = destination;
+  m_retries = 0;
+}
+
 
 bool 
 ArpCache::Entry::IsDead (void)
@@ -370,21 +468,27 @@ ArpCache::Entry::UpdateWaitReply (Ptr<Packet> waiting)
    * we dump the previously waiting packet and
    * replace it with this one.
    */
-  if (m_pending.size () >= m_arp->m_pendingQueueSize)
+  if (m_pendingCount >= m_arp->m_pendingQueueSize)
     {
       return false;
     }
-  m_pending.push_back (waiting);
-  return true;
+  return EnqueuePending (waiting);
 }
 void 
 ArpCache::Entry::MarkWaitReply (Ptr<Packet> waiting)
 {
   NS_LOG_FUNCTION (this << waiting);
   NS_ASSERT (m_state == ALIVE || m_state == DEAD);
-  NS_ASSERT (m_pending.empty ());
+  NS_ASSERT (m_pendingCount == 0);
+  // the ring is sized once for the current PendingQueueSize and then reused
+  uint32_t capacity = std::max<uint32_t> (m_arp->m_pendingQueueSize, 1);
+  if (m_pending.size () != capacity)
+    {
+      m_pending.resize (capacity);
+      m_pendingHead = 0;
+    }
   m_state = WAIT_REPLY;
-  m_pending.push_back (waiting);
+  EnqueuePending (waiting);
   UpdateSeen ();
   m_arp->StartWaitReplyTimer ();
 }
@@ -441,17 +545,31 @@ Ptr<Packet>
 ArpCache::Entry::DequeuePending (void)
 {
   NS_LOG_FUNCTION (this);
-  if (m_pending.empty ())
+  if (m_pendingCount == 0)
     {
       return 0;
     }
   else
     {
-      Ptr<Packet> p = m_pending.front ();
-      m_pending.pop_front ();
+      Ptr<Packet> p = m_pending[m_pendingHead];
+      m_pending[m_pendingHead] = 0;
+      m_pendingHead = (m_pendingHead + 1) % m_pending.size ();
+      m_pendingCount--;
       return p;
     }
 }
+bool
+ArpCache::Entry::EnqueuePending (Ptr<Packet> waiting)
+{
+  NS_LOG_FUNCTION (this << waiting);
+  if (m_pendingCount == m_pending.size ())
+    {
+      return false;
+    }
+  m_pending[(m_pendingHead + m_pendingCount) % m_pending.size ()] = waiting;
+  m_pendingCount++;
+  return true;
+}
 void 
 ArpCache::Entry::UpdateSeen (void)
 {
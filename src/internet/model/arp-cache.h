@@ -21,7 +21,8 @@
 #define ARP_CACHE_H
 
 #include <stdint.h>
-#include <list>
+#include <vector>
+#include <deque>
 #include "ns3/simulator.h"
 #include "ns3/callback.h"
 #include "ns3/packet.h"
@@ -32,8 +33,8 @@
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/traced-callback.h"
-#include "ns3/sgi-hashmap.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/open-hash-map.h"
 
 namespace ns3 {
 
@@ -46,6 +47,16 @@ class Ipv4Interface;
  *
  * A cached lookup table for translating layer 3 addresses to layer 2.
  * This implementation does lookups from IPv4 to a MAC address
+ *
+ * Entries are indexed by an OpenHashMap keyed by the IPv4 address.
+ * The map only holds the index of the entry in a chunked entry pool,
+ * so that an ArpCache::Entry pointer returned by Lookup or Add stays
+ * valid when the map grows.  Pool slots and the per-entry pending packet rings
+ * are recycled, so a steady-state cache does not allocate.
+ *
+ * Entries normally expire lazily, when they are looked up.  If the
+ * SweepInterval attribute is non-zero, a single periodic sweep event
+ * per cache removes the expired ALIVE and DEAD entries in one pass.
  */
 class ArpCache : public Object
 {
@@ -139,6 +150,12 @@ public:
    * in which case this method does nothing.
    */
   void StartWaitReplyTimer (void);
+  /**
+   * This method will schedule a sweep of the expired entries at
+   * SweepInterval in the future, unless the sweep is disabled or
+   * already scheduled.
+   */
+  void StartSweepTimer (void);
   /**
    * \brief Do lookup in the ARP cache against an IP address
    * \param destination The destination IPv4 address to lookup the MAC address
@@ -154,6 +171,17 @@ public:
    * \brief Clear the ArpCache of all entries
    */
   void Flush (void);
+  /**
+   * \brief Remove the expired ALIVE and DEAD entries from the cache
+   *
+   * Entries in WAIT_REPLY state are left to HandleWaitReplyTimeout.
+   * \returns the number of entries removed
+   */
+  uint32_t Sweep (void);
+  /**
+   * \returns the number of entries in the cache
+   */
+  uint32_t GetNEntries (void) const;
 
   /**
    * \brief Print the ARP cache entries
@@ -166,6 +194,7 @@ public:
    * \brief A record that that holds information about an ArpCache entry
    */
   class Entry {
+    friend class ArpCache;
 public:
     /**
      * \brief Constructor
@@ -256,6 +285,21 @@ private:
      */
     void UpdateSeen (void);
 
+    /**
+     * \brief Bring a recycled entry back to its initial state
+     *
+     * The storage of the pending packet ring is kept.
+     * \param destination The Ipv4Address for this entry
+     */
+    void Reset (Ipv4Address destination);
+
+    /**
+     * \brief Append a packet to the pending packet ring
+     * \param waiting the packet
+     * \return false if the ring is full
+     */
+    bool EnqueuePending (Ptr<Packet> waiting);
+
     /**
      * \brief Returns the entry timeout
      * \returns the entry timeout
@@ -267,19 +311,26 @@ private:
     Time m_lastSeen; //!< last moment a packet from that address has been seen
     Address m_macAddress; //!< entry's MAC address
     Ipv4Address m_ipv4Address; //!< entry's IP address
-    std::list<Ptr<Packet> > m_pending; //!< list of pending packets for the entry's IP
+    std::vector<Ptr<Packet> > m_pending; //!< ring of pending packets for the entry's IP
+    uint32_t m_pendingHead; //!< index of the oldest pending packet in the ring
+    uint32_t m_pendingCount; //!< number of pending packets in the ring
     uint32_t m_retries; //!< rerty counter
   };
 
 private:
   /**
-   * \brief ARP Cache container
+   * \brief ARP Cache container, mapping addresses to entry pool indexes
    */
-  typedef sgi::hash_map<Ipv4Address, ArpCache::Entry *, Ipv4AddressHash> Cache;
+  typedef OpenHashMap<Ipv4Address, uint32_t, Ipv4AddressHash> Cache;
   /**
    * \brief ARP Cache container iterator
    */
-  typedef sgi::hash_map<Ipv4Address, ArpCache::Entry *, Ipv4AddressHash>::iterator CacheI;
+  typedef Cache::iterator CacheI;
+
+  /**
+   * \brief Periodic event handler removing the expired entries
+   */
+  void HandleSweep (void);
 
   virtual void DoDispose (void);
 
@@ -299,7 +350,12 @@ private:
    */
   void HandleWaitReplyTimeout (void);
   uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
+  Time m_sweepInterval; //!< interval between sweeps of expired entries, zero to disable
+  EventId m_sweepTimer; //!< sweep event
   Cache m_arpCache; //!< the ARP cache
+  std::deque<Entry> m_entries; //!< entry pool, stable addresses
+  std::vector<uint32_t> m_freeEntries; //!< recycled pool indexes
+  std::vector<Ipv4Address> m_expired; //!< scratch list reused by Sweep
   TracedCallback<Ptr<const Packet> > m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
 
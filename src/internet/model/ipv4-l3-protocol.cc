@@ -32,6 +32,7 @@
 #include "ns3/ipv4-header.h"
 #include "ns3/boolean.h"
 #include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/segmentation-offload-tag.h"
 
 #include "loopback-net-device.h"
 #include "arp-l3-protocol.h"
@@ -762,12 +763,13 @@ Ipv4L3Protocol::BuildHeader (
   uint64_t dst = destination.Get ();
   uint64_t srcDst = dst | (src << 32);
   std::pair<uint64_t, uint8_t> key = std::make_pair (srcDst, protocol);
+  uint16_t &identification = m_identification[key];
 
   if (mayFragment == true)
     {
       ipHeader.SetMayFragment ();
-      ipHeader.SetIdentification (m_identification[key]);
-      m_identification[key]++;
+      ipHeader.SetIdentification (identification);
+      identification++;
     }
   else
     {
@@ -776,8 +778,8 @@ Ipv4L3Protocol::BuildHeader (
       // identification requirement:
       // >> Originating sources MAY set the IPv4 ID field of atomic datagrams
       //    to any value.
-      ipHeader.SetIdentification (m_identification[key]);
-      m_identification[key]++;
+      ipHeader.SetIdentification (identification);
+      identification++;
     }
   if (Node::ChecksumEnabled ())
     {
@@ -804,13 +806,16 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
   NS_ASSERT (interface >= 0);
   Ptr<Ipv4Interface> outInterface = GetInterface (interface);
   NS_LOG_LOGIC ("Send via NetDevice ifIndex " << outDev->GetIfIndex () << " ipv4InterfaceIndex " << interface);
+  // Offloaded super-segments are accounted as wire packets by the device: never fragment them
+  bool fragment = packet->GetSize () > outInterface->GetDevice ()->GetMtu ()
+    && SegmentationOffloadTag::GetWirePackets (packet) == 1;
 
   if (!route->GetGateway ().IsEqual (Ipv4Address ("0.0.0.0")))
     {
       if (outInterface->IsUp ())
         {
           NS_LOG_LOGIC ("Send to gateway " << route->GetGateway ());
-          if ( packet->GetSize () > outInterface->GetDevice ()->GetMtu () )
+          if (fragment)
             {
               std::list<Ptr<Packet> > listFragments;
               DoFragmentation (packet, outInterface->GetDevice ()->GetMtu (), listFragments);
@@ -839,7 +844,7 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
       if (outInterface->IsUp ())
         {
           NS_LOG_LOGIC ("Send to destination " << ipHeader.GetDestination ());
-          if ( packet->GetSize () > outInterface->GetDevice ()->GetMtu () )
+          if (fragment)
             {
               std::list<Ptr<Packet> > listFragments;
               DoFragmentation (packet, outInterface->GetDevice ()->GetMtu (), listFragments);
@@ -1381,10 +1386,11 @@ Ipv4L3Protocol::ProcessFragment (Ptr<Packet>& packet, Ipv4Header& ipHeader, uint
       packet = fragments->GetPacket ();
       fragments = 0;
       m_fragments.erase (key);
-      if (m_fragmentsTimers[key].IsRunning ())
+      MapFragmentsTimers_t::iterator timer = m_fragmentsTimers.find (key);
+      if (timer != m_fragmentsTimers.end () && timer->second.IsRunning ())
         {
           NS_LOG_LOGIC ("Stopping WaitFragmentsTimer at " << Simulator::Now ().GetSeconds () << " due to complete packet");
-          m_fragmentsTimers[key].Cancel ();
+          timer->second.Cancel ();
         }
       m_fragmentsTimers.erase (key);
       ret = true;
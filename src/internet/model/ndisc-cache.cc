@@ -92,10 +92,10 @@ NdiscCache::Entry* NdiscCache::Lookup (Ipv6Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
 
-  if (m_ndCache.find (dst) != m_ndCache.end ())
+  CacheI it = m_ndCache.find (dst);
+  if (it != m_ndCache.end ())
     {
-      NdiscCache::Entry* entry = m_ndCache[dst];
-      return entry;
+      return it->second;
     }
   return 0;
 }
@@ -136,7 +136,7 @@ void NdiscCache::Flush ()
       delete (*i).second; /* delete the pointer NdiscCache::Entry */
     }
 
-  m_ndCache.erase (m_ndCache.begin (), m_ndCache.end ());
+  m_ndCache.clear ();
 }
 
 void NdiscCache::SetUnresQlen (uint32_t unresQlen)
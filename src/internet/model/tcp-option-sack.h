@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TCP_OPTION_SACK_H
+#define TCP_OPTION_SACK_H
+
+#include <list>
+#include "ns3/tcp-option.h"
+#include "ns3/sequence-number.h"
+
+namespace ns3 {
+
+/**
+ * \brief Defines the TCP option of kind 5 (selective acknowledgment option)
+ * as in \RFC{2018}
+ *
+ * The option reports to the data sender the non-contiguous blocks of data
+ * that have been received and queued by the receiver. Each block is
+ * described by the sequence number of its first byte (left edge) and by
+ * the sequence number immediately following its last byte (right edge).
+ *
+ * Since the TCP option space is limited to 40 bytes, at most 4 blocks fit
+ * in the option; 3 if the timestamp option is also in use.
+ */
+class TcpOptionSack : public TcpOption
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  /// SACK block definition: left and right edge of the block
+  typedef std::pair<SequenceNumber32, SequenceNumber32> SackBlock;
+  /// SACK list definition
+  typedef std::list<SackBlock> SackList;
+
+  TcpOptionSack ();
+  virtual ~TcpOptionSack ();
+
+  virtual void Print (std::ostream &os) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+  virtual uint8_t GetKind (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+
+  /**
+   * \brief Add a SACK block at the end of the list
+   * \param s the block to add
+   */
+  void AddSackBlock (SackBlock s);
+
+  /**
+   * \brief Count the total number of SACK blocks
+   * \return the number of SACK blocks
+   */
+  uint32_t GetNumSackBlocks (void) const;
+
+  /**
+   * \brief Discard all the SACK blocks
+   */
+  void ClearSackList (void);
+
+  /**
+   * \brief Get the SACK list
+   * \return the SACK list
+   */
+  SackList GetSackList (void) const;
+
+  /**
+   * \brief Compute how many SACK blocks fit in the given option space
+   * \param space the number of free bytes in the options field
+   * \return the number of blocks that can be carried
+   */
+  static uint32_t GetMaxSackBlocks (uint32_t space);
+
+protected:
+  SackList m_sackList; //!< the list of SACK blocks
+};
+
+} // namespace ns3
+
+#endif /* TCP_OPTION_SACK */
@@ -18,6 +18,8 @@
  * Author: Adrian Sai-wah Tam <adrian.sw.tam@gmail.com>
  */
 
+#include <algorithm>
+
 #include "ns3/packet.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
@@ -52,7 +54,8 @@ TcpRxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpRxBuffer::TcpRxBuffer (uint32_t n)
-  : m_nextRxSeq (n), m_gotFin (false), m_size (0), m_maxBuffer (32768), m_availBytes (0)
+  : m_nextRxSeq (n), m_gotFin (false), m_size (0), m_maxBuffer (32768), m_availBytes (0),
+    m_lastRxSeq (n)
 {
 }
 
@@ -196,6 +199,7 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
   // Insert packet into buffer
   NS_ASSERT (m_data.find (headSeq) == m_data.end ()); // Shouldn't be there yet
   m_data [ headSeq ] = p;
+  m_lastRxSeq = headSeq;
   NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
   // Update variables
   m_size += p->GetSize ();      // Occupancy
@@ -265,4 +269,46 @@ TcpRxBuffer::Extract (uint32_t maxSize)
   return outPkt;
 }
 
+TcpOptionSack::SackList
+TcpRxBuffer::GetSackList (uint32_t maxBlocks) const
+{
+  NS_LOG_FUNCTION (this << maxBlocks);
+
+  TcpOptionSack::SackList blocks;
+  if (maxBlocks == 0)
+    {
+      return blocks;
+    }
+
+  // Data beyond nextRxSeq is out of order; coalesce adjacent packets
+  std::map<SequenceNumber32, Ptr<Packet> >::const_iterator i = m_data.upper_bound (m_nextRxSeq);
+  while (i != m_data.end ())
+    {
+      SequenceNumber32 left = i->first;
+      SequenceNumber32 right = left + SequenceNumber32 (i->second->GetSize ());
+      for (++i; i != m_data.end () && i->first <= right; ++i)
+        {
+          right = std::max (right, i->first + SequenceNumber32 (i->second->GetSize ()));
+        }
+      // Decreasing order, so the highest blocks survive the truncation below
+      blocks.push_front (std::make_pair (left, right));
+    }
+
+  // Move the block holding the last received segment in front
+  for (TcpOptionSack::SackList::iterator it = blocks.begin (); it != blocks.end (); ++it)
+    {
+      if (it->first <= m_lastRxSeq && m_lastRxSeq < it->second)
+        {
+          blocks.splice (blocks.begin (), blocks, it);
+          break;
+        }
+    }
+
+  while (blocks.size () > maxBlocks)
+    {
+      blocks.pop_back ();
+    }
+  return blocks;
+}
+
 } //namepsace ns3
@@ -27,6 +27,7 @@
 #include "ns3/sequence-number.h"
 #include "ns3/ptr.h"
 #include "ns3/tcp-header.h"
+#include "ns3/tcp-option-sack.h"
 
 namespace ns3 {
 class Packet;
@@ -124,6 +125,19 @@ public:
    * \returns a packet
    */
   Ptr<Packet> Extract (uint32_t maxSize);
+
+  /**
+   * \brief Get the list of non-contiguous blocks of data held in the buffer
+   *
+   * The blocks are meant to be reported to the peer through the SACK
+   * option. As required by \RFC{2018}, the block containing the most
+   * recently received segment comes first; the others follow in
+   * decreasing sequence order.
+   *
+   * \param maxBlocks the maximum number of blocks to return
+   * \returns the list of out-of-order blocks (empty if there is no gap)
+   */
+  TcpOptionSack::SackList GetSackList (uint32_t maxBlocks) const;
 public:
   /// container for data stored in the buffer
   typedef std::map<SequenceNumber32, Ptr<Packet> >::iterator BufIterator;
@@ -133,6 +147,7 @@ public:
   uint32_t m_size;                           //!< Number of total data bytes in the buffer, not necessarily contiguous
   uint32_t m_maxBuffer;                      //!< Upper bound of the number of data bytes in buffer (RCV.WND)
   uint32_t m_availBytes;                     //!< Number of bytes available to read, i.e. contiguous block at head
+  SequenceNumber32 m_lastRxSeq;              //!< Seqnum of the most recently buffered data
   std::map<SequenceNumber32, Ptr<Packet> > m_data; //!< Corresponding data (may be null)
 };
 
@@ -41,6 +41,7 @@
 #include "ns3/double.h"
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "tcp-socket-base.h"
 #include "tcp-l4-protocol.h"
 #include "ipv4-end-point.h"
@@ -49,6 +50,8 @@
 #include "tcp-header.h"
 #include "tcp-option-winscale.h"
 #include "tcp-option-ts.h"
+#include "tcp-option-sack-permitted.h"
+#include "tcp-option-sack.h"
 #include "rtt-estimator.h"
 
 #include <math.h>
@@ -60,6 +63,24 @@ NS_LOG_COMPONENT_DEFINE ("TcpSocketBase");
 
 NS_OBJECT_ENSURE_REGISTERED (TcpSocketBase);
 
+/// Number of duplicate ACKs (or SACKed segments) that trigger the SACK-based recovery (RFC 6675 DupThresh)
+static const uint32_t SACK_DUP_THRESH = 3;
+
+/// Largest payload of an offloaded super-segment, so that it still fits the IPv4 total length field
+static const uint32_t TSO_MAX_PAYLOAD = 65535 - 20 - 60;
+
+/**
+ * \brief Order a sequence number against an RttHistory entry
+ * \param seq the sequence number
+ * \param h the history entry
+ * \returns true if seq comes before the first byte of the entry
+ */
+static bool
+SeqBeforeHistory (const SequenceNumber32 &seq, const RttHistory &h)
+{
+  return seq < h.seq;
+}
+
 TypeId
 TcpSocketBase::GetTypeId (void)
 {
@@ -96,6 +117,16 @@ TcpSocketBase::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpSocketBase::m_timestampEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("Sack", "Enable or disable the SACK option and the SACK-based loss recovery",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::m_sackEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("TsoMaxSegments",
+                   "Maximum number of segments sent as a single offloaded super-segment "
+                   "over IPv4 (TSO emulation); 1 disables segmentation offload",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&TcpSocketBase::m_tsoMaxSegments),
+                   MakeUintegerChecker<uint32_t> (1, 64))
     .AddAttribute ("MinRto",
                    "Minimum retransmit timeout value",
                    TimeValue (Seconds (1.0)), // RFC 6298 says min RTO=1 sec, but Linux uses 200ms. See http://www.postel.org/pipermail/end2end-interest/2004-November/004402.html
@@ -190,7 +221,12 @@ TcpSocketBase::TcpSocketBase (void)
     m_sndScaleFactor (0),
     m_rcvScaleFactor (0),
     m_timestampEnabled (true),
-    m_timestampToEcho (0)
+    m_timestampToEcho (0),
+    m_sackEnabled (false),
+    m_tsoMaxSegments (1),
+    m_inSackRecovery (false),
+    m_sackRecover (0),
+    m_highRxt (0)
 
 {
   NS_LOG_FUNCTION (this);
@@ -237,7 +273,12 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_sndScaleFactor (sock.m_sndScaleFactor),
     m_rcvScaleFactor (sock.m_rcvScaleFactor),
     m_timestampEnabled (sock.m_timestampEnabled),
-    m_timestampToEcho (sock.m_timestampToEcho)
+    m_timestampToEcho (sock.m_timestampToEcho),
+    m_sackEnabled (sock.m_sackEnabled),
+    m_tsoMaxSegments (sock.m_tsoMaxSegments),
+    m_inSackRecovery (false),
+    m_sackRecover (0),
+    m_highRxt (0)
 
 {
   NS_LOG_FUNCTION (this);
@@ -1151,6 +1192,12 @@ TcpSocketBase::ReceivedAck (Ptr<Packet> packet, const TcpHeader& tcpHeader)
 {
   NS_LOG_FUNCTION (this << tcpHeader);
 
+  if ((tcpHeader.GetFlags () & TcpHeader::ACK) && m_sackEnabled
+      && tcpHeader.HasOption (TcpOption::SACK))
+    {
+      ProcessOptionSack (tcpHeader.GetOption (TcpOption::SACK));
+    }
+
   // Received ACK. Compare the ACK number against highest unacked seqno
   if (0 == (tcpHeader.GetFlags () & TcpHeader::ACK))
     { // Ignore if no ACK flag
@@ -1164,7 +1211,15 @@ TcpSocketBase::ReceivedAck (Ptr<Packet> packet, const TcpHeader& tcpHeader)
       if (tcpHeader.GetAckNumber () < m_nextTxSequence && packet->GetSize() == 0)
         {
           NS_LOG_LOGIC ("Dupack of " << tcpHeader.GetAckNumber ());
-          DupAck (tcpHeader, ++m_dupAckCount);
+          if (m_sackEnabled)
+            { // Loss recovery is driven by the scoreboard
+              ++m_dupAckCount;
+              SackDupAck ();
+            }
+          else
+            {
+              DupAck (tcpHeader, ++m_dupAckCount);
+            }
         }
       // otherwise, the ACK is precisely equal to the nextTxSequence
       NS_ASSERT (tcpHeader.GetAckNumber () <= m_nextTxSequence);
@@ -1172,7 +1227,14 @@ TcpSocketBase::ReceivedAck (Ptr<Packet> packet, const TcpHeader& tcpHeader)
   else if (tcpHeader.GetAckNumber () > m_txBuffer->HeadSequence ())
     { // Case 3: New ACK, reset m_dupAckCount and update m_txBuffer
       NS_LOG_LOGIC ("New ack of " << tcpHeader.GetAckNumber ());
-      NewAck (tcpHeader.GetAckNumber ());
+      if (m_inSackRecovery)
+        {
+          SackNewAck (tcpHeader.GetAckNumber ());
+        }
+      else
+        {
+          NewAck (tcpHeader.GetAckNumber ());
+        }
       m_dupAckCount = 0;
     }
   // If there is any data piggybacked, store it into m_rxBuffer
@@ -1879,8 +1941,10 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
 {
   NS_LOG_FUNCTION (this << seq << maxSize << withAck);
 
+  // With SACK, every segment below m_highTxMark is a retransmission, so
+  // that its history entry is marked and never gives an RTT sample (Karn)
   bool isRetransmission = false;
-  if ( seq == m_txBuffer->HeadSequence () )
+  if (m_sackEnabled ? seq < m_highTxMark : seq == m_txBuffer->HeadSequence ())
     {
       isRetransmission = true;
     }
@@ -1930,6 +1994,12 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
       p->AddPacketTag (ipHopLimitTag);
     }
 
+  if (sz > m_segmentSize)
+    { // Super-segment: the devices account for it as the segments it carries
+      SegmentationOffloadTag tsoTag ((sz + m_segmentSize - 1) / m_segmentSize, sz);
+      p->AddPacketTag (tsoTag);
+    }
+
   if (m_closeOnEmpty && (remainingData == 0))
     {
       flags |= TcpHeader::FIN;
@@ -1992,6 +2062,16 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
     { // This is the next expected one, just log at end
       m_history.push_back (RttHistory (seq, sz, Simulator::Now () ));
     }
+  else if (m_sackEnabled)
+    { // The history is sorted, as only new data is appended to it
+      RttHistory_t::iterator i = FindHistory (seq);
+      if (i != m_history.end ())
+        {
+          i->retx = true;
+          i->count = ((seq + SequenceNumber32 (sz)) - i->seq); // And update count in hist
+          i->time = Simulator::Now (); // Last send time, for the loss detection
+        }
+    }
   else
     { // This is a retransmit, find in list and mark as re-tx
       for (RttHistory_t::iterator i = m_history.begin (); i != m_history.end (); ++i)
@@ -2057,7 +2137,7 @@ TcpSocketBase::SendPendingData (bool withAck)
                     " highestRxAck " << m_txBuffer->HeadSequence () <<
                     " pd->Size " << m_txBuffer->Size () <<
                     " pd->SFS " << m_txBuffer->SizeFromSequence (m_nextTxSequence));
-      uint32_t s = std::min (w, m_segmentSize);  // Send no more than window
+      uint32_t s = std::min (w, MaxSendSize ());  // Send no more than window
       uint32_t sz = SendDataPacket (m_nextTxSequence, s, withAck);
       nPacketsSent++;                             // Count sent this loop
       m_nextTxSequence += sz;                     // Advance next tx sequence
@@ -2066,6 +2146,16 @@ TcpSocketBase::SendPendingData (bool withAck)
   return (nPacketsSent > 0);
 }
 
+uint32_t
+TcpSocketBase::MaxSendSize () const
+{
+  if (m_tsoMaxSegments > 1 && m_endPoint != 0)
+    {
+      return std::min (m_segmentSize * m_tsoMaxSegments, TSO_MAX_PAYLOAD);
+    }
+  return m_segmentSize;
+}
+
 uint32_t
 TcpSocketBase::UnAckDataCount ()
 {
@@ -2091,7 +2181,8 @@ uint32_t
 TcpSocketBase::AvailableWindow ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  uint32_t unack = UnAckDataCount (); // Number of outstanding bytes
+  // Number of outstanding bytes; during SACK recovery, the ones still in the network
+  uint32_t unack = m_inSackRecovery ? SackPipe () : UnAckDataCount ();
   uint32_t win = Window (); // Number of bytes allowed to be outstanding
   NS_LOG_LOGIC ("UnAckCount=" << unack << ", Win=" << win);
   return (win < unack) ? 0 : (win - unack);
@@ -2136,7 +2227,10 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
   else
     { // In-sequence packet: ACK if delayed ack count allows
-      if (++m_delAckCount >= m_delAckMaxCount)
+      // An offloaded super-segment counts as the segments it carries (GRO)
+      SegmentationOffloadTag tsoTag;
+      m_delAckCount += p->PeekPacketTag (tsoTag) ? tsoTag.GetSegments () : 1;
+      if (m_delAckCount >= m_delAckMaxCount)
         {
           m_delAckEvent.Cancel ();
           m_delAckCount = 0;
@@ -2218,6 +2312,10 @@ TcpSocketBase::EstimateRtt (const TcpHeader& tcpHeader)
       // RFC 6298, clause 2.4
       m_rto = Max (m_rtt->GetEstimate () + Max (m_clockGranularity, m_rtt->GetVariation ()*4), m_minRto);
       m_lastRtt = m_rtt->GetEstimate ();
+      if (m_minRtt.IsZero () || m < m_minRtt)
+        {
+          m_minRtt = m;
+        }
       NS_LOG_FUNCTION(this << m_lastRtt);
     }
 }
@@ -2298,6 +2396,12 @@ TcpSocketBase::ReTxTimeout ()
       return;
     }
 
+  if (m_sackEnabled)
+    { // RFC 2018 sec. 8: after a timeout, the SACK information is discarded
+      m_txBuffer->ResetScoreboard ();
+      m_inSackRecovery = false;
+    }
+
   Retransmit ();
 }
 
@@ -2573,6 +2677,12 @@ TcpSocketBase::ReadOptions (const TcpHeader& header)
               ScaleSsThresh (m_sndScaleFactor);
             }
         }
+
+      if (m_sackEnabled)
+        {
+          m_sackEnabled = header.HasOption (TcpOption::SACKPERMITTED);
+          NS_LOG_INFO ("SACK " << (m_sackEnabled ? "enabled" : "disabled") << " by the peer");
+        }
     }
 
   m_timestampEnabled = false;
@@ -2599,6 +2709,19 @@ TcpSocketBase::AddOptions (TcpHeader& header)
     {
       AddOptionTimestamp (header);
     }
+
+  // SACK permitted goes in SYN packets, the SACK blocks in the others
+  if (m_sackEnabled)
+    {
+      if (header.GetFlags () & TcpHeader::SYN)
+        {
+          AddOptionSackPermitted (header);
+        }
+      else
+        {
+          AddOptionSack (header);
+        }
+    }
 }
 
 void
@@ -2693,6 +2816,234 @@ TcpSocketBase::AddOptionTimestamp (TcpHeader& header)
                option->GetTimestamp () << " echo=" << m_timestampToEcho);
 }
 
+void
+TcpSocketBase::AddOptionSackPermitted (TcpHeader& header)
+{
+  NS_LOG_FUNCTION (this << header);
+  NS_ASSERT (header.GetFlags () & TcpHeader::SYN);
+
+  Ptr<TcpOptionSackPermitted> option = CreateObject<TcpOptionSackPermitted> ();
+  header.AppendOption (option);
+  NS_LOG_INFO (m_node->GetId () << " Add option SACK permitted");
+}
+
+void
+TcpSocketBase::AddOptionSack (TcpHeader& header)
+{
+  NS_LOG_FUNCTION (this << header);
+
+  // Option space left, the header length being in 32-bit words
+  uint32_t space = 40 - (header.GetLength () * 4 - 20);
+  TcpOptionSack::SackList list = m_rxBuffer->GetSackList (TcpOptionSack::GetMaxSackBlocks (space));
+  if (list.empty ())
+    {
+      return;
+    }
+
+  Ptr<TcpOptionSack> option = CreateObject<TcpOptionSack> ();
+  for (TcpOptionSack::SackList::const_iterator it = list.begin (); it != list.end (); ++it)
+    {
+      option->AddSackBlock (*it);
+    }
+  header.AppendOption (option);
+  NS_LOG_INFO (m_node->GetId () << " Add option SACK with " << list.size () <<
+               " blocks, first [" << list.front ().first << ";" << list.front ().second << ")");
+}
+
+void
+TcpSocketBase::ProcessOptionSack (const Ptr<const TcpOption> option)
+{
+  NS_LOG_FUNCTION (this << option);
+
+  Ptr<const TcpOptionSack> sack = DynamicCast<const TcpOptionSack> (option);
+  TcpOptionSack::SackList list = sack->GetSackList ();
+  uint32_t newlySacked = m_txBuffer->UpdateScoreboard (list);
+
+  // The last byte of each block tells which segment has been delivered
+  for (TcpOptionSack::SackList::const_iterator it = list.begin (); it != list.end (); ++it)
+    {
+      RttHistory_t::iterator h = FindHistory (it->second - 1);
+      if (h != m_history.end () && h->time > m_rackXmitTs)
+        {
+          m_rackXmitTs = h->time;
+        }
+    }
+
+  NS_LOG_INFO (m_node->GetId () << " Got SACK with " << list.size () << " blocks, " << newlySacked <<
+               " bytes newly SACKed, " << m_txBuffer->GetSackedBytes () << " in total");
+}
+
+void
+TcpSocketBase::SackDupAck (void)
+{
+  NS_LOG_FUNCTION (this << m_dupAckCount);
+
+  if (m_inSackRecovery)
+    {
+      SackTransmit ();
+    }
+  else if (m_dupAckCount >= SACK_DUP_THRESH || IsLost (m_txBuffer->HeadSequence ()))
+    {
+      EnterSackRecovery ();
+    }
+}
+
+void
+TcpSocketBase::SackNewAck (SequenceNumber32 const& ack)
+{
+  NS_LOG_FUNCTION (this << ack);
+  NS_ASSERT (m_inSackRecovery);
+
+  if (ack >= m_sackRecover)
+    { // Everything outstanding at the start of the recovery has been acked
+      m_inSackRecovery = false;
+      m_cWnd = m_ssThresh;
+      NS_LOG_INFO ("Received full ACK for seq " << ack << ". Leaving SACK recovery with cwnd set to " << m_cWnd);
+      NewAck (ack);
+    }
+  else
+    { // Partial ACK: the window stays as it is, refill the pipe
+      TcpSocketBase::NewAck (ack);
+      SackTransmit ();
+    }
+}
+
+void
+TcpSocketBase::EnterSackRecovery (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_ssThresh = std::max (2 * m_segmentSize, BytesInFlight () / 2);
+  m_cWnd = m_ssThresh;
+  m_sackRecover = m_highTxMark;
+  m_inSackRecovery = true;
+  NS_LOG_INFO ("Entering SACK recovery. Reset cwnd to " << m_cWnd << ", ssthresh to " <<
+               m_ssThresh << " at recovery seqnum " << m_sackRecover);
+
+  // Retransmit the first segment, presumed dropped
+  SequenceNumber32 head = m_txBuffer->HeadSequence ();
+  uint32_t sz = SendDataPacket (head, m_segmentSize, true);
+  m_highRxt = head + SequenceNumber32 (sz);
+
+  SackTransmit ();
+}
+
+void
+TcpSocketBase::SackTransmit (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  SequenceNumber32 start;
+  SequenceNumber32 end;
+  while (m_cWnd.Get () >= SackPipe () + m_segmentSize)
+    {
+      uint32_t sz = 0;
+      if (NextLostSegment (start, end))
+        { // Rule (1): retransmit the first lost segment not yet retransmitted
+          sz = SendDataPacket (start, std::min<uint32_t> (end - start, m_segmentSize), true);
+          m_highRxt = start + SequenceNumber32 (sz);
+          NS_LOG_LOGIC ("SACK recovery: retransmitted " << sz << " bytes at seq " << start);
+        }
+      else if (m_txBuffer->SizeFromSequence (m_nextTxSequence) > 0
+               && UnAckDataCount () + m_segmentSize <= m_rWnd.Get ())
+        { // Rule (2): send new data
+          sz = SendDataPacket (m_nextTxSequence, m_segmentSize, true);
+          m_nextTxSequence += sz;
+          NS_LOG_LOGIC ("SACK recovery: sent " << sz << " new bytes");
+        }
+      if (sz == 0)
+        {
+          break;
+        }
+    }
+}
+
+uint32_t
+TcpSocketBase::SackPipe (void)
+{
+  SequenceNumber32 head = m_txBuffer->HeadSequence ();
+  if (m_highTxMark.Get () <= head)
+    {
+      return 0;
+    }
+
+  // Bytes not acknowledged, minus those known to have left the network
+  uint32_t pipe = m_highTxMark.Get () - head;
+  pipe -= std::min (pipe, m_txBuffer->GetSackedBytes ());
+
+  SequenceNumber32 start;
+  SequenceNumber32 end;
+  SequenceNumber32 seq = head;
+  while (m_txBuffer->NextHole (seq, start, end))
+    {
+      if (IsLost (start))
+        { // Lost bytes are not in the network, unless retransmitted
+          uint32_t lost = end - start;
+          uint32_t retx = (m_highRxt > start) ? std::min (m_highRxt, end) - start : 0;
+          pipe -= std::min (pipe, lost - retx);
+        }
+      seq = end;
+    }
+  return pipe;
+}
+
+bool
+TcpSocketBase::IsLost (SequenceNumber32 seq)
+{
+  if (seq >= m_txBuffer->GetHighSacked () || m_txBuffer->IsSacked (seq))
+    {
+      return false;
+    }
+
+  // RFC 6675: at least DupThresh segments SACKed above it
+  if (m_txBuffer->GetSackedBytesAbove (seq) > (SACK_DUP_THRESH - 1) * m_segmentSize)
+    {
+      return true;
+    }
+
+  // RACK: a segment sent more than a reordering window later has been
+  // delivered. The window is a quarter of the minimum RTT; with no RTT
+  // sample yet, rely on the rule above only.
+  if (m_minRtt.IsZero ())
+    {
+      return false;
+    }
+  RttHistory_t::iterator h = FindHistory (seq);
+  return (h != m_history.end () && h->time + m_minRtt / int64_t (4) < m_rackXmitTs);
+}
+
+bool
+TcpSocketBase::NextLostSegment (SequenceNumber32& start, SequenceNumber32& end)
+{
+  SequenceNumber32 seq = std::max (m_highRxt, m_txBuffer->HeadSequence ());
+  while (m_txBuffer->NextHole (seq, start, end))
+    {
+      if (IsLost (start))
+        {
+          return true;
+        }
+      seq = end;
+    }
+  return false;
+}
+
+RttHistory_t::iterator
+TcpSocketBase::FindHistory (SequenceNumber32 seq)
+{
+  RttHistory_t::iterator i = std::upper_bound (m_history.begin (), m_history.end (),
+                                               seq, SeqBeforeHistory);
+  if (i == m_history.begin ())
+    {
+      return m_history.end ();
+    }
+  --i;
+  if (seq < i->seq + SequenceNumber32 (i->count))
+    {
+      return i;
+    }
+  return m_history.end ();
+}
+
 void TcpSocketBase::UpdateWindowSize (const TcpHeader &header)
 {
   NS_LOG_FUNCTION (this << header);
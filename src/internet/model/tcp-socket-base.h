@@ -498,6 +498,16 @@ protected:
 
   // Window management
 
+  /**
+   * \brief Return the largest amount of data sent in a single packet
+   *
+   * This is the segment size, or a multiple of it when segmentation
+   * offload is enabled (IPv4 only).
+   *
+   * \returns the maximum size (bytes) of the payload of an outgoing packet
+   */
+  uint32_t MaxSendSize (void) const;
+
   /**
    * \brief Return count of number of unacked bytes
    * \returns count of number of unacked bytes
@@ -685,6 +695,110 @@ protected:
    */
   void AddOptionTimestamp (TcpHeader& header);
 
+  /**
+   * \brief Add the SACK permitted option to the header
+   *
+   * The option is sent only in SYN segments, to negotiate the use of the
+   * SACK option with the peer (\RFC{2018}).
+   *
+   * \param header TcpHeader to which add the option to
+   */
+  void AddOptionSackPermitted (TcpHeader& header);
+
+  /**
+   * \brief Add the SACK option to the header
+   *
+   * Report the out-of-order blocks held in the rx buffer, as many as fit
+   * in the remaining option space. Nothing is added if there is no gap.
+   *
+   * \param header TcpHeader to which add the option to
+   */
+  void AddOptionSack (TcpHeader& header);
+
+  /**
+   * \brief Process the SACK option from the other side
+   *
+   * Merge the reported blocks into the scoreboard held by the tx buffer,
+   * and keep track of the send time of the most recently sent segment
+   * delivered, for the time-based (RACK-style) loss detection.
+   *
+   * \param option Option from the packet
+   */
+  void ProcessOptionSack (const Ptr<const TcpOption> option);
+
+  // SACK-based loss recovery (RFC 6675)
+
+  /**
+   * \brief Received a duplicate ACK while SACK is in use
+   *
+   * Enter the loss recovery when DupThresh duplicate ACKs have been
+   * received or the scoreboard says that the first unacked segment is lost;
+   * inside the recovery, send whatever the pipe allows.
+   */
+  void SackDupAck (void);
+
+  /**
+   * \brief Received a new ACK during the SACK-based loss recovery
+   *
+   * A partial ACK keeps the socket in recovery, and more segments are sent
+   * according to the pipe; an ACK covering the recovery point ends it.
+   *
+   * \param ack the ACK number
+   */
+  void SackNewAck (SequenceNumber32 const& ack);
+
+  /**
+   * \brief Enter the SACK-based loss recovery
+   *
+   * Halve the congestion window, retransmit the first unacked segment and
+   * fill the pipe with lost or new segments.
+   */
+  void EnterSackRecovery (void);
+
+  /**
+   * \brief Send lost segments, then new ones, while the pipe allows it
+   *
+   * This implements the loop of \RFC{6675} sec. 5 step (C), with the
+   * rules (1) and (2) of NextSeg ().
+   */
+  void SackTransmit (void);
+
+  /**
+   * \brief Estimate the number of bytes still in the network (\RFC{6675} pipe)
+   * \returns the estimation of the bytes in flight
+   */
+  uint32_t SackPipe (void);
+
+  /**
+   * \brief Check if the segment starting at seq is deemed lost
+   *
+   * A segment is lost if more than (DupThresh - 1) segments above it have
+   * been SACKed (\RFC{6675} IsLost ()), or if a segment sent more than a
+   * reordering window after it has already been SACKed (RACK-style).
+   *
+   * \param seq the first sequence number of the segment
+   * \returns true if the segment is deemed lost
+   */
+  bool IsLost (SequenceNumber32 seq);
+
+  /**
+   * \brief Find the first lost, not yet retransmitted, range of bytes
+   * \param start filled with the first lost byte
+   * \param end filled with the end of the lost range
+   * \returns true if a lost range has been found
+   */
+  bool NextLostSegment (SequenceNumber32& start, SequenceNumber32& end);
+
+  /**
+   * \brief Find the history entry covering a sequence number
+   *
+   * The history is sorted by sequence number, so this is a binary search.
+   *
+   * \param seq the sequence number
+   * \returns the entry, or m_history.end () if there is none
+   */
+  RttHistory_t::iterator FindHistory (SequenceNumber32 seq);
+
   /**
    * \brief Scale the initial SsThresh value to the correct one
    *
@@ -773,6 +887,17 @@ protected:
   bool     m_timestampEnabled;    //!< Timestamp option enabled
   uint32_t m_timestampToEcho;     //!< Timestamp to echo
 
+  bool     m_sackEnabled;         //!< SACK option enabled
+
+  uint32_t m_tsoMaxSegments;      //!< Max segments per offloaded super-segment (1: no offload)
+
+  // SACK-based loss recovery
+  bool             m_inSackRecovery; //!< SACK-based loss recovery in progress
+  SequenceNumber32 m_sackRecover;    //!< RecoveryPoint (RFC 6675): highest seqno sent when recovery started
+  SequenceNumber32 m_highRxt;        //!< HighRxt (RFC 6675): highest seqno retransmitted in this recovery
+  Time             m_rackXmitTs;     //!< Send time of the most recently sent segment SACKed
+  Time             m_minRtt;         //!< Minimum RTT sample, used as reordering window base
+
   EventId m_sendPendingDataEvent; //!< micro-delay event to send pending data
 };
 
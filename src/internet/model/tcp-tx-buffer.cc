@@ -57,7 +57,8 @@ TcpTxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpTxBuffer::TcpTxBuffer (uint32_t n)
-  : m_firstByteSeq (n), m_size (0), m_maxBuffer (32768), m_data (0)
+  : m_firstByteSeq (n), m_size (0), m_maxBuffer (32768), m_data (0),
+    m_sackedBytes (0)
 {
 }
 
@@ -251,6 +252,149 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
   NS_LOG_LOGIC ("size=" << m_size << " headSeq=" << m_firstByteSeq << " maxBuffer=" << m_maxBuffer
                         <<" numPkts="<< m_data.size ());
   NS_ASSERT (m_firstByteSeq == seq);
+
+  // Drop the scoreboard entries that are now cumulatively acknowledged
+  while (!m_sacked.empty () && m_sacked.begin ()->first < seq)
+    {
+      SequenceNumber32 left = m_sacked.begin ()->first;
+      SequenceNumber32 right = m_sacked.begin ()->second;
+      m_sacked.erase (m_sacked.begin ());
+      if (right > seq)
+        {
+          m_sackedBytes -= seq - left;
+          m_sacked[seq] = right;
+          break;
+        }
+      m_sackedBytes -= right - left;
+    }
+}
+
+uint32_t
+TcpTxBuffer::UpdateScoreboard (const TcpOptionSack::SackList &list)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t before = m_sackedBytes;
+  SequenceNumber32 tail = TailSequence ();
+
+  for (TcpOptionSack::SackList::const_iterator b = list.begin (); b != list.end (); ++b)
+    {
+      SequenceNumber32 left = std::max (b->first, m_firstByteSeq.Get ());
+      SequenceNumber32 right = std::min (b->second, tail);
+      if (right <= left)
+        {
+          NS_LOG_LOGIC ("Ignoring SACK block [" << b->first << ";" << b->second << ")");
+          continue;
+        }
+
+      // Absorb the interval that starts before and touches the block...
+      SackedIntervals::iterator it = m_sacked.upper_bound (left);
+      if (it != m_sacked.begin ())
+        {
+          SackedIntervals::iterator prev = it;
+          --prev;
+          if (prev->second >= left)
+            {
+              left = prev->first;
+              right = std::max (right, prev->second);
+              m_sackedBytes -= prev->second - prev->first;
+              m_sacked.erase (prev);
+            }
+        }
+      // ...and the ones that start inside it or right after it
+      while (it != m_sacked.end () && it->first <= right)
+        {
+          right = std::max (right, it->second);
+          m_sackedBytes -= it->second - it->first;
+          m_sacked.erase (it++);
+        }
+
+      m_sacked[left] = right;
+      m_sackedBytes += right - left;
+    }
+
+  NS_LOG_LOGIC ("Scoreboard has " << m_sacked.size () << " blocks, " <<
+                m_sackedBytes << " bytes SACKed");
+  return m_sackedBytes - before;
+}
+
+void
+TcpTxBuffer::ResetScoreboard (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_sacked.clear ();
+  m_sackedBytes = 0;
+}
+
+bool
+TcpTxBuffer::IsSacked (const SequenceNumber32& seq) const
+{
+  SackedIntervals::const_iterator it = m_sacked.upper_bound (seq);
+  if (it == m_sacked.begin ())
+    {
+      return false;
+    }
+  --it;
+  return seq < it->second;
+}
+
+uint32_t
+TcpTxBuffer::GetSackedBytes (void) const
+{
+  return m_sackedBytes;
+}
+
+uint32_t
+TcpTxBuffer::GetSackedBytesAbove (const SequenceNumber32& seq) const
+{
+  uint32_t bytes = 0;
+  SackedIntervals::const_iterator it = m_sacked.upper_bound (seq);
+  if (it != m_sacked.begin ())
+    {
+      SackedIntervals::const_iterator prev = it;
+      --prev;
+      if (seq < prev->second)
+        {
+          bytes += prev->second - seq;
+        }
+    }
+  for (; it != m_sacked.end (); ++it)
+    {
+      bytes += it->second - it->first;
+    }
+  return bytes;
+}
+
+SequenceNumber32
+TcpTxBuffer::GetHighSacked (void) const
+{
+  if (m_sacked.empty ())
+    {
+      return m_firstByteSeq;
+    }
+  return m_sacked.rbegin ()->second;
+}
+
+bool
+TcpTxBuffer::NextHole (const SequenceNumber32& seq, SequenceNumber32& start, SequenceNumber32& end) const
+{
+  SequenceNumber32 s = std::max (seq, m_firstByteSeq.Get ());
+  SackedIntervals::const_iterator it = m_sacked.upper_bound (s);
+  if (it != m_sacked.begin ())
+    {
+      SackedIntervals::const_iterator prev = it;
+      --prev;
+      if (s < prev->second)
+        { // Inside a SACKed interval, the hole begins at its right edge
+          s = prev->second;
+        }
+    }
+  if (it == m_sacked.end ())
+    {
+      return false;
+    }
+  start = s;
+  end = it->first;
+  return true;
 }
 
 } // namepsace ns3
@@ -22,11 +22,13 @@
 #define TCP_TX_BUFFER_H
 
 #include <list>
+#include <map>
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/object.h"
 #include "ns3/sequence-number.h"
 #include "ns3/ptr.h"
+#include "ns3/tcp-option-sack.h"
 
 namespace ns3 {
 class Packet;
@@ -127,14 +129,77 @@ public:
    */
   void DiscardUpTo (const SequenceNumber32& seq);
 
+  // SACK scoreboard (RFC 6675)
+
+  /**
+   * \brief Merge the blocks reported by the peer into the scoreboard
+   *
+   * The scoreboard is kept as a set of disjoint intervals, ordered by
+   * sequence number; overlapping or adjacent blocks are coalesced, and the
+   * parts of the blocks outside [HeadSequence, TailSequence) are ignored.
+   *
+   * \param list the SACK blocks received from the peer
+   * \returns the number of bytes newly marked as SACKed
+   */
+  uint32_t UpdateScoreboard (const TcpOptionSack::SackList &list);
+
+  /**
+   * \brief Forget all the SACK information (e.g., after a retransmission timeout)
+   */
+  void ResetScoreboard (void);
+
+  /**
+   * \brief Check if a byte has been SACKed by the peer
+   * \param seq the sequence number of the byte
+   * \returns true if the byte is covered by a SACK block
+   */
+  bool IsSacked (const SequenceNumber32& seq) const;
+
+  /**
+   * \brief Get the number of SACKed bytes in the buffer
+   * \returns the number of SACKed bytes
+   */
+  uint32_t GetSackedBytes (void) const;
+
+  /**
+   * \brief Get the number of SACKed bytes at or above a sequence number
+   * \param seq the sequence number
+   * \returns the number of SACKed bytes in [seq, TailSequence)
+   */
+  uint32_t GetSackedBytesAbove (const SequenceNumber32& seq) const;
+
+  /**
+   * \brief Get the sequence number following the highest SACKed byte
+   * \returns the right edge of the highest SACK block, or HeadSequence if
+   * nothing is SACKed
+   */
+  SequenceNumber32 GetHighSacked (void) const;
+
+  /**
+   * \brief Find the first hole in the scoreboard at or after a sequence number
+   *
+   * A hole is a range of not SACKed bytes with at least one SACKed byte
+   * above it.
+   *
+   * \param seq the sequence number from which the search starts
+   * \param start filled with the first byte of the hole
+   * \param end filled with the sequence number following the hole
+   * \returns true if a hole has been found
+   */
+  bool NextHole (const SequenceNumber32& seq, SequenceNumber32& start, SequenceNumber32& end) const;
+
 private:
   /// container for data stored in the buffer
   typedef std::list<Ptr<Packet> >::iterator BufIterator;
+  /// container for the SACKed intervals, left edge to right edge
+  typedef std::map<SequenceNumber32, SequenceNumber32> SackedIntervals;
 
   TracedValue<SequenceNumber32> m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
   uint32_t m_size;                              //!< Number of data bytes
   uint32_t m_maxBuffer;                         //!< Max number of data bytes in buffer (SND.WND)
   std::list<Ptr<Packet> > m_data;               //!< Corresponding data (may be null)
+  SackedIntervals m_sacked;                     //!< SACK scoreboard
+  uint32_t m_sackedBytes;                       //!< Number of SACKed bytes in the scoreboard
 };
 
 } // namepsace ns3
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/arp-cache.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/mac48-address.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+
+using namespace ns3;
+
+/**
+ * \brief ArpCache table and pending ring test.
+ *
+ * Fills the cache past several table resizes, checks that every
+ * address is found at the entry returned by Add, and that the pending
+ * packet ring honours PendingQueueSize and FIFO order.
+ */
+class ArpCacheTableTest : public TestCase
+{
+public:
+  ArpCacheTableTest ();
+private:
+  virtual void DoRun (void);
+};
+
+ArpCacheTableTest::ArpCacheTableTest ()
+  : TestCase ("ArpCache open-addressing table and pending packet ring")
+{
+}
+
+void
+ArpCacheTableTest::DoRun (void)
+{
+  Ptr<ArpCache> cache = CreateObject<ArpCache> ();
+  cache->SetAttribute ("PendingQueueSize", UintegerValue (2));
+
+  const uint32_t n = 1000;
+  std::vector<ArpCache::Entry *> entries;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // consecutive addresses of a /16, the usual worst case for weak hashes
+      entries.push_back (cache->Add (Ipv4Address (0x0a000000 + i)));
+    }
+  NS_TEST_ASSERT_MSG_EQ (cache->GetNEntries (), n, "wrong number of entries");
+  for (uint32_t i = 0; i < n; i++)
+    {
+      ArpCache::Entry *entry = cache->Lookup (Ipv4Address (0x0a000000 + i));
+      NS_TEST_ASSERT_MSG_EQ (entry, entries[i], "entry moved or not found");
+      NS_TEST_ASSERT_MSG_EQ (entry->GetIpv4Address (), Ipv4Address (0x0a000000 + i), "wrong key");
+    }
+  NS_TEST_ASSERT_MSG_EQ (cache->Lookup (Ipv4Address ("10.1.0.0")), 0, "unexpected entry");
+
+  ArpCache::Entry *entry = entries[7];
+  Ptr<Packet> p1 = Create<Packet> (10);
+  Ptr<Packet> p2 = Create<Packet> (20);
+  entry->MarkWaitReply (p1);
+  NS_TEST_ASSERT_MSG_EQ (entry->UpdateWaitReply (p2), true, "ring should accept a second packet");
+  NS_TEST_ASSERT_MSG_EQ (entry->UpdateWaitReply (Create<Packet> (30)), false, "ring should be full");
+  entry->MarkAlive (Mac48Address ("00:00:00:00:00:01"));
+  NS_TEST_ASSERT_MSG_EQ (entry->DequeuePending (), p1, "ring is not FIFO");
+  NS_TEST_ASSERT_MSG_EQ (entry->DequeuePending (), p2, "ring is not FIFO");
+  NS_TEST_ASSERT_MSG_EQ (entry->DequeuePending (), 0, "ring should be empty");
+
+  cache->Flush ();
+  NS_TEST_ASSERT_MSG_EQ (cache->GetNEntries (), 0, "flush left entries");
+  NS_TEST_ASSERT_MSG_EQ (cache->Lookup (Ipv4Address (0x0a000007)), 0, "flush left entries");
+  cache->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \brief ArpCache periodic sweep test.
+ *
+ * With SweepInterval set, expired ALIVE and DEAD entries must be
+ * removed in a batch while the entries that are still valid survive
+ * and can be found again.
+ */
+class ArpCacheSweepTest : public TestCase
+{
+public:
+  ArpCacheSweepTest ();
+private:
+  virtual void DoRun (void);
+  void CheckEntries (Ptr<ArpCache> cache, uint32_t expected);
+  void Refresh (Ptr<ArpCache> cache, Ipv4Address address);
+};
+
+ArpCacheSweepTest::ArpCacheSweepTest ()
+  : TestCase ("ArpCache periodic sweep of expired entries")
+{
+}
+
+void
+ArpCacheSweepTest::CheckEntries (Ptr<ArpCache> cache, uint32_t expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (cache->GetNEntries (), expected, "wrong number of entries at " << Simulator::Now ().GetSeconds ());
+}
+
+void
+ArpCacheSweepTest::Refresh (Ptr<ArpCache> cache, Ipv4Address address)
+{
+  ArpCache::Entry *entry = cache->Lookup (address);
+  NS_TEST_ASSERT_MSG_NE (entry, 0, "entry should still be in the cache");
+  // drop the placeholder left pending by the initial resolution
+  entry->DequeuePending ();
+  entry->MarkWaitReply (0);
+  entry->MarkAlive (Mac48Address ("00:00:00:00:00:02"));
+}
+
+void
+ArpCacheSweepTest::DoRun (void)
+{
+  Ptr<ArpCache> cache = CreateObject<ArpCache> ();
+  cache->SetAliveTimeout (Seconds (10));
+  cache->SetDeadTimeout (Seconds (5));
+  cache->SetAttribute ("SweepInterval", TimeValue (Seconds (4)));
+
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      ArpCache::Entry *entry = cache->Add (Ipv4Address (0x0a000000 + i));
+      entry->MarkWaitReply (0);
+      if (i % 2)
+        {
+          entry->MarkAlive (Mac48Address ("00:00:00:00:00:01"));
+        }
+      else
+        {
+          entry->MarkDead ();
+        }
+    }
+  // keep one alive entry refreshed past the first alive timeout
+  Simulator::Schedule (Seconds (7), &ArpCacheSweepTest::Refresh, this, cache, Ipv4Address (0x0a000001));
+
+  // t=4: nothing expired; t=8: dead entries gone; t=12: alive ones too,
+  // except the refreshed one; t=20: empty, and the sweep stops
+  Simulator::Schedule (Seconds (5), &ArpCacheSweepTest::CheckEntries, this, cache, 100);
+  Simulator::Schedule (Seconds (9), &ArpCacheSweepTest::CheckEntries, this, cache, 50);
+  Simulator::Schedule (Seconds (13), &ArpCacheSweepTest::CheckEntries, this, cache, 1);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (cache->GetNEntries (), 0, "cache should be empty");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), Seconds (20), "sweep should stop once the cache is empty");
+
+  cache->Dispose ();
+  Simulator::Destroy ();
+}
+
+class ArpCacheTestSuite : public TestSuite
+{
+public:
+  ArpCacheTestSuite () : TestSuite ("arp-cache", UNIT)
+  {
+    AddTestCase (new ArpCacheTableTest, TestCase::QUICK);
+    AddTestCase (new ArpCacheSweepTest, TestCase::QUICK);
+  }
+} g_arpCacheTestSuite;
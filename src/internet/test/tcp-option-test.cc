@@ -22,6 +22,8 @@
 #include "ns3/tcp-option.h"
 #include "ns3/private/tcp-option-winscale.h"
 #include "ns3/private/tcp-option-ts.h"
+#include "ns3/private/tcp-option-sack-permitted.h"
+#include "ns3/tcp-option-sack.h"
 
 #include <string.h>
 
@@ -164,6 +166,59 @@ TcpOptionTSTestCase::DoTeardown ()
 {
 }
 
+class TcpOptionSackTestCase : public TestCase
+{
+public:
+  TcpOptionSackTestCase (std::string name, uint32_t blocks);
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_blocks;
+};
+
+
+TcpOptionSackTestCase::TcpOptionSackTestCase (std::string name, uint32_t blocks)
+  : TestCase (name),
+    m_blocks (blocks)
+{
+}
+
+void
+TcpOptionSackTestCase::DoRun ()
+{
+  Buffer buffer;
+
+  TcpOptionSackPermitted perm;
+  buffer.AddAtStart (perm.GetSerializedSize ());
+  perm.Serialize (buffer.Begin ());
+  NS_TEST_EXPECT_MSG_EQ (buffer.Begin ().PeekU8 (), TcpOption::SACKPERMITTED, "Different kind found");
+  TcpOptionSackPermitted permRead;
+  NS_TEST_EXPECT_MSG_EQ (permRead.Deserialize (buffer.Begin ()), 2, "Wrong SACK permitted size");
+
+  TcpOptionSack opt;
+  for (uint32_t i = 0; i < m_blocks; ++i)
+    {
+      opt.AddSackBlock (std::make_pair (SequenceNumber32 (1000 * i + 1),
+                                        SequenceNumber32 (1000 * i + 501)));
+    }
+  NS_TEST_EXPECT_MSG_EQ (opt.GetSerializedSize (), 2 + 8 * m_blocks, "Wrong SACK size");
+
+  buffer.AddAtStart (opt.GetSerializedSize ());
+  opt.Serialize (buffer.Begin ());
+
+  Buffer::Iterator start = buffer.Begin ();
+  NS_TEST_EXPECT_MSG_EQ (start.PeekU8 (), TcpOption::SACK, "Different kind found");
+
+  TcpOptionSack read;
+  NS_TEST_EXPECT_MSG_EQ (read.Deserialize (start), 2 + 8 * m_blocks, "Wrong deserialized size");
+  NS_TEST_EXPECT_MSG_EQ (read.GetNumSackBlocks (), m_blocks, "Different number of blocks");
+
+  TcpOptionSack::SackList written = opt.GetSackList ();
+  TcpOptionSack::SackList found = read.GetSackList ();
+  NS_TEST_EXPECT_MSG_EQ ((written == found), true, "Different blocks found");
+}
+
 static class TcpOptionTestSuite : public TestSuite
 {
 public:
@@ -176,6 +231,11 @@ public:
                                               "scale value", i), TestCase::QUICK);
       }
     AddTestCase (new TcpOptionTSTestCase ("Testing serialization of random values for timestamp"), TestCase::QUICK);
+    for (uint32_t i = 1; i <= 4; ++i)
+      {
+        AddTestCase (new TcpOptionSackTestCase ("Testing SACK blocks "
+                                                "serialization", i), TestCase::QUICK);
+      }
   }
 
 } g_TcpOptionTestSuite;
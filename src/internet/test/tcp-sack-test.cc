@@ -0,0 +1,425 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/socket-factory.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/error-model.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv4-list-routing.h"
+#include "ns3/node.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/pointer.h"
+#include "ns3/data-rate.h"
+#include "ns3/log.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-tx-buffer.h"
+#include "ns3/tcp-rx-buffer.h"
+#include "ns3/tcp-option-sack.h"
+
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/icmpv4-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/tcp-l4-protocol.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpSackTestSuite");
+
+/**
+ * \brief Check the SACK scoreboard kept by TcpTxBuffer
+ */
+class TcpSackScoreboardTestCase : public TestCase
+{
+public:
+  TcpSackScoreboardTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TcpSackScoreboardTestCase::TcpSackScoreboardTestCase ()
+  : TestCase ("Testing the SACK scoreboard of the tx buffer")
+{
+}
+
+void
+TcpSackScoreboardTestCase::DoRun (void)
+{
+  Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer> (1000);
+  txBuf->SetMaxBufferSize (10000);
+  txBuf->Add (Create<Packet> (10000));
+
+  TcpOptionSack::SackList list;
+  list.push_back (std::make_pair (SequenceNumber32 (3000), SequenceNumber32 (4000)));
+  list.push_back (std::make_pair (SequenceNumber32 (6000), SequenceNumber32 (7000)));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->UpdateScoreboard (list), 2000, "Wrong number of newly SACKed bytes");
+
+  // Overlapping and adjacent blocks are merged, duplicates are not counted twice
+  list.clear ();
+  list.push_back (std::make_pair (SequenceNumber32 (3500), SequenceNumber32 (5000)));
+  list.push_back (std::make_pair (SequenceNumber32 (5000), SequenceNumber32 (5500)));
+  list.push_back (std::make_pair (SequenceNumber32 (6000), SequenceNumber32 (7000)));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->UpdateScoreboard (list), 1500, "Wrong number of newly SACKed bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSackedBytes (), 3500, "Wrong number of SACKed bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->IsSacked (SequenceNumber32 (5499)), true, "Byte should be SACKed");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->IsSacked (SequenceNumber32 (5500)), false, "Byte should not be SACKed");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSackedBytesAbove (SequenceNumber32 (5000)), 1500, "Wrong SACKed bytes above");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetHighSacked (), SequenceNumber32 (7000), "Wrong highest SACKed seq");
+
+  SequenceNumber32 start;
+  SequenceNumber32 end;
+  NS_TEST_ASSERT_MSG_EQ (txBuf->NextHole (SequenceNumber32 (1000), start, end), true, "Hole not found");
+  NS_TEST_ASSERT_MSG_EQ (start, SequenceNumber32 (1000), "Wrong hole start");
+  NS_TEST_ASSERT_MSG_EQ (end, SequenceNumber32 (3000), "Wrong hole end");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->NextHole (SequenceNumber32 (4000), start, end), true, "Hole not found");
+  NS_TEST_ASSERT_MSG_EQ (start, SequenceNumber32 (5500), "Wrong hole start");
+  NS_TEST_ASSERT_MSG_EQ (end, SequenceNumber32 (6000), "Wrong hole end");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->NextHole (SequenceNumber32 (6000), start, end), false, "No hole above the highest block");
+
+  // Blocks below the head or beyond the tail are ignored
+  list.clear ();
+  list.push_back (std::make_pair (SequenceNumber32 (0), SequenceNumber32 (900)));
+  list.push_back (std::make_pair (SequenceNumber32 (20000), SequenceNumber32 (21000)));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->UpdateScoreboard (list), 0, "Out of buffer blocks must be ignored");
+
+  // Cumulative ACKs trim the scoreboard
+  txBuf->DiscardUpTo (SequenceNumber32 (3500));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSackedBytes (), 3000, "Wrong number of SACKed bytes after the ACK");
+  txBuf->DiscardUpTo (SequenceNumber32 (6500));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSackedBytes (), 500, "Wrong number of SACKed bytes after the ACK");
+
+  txBuf->ResetScoreboard ();
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSackedBytes (), 0, "Scoreboard not reset");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->IsSacked (SequenceNumber32 (6700)), false, "Scoreboard not reset");
+}
+
+/**
+ * \brief Check the SACK blocks generated by TcpRxBuffer
+ */
+class TcpSackRxBufferTestCase : public TestCase
+{
+public:
+  TcpSackRxBufferTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void AddSegment (Ptr<TcpRxBuffer> rxBuf, uint32_t seq, uint32_t size);
+};
+
+TcpSackRxBufferTestCase::TcpSackRxBufferTestCase ()
+  : TestCase ("Testing the SACK blocks of the rx buffer")
+{
+}
+
+void
+TcpSackRxBufferTestCase::AddSegment (Ptr<TcpRxBuffer> rxBuf, uint32_t seq, uint32_t size)
+{
+  TcpHeader h;
+  h.SetSequenceNumber (SequenceNumber32 (seq));
+  rxBuf->Add (Create<Packet> (size), h);
+}
+
+void
+TcpSackRxBufferTestCase::DoRun (void)
+{
+  Ptr<TcpRxBuffer> rxBuf = CreateObject<TcpRxBuffer> (1000);
+  rxBuf->SetMaxBufferSize (100000);
+
+  AddSegment (rxBuf, 1000, 500);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf->GetSackList (4).size (), 0, "No block expected without gaps");
+
+  AddSegment (rxBuf, 2000, 500);
+  AddSegment (rxBuf, 2500, 500);
+  AddSegment (rxBuf, 4000, 500);
+  AddSegment (rxBuf, 6000, 500);
+  AddSegment (rxBuf, 3500, 500);
+
+  TcpOptionSack::SackList list = rxBuf->GetSackList (4);
+  NS_TEST_ASSERT_MSG_EQ (list.size (), 3, "Wrong number of blocks");
+  // The block with the last received segment comes first
+  NS_TEST_ASSERT_MSG_EQ (list.front ().first, SequenceNumber32 (3500), "Wrong first block");
+  NS_TEST_ASSERT_MSG_EQ (list.front ().second, SequenceNumber32 (4500), "Wrong first block");
+  list.pop_front ();
+  NS_TEST_ASSERT_MSG_EQ (list.front ().first, SequenceNumber32 (6000), "Wrong second block");
+  list.pop_front ();
+  NS_TEST_ASSERT_MSG_EQ (list.front ().first, SequenceNumber32 (2000), "Wrong third block");
+  NS_TEST_ASSERT_MSG_EQ (list.front ().second, SequenceNumber32 (3000), "Wrong third block");
+
+  NS_TEST_ASSERT_MSG_EQ (rxBuf->GetSackList (1).size (), 1, "Block list not truncated");
+
+  // Filling the first gap removes the block
+  AddSegment (rxBuf, 1500, 500);
+  list = rxBuf->GetSackList (4);
+  NS_TEST_ASSERT_MSG_EQ (list.size (), 2, "Wrong number of blocks after filling a gap");
+  NS_TEST_ASSERT_MSG_EQ (list.back ().first, SequenceNumber32 (3500), "Wrong block after filling a gap");
+}
+
+/**
+ * \brief Transfer data over a lossy link, with and without SACK on each side
+ *
+ * Several segments of the same window are dropped. When both sides enable
+ * SACK, all the losses must be repaired in the same recovery episode: the
+ * congestion window is cut once, and no retransmission timeout happens.
+ */
+class TcpSackTransferTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param sourceSack SACK enabled on the data sender
+   * \param serverSack SACK enabled on the data receiver
+   * \param name test case name
+   */
+  TcpSackTransferTestCase (bool sourceSack, bool serverSack, std::string name);
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  Ptr<Node> CreateInternetNode (void);
+  Ptr<SimpleNetDevice> AddSimpleNetDevice (Ptr<Node> node, const char* ipaddr, const char* netmask);
+  void ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr);
+  void ServerHandleRecv (Ptr<Socket> sock);
+  void SourceHandleSend (Ptr<Socket> sock, uint32_t available);
+  void CwndTrace (uint32_t oldValue, uint32_t newValue);
+  void SsThreshTrace (uint32_t oldValue, uint32_t newValue);
+
+  bool m_sourceSack;
+  bool m_serverSack;
+  uint32_t m_totalBytes;
+  uint32_t m_currentSourceTxBytes;
+  uint32_t m_currentServerRxBytes;
+  uint32_t m_segmentSize;
+  uint32_t m_minCwnd;
+  uint32_t m_ssThreshCuts;
+  Ptr<TcpSocketBase> m_source;
+};
+
+TcpSackTransferTestCase::TcpSackTransferTestCase (bool sourceSack, bool serverSack, std::string name)
+  : TestCase (name),
+    m_sourceSack (sourceSack),
+    m_serverSack (serverSack),
+    m_totalBytes (100000),
+    m_segmentSize (536)
+{
+}
+
+void
+TcpSackTransferTestCase::DoRun (void)
+{
+  m_currentSourceTxBytes = 0;
+  m_currentServerRxBytes = 0;
+  m_minCwnd = 0xffffffff;
+  m_ssThreshCuts = 0;
+
+  const char* netmask = "255.255.255.0";
+  const char* ipaddr0 = "192.168.1.1";
+  const char* ipaddr1 = "192.168.1.2";
+  Ptr<Node> node0 = CreateInternetNode ();
+  Ptr<Node> node1 = CreateInternetNode ();
+  Ptr<SimpleNetDevice> dev0 = AddSimpleNetDevice (node0, ipaddr0, netmask);
+  Ptr<SimpleNetDevice> dev1 = AddSimpleNetDevice (node1, ipaddr1, netmask);
+
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MilliSeconds (10)));
+  dev0->SetChannel (channel);
+  dev1->SetChannel (channel);
+
+  // Drop three data segments of the same window at the receiver
+  Ptr<ReceiveListErrorModel> em = CreateObject<ReceiveListErrorModel> ();
+  std::list<uint32_t> drops;
+  drops.push_back (30);
+  drops.push_back (32);
+  drops.push_back (35);
+  em->SetList (drops);
+  dev0->SetAttribute ("ReceiveErrorModel", PointerValue (em));
+
+  Ptr<SocketFactory> sockFactory0 = node0->GetObject<TcpSocketFactory> ();
+  Ptr<SocketFactory> sockFactory1 = node1->GetObject<TcpSocketFactory> ();
+
+  Ptr<TcpSocketBase> server = DynamicCast<TcpSocketBase> (sockFactory0->CreateSocket ());
+  m_source = DynamicCast<TcpSocketBase> (sockFactory1->CreateSocket ());
+  NS_ASSERT (server != 0);
+  NS_ASSERT (m_source != 0);
+
+  server->SetAttribute ("Sack", BooleanValue (m_serverSack));
+  m_source->SetAttribute ("Sack", BooleanValue (m_sourceSack));
+  server->SetAttribute ("RcvBufSize", UintegerValue (m_totalBytes));
+  m_source->SetAttribute ("SndBufSize", UintegerValue (m_totalBytes));
+  m_source->SetAttribute ("SegmentSize", UintegerValue (m_segmentSize));
+  m_source->TraceConnectWithoutContext ("CongestionWindow",
+                                        MakeCallback (&TcpSackTransferTestCase::CwndTrace, this));
+  m_source->TraceConnectWithoutContext ("SlowStartThreshold",
+                                        MakeCallback (&TcpSackTransferTestCase::SsThreshTrace, this));
+
+  uint16_t port = 50000;
+  InetSocketAddress serverlocaladdr (Ipv4Address::GetAny (), port);
+  InetSocketAddress serverremoteaddr (Ipv4Address (ipaddr0), port);
+
+  server->Bind (serverlocaladdr);
+  server->Listen ();
+  server->SetAcceptCallback (MakeNullCallback<bool, Ptr< Socket >, const Address &> (),
+                             MakeCallback (&TcpSackTransferTestCase::ServerHandleConnectionCreated, this));
+
+  m_source->SetSendCallback (MakeCallback (&TcpSackTransferTestCase::SourceHandleSend, this));
+  m_source->Connect (serverremoteaddr);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_currentSourceTxBytes, m_totalBytes, "Source did not send all bytes");
+  NS_TEST_ASSERT_MSG_EQ (m_currentServerRxBytes, m_totalBytes, "Server did not receive all bytes");
+
+  BooleanValue negotiated;
+  m_source->GetAttribute ("Sack", negotiated);
+  NS_TEST_ASSERT_MSG_EQ (negotiated.Get (), m_sourceSack && m_serverSack, "Wrong SACK negotiation");
+
+  if (m_sourceSack && m_serverSack)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_ssThreshCuts, 1, "All losses should be recovered in one episode");
+      NS_TEST_ASSERT_MSG_GT (m_minCwnd, m_segmentSize, "Unexpected retransmission timeout");
+    }
+}
+
+void
+TcpSackTransferTestCase::DoTeardown (void)
+{
+  m_source = 0;
+  Simulator::Destroy ();
+}
+
+void
+TcpSackTransferTestCase::CwndTrace (uint32_t oldValue, uint32_t newValue)
+{
+  // Skip the initial window setup
+  if (oldValue != 0 && m_source->GetTxBuffer ()->HeadSequence () > SequenceNumber32 (1))
+    {
+      m_minCwnd = std::min (m_minCwnd, newValue);
+    }
+}
+
+void
+TcpSackTransferTestCase::SsThreshTrace (uint32_t oldValue, uint32_t newValue)
+{
+  if (newValue < oldValue)
+    {
+      ++m_ssThreshCuts;
+    }
+}
+
+void
+TcpSackTransferTestCase::ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr)
+{
+  s->SetRecvCallback (MakeCallback (&TcpSackTransferTestCase::ServerHandleRecv, this));
+}
+
+void
+TcpSackTransferTestCase::ServerHandleRecv (Ptr<Socket> sock)
+{
+  while (sock->GetRxAvailable () > 0)
+    {
+      Ptr<Packet> p = sock->Recv (sock->GetRxAvailable (), 0);
+      m_currentServerRxBytes += p->GetSize ();
+    }
+  if (m_currentServerRxBytes == m_totalBytes)
+    {
+      sock->Close ();
+    }
+}
+
+void
+TcpSackTransferTestCase::SourceHandleSend (Ptr<Socket> sock, uint32_t available)
+{
+  while (sock->GetTxAvailable () > 0 && m_currentSourceTxBytes < m_totalBytes)
+    {
+      uint32_t left = m_totalBytes - m_currentSourceTxBytes;
+      uint32_t toSend = std::min (left, sock->GetTxAvailable ());
+      int sent = sock->Send (Create<Packet> (toSend));
+      NS_TEST_EXPECT_MSG_EQ ((sent != -1), true, "Error during send ?");
+      m_currentSourceTxBytes += sent;
+    }
+  if (m_currentSourceTxBytes == m_totalBytes)
+    {
+      sock->Close ();
+    }
+}
+
+Ptr<Node>
+TcpSackTransferTestCase::CreateInternetNode ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  //ARP
+  Ptr<ArpL3Protocol> arp = CreateObject<ArpL3Protocol> ();
+  node->AggregateObject (arp);
+  //IPV4
+  Ptr<Ipv4L3Protocol> ipv4 = CreateObject<Ipv4L3Protocol> ();
+  //Routing for Ipv4
+  Ptr<Ipv4ListRouting> ipv4Routing = CreateObject<Ipv4ListRouting> ();
+  ipv4->SetRoutingProtocol (ipv4Routing);
+  Ptr<Ipv4StaticRouting> ipv4staticRouting = CreateObject<Ipv4StaticRouting> ();
+  ipv4Routing->AddRoutingProtocol (ipv4staticRouting, 0);
+  node->AggregateObject (ipv4);
+  //ICMP
+  Ptr<Icmpv4L4Protocol> icmp = CreateObject<Icmpv4L4Protocol> ();
+  node->AggregateObject (icmp);
+  //UDP
+  Ptr<UdpL4Protocol> udp = CreateObject<UdpL4Protocol> ();
+  node->AggregateObject (udp);
+  //TCP
+  Ptr<TcpL4Protocol> tcp = CreateObject<TcpL4Protocol> ();
+  node->AggregateObject (tcp);
+  return node;
+}
+
+Ptr<SimpleNetDevice>
+TcpSackTransferTestCase::AddSimpleNetDevice (Ptr<Node> node, const char* ipaddr, const char* netmask)
+{
+  Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+  dev->SetAddress (Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  dev->SetAttribute ("DataRate", DataRateValue (DataRate ("10Mbps")));
+  node->AddDevice (dev);
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  uint32_t ndid = ipv4->AddInterface (dev);
+  Ipv4InterfaceAddress ipv4Addr = Ipv4InterfaceAddress (Ipv4Address (ipaddr), Ipv4Mask (netmask));
+  ipv4->AddAddress (ndid, ipv4Addr);
+  ipv4->SetUp (ndid);
+  return dev;
+}
+
+static class TcpSackTestSuite : public TestSuite
+{
+public:
+  TcpSackTestSuite ()
+    : TestSuite ("tcp-sack", UNIT)
+  {
+    AddTestCase (new TcpSackScoreboardTestCase (), TestCase::QUICK);
+    AddTestCase (new TcpSackRxBufferTestCase (), TestCase::QUICK);
+    AddTestCase (new TcpSackTransferTestCase (true, true, "SACK enabled"), TestCase::QUICK);
+    AddTestCase (new TcpSackTransferTestCase (true, false, "SACK enabled only on the sender"), TestCase::QUICK);
+    AddTestCase (new TcpSackTransferTestCase (false, true, "SACK enabled only on the receiver"), TestCase::QUICK);
+    AddTestCase (new TcpSackTransferTestCase (false, false, "SACK disabled"), TestCase::QUICK);
+  }
+
+} g_tcpSackTestSuite;
+
+} // namespace ns3
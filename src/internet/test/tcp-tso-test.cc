@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/socket-factory.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv4-list-routing.h"
+#include "ns3/node.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-rate.h"
+#include "ns3/log.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/tcp-socket-base.h"
+
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/icmpv4-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/tcp-l4-protocol.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpTsoTestSuite");
+
+/**
+ * \brief Check a bulk transfer with segmentation offload (TSO) emulation
+ *
+ * The source is allowed to send up to a given number of segments in a single
+ * super-segment, on a link whose MTU fits exactly one segment. The transfer
+ * must complete, super-segments must reach the device unfragmented, and the
+ * wire packets they stand for must cover at least the whole stream.
+ */
+class TcpTsoTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param tsoMaxSegments maximum number of segments in a super-segment
+   * \param name test description
+   */
+  TcpTsoTestCase (uint32_t tsoMaxSegments, std::string name);
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  /**
+   * \brief Count the packets sent by the source IP layer
+   * \param p the packet
+   * \param ipv4 the IPv4 protocol
+   * \param interface the interface index
+   */
+  void IpTx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
+  /**
+   * \brief Server: Handle connection created
+   * \param s the socket
+   * \param addr the peer address
+   */
+  void ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr);
+  /**
+   * \brief Server: Receive data
+   * \param sock the socket
+   */
+  void ServerHandleRecv (Ptr<Socket> sock);
+  /**
+   * \brief Source: Send data
+   * \param sock the socket
+   * \param available the available space in the tx buffer
+   */
+  void SourceHandleSend (Ptr<Socket> sock, uint32_t available);
+
+  /**
+   * \brief Create a node with the IPv4 stack
+   * \returns the node
+   */
+  Ptr<Node> CreateInternetNode (void);
+  /**
+   * \brief Add a SimpleNetDevice to a node
+   * \param node the node
+   * \param ipaddr the IPv4 address
+   * \param netmask the IPv4 netmask
+   * \returns the device
+   */
+  Ptr<SimpleNetDevice> AddSimpleNetDevice (Ptr<Node> node, const char* ipaddr, const char* netmask);
+
+  uint32_t m_tsoMaxSegments;       //!< Max segments in a super-segment
+  uint32_t m_totalBytes;           //!< Bytes to transfer
+  uint32_t m_segmentSize;          //!< Segment size
+  uint32_t m_currentSourceTxBytes; //!< Bytes handed to the source socket
+  uint32_t m_currentServerRxBytes; //!< Bytes received by the server
+  uint32_t m_superSegments;        //!< Packets carrying more than one segment
+  uint32_t m_wirePackets;          //!< Wire packets the IP packets stand for
+  uint32_t m_maxSegments;          //!< Largest number of segments in a packet
+};
+
+TcpTsoTestCase::TcpTsoTestCase (uint32_t tsoMaxSegments, std::string name)
+  : TestCase (name),
+    m_tsoMaxSegments (tsoMaxSegments),
+    m_totalBytes (100000),
+    m_segmentSize (536)
+{
+}
+
+void
+TcpTsoTestCase::DoRun (void)
+{
+  m_currentSourceTxBytes = 0;
+  m_currentServerRxBytes = 0;
+  m_superSegments = 0;
+  m_wirePackets = 0;
+  m_maxSegments = 0;
+
+  const char* netmask = "255.255.255.0";
+  const char* ipaddr0 = "192.168.1.1";
+  const char* ipaddr1 = "192.168.1.2";
+  Ptr<Node> node0 = CreateInternetNode ();
+  Ptr<Node> node1 = CreateInternetNode ();
+  Ptr<SimpleNetDevice> dev0 = AddSimpleNetDevice (node0, ipaddr0, netmask);
+  Ptr<SimpleNetDevice> dev1 = AddSimpleNetDevice (node1, ipaddr1, netmask);
+
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MilliSeconds (10)));
+  dev0->SetChannel (channel);
+  dev1->SetChannel (channel);
+
+  node1->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("Tx", MakeCallback (&TcpTsoTestCase::IpTx, this));
+
+  Ptr<SocketFactory> sockFactory0 = node0->GetObject<TcpSocketFactory> ();
+  Ptr<SocketFactory> sockFactory1 = node1->GetObject<TcpSocketFactory> ();
+
+  Ptr<Socket> server = sockFactory0->CreateSocket ();
+  Ptr<Socket> source = sockFactory1->CreateSocket ();
+
+  server->SetAttribute ("RcvBufSize", UintegerValue (m_totalBytes));
+  source->SetAttribute ("SndBufSize", UintegerValue (m_totalBytes));
+  source->SetAttribute ("SegmentSize", UintegerValue (m_segmentSize));
+  source->SetAttribute ("TsoMaxSegments", UintegerValue (m_tsoMaxSegments));
+
+  uint16_t port = 50000;
+  InetSocketAddress serverlocaladdr (Ipv4Address::GetAny (), port);
+  InetSocketAddress serverremoteaddr (Ipv4Address (ipaddr0), port);
+
+  server->Bind (serverlocaladdr);
+  server->Listen ();
+  server->SetAcceptCallback (MakeNullCallback<bool, Ptr< Socket >, const Address &> (),
+                             MakeCallback (&TcpTsoTestCase::ServerHandleConnectionCreated, this));
+
+  source->SetSendCallback (MakeCallback (&TcpTsoTestCase::SourceHandleSend, this));
+  source->Connect (serverremoteaddr);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_currentSourceTxBytes, m_totalBytes, "Source did not send all bytes");
+  NS_TEST_ASSERT_MSG_EQ (m_currentServerRxBytes, m_totalBytes, "Server did not receive all bytes");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (m_wirePackets, (m_totalBytes + m_segmentSize - 1) / m_segmentSize,
+                               "Wire packets do not cover the whole stream");
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (m_maxSegments, m_tsoMaxSegments, "Super-segment larger than allowed");
+  if (m_tsoMaxSegments > 1)
+    {
+      NS_TEST_ASSERT_MSG_GT (m_superSegments, 0, "No super-segment sent");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_superSegments, 0, "Super-segment sent with offload disabled");
+    }
+}
+
+void
+TcpTsoTestCase::DoTeardown (void)
+{
+  Simulator::Destroy ();
+}
+
+void
+TcpTsoTestCase::IpTx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  uint32_t segments = SegmentationOffloadTag::GetWirePackets (p);
+  if (segments > 1)
+    {
+      NS_TEST_EXPECT_MSG_GT (p->GetSize (), 600, "Super-segment fragmented or too small");
+      ++m_superSegments;
+    }
+  m_wirePackets += segments;
+  m_maxSegments = std::max (m_maxSegments, segments);
+}
+
+void
+TcpTsoTestCase::ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr)
+{
+  s->SetRecvCallback (MakeCallback (&TcpTsoTestCase::ServerHandleRecv, this));
+}
+
+void
+TcpTsoTestCase::ServerHandleRecv (Ptr<Socket> sock)
+{
+  while (sock->GetRxAvailable () > 0)
+    {
+      Ptr<Packet> p = sock->Recv (sock->GetRxAvailable (), 0);
+      m_currentServerRxBytes += p->GetSize ();
+    }
+  if (m_currentServerRxBytes == m_totalBytes)
+    {
+      sock->Close ();
+    }
+}
+
+void
+TcpTsoTestCase::SourceHandleSend (Ptr<Socket> sock, uint32_t available)
+{
+  while (sock->GetTxAvailable () > 0 && m_currentSourceTxBytes < m_totalBytes)
+    {
+      uint32_t left = m_totalBytes - m_currentSourceTxBytes;
+      uint32_t toSend = std::min (left, sock->GetTxAvailable ());
+      int sent = sock->Send (Create<Packet> (toSend));
+      NS_TEST_EXPECT_MSG_EQ ((sent != -1), true, "Error during send ?");
+      m_currentSourceTxBytes += sent;
+    }
+  if (m_currentSourceTxBytes == m_totalBytes)
+    {
+      sock->Close ();
+    }
+}
+
+Ptr<Node>
+TcpTsoTestCase::CreateInternetNode ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  //ARP
+  Ptr<ArpL3Protocol> arp = CreateObject<ArpL3Protocol> ();
+  node->AggregateObject (arp);
+  //IPV4
+  Ptr<Ipv4L3Protocol> ipv4 = CreateObject<Ipv4L3Protocol> ();
+  //Routing for Ipv4
+  Ptr<Ipv4ListRouting> ipv4Routing = CreateObject<Ipv4ListRouting> ();
+  ipv4->SetRoutingProtocol (ipv4Routing);
+  Ptr<Ipv4StaticRouting> ipv4staticRouting = CreateObject<Ipv4StaticRouting> ();
+  ipv4Routing->AddRoutingProtocol (ipv4staticRouting, 0);
+  node->AggregateObject (ipv4);
+  //ICMP
+  Ptr<Icmpv4L4Protocol> icmp = CreateObject<Icmpv4L4Protocol> ();
+  node->AggregateObject (icmp);
+  //UDP
+  Ptr<UdpL4Protocol> udp = CreateObject<UdpL4Protocol> ();
+  node->AggregateObject (udp);
+  //TCP
+  Ptr<TcpL4Protocol> tcp = CreateObject<TcpL4Protocol> ();
+  node->AggregateObject (tcp);
+  return node;
+}
+
+Ptr<SimpleNetDevice>
+TcpTsoTestCase::AddSimpleNetDevice (Ptr<Node> node, const char* ipaddr, const char* netmask)
+{
+  Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+  dev->SetAddress (Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  dev->SetAttribute ("DataRate", DataRateValue (DataRate ("10Mbps")));
+  // One segment plus the IPv4 and TCP headers (with options)
+  dev->SetMtu (600);
+  node->AddDevice (dev);
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  uint32_t ndid = ipv4->AddInterface (dev);
+  Ipv4InterfaceAddress ipv4Addr = Ipv4InterfaceAddress (Ipv4Address (ipaddr), Ipv4Mask (netmask));
+  ipv4->AddAddress (ndid, ipv4Addr);
+  ipv4->SetUp (ndid);
+  return dev;
+}
+
+static class TcpTsoTestSuite : public TestSuite
+{
+public:
+  TcpTsoTestSuite ()
+    : TestSuite ("tcp-tso", UNIT)
+  {
+    AddTestCase (new TcpTsoTestCase (1, "Segmentation offload disabled"), TestCase::QUICK);
+    AddTestCase (new TcpTsoTestCase (8, "Up to 8 segments per super-segment"), TestCase::QUICK);
+    AddTestCase (new TcpTsoTestCase (64, "Up to 64 segments per super-segment"), TestCase::QUICK);
+  }
+} g_tcpTsoTestSuite;
+
+} // namespace ns3
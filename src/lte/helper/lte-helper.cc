@@ -59,6 +59,7 @@
 #include <ns3/epc-helper.h>
 #include <iostream>
 #include <ns3/buildings-propagation-loss-model.h>
+#include <ns3/pathloss-matrix-propagation-loss-model.h>
 #include <ns3/lte-spectrum-value-helper.h>
 #include <ns3/epc-x2.h>
 
@@ -100,6 +101,13 @@ LteHelper::DoInitialize (void)
       NS_LOG_LOGIC (this << " using a PropagationLossModel in DL");
       Ptr<PropagationLossModel> dlPlm = m_downlinkPathlossModel->GetObject<PropagationLossModel> ();
       NS_ASSERT_MSG (dlPlm != 0, " " << m_downlinkPathlossModel << " is neither PropagationLossModel nor SpectrumPropagationLossModel");
+      if (m_usePathlossMatrix)
+        {
+          NS_LOG_LOGIC (this << " using a path loss matrix in DL");
+          m_downlinkPathlossMatrix = CreateObject<PathlossMatrixPropagationLossModel> ();
+          m_downlinkPathlossMatrix->SetPropagationLossModel (dlPlm);
+          dlPlm = m_downlinkPathlossMatrix;
+        }
       m_downlinkChannel->AddPropagationLossModel (dlPlm);
     }
 
@@ -115,6 +123,13 @@ LteHelper::DoInitialize (void)
       NS_LOG_LOGIC (this << " using a PropagationLossModel in UL");
       Ptr<PropagationLossModel> ulPlm = m_uplinkPathlossModel->GetObject<PropagationLossModel> ();
       NS_ASSERT_MSG (ulPlm != 0, " " << m_uplinkPathlossModel << " is neither PropagationLossModel nor SpectrumPropagationLossModel");
+      if (m_usePathlossMatrix)
+        {
+          NS_LOG_LOGIC (this << " using a path loss matrix in UL");
+          m_uplinkPathlossMatrix = CreateObject<PathlossMatrixPropagationLossModel> ();
+          m_uplinkPathlossMatrix->SetPropagationLossModel (ulPlm);
+          ulPlm = m_uplinkPathlossMatrix;
+        }
       m_uplinkChannel->AddPropagationLossModel (ulPlm);
     }
   if (!m_fadingModelType.empty ())
@@ -200,6 +215,17 @@ TypeId LteHelper::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&LteHelper::m_usePdschForCqiGeneration),
                    MakeBooleanChecker ())
+    .AddAttribute ("UsePathlossMatrix",
+                   "If true, the gains of the path loss models between stationary nodes "
+                   "are computed once and stored in a PathlossMatrixPropagationLossModel, "
+                   "which can be saved to a file and loaded in the next runs. "
+                   "The path loss models must return the same gain for the same positions: "
+                   "the models drawing a new gain at every call (Random, Nakagami, Jakes) "
+                   "would be frozen at their first value, and are rejected. This attribute "
+                   "has no effect on a SpectrumPropagationLossModel.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteHelper::m_usePathlossMatrix),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -210,6 +236,8 @@ LteHelper::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_downlinkChannel = 0;
   m_uplinkChannel = 0;
+  m_downlinkPathlossMatrix = 0;
+  m_uplinkPathlossMatrix = 0;
   Object::DoDispose ();
 }
 
@@ -303,6 +331,27 @@ LteHelper::SetPathlossModelAttribute (std::string n, const AttributeValue &v)
   m_ulPathlossModelFactory.Set (n, v);
 }
 
+void
+LteHelper::LoadPathlossMatrix (std::string dlFilename, std::string ulFilename)
+{
+  NS_LOG_FUNCTION (this << dlFilename << ulFilename);
+  Initialize ();  // will run DoInitialize () if necessary
+  NS_ABORT_MSG_IF (m_downlinkPathlossMatrix == 0 || m_uplinkPathlossMatrix == 0,
+                   "the path loss matrices require UsePathlossMatrix and a PropagationLossModel");
+  m_downlinkPathlossMatrix->Load (dlFilename);
+  m_uplinkPathlossMatrix->Load (ulFilename);
+}
+
+void
+LteHelper::SavePathlossMatrix (std::string dlFilename, std::string ulFilename) const
+{
+  NS_LOG_FUNCTION (this << dlFilename << ulFilename);
+  NS_ABORT_MSG_IF (m_downlinkPathlossMatrix == 0 || m_uplinkPathlossMatrix == 0,
+                   "the path loss matrices require UsePathlossMatrix and a PropagationLossModel");
+  m_downlinkPathlossMatrix->Save (dlFilename);
+  m_uplinkPathlossMatrix->Save (ulFilename);
+}
+
 void
 LteHelper::SetEnbDeviceAttribute (std::string n, const AttributeValue &v)
 {
@@ -47,6 +47,7 @@ class SpectrumChannel;
 class EpcHelper;
 class PropagationLossModel;
 class SpectrumPropagationLossModel;
+class PathlossMatrixPropagationLossModel;
 
 /**
  * \ingroup lte
@@ -138,6 +139,26 @@ public:
    */
   void SetPathlossModelAttribute (std::string n, const AttributeValue &v);
 
+  /**
+   * Load the gains of the DL and UL path loss matrices from the files
+   * saved by SavePathlossMatrix () in a previous run of the same
+   * deployment. The UsePathlossMatrix attribute must be true.
+   *
+   * \param dlFilename the file of the DL path loss matrix
+   * \param ulFilename the file of the UL path loss matrix
+   */
+  void LoadPathlossMatrix (std::string dlFilename, std::string ulFilename);
+
+  /**
+   * Save the gains of the DL and UL path loss matrices computed so far,
+   * typically at the end of the simulation. The UsePathlossMatrix
+   * attribute must be true.
+   *
+   * \param dlFilename the file of the DL path loss matrix
+   * \param ulFilename the file of the UL path loss matrix
+   */
+  void SavePathlossMatrix (std::string dlFilename, std::string ulFilename) const;
+
   /** 
    * Set the type of scheduler to be used by eNodeB devices.
    * 
@@ -646,6 +667,15 @@ private:
   Ptr<Object> m_downlinkPathlossModel;
   /// The path loss model used in the uplink channel.
   Ptr<Object> m_uplinkPathlossModel;
+  /**
+   * True if the path loss models are wrapped in a path loss matrix, which
+   * stores their gains between stationary nodes.
+   */
+  bool m_usePathlossMatrix;
+  /// The path loss matrix of the downlink channel, if any.
+  Ptr<PathlossMatrixPropagationLossModel> m_downlinkPathlossMatrix;
+  /// The path loss matrix of the uplink channel, if any.
+  Ptr<PathlossMatrixPropagationLossModel> m_uplinkPathlossMatrix;
 
   /// Factory of MAC scheduler object.
   ObjectFactory m_schedulerFactory;
@@ -22,6 +22,7 @@
 
 #include <ns3/log.h>
 #include <ns3/config.h>
+#include <ns3/boolean.h>
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-enb-net-device.h>
@@ -34,7 +35,8 @@ NS_LOG_COMPONENT_DEFINE ("LteStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (LteStatsCalculator);
 
 LteStatsCalculator::LteStatsCalculator ()
-  : m_dlOutputFilename (""),
+  : m_binaryOutput (false),
+    m_dlOutputFilename (""),
     m_ulOutputFilename ("")
 {
   // Nothing to do here
@@ -54,6 +56,12 @@ LteStatsCalculator::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteStatsCalculator> ()
+    .AddAttribute ("BinaryOutput",
+                   "If true, the statistics are written in a binary columnar format, "
+                   "which the convert-lte-stats program turns into the text format.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteStatsCalculator::m_binaryOutput),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -83,6 +91,12 @@ LteStatsCalculator::GetDlOutputFilename (void)
   return m_dlOutputFilename;
 }
 
+bool
+LteStatsCalculator::IsBinaryOutput (void) const
+{
+  return m_binaryOutput;
+}
+
 
 bool
 LteStatsCalculator::ExistsImsiPath (std::string path)
@@ -23,6 +23,7 @@
 
 #include "ns3/object.h"
 #include "ns3/string.h"
+#include "ns3/lte-stats-writer.h"
 #include <map>
 
 namespace ns3 {
@@ -80,6 +81,12 @@ public:
    */
   std::string GetDlOutputFilename (void);
 
+  /**
+   * \return true if the statistics are written in the binary format of
+   *         LteStatsWriter
+   */
+  bool IsBinaryOutput (void) const;
+
   /**
    * Checks if there is an already stored IMSI for the given path
    * @param path Path in the attribute system to check
@@ -195,6 +202,11 @@ private:
    */
   std::map<std::string, uint16_t> m_pathCellIdMap;
 
+  /**
+   * Whether the statistics are written in the binary format
+   */
+  bool m_binaryOutput;
+
   /**
    * Name of the file where the downlink results will be saved
    */
@@ -0,0 +1,490 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-stats-writer.h"
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/assert.h>
+#include <ns3/callback.h>
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteStatsWriter");
+
+/// Magic string at the beginning of a binary stats file.
+static const char g_lteStatsMagic[8] = { 'n', 's', '3', 'l', 't', 's', '0', '1' };
+
+/// Size of the blocks handed over to the writing thread, in bytes.
+static const uint32_t g_lteStatsBlockSize = 1 << 20;
+
+/**
+ * Header of a binary stats file, followed by the text header and by the
+ * type and separator of each column.
+ */
+struct LteStatsFileHeader
+{
+  char magic[8];         ///< g_lteStatsMagic
+  uint32_t headerLength; ///< number of characters of the text header
+  uint32_t nColumns;     ///< number of columns
+};
+
+/**
+ * \param os the text stream
+ * \param isList whether the value is a list, whose values are already
+ *               followed by a separator
+ * \param last whether the value is the last one of the record
+ */
+static void
+WriteTextSeparator (std::ostream &os, bool isList, bool last)
+{
+  if (last)
+    {
+      os << '\n';
+    }
+  else if (!isList)
+    {
+      os << '\t';
+    }
+}
+
+/**
+ * \param type a scalar column type
+ * \return the number of bytes of a value
+ */
+static uint32_t
+GetValueSize (LteStatsWriter::ColumnType type)
+{
+  switch (type)
+    {
+    case LteStatsWriter::UINT8:
+      return 1;
+    case LteStatsWriter::UINT16:
+      return 2;
+    case LteStatsWriter::UINT32:
+      return 4;
+    case LteStatsWriter::UINT64:
+    case LteStatsWriter::INT64:
+    case LteStatsWriter::DOUBLE:
+      return 8;
+    default:
+      NS_FATAL_ERROR ("Column type " << type << " has no fixed size");
+      return 0;
+    }
+}
+
+LteStatsWriter::LteStatsWriter ()
+  : m_binary (false),
+    m_column (0),
+    m_records (0),
+    m_blockSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LteStatsWriter::~LteStatsWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+void
+LteStatsWriter::SetHeader (std::string header)
+{
+  m_header = header;
+}
+
+void
+LteStatsWriter::AddColumn (ColumnType type, char separator)
+{
+  NS_ASSERT_MSG (!IsOpen (), "columns must be added before the file is opened");
+  Column column;
+  column.type = type;
+  column.separator = separator;
+  m_columns.push_back (column);
+}
+
+bool
+LteStatsWriter::Open (std::string filename, bool binary)
+{
+  NS_LOG_FUNCTION (this << filename << binary);
+  NS_ASSERT (!IsOpen () && !m_columns.empty ());
+  m_binary = binary;
+  m_column = 0;
+  m_records = 0;
+  m_blockSize = 0;
+  if (!m_binary)
+    {
+      m_file.open (filename.c_str ());
+      if (!m_file.is_open ())
+        {
+          return false;
+        }
+      m_file << m_header << '\n';
+      return true;
+    }
+
+  m_file.open (filename.c_str (), std::ofstream::out | std::ofstream::binary);
+  if (!m_file.is_open ())
+    {
+      return false;
+    }
+  LteStatsFileHeader header;
+  std::memcpy (header.magic, g_lteStatsMagic, sizeof (g_lteStatsMagic));
+  header.headerLength = m_header.size ();
+  header.nColumns = m_columns.size ();
+  m_file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  m_file.write (m_header.data (), m_header.size ());
+  for (std::vector<Column>::const_iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      char description[2] = { static_cast<char> (it->type), it->separator };
+      m_file.write (description, sizeof (description));
+    }
+  return true;
+}
+
+bool
+LteStatsWriter::IsOpen (void) const
+{
+  return m_file.is_open ();
+}
+
+void
+LteStatsWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!IsOpen ())
+    {
+      return;
+    }
+  NS_ASSERT_MSG (m_column == 0, "incomplete record");
+  if (m_binary && m_records > 0)
+    {
+      FlushBlock ();
+    }
+  JoinWriter ();
+  m_file.close ();
+}
+
+LteStatsWriter::Column &
+LteStatsWriter::NextColumn (void)
+{
+  NS_ASSERT (IsOpen ());
+  return m_columns[m_column];
+}
+
+void
+LteStatsWriter::AppendValue (Column &column, const void *bytes, uint32_t size)
+{
+  size_t offset = column.values.size ();
+  column.values.resize (offset + size);
+  std::memcpy (&column.values[offset], bytes, size);
+  m_blockSize += size;
+}
+
+void
+LteStatsWriter::EndValue (void)
+{
+  bool last = (m_column + 1 == m_columns.size ());
+  if (!m_binary)
+    {
+      WriteTextSeparator (m_file, m_columns[m_column].type == DOUBLE_LIST, last);
+    }
+  if (!last)
+    {
+      ++m_column;
+      return;
+    }
+  m_column = 0;
+  if (m_binary)
+    {
+      ++m_records;
+      if (m_blockSize >= g_lteStatsBlockSize)
+        {
+          FlushBlock ();
+        }
+    }
+}
+
+void
+LteStatsWriter::AddUint (uint64_t value)
+{
+  Column &column = NextColumn ();
+  NS_ASSERT_MSG (column.type <= UINT64, "column " << m_column << " is not unsigned");
+  if (!m_binary)
+    {
+      m_file << value;
+    }
+  else
+    {
+      switch (column.type)
+        {
+        case UINT8:
+          {
+            uint8_t v = value;
+            AppendValue (column, &v, sizeof (v));
+            break;
+          }
+        case UINT16:
+          {
+            uint16_t v = value;
+            AppendValue (column, &v, sizeof (v));
+            break;
+          }
+        case UINT32:
+          {
+            uint32_t v = value;
+            AppendValue (column, &v, sizeof (v));
+            break;
+          }
+        default:
+          AppendValue (column, &value, sizeof (value));
+          break;
+        }
+    }
+  EndValue ();
+}
+
+void
+LteStatsWriter::AddInt (int64_t value)
+{
+  Column &column = NextColumn ();
+  NS_ASSERT_MSG (column.type == INT64, "column " << m_column << " is not signed");
+  if (!m_binary)
+    {
+      m_file << value;
+    }
+  else
+    {
+      AppendValue (column, &value, sizeof (value));
+    }
+  EndValue ();
+}
+
+void
+LteStatsWriter::AddDouble (double value)
+{
+  Column &column = NextColumn ();
+  NS_ASSERT_MSG (column.type == DOUBLE, "column " << m_column << " is not a double");
+  if (!m_binary)
+    {
+      m_file << value;
+    }
+  else
+    {
+      AppendValue (column, &value, sizeof (value));
+    }
+  EndValue ();
+}
+
+void
+LteStatsWriter::AddDoubles (std::vector<double>::const_iterator begin,
+                            std::vector<double>::const_iterator end)
+{
+  Column &column = NextColumn ();
+  NS_ASSERT_MSG (column.type == DOUBLE_LIST, "column " << m_column << " is not a list");
+  if (!m_binary)
+    {
+      for (std::vector<double>::const_iterator it = begin; it != end; ++it)
+        {
+          m_file << *it << column.separator;
+        }
+    }
+  else
+    {
+      uint32_t count = end - begin;
+      size_t offset = column.counts.size ();
+      column.counts.resize (offset + sizeof (count));
+      std::memcpy (&column.counts[offset], &count, sizeof (count));
+      m_blockSize += sizeof (count);
+      if (count > 0)
+        {
+          AppendValue (column, &(*begin), count * sizeof (double));
+        }
+    }
+  EndValue ();
+}
+
+void
+LteStatsWriter::FlushBlock (void)
+{
+  NS_LOG_FUNCTION (this << m_records);
+  JoinWriter ();
+
+  // block: number of records, then the size and the bytes of each column,
+  // the counts of a list preceding its values
+  m_pendingBlock.clear ();
+  m_pendingBlock.reserve (sizeof (uint32_t) * (1 + m_columns.size ()) + m_blockSize);
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *> (&m_records);
+  m_pendingBlock.insert (m_pendingBlock.end (), bytes, bytes + sizeof (m_records));
+  for (std::vector<Column>::iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      uint32_t size = it->counts.size () + it->values.size ();
+      bytes = reinterpret_cast<const uint8_t *> (&size);
+      m_pendingBlock.insert (m_pendingBlock.end (), bytes, bytes + sizeof (size));
+      m_pendingBlock.insert (m_pendingBlock.end (), it->counts.begin (), it->counts.end ());
+      m_pendingBlock.insert (m_pendingBlock.end (), it->values.begin (), it->values.end ());
+      it->counts.clear ();
+      it->values.clear ();
+    }
+  m_records = 0;
+  m_blockSize = 0;
+
+#ifdef HAVE_PTHREAD_H
+  // the next block is filled while this one is written
+  m_writer = Create<SystemThread> (MakeCallback (&LteStatsWriter::WritePendingBlock, this));
+  m_writer->Start ();
+#else
+  WritePendingBlock ();
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+LteStatsWriter::WritePendingBlock (void)
+{
+  m_file.write (reinterpret_cast<const char *> (&m_pendingBlock[0]), m_pendingBlock.size ());
+}
+
+void
+LteStatsWriter::JoinWriter (void)
+{
+#ifdef HAVE_PTHREAD_H
+  if (m_writer != 0)
+    {
+      m_writer->Join ();
+      m_writer = 0;
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+LteStatsWriter::ConvertToText (std::string filename, std::ostream &os)
+{
+  NS_LOG_FUNCTION (filename);
+  std::ifstream ifs (filename.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_ABORT_MSG_IF (!ifs.good (), "Cannot open " << filename);
+  LteStatsFileHeader header;
+  ifs.read (reinterpret_cast<char *> (&header), sizeof (header));
+  NS_ABORT_MSG_IF (!ifs.good () || std::memcmp (header.magic, g_lteStatsMagic, sizeof (g_lteStatsMagic)) != 0,
+                   filename << " is not a binary LTE stats file");
+  std::vector<char> text (header.headerLength + 1, '\0');
+  ifs.read (&text[0], header.headerLength);
+  std::vector<ColumnType> types (header.nColumns);
+  std::vector<char> separators (header.nColumns);
+  for (uint32_t c = 0; c < header.nColumns; ++c)
+    {
+      char description[2];
+      ifs.read (description, sizeof (description));
+      types[c] = static_cast<ColumnType> (description[0]);
+      separators[c] = description[1];
+      NS_ABORT_MSG_IF (types[c] > DOUBLE_LIST, "Unknown column type in " << filename);
+    }
+  NS_ABORT_MSG_IF (!ifs.good () || header.nColumns == 0, "Binary LTE stats file " << filename << " is truncated");
+  os << &text[0] << '\n';
+
+  std::vector<std::vector<uint8_t> > columns (header.nColumns);
+  std::vector<const uint8_t *> counts (header.nColumns);
+  std::vector<const uint8_t *> values (header.nColumns);
+  uint32_t records;
+  while (ifs.read (reinterpret_cast<char *> (&records), sizeof (records)))
+    {
+      for (uint32_t c = 0; c < header.nColumns; ++c)
+        {
+          uint32_t size = 0;
+          ifs.read (reinterpret_cast<char *> (&size), sizeof (size));
+          // one spare byte, so that a column is never empty
+          columns[c].resize (size + 1);
+          ifs.read (reinterpret_cast<char *> (&columns[c][0]), size);
+          NS_ABORT_MSG_IF (!ifs.good (), "Binary LTE stats file " << filename << " is truncated");
+          counts[c] = &columns[c][0];
+          values[c] = &columns[c][0];
+          if (types[c] == DOUBLE_LIST)
+            {
+              values[c] += records * sizeof (uint32_t);
+            }
+        }
+
+      for (uint32_t r = 0; r < records; ++r)
+        {
+          for (uint32_t c = 0; c < header.nColumns; ++c)
+            {
+              switch (types[c])
+                {
+                case UINT8:
+                  os << static_cast<uint32_t> (*values[c]);
+                  break;
+                case UINT16:
+                  {
+                    uint16_t v;
+                    std::memcpy (&v, values[c], sizeof (v));
+                    os << v;
+                    break;
+                  }
+                case UINT32:
+                  {
+                    uint32_t v;
+                    std::memcpy (&v, values[c], sizeof (v));
+                    os << v;
+                    break;
+                  }
+                case UINT64:
+                  {
+                    uint64_t v;
+                    std::memcpy (&v, values[c], sizeof (v));
+                    os << v;
+                    break;
+                  }
+                case INT64:
+                  {
+                    int64_t v;
+                    std::memcpy (&v, values[c], sizeof (v));
+                    os << v;
+                    break;
+                  }
+                case DOUBLE:
+                  {
+                    double v;
+                    std::memcpy (&v, values[c], sizeof (v));
+                    os << v;
+                    break;
+                  }
+                case DOUBLE_LIST:
+                  {
+                    uint32_t count;
+                    std::memcpy (&count, counts[c], sizeof (count));
+                    counts[c] += sizeof (count);
+                    for (uint32_t i = 0; i < count; ++i)
+                      {
+                        double v;
+                        std::memcpy (&v, values[c], sizeof (v));
+                        values[c] += sizeof (v);
+                        os << v << separators[c];
+                      }
+                    break;
+                  }
+                }
+              if (types[c] != DOUBLE_LIST)
+                {
+                  values[c] += GetValueSize (types[c]);
+                }
+              WriteTextSeparator (os, types[c] == DOUBLE_LIST, c + 1 == header.nColumns);
+            }
+        }
+    }
+}
+
+} // namespace ns3
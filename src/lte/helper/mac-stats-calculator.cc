@@ -30,11 +30,29 @@ NS_LOG_COMPONENT_DEFINE ("MacStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (MacStatsCalculator);
 
 MacStatsCalculator::MacStatsCalculator ()
-  : m_dlFirstWrite (true),
-    m_ulFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
-
+  m_dlWriter.SetHeader ("% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2");
+  m_dlWriter.AddColumn (LteStatsWriter::DOUBLE);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT64);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT32);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT32);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+
+  m_ulWriter.SetHeader ("% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize");
+  m_ulWriter.AddColumn (LteStatsWriter::DOUBLE);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT64);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT32);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT32);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
 }
 
 MacStatsCalculator::~MacStatsCalculator ()
@@ -42,6 +60,15 @@ MacStatsCalculator::~MacStatsCalculator ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+MacStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_dlWriter.Close ();
+  m_ulWriter.Close ();
+  LteStatsCalculator::DoDispose ();
+}
+
 TypeId
 MacStatsCalculator::GetTypeId (void)
 {
@@ -94,40 +121,22 @@ MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb1 << sizeTb1 << (uint32_t) mcsTb2 << sizeTb2);
   NS_LOG_INFO ("Write DL Mac Stats in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlFirstWrite == true )
+  if (!m_dlWriter.IsOpen () && !m_dlWriter.Open (GetDlOutputFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_dlFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << frameNo << "\t";
-  outFile << subframeNo << "\t";
-  outFile << rnti << "\t";
-  outFile << (uint32_t) mcsTb1 << "\t";
-  outFile << sizeTb1 << "\t";
-  outFile << (uint32_t) mcsTb2 << "\t";
-  outFile << sizeTb2 << std::endl;
-  outFile.close ();
+  m_dlWriter.AddDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_dlWriter.AddUint (cellId);
+  m_dlWriter.AddUint (imsi);
+  m_dlWriter.AddUint (frameNo);
+  m_dlWriter.AddUint (subframeNo);
+  m_dlWriter.AddUint (rnti);
+  m_dlWriter.AddUint (mcsTb1);
+  m_dlWriter.AddUint (sizeTb1);
+  m_dlWriter.AddUint (mcsTb2);
+  m_dlWriter.AddUint (sizeTb2);
 }
 
 void
@@ -137,38 +146,20 @@ MacStatsCalculator::UlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb << size);
   NS_LOG_INFO ("Write UL Mac Stats in " << GetUlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulFirstWrite == true )
-    {
-      outFile.open (GetUlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-      m_ulFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize";
-      outFile << std::endl;
-    }
-  else
+  if (!m_ulWriter.IsOpen () && !m_ulWriter.Open (GetUlOutputFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetUlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << frameNo << "\t";
-  outFile << subframeNo << "\t";
-  outFile << rnti << "\t";
-  outFile << (uint32_t) mcsTb << "\t";
-  outFile << size << std::endl;
-  outFile.close ();
+  m_ulWriter.AddDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_ulWriter.AddUint (cellId);
+  m_ulWriter.AddUint (imsi);
+  m_ulWriter.AddUint (frameNo);
+  m_ulWriter.AddUint (subframeNo);
+  m_ulWriter.AddUint (rnti);
+  m_ulWriter.AddUint (mcsTb);
+  m_ulWriter.AddUint (size);
 }
 
 void
@@ -61,6 +61,7 @@ public:
    *  \return The object TypeId.
    */
   static TypeId GetTypeId (void);
+  void DoDispose ();
 
   /**
    * Set the name of the file where the uplink statistics will be stored.
@@ -153,20 +154,14 @@ public:
 
 private:
   /**
-   * When writing DL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the DL MAC statistics, opened at the first write
    */
-  bool m_dlFirstWrite;
+  LteStatsWriter m_dlWriter;
 
   /**
-   * When writing UL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the UL MAC statistics, opened at the first write
    */
-  bool m_ulFirstWrite;
+  LteStatsWriter m_ulWriter;
 
 };
 
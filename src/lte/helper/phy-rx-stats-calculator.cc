@@ -32,11 +32,32 @@ NS_LOG_COMPONENT_DEFINE ("PhyRxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyRxStatsCalculator);
 
 PhyRxStatsCalculator::PhyRxStatsCalculator ()
-  : m_dlRxFirstWrite (true),
-    m_ulRxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
-
+  m_dlWriter.SetHeader ("% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect");
+  m_dlWriter.AddColumn (LteStatsWriter::INT64);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT64);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+
+  m_ulWriter.SetHeader ("% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect");
+  m_ulWriter.AddColumn (LteStatsWriter::INT64);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT64);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
 }
 
 PhyRxStatsCalculator::~PhyRxStatsCalculator ()
@@ -44,6 +65,15 @@ PhyRxStatsCalculator::~PhyRxStatsCalculator ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+PhyRxStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_dlWriter.Close ();
+  m_ulWriter.Close ();
+  LteStatsCalculator::DoDispose ();
+}
+
 TypeId
 PhyRxStatsCalculator::GetTypeId (void)
 {
@@ -95,42 +125,23 @@ PhyRxStatsCalculator::DlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write DL Rx Phy Stats in " << GetDlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlRxFirstWrite == true )
+  if (!m_dlWriter.IsOpen () && !m_dlWriter.Open (GetDlRxOutputFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetDlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
+      return;
     }
 
-//   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_txMode << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << std::endl;
-  outFile.close ();
+  m_dlWriter.AddInt (params.m_timestamp);
+  m_dlWriter.AddUint (params.m_cellId);
+  m_dlWriter.AddUint (params.m_imsi);
+  m_dlWriter.AddUint (params.m_rnti);
+  m_dlWriter.AddUint (params.m_txMode);
+  m_dlWriter.AddUint (params.m_layer);
+  m_dlWriter.AddUint (params.m_mcs);
+  m_dlWriter.AddUint (params.m_size);
+  m_dlWriter.AddUint (params.m_rv);
+  m_dlWriter.AddUint (params.m_ndi);
+  m_dlWriter.AddUint (params.m_correctness);
 }
 
 void
@@ -139,41 +150,22 @@ PhyRxStatsCalculator::UlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write UL Rx Phy Stats in " << GetUlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulRxFirstWrite == true )
-    {
-      outFile.open (GetUlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect";
-      outFile << std::endl;
-    }
-  else
+  if (!m_ulWriter.IsOpen () && !m_ulWriter.Open (GetUlRxOutputFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetUlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
+      return;
     }
 
-//   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << std::endl;
-  outFile.close ();
+  m_ulWriter.AddInt (params.m_timestamp);
+  m_ulWriter.AddUint (params.m_cellId);
+  m_ulWriter.AddUint (params.m_imsi);
+  m_ulWriter.AddUint (params.m_rnti);
+  m_ulWriter.AddUint (params.m_layer);
+  m_ulWriter.AddUint (params.m_mcs);
+  m_ulWriter.AddUint (params.m_size);
+  m_ulWriter.AddUint (params.m_rv);
+  m_ulWriter.AddUint (params.m_ndi);
+  m_ulWriter.AddUint (params.m_correctness);
 }
 
 void
@@ -66,6 +66,7 @@ public:
    *  \return The object TypeId.
    */
   static TypeId GetTypeId (void);
+  void DoDispose ();
 
   /**
    * Set the name of the file where the UL Rx PHY statistics will be stored.
@@ -125,22 +126,15 @@ public:
   static void UlPhyReceptionCallback (Ptr<PhyRxStatsCalculator> phyRxStats,
                                std::string path, PhyReceptionStatParameters params);
 private:
-
   /**
-   * When writing DL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the DL RX PHY statistics, opened at the first write
    */
-  bool m_dlRxFirstWrite;
+  LteStatsWriter m_dlWriter;
 
   /**
-   * When writing UL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the UL RX PHY statistics, opened at the first write
    */
-  bool m_ulRxFirstWrite;
+  LteStatsWriter m_ulWriter;
 
 };
 
@@ -30,12 +30,28 @@ NS_LOG_COMPONENT_DEFINE ("PhyStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyStatsCalculator);
 
 PhyStatsCalculator::PhyStatsCalculator ()
-  :  m_RsrpSinrFirstWrite (true),
-    m_UeSinrFirstWrite (true),
-    m_InterferenceFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
-
+  m_rsrpSinrWriter.SetHeader ("% time\tcellId\tIMSI\tRNTI\trsrp\tsinr");
+  m_rsrpSinrWriter.AddColumn (LteStatsWriter::DOUBLE);
+  m_rsrpSinrWriter.AddColumn (LteStatsWriter::UINT16);
+  m_rsrpSinrWriter.AddColumn (LteStatsWriter::UINT64);
+  m_rsrpSinrWriter.AddColumn (LteStatsWriter::UINT16);
+  m_rsrpSinrWriter.AddColumn (LteStatsWriter::DOUBLE);
+  m_rsrpSinrWriter.AddColumn (LteStatsWriter::DOUBLE);
+
+  m_ueSinrWriter.SetHeader ("% time\tcellId\tIMSI\tRNTI\tsinrLinear");
+  m_ueSinrWriter.AddColumn (LteStatsWriter::DOUBLE);
+  m_ueSinrWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ueSinrWriter.AddColumn (LteStatsWriter::UINT64);
+  m_ueSinrWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ueSinrWriter.AddColumn (LteStatsWriter::DOUBLE);
+
+  // the interference of each RB, as printed by SpectrumValue
+  m_interferenceWriter.SetHeader ("% time\tcellId\tInterference");
+  m_interferenceWriter.AddColumn (LteStatsWriter::DOUBLE);
+  m_interferenceWriter.AddColumn (LteStatsWriter::UINT16);
+  m_interferenceWriter.AddColumn (LteStatsWriter::DOUBLE_LIST, ' ');
 }
 
 PhyStatsCalculator::~PhyStatsCalculator ()
@@ -43,6 +59,16 @@ PhyStatsCalculator::~PhyStatsCalculator ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+PhyStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_rsrpSinrWriter.Close ();
+  m_ueSinrWriter.Close ();
+  m_interferenceWriter.Close ();
+  LteStatsCalculator::DoDispose ();
+}
+
 TypeId
 PhyStatsCalculator::GetTypeId (void)
 {
@@ -114,36 +140,18 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr (uint16_t cellId, uint64_t imsi, u
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << rsrp << sinr);
   NS_LOG_INFO ("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_RsrpSinrFirstWrite == true )
+  if (!m_rsrpSinrWriter.IsOpen () && !m_rsrpSinrWriter.Open (GetCurrentCellRsrpSinrFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
-      m_RsrpSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << rsrp << "\t";
-  outFile << sinr << std::endl;
-  outFile.close ();
+  m_rsrpSinrWriter.AddDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_rsrpSinrWriter.AddUint (cellId);
+  m_rsrpSinrWriter.AddUint (imsi);
+  m_rsrpSinrWriter.AddUint (rnti);
+  m_rsrpSinrWriter.AddDouble (rsrp);
+  m_rsrpSinrWriter.AddDouble (sinr);
 }
 
 void
@@ -152,35 +160,17 @@ PhyStatsCalculator::ReportUeSinr (uint16_t cellId, uint64_t imsi, uint16_t rnti,
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << sinrLinear);
   NS_LOG_INFO ("Write SINR Linear Phy Stats in " << GetUeSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_UeSinrFirstWrite == true )
-    {
-      outFile.open (GetUeSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
-      m_UeSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear";
-      outFile << std::endl;
-    }
-  else
+  if (!m_ueSinrWriter.IsOpen () && !m_ueSinrWriter.Open (GetUeSinrFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetUeSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << sinrLinear << std::endl;
-  outFile.close ();
+  m_ueSinrWriter.AddDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_ueSinrWriter.AddUint (cellId);
+  m_ueSinrWriter.AddUint (imsi);
+  m_ueSinrWriter.AddUint (rnti);
+  m_ueSinrWriter.AddDouble (sinrLinear);
 }
 
 void
@@ -189,33 +179,15 @@ PhyStatsCalculator::ReportInterference (uint16_t cellId, Ptr<SpectrumValue> inte
   NS_LOG_FUNCTION (this << cellId <<  interference);
   NS_LOG_INFO ("Write Interference Phy Stats in " << GetInterferenceFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_InterferenceFirstWrite == true )
-    {
-      outFile.open (GetInterferenceFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
-        }
-      m_InterferenceFirstWrite = false;
-      outFile << "% time\tcellId\tInterference";
-      outFile << std::endl;
-    }
-  else
+  if (!m_interferenceWriter.IsOpen () && !m_interferenceWriter.Open (GetInterferenceFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetInterferenceFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << *interference;
-  outFile.close ();
+  m_interferenceWriter.AddDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_interferenceWriter.AddUint (cellId);
+  m_interferenceWriter.AddDoubles (interference->ConstValuesBegin (), interference->ConstValuesEnd ());
 }
 
 
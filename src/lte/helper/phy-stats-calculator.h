@@ -71,6 +71,7 @@ public:
    *  @return The object TypeId.
    */
   static TypeId GetTypeId (void);
+  void DoDispose ();
 
   /**
    * Set the name of the file where the RSRP/SINR statistics will be stored.
@@ -177,28 +178,19 @@ public:
 
 private:
   /**
-   * When writing RSRP SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the RSRP/SINR statistics, opened at the first write
    */
-  bool m_RsrpSinrFirstWrite;
+  LteStatsWriter m_rsrpSinrWriter;
 
   /**
-   * When writing UE SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the UE SINR statistics, opened at the first write
    */
-  bool m_UeSinrFirstWrite;
+  LteStatsWriter m_ueSinrWriter;
 
   /**
-   * When writing interference statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the interference statistics, opened at the first write
    */
-  bool m_InterferenceFirstWrite;
+  LteStatsWriter m_interferenceWriter;
 
   /**
    * Name of the file where the RSRP/SINR statistics will be saved
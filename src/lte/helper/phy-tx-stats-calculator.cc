@@ -32,11 +32,29 @@ NS_LOG_COMPONENT_DEFINE ("PhyTxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyTxStatsCalculator);
 
 PhyTxStatsCalculator::PhyTxStatsCalculator ()
-  : m_dlTxFirstWrite (true),
-    m_ulTxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
-
+  m_dlWriter.SetHeader ("% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi");
+  m_dlWriter.AddColumn (LteStatsWriter::INT64);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT64);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT16);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+  m_dlWriter.AddColumn (LteStatsWriter::UINT8);
+
+  m_ulWriter.SetHeader ("% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi");
+  m_ulWriter.AddColumn (LteStatsWriter::INT64);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT64);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT16);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
+  m_ulWriter.AddColumn (LteStatsWriter::UINT8);
 }
 
 PhyTxStatsCalculator::~PhyTxStatsCalculator ()
@@ -44,6 +62,15 @@ PhyTxStatsCalculator::~PhyTxStatsCalculator ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+PhyTxStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_dlWriter.Close ();
+  m_ulWriter.Close ();
+  LteStatsCalculator::DoDispose ();
+}
+
 TypeId
 PhyTxStatsCalculator::GetTypeId (void)
 {
@@ -95,42 +122,21 @@ PhyTxStatsCalculator::DlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write DL Tx Phy Stats in " << GetDlTxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlTxFirstWrite == true )
+  if (!m_dlWriter.IsOpen () && !m_dlWriter.Open (GetDlTxOutputFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlTxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlTxFirstWrite = false;
-      //outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi"; // txMode is not available at dl tx side
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlTxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlTxOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetDlTxOutputFilename ().c_str ());
+      return;
     }
 
-//   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  //outFile << (uint32_t) params.m_txMode << "\t"; // txMode is not available at dl tx side
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << std::endl;
-  outFile.close ();
+  m_dlWriter.AddInt (params.m_timestamp);
+  m_dlWriter.AddUint (params.m_cellId);
+  m_dlWriter.AddUint (params.m_imsi);
+  m_dlWriter.AddUint (params.m_rnti);
+  m_dlWriter.AddUint (params.m_layer);
+  m_dlWriter.AddUint (params.m_mcs);
+  m_dlWriter.AddUint (params.m_size);
+  m_dlWriter.AddUint (params.m_rv);
+  m_dlWriter.AddUint (params.m_ndi);
 }
 
 void
@@ -139,42 +145,21 @@ PhyTxStatsCalculator::UlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write UL Tx Phy Stats in " << GetUlTxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulTxFirstWrite == true )
-    {
-      outFile.open (GetUlTxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlTxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulTxFirstWrite = false;
-//       outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi";
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi";
-      outFile << std::endl;
-    }
-  else
+  if (!m_ulWriter.IsOpen () && !m_ulWriter.Open (GetUlTxOutputFilename (), IsBinaryOutput ()))
     {
-      outFile.open (GetUlTxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlTxOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetUlTxOutputFilename ().c_str ());
+      return;
     }
 
-//   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  //outFile << (uint32_t) params.m_txMode << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << std::endl;
-  outFile.close ();
+  m_ulWriter.AddInt (params.m_timestamp);
+  m_ulWriter.AddUint (params.m_cellId);
+  m_ulWriter.AddUint (params.m_imsi);
+  m_ulWriter.AddUint (params.m_rnti);
+  m_ulWriter.AddUint (params.m_layer);
+  m_ulWriter.AddUint (params.m_mcs);
+  m_ulWriter.AddUint (params.m_size);
+  m_ulWriter.AddUint (params.m_rv);
+  m_ulWriter.AddUint (params.m_ndi);
 }
 
 void
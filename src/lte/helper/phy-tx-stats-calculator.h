@@ -66,6 +66,7 @@ public:
    *  \return The object TypeId.
    */
   static TypeId GetTypeId (void);
+  void DoDispose ();
 
   /**
    * Set the name of the file where the UL Tx PHY statistics will be stored.
@@ -128,20 +129,14 @@ public:
 
 private:
   /**
-   * When writing DL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the DL TX PHY statistics, opened at the first write
    */
-  bool m_dlTxFirstWrite;
+  LteStatsWriter m_dlWriter;
 
   /**
-   * When writing UL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Output file of the UL TX PHY statistics, opened at the first write
    */
-  bool m_ulTxFirstWrite;
+  LteStatsWriter m_ulWriter;
 
 };
 
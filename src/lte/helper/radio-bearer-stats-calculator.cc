@@ -33,19 +33,21 @@ NS_LOG_COMPONENT_DEFINE ("RadioBearerStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED ( RadioBearerStatsCalculator);
 
 RadioBearerStatsCalculator::RadioBearerStatsCalculator ()
-  : m_firstWrite (true),
-    m_pendingOutput (false), 
+  : m_pendingOutput (false), 
     m_protocolType ("RLC")
 {
   NS_LOG_FUNCTION (this);
+  InitWriter (m_ulWriter);
+  InitWriter (m_dlWriter);
 }
 
 RadioBearerStatsCalculator::RadioBearerStatsCalculator (std::string protocolType)
-  : m_firstWrite (true),
-    m_pendingOutput (false)
+  : m_pendingOutput (false)
 {
   NS_LOG_FUNCTION (this);
   m_protocolType = protocolType;
+  InitWriter (m_ulWriter);
+  InitWriter (m_dlWriter);
 }
 
 RadioBearerStatsCalculator::~RadioBearerStatsCalculator ()
@@ -102,6 +104,28 @@ RadioBearerStatsCalculator::DoDispose ()
     {
       ShowResults ();
     }
+  m_ulWriter.Close ();
+  m_dlWriter.Close ();
+}
+
+void
+RadioBearerStatsCalculator::InitWriter (LteStatsWriter &writer)
+{
+  writer.SetHeader ("% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t"
+                    "delay\tstdDev\tmin\tmax\tPduSize\tstdDev\tmin\tmax");
+  writer.AddColumn (LteStatsWriter::DOUBLE);
+  writer.AddColumn (LteStatsWriter::DOUBLE);
+  writer.AddColumn (LteStatsWriter::UINT32);
+  writer.AddColumn (LteStatsWriter::UINT64);
+  writer.AddColumn (LteStatsWriter::UINT16);
+  writer.AddColumn (LteStatsWriter::UINT8);
+  writer.AddColumn (LteStatsWriter::UINT32);
+  writer.AddColumn (LteStatsWriter::UINT64);
+  writer.AddColumn (LteStatsWriter::UINT32);
+  writer.AddColumn (LteStatsWriter::UINT64);
+  // average, standard deviation, minimum and maximum of the delay and of the PDU size
+  writer.AddColumn (LteStatsWriter::DOUBLE_LIST, '\t');
+  writer.AddColumn (LteStatsWriter::DOUBLE_LIST, '\t');
 }
 
 void 
@@ -216,59 +240,25 @@ RadioBearerStatsCalculator::ShowResults (void)
   NS_LOG_FUNCTION (this << GetUlOutputFilename ().c_str () << GetDlOutputFilename ().c_str ());
   NS_LOG_INFO ("Write Rlc Stats in " << GetUlOutputFilename ().c_str () << " and in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream ulOutFile;
-  std::ofstream dlOutFile;
-
-  if (m_firstWrite == true)
+  if (!m_ulWriter.IsOpen () && !m_ulWriter.Open (GetUlOutputFilename (), IsBinaryOutput ()))
     {
-      ulOutFile.open (GetUlOutputFilename ().c_str ());
-      if (!ulOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-
-      dlOutFile.open (GetDlOutputFilename ().c_str ());
-      if (!dlOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_firstWrite = false;
-      ulOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-      ulOutFile << "delay\tstdDev\tmin\tmax\t";
-      ulOutFile << "PduSize\tstdDev\tmin\tmax";
-      ulOutFile << std::endl;
-      dlOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-      dlOutFile << "delay\tstdDev\tmin\tmax\t";
-      dlOutFile << "PduSize\tstdDev\tmin\tmax";
-      dlOutFile << std::endl;
+      NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
+      return;
     }
-  else
+  if (!m_dlWriter.IsOpen () && !m_dlWriter.Open (GetDlOutputFilename (), IsBinaryOutput ()))
     {
-      ulOutFile.open (GetUlOutputFilename ().c_str (), std::ios_base::app);
-      if (!ulOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-
-      dlOutFile.open (GetDlOutputFilename ().c_str (), std::ios_base::app);
-      if (!dlOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
+      return;
     }
 
-  WriteUlResults (ulOutFile);
-  WriteDlResults (dlOutFile);
+  WriteUlResults ();
+  WriteDlResults ();
   m_pendingOutput = false;
 
 }
 
 void
-RadioBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
+RadioBearerStatsCalculator::WriteUlResults (void)
 {
   NS_LOG_FUNCTION (this);
 
@@ -287,34 +277,29 @@ RadioBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
   for (std::vector<ImsiLcidPair_t>::iterator it = pairVector.begin (); it != pairVector.end (); ++it)
     {
       ImsiLcidPair_t p = *it;
-      outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << GetUlCellId (p.m_imsi, p.m_lcId) << "\t";
-      outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-      outFile << GetUlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxData (p.m_imsi, p.m_lcId) << "\t";
+      m_ulWriter.AddDouble (m_startTime.GetNanoSeconds () / 1.0e9);
+      m_ulWriter.AddDouble (endTime.GetNanoSeconds () / 1.0e9);
+      m_ulWriter.AddUint (GetUlCellId (p.m_imsi, p.m_lcId));
+      m_ulWriter.AddUint (p.m_imsi);
+      m_ulWriter.AddUint (m_flowId[p].m_rnti);
+      m_ulWriter.AddUint (m_flowId[p].m_lcId);
+      m_ulWriter.AddUint (GetUlTxPackets (p.m_imsi, p.m_lcId));
+      m_ulWriter.AddUint (GetUlTxData (p.m_imsi, p.m_lcId));
+      m_ulWriter.AddUint (GetUlRxPackets (p.m_imsi, p.m_lcId));
+      m_ulWriter.AddUint (GetUlRxData (p.m_imsi, p.m_lcId));
       std::vector<double> stats = GetUlDelayStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
-          outFile << (*it) * 1e-9 << "\t";
+          (*it) *= 1e-9;
         }
+      m_ulWriter.AddDoubles (stats.begin (), stats.end ());
       stats = GetUlPduSizeStats (p.m_imsi, p.m_lcId);
-      for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
-        {
-          outFile << (*it) << "\t";
-        }
-      outFile << std::endl;
+      m_ulWriter.AddDoubles (stats.begin (), stats.end ());
     }
-
-  outFile.close ();
 }
 
 void
-RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
+RadioBearerStatsCalculator::WriteDlResults (void)
 {
   NS_LOG_FUNCTION (this);
 
@@ -332,30 +317,25 @@ RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
   for (std::vector<ImsiLcidPair_t>::iterator pair = pairVector.begin (); pair != pairVector.end (); ++pair)
     {
       ImsiLcidPair_t p = *pair;
-      outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << GetDlCellId (p.m_imsi, p.m_lcId) << "\t";
-      outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-      outFile << GetDlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxData (p.m_imsi, p.m_lcId) << "\t";
+      m_dlWriter.AddDouble (m_startTime.GetNanoSeconds () / 1.0e9);
+      m_dlWriter.AddDouble (endTime.GetNanoSeconds () / 1.0e9);
+      m_dlWriter.AddUint (GetDlCellId (p.m_imsi, p.m_lcId));
+      m_dlWriter.AddUint (p.m_imsi);
+      m_dlWriter.AddUint (m_flowId[p].m_rnti);
+      m_dlWriter.AddUint (m_flowId[p].m_lcId);
+      m_dlWriter.AddUint (GetDlTxPackets (p.m_imsi, p.m_lcId));
+      m_dlWriter.AddUint (GetDlTxData (p.m_imsi, p.m_lcId));
+      m_dlWriter.AddUint (GetDlRxPackets (p.m_imsi, p.m_lcId));
+      m_dlWriter.AddUint (GetDlRxData (p.m_imsi, p.m_lcId));
       std::vector<double> stats = GetDlDelayStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
-          outFile << (*it) * 1e-9 << "\t";
+          (*it) *= 1e-9;
         }
+      m_dlWriter.AddDoubles (stats.begin (), stats.end ());
       stats = GetDlPduSizeStats (p.m_imsi, p.m_lcId);
-      for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
-        {
-          outFile << (*it) << "\t";
-        }
-      outFile << std::endl;
+      m_dlWriter.AddDoubles (stats.begin (), stats.end ());
     }
-
-  outFile.close ();
 }
 
 void
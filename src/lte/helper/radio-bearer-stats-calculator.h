@@ -348,30 +348,32 @@ public:
   GetDlPduSizeStats (uint64_t imsi, uint8_t lcid);
 
 private:
+  /**
+   * Set the columns of an output file.
+   * @param writer the UL or DL output file
+   */
+  void
+  InitWriter (LteStatsWriter &writer);
+
   /**
    * Called after each epoch to write collected
    * statistics to output files. During first call
    * it opens output files and write columns descriptions.
-   * During next calls it opens output files in append mode.
    */
   void
   ShowResults (void);
 
   /**
-   * Writes collected statistics to UL output file and
-   * closes UL output file.
-   * @param outFile ofstream for UL statistics
+   * Writes collected statistics to UL output file.
    */
   void
-  WriteUlResults (std::ofstream& outFile);
+  WriteUlResults (void);
 
   /**
-   * Writes collected statistics to DL output file and
-   * closes DL output file.
-   * @param outFile ofstream for DL statistics
+   * Writes collected statistics to DL output file.
    */
   void
-  WriteDlResults (std::ofstream& outFile);
+  WriteDlResults (void);
 
   /**
    * Erases collected statistics
@@ -423,9 +425,14 @@ private:
   Time m_epochDuration;
 
   /**
-   * true if output files have not been opened yet
+   * Output file of the UL statistics, opened at the first write
+   */
+  LteStatsWriter m_ulWriter;
+
+  /**
+   * Output file of the DL statistics, opened at the first write
    */
-  bool m_firstWrite;
+  LteStatsWriter m_dlWriter;
 
   /**
    * true if any output is pending
@@ -37,9 +37,19 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/node-list.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/antenna-model.h>
 
 #include <fstream>
 #include <limits>
+#include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -144,6 +154,18 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("Offline",
+                   "If true, the REM is computed in a single pass by querying "
+                   "the propagation loss models of the channel directly for "
+                   "each eNB and each point, instead of deploying RemSpectrumPhy "
+                   "listeners on the channel. Every eNB is assumed to transmit "
+                   "over its full DL bandwidth, also when UseDataChannel is true. "
+                   "As in the default mode, every point of an iteration has its "
+                   "own listener, so that the shadowing and fading drawn per pair "
+                   "of nodes by the propagation loss models are drawn per point.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_offline),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -200,6 +222,15 @@ RadioEnvironmentMapHelper::Install ()
       return;
     }
   
+  if (m_offline)
+    {
+      // the eNBs only need to be configured, no transmission is awaited
+      Simulator::Schedule (Seconds (0.0026),
+                           &RadioEnvironmentMapHelper::RunOffline,
+                           this);
+      return;
+    }
+
   double startDelay = 0.0026;
 
   if (m_useDataChannel)
@@ -340,6 +371,181 @@ RadioEnvironmentMapHelper::PrintAndReset ()
     }
 }
 
+std::vector<RadioEnvironmentMapHelper::RemTransmitter>
+RadioEnvironmentMapHelper::GetTransmitters () const
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<const SpectrumModel> rxSpectrumModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  std::vector<RemTransmitter> transmitters;
+  for (NodeList::Iterator nit = NodeList::Begin (); nit != NodeList::End (); ++nit)
+    {
+      for (uint32_t i = 0; i < (*nit)->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> ((*nit)->GetDevice (i));
+          if (enbDev == 0)
+            {
+              continue;
+            }
+          Ptr<LteEnbPhy> enbPhy = enbDev->GetPhy ();
+          Ptr<LteSpectrumPhy> dlPhy = enbPhy->GetDownlinkSpectrumPhy ();
+          if (dlPhy->GetChannel () != m_channel)
+            {
+              continue;
+            }
+          // same PSD as the one used by LteEnbPhy::SendControlChannels
+          std::vector<int> dlRb;
+          for (uint8_t rb = 0; rb < enbDev->GetDlBandwidth (); ++rb)
+            {
+              dlRb.push_back (rb);
+            }
+          RemTransmitter tx;
+          tx.mobility = dlPhy->GetMobility ();
+          tx.antenna = dlPhy->GetRxAntenna ();
+          tx.psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (enbDev->GetDlEarfcn (),
+                                                                         enbDev->GetDlBandwidth (),
+                                                                         enbPhy->GetTxPower (),
+                                                                         dlRb);
+          if (tx.psd->GetSpectrumModelUid () != rxSpectrumModel->GetUid ())
+            {
+              SpectrumConverter converter (tx.psd->GetSpectrumModel (), rxSpectrumModel);
+              tx.psd = converter.Convert (tx.psd);
+            }
+          if (m_rbId >= 0)
+            {
+              tx.power = (*(tx.psd))[m_rbId] * 180000;
+            }
+          else
+            {
+              tx.power = Integral (*(tx.psd));
+            }
+          NS_LOG_LOGIC ("eNB node " << (*nit)->GetId () << " power " << tx.power);
+          transmitters.push_back (tx);
+        }
+    }
+  return transmitters;
+}
+
+void
+RadioEnvironmentMapHelper::RunOffline ()
+{
+  NS_LOG_FUNCTION (this);
+  m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
+  m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
+
+  std::vector<RemTransmitter> transmitters = GetTransmitters ();
+  const uint32_t nTx = transmitters.size ();
+  NS_LOG_INFO ("computing REM for " << nTx << " eNBs");
+
+  Ptr<PropagationLossModel> propagationLoss = m_channel->GetPropagationLossModel ();
+  Ptr<SpectrumPropagationLossModel> spectrumPropagationLoss = m_channel->GetSpectrumPropagationLossModel ();
+  DoubleValue maxLossDb (std::numeric_limits<double>::max ());
+  m_channel->GetAttributeFailSafe ("MaxLossDb", maxLossDb);
+
+  // the propagation loss models may keep a state per pair of mobility
+  // models, e.g., the shadowing of BuildingsPropagationLossModel, so every
+  // point uses its own listener, and the listeners are reused every
+  // MaxPointsPerIteration points as the RemSpectrumPhy of the default mode
+  uint32_t nListeners = m_maxPointsPerIteration;
+  if ((double)m_xRes * (double) m_yRes < (double) m_maxPointsPerIteration)
+    {
+      nListeners = m_xRes * m_yRes;
+    }
+  std::vector<Ptr<MobilityModel> > listeners;
+  uint32_t point = 0;
+
+  // received powers of one column of the map, stored per transmitter so
+  // that the SINR accumulation below runs over contiguous arrays
+  std::vector<double> yValues;
+  std::vector<double> rxPower;
+  std::vector<double> sumPower;
+  std::vector<double> refPower;
+
+  for (double x = m_xMin; x < m_xMax + 0.5*m_xStep; x += m_xStep)
+    {
+      yValues.clear ();
+      for (double y = m_yMin; y < m_yMax + 0.5*m_yStep ; y += m_yStep)
+        {
+          yValues.push_back (y);
+        }
+      const uint32_t nY = yValues.size ();
+      rxPower.assign (nTx * nY, 0.0);
+
+      for (uint32_t j = 0; j < nY; ++j, ++point)
+        {
+          if (listeners.size () < nListeners)
+            {
+              Ptr<MobilityModel> listener = CreateObject<ConstantPositionMobilityModel> ();
+              Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+              listener->AggregateObject (buildingInfo); // operation usually done by BuildingsHelper::Install
+              listeners.push_back (listener);
+            }
+          Ptr<MobilityModel> rxMobility = listeners[point % nListeners];
+          rxMobility->SetPosition (Vector (x, yValues[j], m_z));
+          BuildingsHelper::MakeConsistent (rxMobility);
+          for (uint32_t t = 0; t < nTx; ++t)
+            {
+              const RemTransmitter &tx = transmitters[t];
+              if (tx.mobility == 0)
+                {
+                  rxPower[t * nY + j] = tx.power;
+                  continue;
+                }
+              // same computation as in the StartTx method of the channel
+              double pathLossDb = 0;
+              if (tx.antenna != 0)
+                {
+                  Angles txAngles (rxMobility->GetPosition (), tx.mobility->GetPosition ());
+                  pathLossDb -= tx.antenna->GetGainDb (txAngles);
+                }
+              if (propagationLoss != 0)
+                {
+                  pathLossDb -= propagationLoss->CalcRxPower (0, tx.mobility, rxMobility);
+                }
+              if (pathLossDb > maxLossDb.Get ())
+                {
+                  continue;
+                }
+              double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+              if (spectrumPropagationLoss == 0)
+                {
+                  rxPower[t * nY + j] = tx.power * pathGainLinear;
+                }
+              else
+                {
+                  Ptr<SpectrumValue> psd = Copy<SpectrumValue> (tx.psd);
+                  *psd *= pathGainLinear;
+                  psd = spectrumPropagationLoss->CalcRxPowerSpectralDensity (psd, tx.mobility, rxMobility);
+                  rxPower[t * nY + j] = (m_rbId >= 0) ? (*psd)[m_rbId] * 180000 : Integral (*psd);
+                }
+            }
+        }
+
+      sumPower.assign (nY, 0.0);
+      refPower.assign (nY, 0.0);
+      for (uint32_t t = 0; t < nTx; ++t)
+        {
+          const double *p = &rxPower[t * nY];
+          for (uint32_t j = 0; j < nY; ++j)
+            {
+              sumPower[j] += p[j];
+              refPower[j] = std::max (refPower[j], p[j]);
+            }
+        }
+
+      for (uint32_t j = 0; j < nY; ++j)
+        {
+          double sinr = refPower[j] / (sumPower[j] - refPower[j] + m_noisePower);
+          NS_LOG_LOGIC ("output: " << x << "\t" << yValues[j] << "\t" << m_z << "\t" << sinr);
+          m_outFile << x << "\t"
+                    << yValues[j] << "\t"
+                    << m_z << "\t"
+                    << sinr << "\n";
+        }
+    }
+
+  Finalize ();
+}
+
 void 
 RadioEnvironmentMapHelper::Finalize ()
 {
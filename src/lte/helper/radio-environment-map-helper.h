@@ -25,6 +25,7 @@
 
 #include <ns3/object.h>
 #include <fstream>
+#include <vector>
 
 
 namespace ns3 {
@@ -35,6 +36,8 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
+class SpectrumValue;
 
 /** 
  * \ingroup lte
@@ -108,6 +111,35 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Scheduled by Install() instead of DelayedInstall() when the `Offline`
+   * attribute is set. Evaluates the whole map in a single pass by querying
+   * the propagation loss models of the channel directly for every eNB and
+   * every grid point, writing each column of the map as soon as it is
+   * computed, and then calls Finalize().
+   */
+  void RunOffline ();
+
+  /// An eNB transmitting on the channel, as seen by the offline engine.
+  struct RemTransmitter
+  {
+    /// Position of the eNB.
+    Ptr<MobilityModel> mobility;
+    /// Antenna of the eNB, may be null.
+    Ptr<AntennaModel> antenna;
+    /// Full-band DL transmit PSD, expressed in the spectrum model of the map.
+    Ptr<SpectrumValue> psd;
+    /// Transmit power over the bandwidth of interest (all RBs or `RbId`).
+    double power;
+  };
+
+  /**
+   * Find all the eNBs whose downlink is attached to the channel.
+   *
+   * \return the list of transmitters to be accounted for by RunOffline()
+   */
+  std::vector<RemTransmitter> GetTransmitters () const;
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -152,6 +184,8 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_offline;  ///< The `Offline` attribute.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
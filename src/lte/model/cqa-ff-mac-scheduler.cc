@@ -799,7 +799,7 @@ CqaFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
   std::map<LteFlowId_t,int> UEtoHOL;
   std::vector <bool> rbgMap;  // global RBGs map
   uint16_t rbgAllocatedNum = 0;
-  std::set <uint16_t> rntiAllocated;
+  m_dlWorkspace.Reset ();
   rbgMap.resize (m_cschedCellConfig.m_dlBandwidth / rbgSize, false);
 
   rbgMap = m_ffrSapProvider->GetAvailableDlRbg ();
@@ -971,8 +971,7 @@ CqaFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
   std::vector <struct DlInfoListElement_s> dlInfoListUntxed;
   for (uint16_t i = 0; i < m_dlInfoListBuffered.size (); i++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_dlInfoListBuffered.at (i).m_rnti);
-      if (itRnti != rntiAllocated.end ())
+      if (m_dlWorkspace.IsRntiAllocated (m_dlInfoListBuffered.at (i).m_rnti))
         {
           // RNTI already allocated for retx
           continue;
@@ -1036,7 +1035,7 @@ CqaFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
             }
           // check the feasibility of retransmitting on the same RBGs
           // translate the DCI to Spectrum framework
-          std::vector <int> dciRbg;
+          std::vector <int> &dciRbg = m_dlWorkspace.GetDciRbgBuffer ();
           uint32_t mask = 0x1;
           NS_LOG_INFO ("Original RBGs " << dci.m_rbBitmap << " rnti " << dci.m_rnti);
           for (int j = 0; j < 32; j++)
@@ -1076,7 +1075,8 @@ CqaFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
               uint8_t j = 0;
               uint8_t rbgId = (dciRbg.at (dciRbg.size () - 1) + 1) % numberOfRBGs;
               uint8_t startRbg = dciRbg.at (dciRbg.size () - 1);
-              std::vector <bool> rbgMapCopy = rbgMap;
+              std::vector <bool> &rbgMapCopy = m_dlWorkspace.GetRbgMapBuffer ();
+              rbgMapCopy = rbgMap;
               while ((j < dciRbg.size ())&&(startRbg != rbgId))
                 {
                   if (rbgMapCopy.at (rbgId) == false)
@@ -1175,7 +1175,7 @@ CqaFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
             }
           (*itHarqTimer).second.at (harqId) = 0;
           ret.m_buildDataList.push_back (newEl);
-          rntiAllocated.insert (rnti);
+          m_dlWorkspace.MarkRntiAllocated (rnti);
         }
       else
         {
@@ -1198,19 +1198,18 @@ CqaFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
             }
         }
     }
-  m_dlInfoListBuffered.clear ();
-  m_dlInfoListBuffered = dlInfoListUntxed;
+  m_dlInfoListBuffered.swap (dlInfoListUntxed);
 	
 	
   std::map <LteFlowId_t,struct LogicalChannelConfigListElement_s>::iterator itLogicalChannels;
 	
   for (itLogicalChannels = m_ueLogicalChannelsConfigList.begin (); itLogicalChannels != m_ueLogicalChannelsConfigList.end (); itLogicalChannels++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (itLogicalChannels->first.m_rnti);
-      if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability (itLogicalChannels->first.m_rnti)))
+      bool rntiAllocated = m_dlWorkspace.IsRntiAllocated (itLogicalChannels->first.m_rnti);
+      if ((rntiAllocated)||(!HarqProcessAvailability (itLogicalChannels->first.m_rnti)))
         {
           // UE already allocated for HARQ or without HARQ process available -> drop it
-          if (itRnti != rntiAllocated.end ())
+          if (rntiAllocated)
             {
               NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(itLogicalChannels->first.m_rnti));
             }
@@ -1306,18 +1305,9 @@ CqaFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
               NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itrbr).first.m_rnti);
             }
           int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-          std::vector <uint8_t> sbCqis;
-          if (itCqi == m_a30CqiRxed.end ())
-            {
-              for (uint8_t k = 0; k < nLayer; k++)
-                {
-                  sbCqis.push_back (1);                        // start with lowest value
-                }
-            }
-          else
-            {
-              sbCqis = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-            }
+          const std::vector <uint8_t> &sbCqis = (itCqi == m_a30CqiRxed.end ())
+            ? m_dlWorkspace.GetDefaultSbCqi (nLayer)  // start with lowest value
+            : (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
 
           uint8_t cqi1 = sbCqis.at (0);
           uint8_t cqi2 = 1;
@@ -30,9 +30,6 @@
 #include "epc-tft.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
-#include "ns3/ipv4-header.h"
-#include "ns3/udp-header.h"
-#include "ns3/tcp-header.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/tcp-l4-protocol.h"
 
@@ -69,10 +66,16 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 {
   NS_LOG_FUNCTION (this << p << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
-
-  Ipv4Header ipv4Header;
-  pCopy->RemoveHeader (ipv4Header);
+  // read the fields straight from the bytes of the IPv4 and UDP/TCP
+  // headers, rather than copying the packet and deserializing them: an
+  // IPv4 header with options is at most 60 bytes long, and the ports are
+  // the first 4 bytes of both the UDP and the TCP header
+  uint8_t buf[64];
+  uint32_t size = p->CopyData (buf, sizeof (buf));
+  NS_ASSERT_MSG (size >= 20, "packet too short for an IPv4 header");
+  uint32_t ipv4HeaderSize = (buf[0] & 0x0f) * 4;
+  Ipv4Address source = Ipv4Address::Deserialize (buf + 12);
+  Ipv4Address destination = Ipv4Address::Deserialize (buf + 16);
 
   Ipv4Address localAddress;
   Ipv4Address remoteAddress;
@@ -80,52 +83,37 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
   
   if (direction ==  EpcTft::UPLINK)
     {
-      localAddress = ipv4Header.GetSource ();
-      remoteAddress = ipv4Header.GetDestination ();
+      localAddress = source;
+      remoteAddress = destination;
     }
   else
     { 
       NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-      remoteAddress = ipv4Header.GetSource ();
-      localAddress = ipv4Header.GetDestination ();      
+      remoteAddress = source;
+      localAddress = destination;
     }
   
-  uint8_t protocol = ipv4Header.GetProtocol ();
+  uint8_t protocol = buf[9];
 
-  uint8_t tos = ipv4Header.GetTos ();
+  uint8_t tos = buf[1];
 
   uint16_t localPort = 0;
   uint16_t remotePort = 0;
 
-  if (protocol == UdpL4Protocol::PROT_NUMBER)
-    {
-      UdpHeader udpHeader;
-      pCopy->RemoveHeader (udpHeader);
-
-      if (direction ==  EpcTft::UPLINK)
-	{
-	  localPort = udpHeader.GetSourcePort ();
-	  remotePort = udpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = udpHeader.GetSourcePort ();
-	  localPort = udpHeader.GetDestinationPort ();
-	}
-    }
-  else if (protocol == TcpL4Protocol::PROT_NUMBER)
+  if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
     {
-      TcpHeader tcpHeader;
-      pCopy->RemoveHeader (tcpHeader);
+      NS_ASSERT_MSG (size >= ipv4HeaderSize + 4, "packet too short for a UDP or TCP header");
+      uint16_t sourcePort = (buf[ipv4HeaderSize] << 8) | buf[ipv4HeaderSize + 1];
+      uint16_t destinationPort = (buf[ipv4HeaderSize + 2] << 8) | buf[ipv4HeaderSize + 3];
       if (direction ==  EpcTft::UPLINK)
 	{
-	  localPort = tcpHeader.GetSourcePort ();
-	  remotePort = tcpHeader.GetDestinationPort ();
+	  localPort = sourcePort;
+	  remotePort = destinationPort;
 	}
       else
 	{
-	  remotePort = tcpHeader.GetSourcePort ();
-	  localPort = tcpHeader.GetDestinationPort ();
+	  remotePort = sourcePort;
+	  localPort = destinationPort;
 	}
     }
   else
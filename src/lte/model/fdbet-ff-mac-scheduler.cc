@@ -656,10 +656,9 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
 
   int rbgSize = GetRbgSize (m_cschedCellConfig.m_dlBandwidth);
   int rbgNum = m_cschedCellConfig.m_dlBandwidth / rbgSize;
-  std::map <uint16_t, std::vector <uint16_t> > allocationMap; // RBs map per RNTI
   std::vector <bool> rbgMap;  // global RBGs map
   uint16_t rbgAllocatedNum = 0;
-  std::set <uint16_t> rntiAllocated;
+  m_dlWorkspace.Reset ();
   rbgMap.resize (m_cschedCellConfig.m_dlBandwidth / rbgSize, false);
   FfMacSchedSapUser::SchedDlConfigIndParameters ret;
 
@@ -781,8 +780,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
   std::vector <struct DlInfoListElement_s> dlInfoListUntxed;
   for (uint16_t i = 0; i < m_dlInfoListBuffered.size (); i++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_dlInfoListBuffered.at (i).m_rnti);
-      if (itRnti != rntiAllocated.end ())
+      if (m_dlWorkspace.IsRntiAllocated (m_dlInfoListBuffered.at (i).m_rnti))
         {
           // RNTI already allocated for retx
           continue;
@@ -846,7 +844,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
             }
           // check the feasibility of retransmitting on the same RBGs
           // translate the DCI to Spectrum framework
-          std::vector <int> dciRbg;
+          std::vector <int> &dciRbg = m_dlWorkspace.GetDciRbgBuffer ();
           uint32_t mask = 0x1;
           NS_LOG_INFO ("Original RBGs " << dci.m_rbBitmap << " rnti " << dci.m_rnti);
           for (int j = 0; j < 32; j++)
@@ -886,7 +884,8 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
               uint8_t j = 0;
               uint8_t rbgId = (dciRbg.at (dciRbg.size () - 1) + 1) % rbgNum;
               uint8_t startRbg = dciRbg.at (dciRbg.size () - 1);
-              std::vector <bool> rbgMapCopy = rbgMap;
+              std::vector <bool> &rbgMapCopy = m_dlWorkspace.GetRbgMapBuffer ();
+              rbgMapCopy = rbgMap;
               while ((j < dciRbg.size ())&&(startRbg != rbgId))
                 {
                   if (rbgMapCopy.at (rbgId) == false)
@@ -985,7 +984,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
             }
           (*itHarqTimer).second.at (harqId) = 0;
           ret.m_buildDataList.push_back (newEl);
-          rntiAllocated.insert (rnti);
+          m_dlWorkspace.MarkRntiAllocated (rnti);
         }
       else
         {
@@ -1008,8 +1007,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
             }
         }
     }
-  m_dlInfoListBuffered.clear ();
-  m_dlInfoListBuffered = dlInfoListUntxed;
+  m_dlInfoListBuffered.swap (dlInfoListUntxed);
 
   if (rbgAllocatedNum == rbgNum)
     {
@@ -1029,11 +1027,11 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
   double metricMax = 0.0;
   for (itFlow = m_flowStatsDl.begin (); itFlow != m_flowStatsDl.end (); itFlow++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*itFlow).first);
-      if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*itFlow).first)))
+      bool rntiAllocated = m_dlWorkspace.IsRntiAllocated ((*itFlow).first);
+      if ((rntiAllocated)||(!HarqProcessAvailability ((*itFlow).first)))
         {
           // UE already allocated for HARQ or without HARQ process available -> drop it
-          if (itRnti != rntiAllocated.end ())
+          if (rntiAllocated)
             {
               NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*itFlow).first);
             }
@@ -1070,18 +1068,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
           if (rbgMap.at (i) == false)
             {
               // allocate one RBG to current UE
-              std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              std::vector <uint16_t> tempMap;
-              itMap = allocationMap.find ((*itMax).first);
-              if (itMap == allocationMap.end ())
-                {
-                  tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).first, tempMap));
-                }
-              else
-                {
-                  (*itMap).second.push_back (i);
-                }
+              m_dlWorkspace.AllocateRbg ((*itMax).first, i);
 
               // caculate expected throughput for current UE
               std::map <uint16_t,uint8_t>::iterator itCqi;
@@ -1155,32 +1142,33 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
 
   // generate the transmission opportunities by grouping the RBGs of the same RNTI and
   // creating the correspondent DCIs
-  std::map <uint16_t, std::vector <uint16_t> >::iterator itMap = allocationMap.begin ();
-  while (itMap != allocationMap.end ())
+  for (uint32_t a = 0; a < m_dlWorkspace.GetNAllocations (); a++)
     {
+      uint16_t allocRnti = m_dlWorkspace.GetAllocationRnti (a);
+      const std::vector <uint16_t> &allocRbgs = m_dlWorkspace.GetAllocationRbgs (a);
       // create new BuildDataListElement_s for this LC
       BuildDataListElement_s newEl;
-      newEl.m_rnti = (*itMap).first;
+      newEl.m_rnti = allocRnti;
       // create the DlDciListElement_s
       DlDciListElement_s newDci;
-      newDci.m_rnti = (*itMap).first;
-      newDci.m_harqProcess = UpdateHarqProcessId ((*itMap).first);
+      newDci.m_rnti = allocRnti;
+      newDci.m_harqProcess = UpdateHarqProcessId (allocRnti);
 
-      uint16_t lcActives = LcActivePerFlow ((*itMap).first);
+      uint16_t lcActives = LcActivePerFlow (allocRnti);
       NS_LOG_INFO (this << "Allocate user " << newEl.m_rnti << " rbg " << lcActives);
       if (lcActives == 0)
         {
           // Set to max value, to avoid divide by 0 below
           lcActives = (uint16_t)65535; // UINT16_MAX;
         }
-      uint16_t RgbPerRnti = (*itMap).second.size ();
+      uint16_t RgbPerRnti = allocRbgs.size ();
       std::map <uint16_t,uint8_t>::iterator itCqi;
-      itCqi = m_p10CqiRxed.find ((*itMap).first);
+      itCqi = m_p10CqiRxed.find (allocRnti);
       std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itMap).first);
+      itTxMode = m_uesTxMode.find (allocRnti);
       if (itTxMode == m_uesTxMode.end ())
         {
-          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMap).first);
+          NS_FATAL_ERROR ("No Transmission Mode info on user " << allocRnti);
         }
       int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
 
@@ -1204,10 +1192,10 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
       newDci.m_resAlloc = 0;  // only allocation type 0 at this stage
       newDci.m_rbBitmap = 0; // TBD (32 bit bitmap see 7.1.6 of 36.213)
       uint32_t rbgMask = 0;
-      for (uint16_t k = 0; k < (*itMap).second.size (); k++)
+      for (uint16_t k = 0; k < allocRbgs.size (); k++)
         {
-          rbgMask = rbgMask + (0x1 << (*itMap).second.at (k));
-          NS_LOG_INFO (this << " Allocated RBG " << (*itMap).second.at (k));
+          rbgMask = rbgMask + (0x1 << allocRbgs.at (k));
+          NS_LOG_INFO (this << " Allocated RBG " << allocRbgs.at (k));
         }
       newDci.m_rbBitmap = rbgMask; // (32 bit bitmap see 7.1.6 of 36.213)
 
@@ -1215,7 +1203,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
       std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itBufReq;
       for (itBufReq = m_rlcBufferReq.begin (); itBufReq != m_rlcBufferReq.end (); itBufReq++)
         {
-          if (((*itBufReq).first.m_rnti == (*itMap).first)
+          if (((*itBufReq).first.m_rnti == allocRnti)
               && (((*itBufReq).second.m_rlcTransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcRetransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcStatusPduSize > 0) ))
@@ -1232,17 +1220,17 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
                   if (m_harqOn == true)
                     {
                       // store RLC PDU list for HARQ
-                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find ((*itMap).first);
+                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (allocRnti);
                       if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
                         {
-                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << (*itMap).first);
+                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << allocRnti);
                         }
                       (*itRlcPdu).second.at (j).at (newDci.m_harqProcess).push_back (newRlcEl);
                     }
                 }
               newEl.m_rlcPduList.push_back (newRlcPduLe);
             }
-          if ((*itBufReq).first.m_rnti > (*itMap).first)
+          if ((*itBufReq).first.m_rnti > allocRnti)
             {
               break;
             }
@@ -1280,7 +1268,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
       ret.m_buildDataList.push_back (newEl);
       // update UE stats
       std::map <uint16_t, fdbetsFlowPerf_t>::iterator it;
-      it = m_flowStatsDl.find ((*itMap).first);
+      it = m_flowStatsDl.find (allocRnti);
       if (it != m_flowStatsDl.end ())
         {
           (*it).second.lastTtiBytesTrasmitted = bytesTxed;
@@ -1293,8 +1281,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
           NS_FATAL_ERROR (this << " No Stats for this allocated UE");
         }
 
-      itMap++;
-    } // end while allocation
+    } // end for allocation
   ret.m_nrOfPdcchOfdmSymbols = 1;   /// \todo check correct value according the DCIs txed
 
 
@@ -645,10 +645,9 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
 
   int rbgSize = GetRbgSize (m_cschedCellConfig.m_dlBandwidth);
   int rbgNum = m_cschedCellConfig.m_dlBandwidth / rbgSize;
-  std::map <uint16_t, std::vector <uint16_t> > allocationMap; // RBs map per RNTI
   std::vector <bool> rbgMap;  // global RBGs map
   uint16_t rbgAllocatedNum = 0;
-  std::set <uint16_t> rntiAllocated;
+  m_dlWorkspace.Reset ();
   rbgMap.resize (m_cschedCellConfig.m_dlBandwidth / rbgSize, false);
   FfMacSchedSapUser::SchedDlConfigIndParameters ret;
 
@@ -769,8 +768,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
   std::vector <struct DlInfoListElement_s> dlInfoListUntxed;
   for (uint16_t i = 0; i < m_dlInfoListBuffered.size (); i++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_dlInfoListBuffered.at (i).m_rnti);
-      if (itRnti != rntiAllocated.end ())
+      if (m_dlWorkspace.IsRntiAllocated (m_dlInfoListBuffered.at (i).m_rnti))
         {
           // RNTI already allocated for retx
           continue;
@@ -834,7 +832,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
             }
           // check the feasibility of retransmitting on the same RBGs
           // translate the DCI to Spectrum framework
-          std::vector <int> dciRbg;
+          std::vector <int> &dciRbg = m_dlWorkspace.GetDciRbgBuffer ();
           uint32_t mask = 0x1;
           NS_LOG_INFO ("Original RBGs " << dci.m_rbBitmap << " rnti " << dci.m_rnti);
           for (int j = 0; j < 32; j++)
@@ -874,7 +872,8 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
               uint8_t j = 0;
               uint8_t rbgId = (dciRbg.at (dciRbg.size () - 1) + 1) % rbgNum;
               uint8_t startRbg = dciRbg.at (dciRbg.size () - 1);
-              std::vector <bool> rbgMapCopy = rbgMap;
+              std::vector <bool> &rbgMapCopy = m_dlWorkspace.GetRbgMapBuffer ();
+              rbgMapCopy = rbgMap;
               while ((j < dciRbg.size ())&&(startRbg != rbgId))
                 {
                   if (rbgMapCopy.at (rbgId) == false)
@@ -973,7 +972,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
             }
           (*itHarqTimer).second.at (harqId) = 0;
           ret.m_buildDataList.push_back (newEl);
-          rntiAllocated.insert (rnti);
+          m_dlWorkspace.MarkRntiAllocated (rnti);
         }
       else
         {
@@ -996,8 +995,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
             }
         }
     }
-  m_dlInfoListBuffered.clear ();
-  m_dlInfoListBuffered = dlInfoListUntxed;
+  m_dlInfoListBuffered.swap (dlInfoListUntxed);
 
   if (rbgAllocatedNum == rbgNum)
     {
@@ -1021,11 +1019,11 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
           double rcqiMax = 0.0;
           for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
             {
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it));
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it))))
+              bool rntiAllocated = m_dlWorkspace.IsRntiAllocated ((*it));
+              if ((rntiAllocated)||(!HarqProcessAvailability ((*it))))
                 {
                   // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
+                  if (rntiAllocated)
                   {
                     NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it));
                   }
@@ -1045,18 +1043,9 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
                   NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it));
                 }
               int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-              std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
-                {
-                  for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                      sbCqi.push_back (1);  // start with lowest value
-                    }
-                }
-              else
-                {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                }
+              const std::vector <uint8_t> &sbCqi = (itCqi == m_a30CqiRxed.end ())
+                ? m_dlWorkspace.GetDefaultSbCqi (nLayer)  // start with lowest value
+                : (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
               uint8_t cqi1 = sbCqi.at (0);
               uint8_t cqi2 = 1;
               if (sbCqi.size () > 1)
@@ -1105,19 +1094,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
           else
             {
               rbgMap.at (i) = true;
-              std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              itMap = allocationMap.find ((*itMax));
-              if (itMap == allocationMap.end ())
-                {
-                  // insert new element
-                  std::vector <uint16_t> tempMap;
-                  tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax), tempMap));
-                }
-              else
-                {
-                  (*itMap).second.push_back (i);
-                }
+              m_dlWorkspace.AllocateRbg ((*itMax), i);
               NS_LOG_INFO (this << " UE assigned " << (*itMax));
             }
         } // end for RBG free
@@ -1125,55 +1102,56 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
 
   // generate the transmission opportunities by grouping the RBGs of the same RNTI and
   // creating the correspondent DCIs
-  std::map <uint16_t, std::vector <uint16_t> >::iterator itMap = allocationMap.begin ();
-  while (itMap != allocationMap.end ())
+  for (uint32_t a = 0; a < m_dlWorkspace.GetNAllocations (); a++)
     {
+      uint16_t allocRnti = m_dlWorkspace.GetAllocationRnti (a);
+      const std::vector <uint16_t> &allocRbgs = m_dlWorkspace.GetAllocationRbgs (a);
       // create new BuildDataListElement_s for this LC
       BuildDataListElement_s newEl;
-      newEl.m_rnti = (*itMap).first;
+      newEl.m_rnti = allocRnti;
       // create the DlDciListElement_s
       DlDciListElement_s newDci;
-      newDci.m_rnti = (*itMap).first;
-      newDci.m_harqProcess = UpdateHarqProcessId ((*itMap).first);
+      newDci.m_rnti = allocRnti;
+      newDci.m_harqProcess = UpdateHarqProcessId (allocRnti);
 
-      uint16_t lcActives = LcActivePerFlow ((*itMap).first);
+      uint16_t lcActives = LcActivePerFlow (allocRnti);
       NS_LOG_INFO (this << "Allocate user " << newEl.m_rnti << " rbg " << lcActives);
       if (lcActives == 0)
         {
           // Set to max value, to avoid divide by 0 below
           lcActives = (uint16_t)65535; // UINT16_MAX;
         }
-      uint16_t RgbPerRnti = (*itMap).second.size ();
+      uint16_t RgbPerRnti = allocRbgs.size ();
       std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-      itCqi = m_a30CqiRxed.find ((*itMap).first);
+      itCqi = m_a30CqiRxed.find (allocRnti);
       std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itMap).first);
+      itTxMode = m_uesTxMode.find (allocRnti);
       if (itTxMode == m_uesTxMode.end ())
         {
-          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMap).first);
+          NS_FATAL_ERROR ("No Transmission Mode info on user " << allocRnti);
         }
       int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-      std::vector <uint8_t> worstCqi (2, 15);
+      uint8_t worstCqi[2] = {15, 15};
       if (itCqi != m_a30CqiRxed.end ())
         {
-          for (uint16_t k = 0; k < (*itMap).second.size (); k++)
+          for (uint16_t k = 0; k < allocRbgs.size (); k++)
             {
-              if ((*itCqi).second.m_higherLayerSelected.size () > (*itMap).second.at (k))
+              if ((*itCqi).second.m_higherLayerSelected.size () > allocRbgs.at (k))
                 {
-                  NS_LOG_INFO (this << " RBG " << (*itMap).second.at (k) << " CQI " << (uint16_t)((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (0)) );
+                  NS_LOG_INFO (this << " RBG " << allocRbgs.at (k) << " CQI " << (uint16_t)((*itCqi).second.m_higherLayerSelected.at (allocRbgs.at (k)).m_sbCqi.at (0)) );
                   for (uint8_t j = 0; j < nLayer; j++)
                     {
-                      if ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.size () > j)
+                      if ((*itCqi).second.m_higherLayerSelected.at (allocRbgs.at (k)).m_sbCqi.size () > j)
                         {
-                          if (((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j)) < worstCqi.at (j))
+                          if (((*itCqi).second.m_higherLayerSelected.at (allocRbgs.at (k)).m_sbCqi.at (j)) < worstCqi[j])
                             {
-                              worstCqi.at (j) = ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j));
+                              worstCqi[j] = ((*itCqi).second.m_higherLayerSelected.at (allocRbgs.at (k)).m_sbCqi.at (j));
                             }
                         }
                       else
                         {
                           // no CQI for this layer of this suband -> worst one
-                          worstCqi.at (j) = 1;
+                          worstCqi[j] = 1;
                         }
                     }
                 }
@@ -1181,7 +1159,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
                 {
                   for (uint8_t j = 0; j < nLayer; j++)
                     {
-                      worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
+                      worstCqi[j] = 1; // try with lowest MCS in RBG with no info on channel
                     }
                 }
             }
@@ -1190,30 +1168,30 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
         {
           for (uint8_t j = 0; j < nLayer; j++)
             {
-              worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
+              worstCqi[j] = 1; // try with lowest MCS in RBG with no info on channel
             }
         }
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " CQI selected " << (uint16_t)worstCqi.at (j));
+          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " CQI selected " << (uint16_t)worstCqi[j]);
         }
       uint32_t bytesTxed = 0;
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          newDci.m_mcs.push_back (m_amc->GetMcsFromCqi (worstCqi.at (j)));
+          newDci.m_mcs.push_back (m_amc->GetMcsFromCqi (worstCqi[j]));
           int tbSize = (m_amc->GetTbSizeFromMcs (newDci.m_mcs.at (j), RgbPerRnti * rbgSize) / 8); // (size of TB in bytes according to table 7.1.7.2.1-1 of 36.213)
           newDci.m_tbsSize.push_back (tbSize);
-          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " MCS selected" << m_amc->GetMcsFromCqi (worstCqi.at (j)));
+          NS_LOG_INFO (this << " Layer " << (uint16_t)j << " MCS selected" << m_amc->GetMcsFromCqi (worstCqi[j]));
           bytesTxed += tbSize;
         }
 
       newDci.m_resAlloc = 0;  // only allocation type 0 at this stage
       newDci.m_rbBitmap = 0; // TBD (32 bit bitmap see 7.1.6 of 36.213)
       uint32_t rbgMask = 0;
-      for (uint16_t k = 0; k < (*itMap).second.size (); k++)
+      for (uint16_t k = 0; k < allocRbgs.size (); k++)
         {
-          rbgMask = rbgMask + (0x1 << (*itMap).second.at (k));
-          NS_LOG_INFO (this << " Allocated RBG " << (*itMap).second.at (k));
+          rbgMask = rbgMask + (0x1 << allocRbgs.at (k));
+          NS_LOG_INFO (this << " Allocated RBG " << allocRbgs.at (k));
         }
       newDci.m_rbBitmap = rbgMask; // (32 bit bitmap see 7.1.6 of 36.213)
 
@@ -1221,7 +1199,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
       std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itBufReq;
       for (itBufReq = m_rlcBufferReq.begin (); itBufReq != m_rlcBufferReq.end (); itBufReq++)
         {
-          if (((*itBufReq).first.m_rnti == (*itMap).first)
+          if (((*itBufReq).first.m_rnti == allocRnti)
               && (((*itBufReq).second.m_rlcTransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcRetransmissionQueueSize > 0)
                   || ((*itBufReq).second.m_rlcStatusPduSize > 0) ))
@@ -1238,17 +1216,17 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
                   if (m_harqOn == true)
                     {
                       // store RLC PDU list for HARQ
-                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find ((*itMap).first);
+                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (allocRnti);
                       if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
                         {
-                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << (*itMap).first);
+                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << allocRnti);
                         }
                       (*itRlcPdu).second.at (j).at (newDci.m_harqProcess).push_back (newRlcEl);
                     }
                 }
               newEl.m_rlcPduList.push_back (newRlcPduLe);
             }
-          if ((*itBufReq).first.m_rnti > (*itMap).first)
+          if ((*itBufReq).first.m_rnti > allocRnti)
             {
               break;
             }
@@ -1285,8 +1263,7 @@ FdMtFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sch
 
       ret.m_buildDataList.push_back (newEl);
 
-      itMap++;
-    } // end while allocation
+    } // end for allocation
   ret.m_nrOfPdcchOfdmSymbols = 1;   /// \todo check correct value according the DCIs txed
 
   m_schedSapUser->SchedDlConfigInd (ret);
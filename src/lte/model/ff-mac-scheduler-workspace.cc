@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ff-mac-scheduler-workspace.h"
+#include <ns3/assert.h>
+#include <ns3/fatal-error.h>
+
+namespace ns3 {
+
+FfMacSchedulerWorkspace::FfMacSchedulerWorkspace ()
+  : m_rntiAllocated (65536 / 32, 0),
+    m_nAllocations (0)
+{
+  m_defaultSbCqi[0].resize (1, 1);  // start with lowest value
+  m_defaultSbCqi[1].resize (2, 1);
+}
+
+void
+FfMacSchedulerWorkspace::Reset ()
+{
+  for (std::vector<uint16_t>::const_iterator it = m_markedRntis.begin (); it != m_markedRntis.end (); ++it)
+    {
+      m_rntiAllocated[(*it) >> 5] = 0;
+    }
+  m_markedRntis.clear ();
+  m_sortedAllocations.clear ();
+  m_nAllocations = 0;
+}
+
+void
+FfMacSchedulerWorkspace::MarkRntiAllocated (uint16_t rnti)
+{
+  if (!IsRntiAllocated (rnti))
+    {
+      m_rntiAllocated[rnti >> 5] |= (1u << (rnti & 0x1F));
+      m_markedRntis.push_back (rnti);
+    }
+}
+
+FfMacSchedulerWorkspace::Allocation&
+FfMacSchedulerWorkspace::FindOrCreateAllocation (uint16_t rnti)
+{
+  // few RNTIs are allocated in a TTI (at most one per RBG): a linear
+  // search is cheaper than any associative container
+  std::vector<uint32_t>::iterator pos = m_sortedAllocations.begin ();
+  while (pos != m_sortedAllocations.end () && m_allocations[*pos].rnti < rnti)
+    {
+      ++pos;
+    }
+  if (pos != m_sortedAllocations.end () && m_allocations[*pos].rnti == rnti)
+    {
+      return m_allocations[*pos];
+    }
+  if (m_nAllocations == m_allocations.size ())
+    {
+      m_allocations.push_back (Allocation ());
+    }
+  Allocation &allocation = m_allocations[m_nAllocations];
+  allocation.rnti = rnti;
+  allocation.rbgs.clear ();
+  m_sortedAllocations.insert (pos, m_nAllocations);
+  m_nAllocations++;
+  return allocation;
+}
+
+void
+FfMacSchedulerWorkspace::AddAllocation (uint16_t rnti)
+{
+  FindOrCreateAllocation (rnti);
+}
+
+const std::vector<uint16_t>&
+FfMacSchedulerWorkspace::AllocateRbg (uint16_t rnti, uint16_t rbg)
+{
+  Allocation &allocation = FindOrCreateAllocation (rnti);
+  allocation.rbgs.push_back (rbg);
+  return allocation.rbgs;
+}
+
+void
+FfMacSchedulerWorkspace::DeallocateLastRbg (uint16_t rnti)
+{
+  for (std::vector<uint32_t>::const_iterator it = m_sortedAllocations.begin (); it != m_sortedAllocations.end (); ++it)
+    {
+      if (m_allocations[*it].rnti == rnti)
+        {
+          NS_ASSERT (!m_allocations[*it].rbgs.empty ());
+          m_allocations[*it].rbgs.pop_back ();
+          return;
+        }
+    }
+  NS_FATAL_ERROR ("No allocation for RNTI " << rnti);
+}
+
+const std::vector<uint8_t>&
+FfMacSchedulerWorkspace::GetDefaultSbCqi (int nLayer) const
+{
+  NS_ASSERT_MSG (nLayer >= 1 && nLayer <= 2, "Unsupported number of layers " << nLayer);
+  return m_defaultSbCqi[nLayer - 1];
+}
+
+} // namespace ns3
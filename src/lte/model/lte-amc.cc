@@ -359,10 +359,16 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
          {
             uint8_t mcs = 0;
             TbStats_t tbStats;
+            HarqProcessInfoList_t harqInfoList;
+            double mi = 0.0;
             while (mcs <= 28)
               {
-                HarqProcessInfoList_t harqInfoList;
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, (uint16_t)GetTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
+                // the mmib only changes with the modulation order
+                if ((mcs == 0) || (mcs == MI_QPSK_MAX_ID + 1) || (mcs == MI_16QAM_MAX_ID + 1))
+                  {
+                    mi = LteMiErrorModel::Mib (sinr, rbgMap, mcs);
+                  }
+                tbStats = LteMiErrorModel::GetTbDecodificationStats (mi, (uint16_t)GetTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
                 if (tbStats.tbler > 0.1)
                   {
                     break;
@@ -25,6 +25,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -32,6 +33,11 @@ namespace ns3 {
  * This class has the purpose to encode Information Elements according
  * to ASN.1 syntax, as defined in ITU-T  X-691.
  * IMPORTANT: The encoding is done following the UNALIGNED variant.
+ *
+ * All the fields are written and read through WriteBits () and
+ * ReadBits (), which move up to 32 bits at a time. The complete octets of
+ * an encoding are collected in a vector and copied to
+ * m_serializationResult in one go when the serialization is finalized.
  */
 class Asn1Header : public Header
 {
@@ -69,13 +75,32 @@ protected:
   mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
   mutable bool m_isDataSerialized; //!< true if data is serialized
   mutable Buffer m_serializationResult; //!< serialization result
+  mutable std::vector<uint8_t> m_serializationOctets; //!< octets not yet copied to m_serializationResult
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
+   * Function to write an octet to the serialization result
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
 
+  /**
+   * Write the least significant bits of a value, most significant first
+   * \param value the value to write
+   * \param numBits the number of bits to write, at most 32
+   */
+  void WriteBits (uint32_t value, uint8_t numBits) const;
+
+  /**
+   * Read bits into the least significant bits of a value, most significant
+   * first
+   * \param value buffer to store the result
+   * \param numBits the number of bits to read, at most 32
+   * \param bIterator buffer iterator
+   * \returns the modified buffer iterator
+   */
+  Buffer::Iterator ReadBits (uint32_t *value, uint8_t numBits,
+                             Buffer::Iterator bIterator);
+
   // Serialization functions
 
   /**
@@ -523,6 +548,17 @@ protected:
    */
   Buffer::Iterator DeserializeSequenceOf (int *numElems, int nMax, int nMin,
                                           Buffer::Iterator bIterator);
+
+private:
+  /**
+   * Serialize the header with PreSerialize () and copy the result to
+   * m_serializationResult
+   */
+  void DoPreSerialize (void) const;
+  /**
+   * Copy the octets written since the last call to m_serializationResult
+   */
+  void FlushSerializationOctets (void) const;
 };
 
 } // namespace ns3
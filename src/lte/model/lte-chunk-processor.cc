@@ -50,7 +50,10 @@ void
 LteChunkProcessor::Start ()
 {
   NS_LOG_FUNCTION (this);
-  m_sumValues = 0;
+  if (m_sumValues != 0)
+    {
+      (*m_sumValues) = 0.0;
+    }
   m_totDuration = MicroSeconds (0);
 }
 
@@ -59,11 +62,18 @@ void
 LteChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  if (m_sumValues == 0)
+  if (m_sumValues == 0 || m_sumValues->GetSpectrumModelUid () != sinr.GetSpectrumModelUid ())
     {
+      NS_ASSERT_MSG (m_totDuration.IsZero (), "SpectrumModel changed during the reception");
       m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
     }
-  (*m_sumValues) += sinr * duration.GetSeconds ();
+  // accumulate in place, without a temporary SpectrumValue
+  double seconds = duration.GetSeconds ();
+  Values::iterator sumIt = m_sumValues->ValuesBegin ();
+  for (Values::const_iterator it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); ++it, ++sumIt)
+    {
+      *sumIt += *it * seconds;
+    }
   m_totDuration += duration;
 }
 
@@ -73,10 +83,21 @@ LteChunkProcessor::End ()
   NS_LOG_FUNCTION (this);
   if (m_totDuration.GetSeconds () > 0)
     {
+      if (m_meanValues == 0 || m_meanValues->GetSpectrumModelUid () != m_sumValues->GetSpectrumModelUid ())
+        {
+          m_meanValues = Create<SpectrumValue> (m_sumValues->GetSpectrumModel ());
+        }
+      // the average is computed once for all the callbacks
+      double seconds = m_totDuration.GetSeconds ();
+      Values::iterator meanIt = m_meanValues->ValuesBegin ();
+      for (Values::const_iterator it = m_sumValues->ConstValuesBegin (); it != m_sumValues->ConstValuesEnd (); ++it, ++meanIt)
+        {
+          *meanIt = *it / seconds;
+        }
       std::vector<LteChunkProcessorCallback>::iterator it;
       for (it = m_lteChunkProcessorCallbacks.begin (); it != m_lteChunkProcessorCallbacks.end (); it++)
         {
-          (*it)((*m_sumValues) / m_totDuration.GetSeconds ());
+          (*it)(*m_meanValues);
         }
     }
   else
@@ -82,7 +82,8 @@ public:
   virtual void End ();
 
 private:
-  Ptr<SpectrumValue> m_sumValues;
+  Ptr<SpectrumValue> m_sumValues; ///< time-weighted sum of the chunks, reused across receptions
+  Ptr<SpectrumValue> m_meanValues; ///< average passed to the callbacks, reused across receptions
   Time m_totDuration;
 
   std::vector<LteChunkProcessorCallback> m_lteChunkProcessorCallbacks;
@@ -23,9 +23,11 @@
 #include <ns3/log.h>
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
 #include <ns3/simulator.h>
 #include <ns3/attribute-accessor-helper.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 
 
 #include "lte-enb-phy.h"
@@ -145,7 +147,9 @@ LteEnbPhy::LteEnbPhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
     m_srsPeriodicity (0),
     m_srsStartTime (Seconds (0)),
     m_currentSrsOffset (0),
-    m_interferenceSampleCounter (0)
+    m_interferenceSampleCounter (0),
+    m_skipIdleSubframes (false),
+    m_skippedSubFrames (0)
 {
   m_enbPhySapProvider = new EnbMemberLteEnbPhySapProvider (this);
   m_enbCphySapProvider = new MemberLteEnbCphySapProvider<LteEnbPhy> (this);
@@ -225,6 +229,22 @@ LteEnbPhy::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&LteEnbPhy::GetUlSpectrumPhy),
                    MakePointerChecker <LteSpectrumPhy> ())
+    .AddAttribute ("SkipIdleSubframes",
+                   "If true, a cell without attached UEs and without pending "
+                   "transmissions runs only the subframes carrying the PSS, "
+                   "the MIB and the SIB1 (i.e., subframes 1 and 6), and "
+                   "resumes the normal subframe cadence as soon as a RACH "
+                   "preamble is received or a UE is added. The skipped "
+                   "subframes are not transmitted at all: an idle cell then "
+                   "causes no control channel interference to the neighbouring "
+                   "cells during them, which changes the SINR, the CQI and "
+                   "hence the results of the UEs of those cells with respect "
+                   "to a simulation without this option. Only the eNB "
+                   "subframes are skipped: the UEs keep running every "
+                   "subframe, including their periodic CQI and SRS.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteEnbPhy::m_skipIdleSubframes),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -416,6 +436,7 @@ void
 LteEnbPhy::DoSendMacPdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this);
+  WakeUp ();
   SetMacPdu (p);
 }
 
@@ -505,6 +526,7 @@ void
 LteEnbPhy::DoSendLteControlMessage (Ptr<LteControlMessage> msg)
 {
   NS_LOG_FUNCTION (this << msg);
+  WakeUp ();
   // queues the message (wait for MAC-PHY delay)
   SetControlMessages (msg);
 }
@@ -531,6 +553,8 @@ LteEnbPhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgL
         case LteControlMessage::RACH_PREAMBLE:
           {
             Ptr<RachPreambleLteControlMessage> rachPreamble = DynamicCast<RachPreambleLteControlMessage> (*it);
+            // the MAC processes the preamble at the next subframe
+            WakeUp ();
             m_enbPhySapUser->ReceiveRachPreamble (rachPreamble->GetRapId ());
           }
           break;
@@ -601,6 +625,7 @@ LteEnbPhy::StartSubFrame (void)
   NS_LOG_FUNCTION (this);
 
   ++m_nrSubFrames;
+  m_subFrameStartTime = Simulator::Now ();
 
   /*
    * Send SIB1 at 6th subframe of every odd-numbered radio frame. This is
@@ -758,9 +783,17 @@ LteEnbPhy::StartSubFrame (void)
   // trigger the MAC
   m_enbPhySapUser->SubframeIndication (m_nrFrames, m_nrSubFrames);
 
-  Simulator::Schedule (Seconds (GetTti ()),
-                       &LteEnbPhy::EndSubFrame,
-                       this);
+  Time subFrameDuration = Seconds (GetTti ());
+  if (m_skipIdleSubframes && IsIdle ())
+    {
+      // skip up to the next subframe carrying the PSS (and the MIB or SIB1)
+      m_skippedSubFrames = (m_nrSubFrames <= 5 ? 5 : 10) - m_nrSubFrames;
+      NS_LOG_LOGIC (this << " cell idle, skipping " << m_skippedSubFrames << " subframes");
+      subFrameDuration = TimeStep (subFrameDuration.GetTimeStep () * (1 + m_skippedSubFrames));
+    }
+  m_endSubFrameEvent = Simulator::Schedule (subFrameDuration,
+                                            &LteEnbPhy::EndSubFrame,
+                                            this);
 
 }
 
@@ -802,6 +835,10 @@ void
 LteEnbPhy::EndSubFrame (void)
 {
   NS_LOG_FUNCTION (this << Simulator::Now ().GetSeconds ());
+  // catch up with the subframes skipped while idle, which never include
+  // the first subframe of a frame
+  m_nrSubFrames += m_skippedSubFrames;
+  m_skippedSubFrames = 0;
   if (m_nrSubFrames == 10)
     {
       Simulator::ScheduleNow (&LteEnbPhy::EndFrame, this);
@@ -821,6 +858,64 @@ LteEnbPhy::EndFrame (void)
 }
 
 
+bool
+LteEnbPhy::IsIdle (void) const
+{
+  if (!m_ueAttached.empty ())
+    {
+      return false;
+    }
+  for (uint16_t i = 0; i < m_controlMessagesQueue.size (); i++)
+    {
+      if (!m_controlMessagesQueue.at (i).empty ())
+        {
+          return false;
+        }
+    }
+  for (uint16_t i = 0; i < m_packetBurstQueue.size (); i++)
+    {
+      if (m_packetBurstQueue.at (i)->GetNPackets () > 0)
+        {
+          return false;
+        }
+    }
+  for (uint16_t i = 0; i < m_ulDciQueue.size (); i++)
+    {
+      if (!m_ulDciQueue.at (i).empty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+
+void
+LteEnbPhy::WakeUp (void)
+{
+  if ((m_skippedSubFrames == 0) || !m_endSubFrameEvent.IsRunning ())
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  // number of subframes between the last one run and the next boundary
+  int64_t tti = Seconds (GetTti ()).GetTimeStep ();
+  int64_t elapsed = (Simulator::Now () - m_subFrameStartTime).GetTimeStep ();
+  int64_t next = std::max<int64_t> (1, (elapsed + tti - 1) / tti);
+  if (next > m_skippedSubFrames)
+    {
+      // the next subframe is already the one at the next boundary
+      return;
+    }
+  NS_LOG_LOGIC (this << " waking up after " << next - 1 << " skipped subframes");
+  m_skippedSubFrames = next - 1;
+  m_endSubFrameEvent.Cancel ();
+  m_endSubFrameEvent = Simulator::Schedule (m_subFrameStartTime + TimeStep (next * tti) - Simulator::Now (),
+                                            &LteEnbPhy::EndSubFrame,
+                                            this);
+}
+
+
 void 
 LteEnbPhy::GenerateCtrlCqiReport (const SpectrumValue& sinr)
 {
@@ -921,6 +1016,7 @@ LteEnbPhy::DoAddUe (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
  
+  WakeUp ();
   bool success = AddUePhy (rnti);
   NS_ASSERT_MSG (success, "AddUePhy() failed");
 
@@ -28,6 +28,7 @@
 #include <ns3/lte-enb-cphy-sap.h>
 #include <ns3/lte-phy.h>
 #include <ns3/lte-harq-phy.h>
+#include <ns3/event-id.h>
 
 #include <map>
 #include <set>
@@ -258,6 +259,23 @@ public:
    */
   void EndFrame (void);
 
+  /**
+   * \brief Whether the cell has nothing to do in the next subframes
+   *
+   * A cell is idle when no UE is attached and no control message, MAC PDU
+   * or UL-DCI is waiting in the MAC-to-PHY queues.
+   *
+   * \return true if the cell is idle
+   */
+  bool IsIdle (void) const;
+  /**
+   * \brief Resume the subframe cadence if idle subframes are being skipped
+   *
+   * The next subframe is started at the next subframe boundary, with the
+   * frame and subframe numbers it would have had without skipping.
+   */
+  void WakeUp (void);
+
   /**
    * \brief PhySpectrum received a new PHY-PDU
    */
@@ -433,6 +451,18 @@ private:
    */
   TracedCallback<PhyTransmissionStatParameters> m_dlPhyTransmission;
 
+  /**
+   * The `SkipIdleSubframes` attribute. If true, an idle cell runs only the
+   * subframes carrying the PSS, the MIB and the SIB1.
+   */
+  bool m_skipIdleSubframes;
+  /// Start time of the last subframe run.
+  Time m_subFrameStartTime;
+  /// Number of subframes skipped before the next EndSubFrame ().
+  uint32_t m_skippedSubFrames;
+  /// The event ending the current subframe.
+  EventId m_endSubFrameEvent;
+
 }; // end of `class LteEnbPhy`
 
 
@@ -53,6 +53,8 @@ LteInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_interf = 0;
+  m_sinr = 0;
   Object::DoDispose ();
 } 
 
@@ -188,17 +190,31 @@ LteInterference::ConditionallyEvaluateChunk ()
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
 
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+      if (!m_sinrChunkProcessorList.empty () || !m_interfChunkProcessorList.empty ())
+        {
+          NS_ASSERT (m_rxSignal->GetSpectrumModelUid () == m_allSignals->GetSpectrumModelUid ());
+          NS_ASSERT (m_noise->GetSpectrumModelUid () == m_allSignals->GetSpectrumModelUid ());
+          // interf = allSignals - rxSignal + noise, sinr = rxSignal / interf
+          Values::const_iterator allIt = m_allSignals->ConstValuesBegin ();
+          Values::const_iterator rxIt = m_rxSignal->ConstValuesBegin ();
+          Values::const_iterator noiseIt = m_noise->ConstValuesBegin ();
+          Values::iterator interfIt = m_interf->ValuesBegin ();
+          Values::iterator sinrIt = m_sinr->ValuesBegin ();
+          for (; allIt != m_allSignals->ConstValuesEnd (); ++allIt, ++rxIt, ++noiseIt, ++interfIt, ++sinrIt)
+            {
+              *interfIt = *allIt - *rxIt + *noiseIt;
+              *sinrIt = *rxIt / *interfIt;
+            }
+        }
 
-      SpectrumValue sinr = (*m_rxSignal) / interf;
       Time duration = Now () - m_lastChangeTime;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (sinr, duration);
+          (*it)->EvaluateChunk (*m_sinr, duration);
         }
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_interfChunkProcessorList.begin (); it != m_interfChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (interf, duration);
+          (*it)->EvaluateChunk (*m_interf, duration);
         }
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
         {
@@ -217,6 +233,8 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   // reset m_allSignals (will reset if already set previously)
   // this is needed since this method can potentially change the SpectrumModel
   m_allSignals = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_interf = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_sinr = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
   if (m_receiving == true)
     {
       // abort rx
@@ -135,6 +135,13 @@ private:
 
   Ptr<const SpectrumValue> m_noise;
 
+  /** interference plus noise of the last chunk, computed in the same pass
+      as m_sinr and passed to all the interference chunk processors */
+  Ptr<SpectrumValue> m_interf;
+
+  /** SINR of the last chunk, passed to all the SINR chunk processors */
+  Ptr<SpectrumValue> m_sinr;
+
   Time m_lastChangeTime;     /**< the time of the last change in
                                 m_TotalPower */
 
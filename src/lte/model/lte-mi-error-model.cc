@@ -38,6 +38,7 @@
 #include <cmath>
 #include <stdint.h>
 #include "stdlib.h"
+#include <algorithm>
 #include <ns3/lte-mi-error-model.h>
 
 
@@ -323,86 +324,68 @@ static const double cEcrTable [9][38] = {
 };
 
 
+/// Mutual information curve of a modulation, uniformly sampled in linear SINR.
+struct MiTable
+{
+  const double *mi;     ///< MI values
+  const double *axis;   ///< linear SINR of each MI value
+  uint16_t size;        ///< number of samples
+  double scalingCoeff;  ///< samples per unit of linear SINR
+};
+
+// since the values of the axes are uniformly spaced, we have
+// index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+// the scaling coefficient is always the same, so it is computed once
+static const MiTable MiTableQpsk = {
+  MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE,
+  (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0])
+};
+static const MiTable MiTable16qam = {
+  MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE,
+  (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0])
+};
+static const MiTable MiTable64qam = {
+  MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE,
+  (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0])
+};
+
+/**
+ * \param table the MI curve of the modulation
+ * \param sinrLin the linear SINR of a RB
+ * \return the MI of the RB
+ */
+static inline double
+MiFromTable (const MiTable &table, double sinrLin)
+{
+  if (sinrLin > table.axis[table.size - 1])
+    {
+      return 1;
+    }
+  double sinrIndexDouble = (sinrLin - table.axis[0]) * table.scalingCoeff + 1;
+  // truncation is the floor of the index, which is clamped to 0 below the axis
+  uint32_t sinrIndex = (sinrIndexDouble > 0.0) ? static_cast<uint32_t> (sinrIndexDouble) : 0;
+  NS_ASSERT_MSG (sinrIndex <= table.size, "MI map out of data");
+  // a SINR equal to the last value of the axis falls one sample after the end
+  return table.mi[std::min<uint32_t> (sinrIndex, table.size - 1)];
+}
+
+
 double 
 LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
   
-  double MI;
+  const MiTable &table = (mcs <= MI_QPSK_MAX_ID) ? MiTableQpsk
+    : ((mcs <= MI_16QAM_MAX_ID) ? MiTable16qam : MiTable64qam);
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  for (std::vector<int>::const_iterator it = map.begin (); it != map.end (); ++it)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
-        {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
-        }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+      double sinrLin = sinr[*it];
+      double MI = MiFromTable (table, sinrLin);
+      NS_LOG_LOGIC (" RB " << *it << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
-  MI = MIsum / map.size ();
+  double MI = MIsum / map.size ();
   NS_LOG_LOGIC (" MI = " << MI);
   return MI;
 }
@@ -458,44 +441,20 @@ double
 LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 {
   NS_LOG_FUNCTION (sinr);
-  double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
-      MIsum += MI;
+      MIsum += MiFromTable (MiTableQpsk, *sinrIt);
       sinrIt++;
       rb++;
     }
-  MI = MIsum / rb;
+  double MI = MIsum / rb;
   // return to the effective SINR value
-  int j = 0;
+  int j = std::lower_bound (MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
   double esinr = 0.0;
-  while ((j<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk[j] < MI))
-    {
-      j++;
-    }
   if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE-1])
     {
       esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1];
@@ -523,12 +482,9 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
   double esirnDb = 10*log10 (esinr); 
 //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk [MI_MAP_QPSK_SIZE-1]));
-  uint16_t i = 0;
+  uint16_t i = std::lower_bound (PdcchPcfichBlerCurveXaxis, PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE, esirnDb)
+    - PdcchPcfichBlerCurveXaxis;
   double errorRate = 0.0;
-  while ((i<PDCCH_PCFICH_CURVE_SIZE)&&(PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-      i++;
-    }
   if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE-1])
     {
       errorRate = 0.0;
@@ -545,36 +501,39 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 
-TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+/// Segmentation of a TB in code blocks (sec 5.1.2 of TS 36.212).
+struct CodeBlockSegmentation
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
+  bool valid;       ///< whether the segmentation has been computed
+  uint32_t C;       ///< no. of codeblocks
+  uint32_t Cplus;   ///< no. of codeblocks with size K+
+  uint32_t Kplus;   ///< size of the codeblocks of size K+
+  uint32_t Cminus;  ///< no. of codeblocks with size K-
+  uint32_t Kminus;  ///< size of the codeblocks of size K-
+};
 
-  double tbMi = Mib(sinr, map, mcs);
-  double MI = 0.0;
-  double Reff = 0.0;
-  NS_ASSERT (mcs < 29);
-  if (miHistory.size ()>0)
+/**
+ * The segmentation only depends on the TB size, which is also the same
+ * for all the retransmissions of a TB, hence it is computed once per size.
+ *
+ * \param size the size in bytes of the TB
+ * \return the segmentation of the TB
+ */
+static const CodeBlockSegmentation &
+GetCodeBlockSegmentation (uint16_t size)
+{
+  static std::vector<CodeBlockSegmentation> cache;
+  if (size >= cache.size ())
     {
-      // evaluate R_eff and MI_eff
-      uint16_t codeBitsSum = 0;
-      double miSum = 0.0;
-      for (uint16_t i = 0; i < miHistory.size (); i++)
-        {
-          NS_LOG_DEBUG (" Sum MI " << miHistory.at (i).m_mi << " Ci " << miHistory.at (i).m_codeBits);
-          codeBitsSum += miHistory.at (i).m_codeBits;
-          miSum += (miHistory.at (i).m_mi*miHistory.at (i).m_codeBits);
-        }
-      codeBitsSum += (((double)size*8.0) / McsEcrTable [mcs]);
-      miSum += (tbMi*(((double)size*8.0) / McsEcrTable [mcs]));
-      Reff = miHistory.at (0).m_infoBits / (double)codeBitsSum; // information bits are the size of the first TB
-      MI = miSum / (double)codeBitsSum;      
+      CodeBlockSegmentation invalid = { false, 0, 0, 0, 0, 0 };
+      cache.resize (size + 1, invalid);
     }
-  else
+  CodeBlockSegmentation &seg = cache[size];
+  if (seg.valid)
     {
-      MI = tbMi;
+      return seg;
     }
-  NS_LOG_DEBUG (" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size ());
+
   // estimate CB size (according to sec 5.1.2 of TS 36.212)
   uint16_t Z = 6144; // max size of a codeblock (including CRC)
   uint32_t B = size * 8;
@@ -667,6 +626,60 @@ LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std:
     }
   NS_LOG_INFO ("--------------------LteMiErrorModel: TB size of " << B << " needs of " << B1 << " bits reparted in " << C << " CBs as "<< Cplus << " block(s) of " << Kplus << " and " << Cminus << " of " << Kminus);
 
+  seg.valid = true;
+  seg.C = C;
+  seg.Cplus = Cplus;
+  seg.Kplus = Kplus;
+  seg.Cminus = Cminus;
+  seg.Kminus = Kminus;
+  return seg;
+}
+
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
+
+  return GetTbDecodificationStats (Mib (sinr, map, mcs), size, mcs, miHistory);
+}
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
+{
+  NS_LOG_FUNCTION (tbMi << (uint32_t) size << (uint32_t) mcs);
+
+  double MI = 0.0;
+  double Reff = 0.0;
+  NS_ASSERT (mcs < 29);
+  if (miHistory.size ()>0)
+    {
+      // evaluate R_eff and MI_eff
+      uint16_t codeBitsSum = 0;
+      double miSum = 0.0;
+      for (uint16_t i = 0; i < miHistory.size (); i++)
+        {
+          NS_LOG_DEBUG (" Sum MI " << miHistory.at (i).m_mi << " Ci " << miHistory.at (i).m_codeBits);
+          codeBitsSum += miHistory.at (i).m_codeBits;
+          miSum += (miHistory.at (i).m_mi*miHistory.at (i).m_codeBits);
+        }
+      codeBitsSum += (((double)size*8.0) / McsEcrTable [mcs]);
+      miSum += (tbMi*(((double)size*8.0) / McsEcrTable [mcs]));
+      Reff = miHistory.at (0).m_infoBits / (double)codeBitsSum; // information bits are the size of the first TB
+      MI = miSum / (double)codeBitsSum;      
+    }
+  else
+    {
+      MI = tbMi;
+    }
+  NS_LOG_DEBUG (" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size ());
+  const CodeBlockSegmentation &seg = GetCodeBlockSegmentation (size);
+  uint32_t C = seg.C;
+  uint32_t Cplus = seg.Cplus;
+  uint32_t Kplus = seg.Kplus;
+  uint32_t Cminus = seg.Cminus;
+  uint32_t Kminus = seg.Kminus;
+
   double errorRate = 1.0;
   uint8_t ecrId = 0;
   if (miHistory.size ()==0)
@@ -24,33 +24,244 @@
 #include <ns3/mobility-model.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/log.h>
+#include <ns3/abort.h>
 #include <ns3/string.h>
 #include <ns3/double.h>
 #include "ns3/uinteger.h"
 #include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
 #include <ns3/simulator.h>
+#include <ns3/core-config.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif /* HAVE_SYS_MMAN_H */
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceFadingLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (TraceFadingLossModel);
-  
+
+/// Magic string at the beginning of a binary fading trace.
+static const char g_binaryTraceMagic[8] = { 'n', 's', '3', 'f', 'a', 'd', '0', '1' };
+
+/// Header of a binary fading trace, followed by the samples.
+struct BinaryTraceHeader
+{
+  char magic[8];        ///< g_binaryTraceMagic
+  uint32_t rbNum;       ///< number of RBs
+  uint32_t samplesNum;  ///< number of samples per RB
+};
+
+
+/**
+ * \ingroup lte
+ *
+ * Read-only samples of a fading trace, stored as linear power gains with
+ * one row of samples per RB. There is a single instance per trace file in
+ * a process, which is shared by all the TraceFadingLossModel instances
+ * using that file and released together with the last of them.
+ */
+class TraceFadingData : public SimpleRefCount<TraceFadingData>
+{
+public:
+  /**
+   * \param fileName the name of the trace file, ASCII or binary
+   * \param rbNum the number of RBs the trace is made of
+   * \param samplesNum the number of samples per RB
+   * \return the samples of the trace, loaded on first use
+   */
+  static Ptr<TraceFadingData> Get (std::string fileName, uint8_t rbNum, uint32_t samplesNum);
+
+  /**
+   * Parse an ASCII trace and convert its values from dB to linear gains.
+   *
+   * \param fileName the name of the ASCII trace file
+   * \param rbNum the number of RBs the trace is made of
+   * \param samplesNum the number of samples per RB
+   * \param gains the parsed samples
+   */
+  static void ReadAsciiTrace (std::string fileName, uint8_t rbNum, uint32_t samplesNum,
+                              std::vector<double> &gains);
+
+  ~TraceFadingData ();
+
+  /**
+   * \param rb the RB
+   * \param sample the index of the sample
+   * \return the linear power gain
+   */
+  double GetGain (uint32_t rb, uint32_t sample) const
+  {
+    return m_gains[rb * m_samplesNum + sample];
+  }
+
+private:
+  /**
+   * \param key the key of this trace in the registry
+   * \param samplesNum the number of samples per RB
+   */
+  TraceFadingData (std::string key, uint32_t samplesNum);
+
+  /**
+   * Map the file in memory if it is a binary trace, or read it where
+   * memory mapping is not available.
+   *
+   * \param fileName the name of the trace file
+   * \param rbNum the expected number of RBs
+   * \return true if the file is a binary trace
+   */
+  bool Map (std::string fileName, uint8_t rbNum);
+
+  /// Traces currently loaded, indexed by file name and dimensions.
+  typedef std::map<std::string, TraceFadingData *> Registry;
+
+  /// \return the traces currently loaded
+  static Registry & GetRegistry (void);
+
+  std::string m_key;            ///< key of this trace in the registry
+  uint32_t m_samplesNum;        ///< number of samples per RB
+  const double *m_gains;        ///< the samples, either read or mapped
+  std::vector<double> m_parsed; ///< storage of the samples read from the file
+#ifdef HAVE_SYS_MMAN_H
+  void *m_map;                  ///< start of the mapping of a binary trace
+  size_t m_mapLength;           ///< length of the mapping of a binary trace
+#endif /* HAVE_SYS_MMAN_H */
+};
+
+TraceFadingData::Registry &
+TraceFadingData::GetRegistry (void)
+{
+  static Registry registry;
+  return registry;
+}
+
+TraceFadingData::TraceFadingData (std::string key, uint32_t samplesNum)
+  : m_key (key),
+    m_samplesNum (samplesNum),
+    m_gains (0)
+#ifdef HAVE_SYS_MMAN_H
+  , m_map (MAP_FAILED),
+    m_mapLength (0)
+#endif /* HAVE_SYS_MMAN_H */
+{
+}
+
+TraceFadingData::~TraceFadingData ()
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (m_map != MAP_FAILED)
+    {
+      munmap (m_map, m_mapLength);
+    }
+#endif /* HAVE_SYS_MMAN_H */
+  GetRegistry ().erase (m_key);
+}
+
+Ptr<TraceFadingData>
+TraceFadingData::Get (std::string fileName, uint8_t rbNum, uint32_t samplesNum)
+{
+  std::ostringstream key;
+  key << fileName << ":" << (uint32_t) rbNum << "x" << samplesNum;
+  Registry::iterator it = GetRegistry ().find (key.str ());
+  if (it != GetRegistry ().end ())
+    {
+      NS_LOG_LOGIC ("reusing trace " << key.str ());
+      return Ptr<TraceFadingData> (it->second);
+    }
+
+  Ptr<TraceFadingData> data = Ptr<TraceFadingData> (new TraceFadingData (key.str (), samplesNum), false);
+  if (data->Map (fileName, rbNum))
+    {
+      NS_LOG_INFO ("loaded binary trace " << fileName);
+    }
+  else
+    {
+      NS_LOG_INFO ("loading ASCII trace " << fileName);
+      ReadAsciiTrace (fileName, rbNum, samplesNum, data->m_parsed);
+      data->m_gains = &data->m_parsed[0];
+    }
+  GetRegistry ()[key.str ()] = PeekPointer (data);
+  return data;
+}
+
+bool
+TraceFadingData::Map (std::string fileName, uint8_t rbNum)
+{
+  std::ifstream ifs (fileName.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_ABORT_MSG_IF (!ifs.is_open (), "Fading trace file " << fileName << " not found");
+  BinaryTraceHeader header;
+  if (!ifs.read (reinterpret_cast<char *> (&header), sizeof (header))
+      || std::memcmp (header.magic, g_binaryTraceMagic, sizeof (g_binaryTraceMagic)) != 0)
+    {
+      return false;
+    }
+  NS_ABORT_MSG_IF (header.rbNum != rbNum || header.samplesNum != m_samplesNum,
+                   "Binary fading trace " << fileName << " has " << header.rbNum << " RBs and "
+                   << header.samplesNum << " samples, while the RbNum and SamplesNum attributes are "
+                   << (uint32_t) rbNum << " and " << m_samplesNum);
+  size_t samples = (size_t) rbNum * m_samplesNum;
+
+#ifdef HAVE_SYS_MMAN_H
+  ifs.close ();
+  int fd = open (fileName.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Fading trace file " << fileName << " not found");
+  struct stat st;
+  m_mapLength = sizeof (header) + samples * sizeof (double);
+  NS_ABORT_MSG_IF (fstat (fd, &st) != 0 || (size_t) st.st_size < m_mapLength,
+                   "Binary fading trace " << fileName << " is truncated");
+  m_map = mmap (0, m_mapLength, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  NS_ABORT_MSG_IF (m_map == MAP_FAILED, "Cannot map fading trace " << fileName << ": " << std::strerror (errno));
+  m_gains = reinterpret_cast<const double *> (static_cast<const char *> (m_map) + sizeof (header));
+#else
+  m_parsed.resize (samples);
+  NS_ABORT_MSG_IF (!ifs.read (reinterpret_cast<char *> (&m_parsed[0]), samples * sizeof (double)),
+                   "Binary fading trace " << fileName << " is truncated");
+  m_gains = &m_parsed[0];
+#endif /* HAVE_SYS_MMAN_H */
+  return true;
+}
+
+void
+TraceFadingData::ReadAsciiTrace (std::string fileName, uint8_t rbNum, uint32_t samplesNum,
+                                 std::vector<double> &gains)
+{
+  std::ifstream ifTraceFile;
+  ifTraceFile.open (fileName.c_str (), std::ifstream::in);
+  NS_ABORT_MSG_IF (!ifTraceFile.good (), "Fading trace file " << fileName << " not found");
+  gains.resize ((size_t) rbNum * samplesNum);
+  for (uint32_t i = 0; i < gains.size (); i++)
+    {
+      double sample;
+      ifTraceFile >> sample;
+      gains[i] = std::pow (10., sample / 10);
+    }
+  NS_ABORT_MSG_IF (ifTraceFile.fail (), "Fading trace file " << fileName << " is shorter than "
+                   << (uint32_t) rbNum << " RBs of " << samplesNum << " samples");
+}
 
 
 TraceFadingLossModel::TraceFadingLossModel ()
-  : m_streamsAssigned (false)
 {
   NS_LOG_FUNCTION (this);
   SetNext (NULL);
+  m_startVariable = CreateObject<UniformRandomVariable> ();
 }
 
 
 TraceFadingLossModel::~TraceFadingLossModel ()
 {
-  m_fadingTrace.clear ();
-  m_windowOffsetsMap.clear ();
-  m_startVariableMap.clear ();
+  m_fadingTrace = 0;
+  m_channelRealizations.clear ();
+  m_windowOffsets.clear ();
 }
 
 
@@ -62,7 +273,8 @@ TraceFadingLossModel::GetTypeId (void)
     .SetGroupName("Lte")
     .AddConstructor<TraceFadingLossModel> ()
     .AddAttribute ("TraceFilename",
-                   "Name of file to load a trace from.",
+                   "Name of file to load a trace from, either in ASCII format or "
+                   "converted with TraceFadingLossModel::ConvertTraceToBinary.",
                    StringValue (""),
                    MakeStringAccessor (&TraceFadingLossModel::SetTraceFileName),
                    MakeStringChecker ())
@@ -87,7 +299,7 @@ TraceFadingLossModel::GetTypeId (void)
                    MakeUintegerAccessor (&TraceFadingLossModel::m_rbNum),
                    MakeUintegerChecker<uint8_t> ())
     .AddAttribute ("RngStreamSetSize",
-                    "The number of RNG streams reserved for the fading model. The maximum number of streams that are needed for an LTE FDD scenario is 2 * numUEs * numeNBs.",
+                    "The number of RNG streams reserved for the fading model. All the channel realizations now draw their offsets from the first stream of the set; the whole set is still reserved so that the streams assigned to the other models do not change.",
                     UintegerValue (200000),
                    MakeUintegerAccessor (&TraceFadingLossModel::m_streamSetSize),
                    MakeUintegerChecker<uint64_t> ())
@@ -120,30 +332,30 @@ void
 TraceFadingLossModel::LoadTrace ()
 {
   NS_LOG_FUNCTION (this << "Loading Fading Trace " << m_traceFile);
-  std::ifstream ifTraceFile;
-  ifTraceFile.open (m_traceFile.c_str (), std::ifstream::in);
-  m_fadingTrace.clear ();
-  if (!ifTraceFile.good ())
-    {
-      NS_LOG_INFO (this << " File: " << m_traceFile);
-      NS_ASSERT_MSG(ifTraceFile.good (), " Fading trace file not found");
-    }
-
-//   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
-//   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-  for (uint32_t i = 0; i < m_rbNum; i++)
-    {
-      FadingTraceSample rbTimeFadingTrace;
-      for (uint32_t j = 0; j < m_samplesNum; j++)
-        {
-          double sample;
-          ifTraceFile >> sample;
-          rbTimeFadingTrace.push_back (sample);
-        }
-      m_fadingTrace.push_back (rbTimeFadingTrace);
-    }
+  m_fadingTrace = TraceFadingData::Get (m_traceFile, m_rbNum, m_samplesNum);
   m_timeGranularity = m_traceLength.GetMilliSeconds () / m_samplesNum;
   m_lastWindowUpdate = Simulator::Now ();
+  m_startVariable->SetAttribute ("Min", DoubleValue (1.0));
+  m_startVariable->SetAttribute ("Max", DoubleValue ((m_traceLength.GetSeconds () - m_windowSize.GetSeconds ()) * 1000.0));
+}
+
+void
+TraceFadingLossModel::ConvertTraceToBinary (std::string asciiFile, std::string binaryFile,
+                                            uint8_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (asciiFile << binaryFile << (uint32_t) rbNum << samplesNum);
+  std::vector<double> gains;
+  TraceFadingData::ReadAsciiTrace (asciiFile, rbNum, samplesNum, gains);
+
+  BinaryTraceHeader header;
+  std::memcpy (header.magic, g_binaryTraceMagic, sizeof (g_binaryTraceMagic));
+  header.rbNum = rbNum;
+  header.samplesNum = samplesNum;
+  std::ofstream ofTraceFile (binaryFile.c_str (), std::ofstream::out | std::ofstream::binary);
+  NS_ABORT_MSG_IF (!ofTraceFile.good (), "Cannot open " << binaryFile);
+  ofTraceFile.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  ofTraceFile.write (reinterpret_cast<const char *> (&gains[0]), gains.size () * sizeof (double));
+  NS_ABORT_MSG_IF (!ofTraceFile.good (), "Cannot write " << binaryFile);
 }
 
 
@@ -155,43 +367,29 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
 {
   NS_LOG_FUNCTION (this << *txPsd << a << b);
   
-  std::map <ChannelRealizationId_t, int >::iterator itOff;
   ChannelRealizationId_t mobilityPair = std::make_pair (a,b);
-  itOff = m_windowOffsetsMap.find (mobilityPair);
-  if (itOff!=m_windowOffsetsMap.end ())
+  std::map <ChannelRealizationId_t, uint32_t>::iterator itOff = m_channelRealizations.find (mobilityPair);
+  if (itOff != m_channelRealizations.end ())
     {
       if (Simulator::Now ().GetSeconds () >= m_lastWindowUpdate.GetSeconds () + m_windowSize.GetSeconds ())
         {
           // update all the offsets
           NS_LOG_INFO ("Fading Windows Updated");
-          std::map <ChannelRealizationId_t, int >::iterator itOff2;
-          for (itOff2 = m_windowOffsetsMap.begin (); itOff2 != m_windowOffsetsMap.end (); itOff2++)
+          for (std::vector<int>::iterator it = m_windowOffsets.begin (); it != m_windowOffsets.end (); ++it)
             {
-              std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> >::iterator itVar;
-              itVar = m_startVariableMap.find ((*itOff2).first);
-              (*itOff2).second = (*itVar).second->GetValue ();
+              *it = m_startVariable->GetValue ();
             }
           m_lastWindowUpdate = Simulator::Now ();
         }
     }
   else
     {
-      NS_LOG_LOGIC (this << "insert new channel realization, m_windowOffsetMap.size () = " << m_windowOffsetsMap.size ());
-      Ptr<UniformRandomVariable> startV = CreateObject<UniformRandomVariable> ();
-      startV->SetAttribute ("Min", DoubleValue (1.0));
-      startV->SetAttribute ("Max", DoubleValue ((m_traceLength.GetSeconds () - m_windowSize.GetSeconds ()) * 1000.0));
-      if (m_streamsAssigned)
-        {
-          NS_ASSERT_MSG (m_currentStream <= m_lastStream, "not enough streams, consider increasing the StreamSetSize attribute");
-          startV->SetStream (m_currentStream);
-          m_currentStream += 1;
-        }
-      ChannelRealizationId_t mobilityPair = std::make_pair (a,b);
-      m_startVariableMap.insert (std::pair<ChannelRealizationId_t,Ptr<UniformRandomVariable> > (mobilityPair, startV));
-      m_windowOffsetsMap.insert (std::pair<ChannelRealizationId_t,int> (mobilityPair, startV->GetValue ()));
+      NS_LOG_LOGIC (this << "insert new channel realization, m_windowOffsets.size () = " << m_windowOffsets.size ());
+      itOff = m_channelRealizations.insert (std::make_pair (mobilityPair, (uint32_t) m_windowOffsets.size ())).first;
+      m_windowOffsets.push_back (m_startVariable->GetValue ());
     }
+  int offset = m_windowOffsets[itOff->second];
 
-  
   Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue> (txPsd);
   Values::iterator vit = rxPsd->ValuesBegin ();
   
@@ -201,27 +399,21 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
   //double speed = std::sqrt (std::pow (aSpeedVector.x-bSpeedVector.x,2) + std::pow (aSpeedVector.y-bSpeedVector.y,2));
 
   NS_LOG_LOGIC (this << *rxPsd);
-  NS_ASSERT (!m_fadingTrace.empty ());
+  NS_ASSERT (m_fadingTrace != 0);
   int now_ms = static_cast<int> (Simulator::Now ().GetMilliSeconds () * m_timeGranularity);
   int lastUpdate_ms = static_cast<int> (m_lastWindowUpdate.GetMilliSeconds () * m_timeGranularity);
-  int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
+  int index = (offset + now_ms - lastUpdate_ms) % m_samplesNum;
   int subChannel = 0;
   while (vit != rxPsd->ValuesEnd ())
     {
-      NS_ASSERT (subChannel < 100);
+      NS_ASSERT (subChannel < m_rbNum);
+      // only the RBs actually used by the transmission need to be faded
       if (*vit != 0.)
         {
-          double fading = m_fadingTrace.at (subChannel).at (index);
-          NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << (*itOff).second << " id " << index << " fading " << fading);
-          double power = *vit; // in Watt/Hz
-          power = 10 * std::log10 (180000 * power); // in dB
-
-          NS_LOG_LOGIC (this << subChannel << *vit  << power << fading);
-
-          *vit = std::pow (10., ((power + fading) / 10)) / 180000; // in Watt
-
+          double fading = m_fadingTrace->GetGain (subChannel, index);
+          NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << offset << " id " << index << " fading " << fading);
+          *vit *= fading; // in Watt/Hz
           NS_LOG_LOGIC (this << subChannel << *vit);
-
         }
 
       ++vit;
@@ -237,20 +429,7 @@ int64_t
 TraceFadingLossModel::AssignStreams (int64_t stream)
 {
   NS_LOG_FUNCTION (this << stream);
-  NS_ASSERT (m_streamsAssigned == false);  
-  m_streamsAssigned = true;
-  m_currentStream = stream;
-  m_lastStream = stream + m_streamSetSize - 1;
-  std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> >::iterator itVar;
-  itVar = m_startVariableMap.begin ();
-  // the following loop is for eventually pre-existing ChannelRealization instances
-  // note that more instances are expected to be created at run time
-  while (itVar!=m_startVariableMap.end ())
-    {
-      NS_ASSERT_MSG (m_currentStream <= m_lastStream, "not enough streams, consider increasing the StreamSetSize attribute");
-      (*itVar).second->SetStream (m_currentStream);
-      m_currentStream += 1;
-    }
+  m_startVariable->SetStream (stream);
   return m_streamSetSize;
 }
 
@@ -27,6 +27,7 @@
 #include <ns3/object.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <map>
+#include <vector>
 #include "ns3/random-variable-stream.h"
 #include <ns3/nstime.h>
 
@@ -34,12 +35,20 @@ namespace ns3 {
 
 
 class MobilityModel;
+class TraceFadingData;
 
 
 /**
  * \ingroup lte
  *
  * \brief fading loss model based on precalculated fading traces
+ *
+ * The samples of a trace are loaded once per process and shared by all
+ * the instances using the same file. A trace previously converted with
+ * ConvertTraceToBinary () is mapped read-only in memory instead of being
+ * parsed, so that its pages are also shared by all the processes using it
+ * (e.g., the ranks of a distributed simulation). Where memory mapping is
+ * not available, the binary samples are read into the shared buffer.
  */
 class TraceFadingLossModel : public SpectrumPropagationLossModel
 {
@@ -66,6 +75,21 @@ public:
   */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * Convert an ASCII fading trace to the binary format that
+   * TraceFadingLossModel maps in memory. The binary file starts with a
+   * 16 byte header (the magic string "ns3fad01", then the number of RBs
+   * and the number of samples as native-endian uint32_t) followed by the
+   * linear power gains as native-endian doubles, one row of samples per RB.
+   *
+   * \param asciiFile the name of the ASCII trace (values in dB)
+   * \param binaryFile the name of the binary trace to be written
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   */
+  static void ConvertTraceToBinary (std::string asciiFile, std::string binaryFile,
+                                    uint8_t rbNum, uint32_t samplesNum);
+
   
 private:
   /**
@@ -93,26 +117,23 @@ private:
   
   void LoadTrace ();
 
-
-   
-  mutable std::map <ChannelRealizationId_t, int > m_windowOffsetsMap;
-  
-  mutable std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> > m_startVariableMap;
-  
-  /**
-   * Vector with fading samples in time domain (for a fixed RB)
-   */
-  typedef std::vector<double> FadingTraceSample;
   /**
-   * Vector collecting the time fading traces in the frequency domain (per RB)
+   * Index of each channel realization in m_windowOffsets. Indices follow
+   * the order of creation, which is also the order in which the offsets
+   * are redrawn at each window update.
    */
-  typedef std::vector<FadingTraceSample> FadingTrace;
+  mutable std::map <ChannelRealizationId_t, uint32_t> m_channelRealizations;
 
+  /// Start offset in the trace (in ms) of each channel realization.
+  mutable std::vector<int> m_windowOffsets;
 
+  /// Draws the start offsets of all the channel realizations.
+  Ptr<UniformRandomVariable> m_startVariable;
   
   std::string m_traceFile;
   
-  FadingTrace m_fadingTrace;
+  /// Samples of the trace as linear power gains, shared with other instances.
+  Ptr<TraceFadingData> m_fadingTrace;
 
   
   Time m_traceLength;
@@ -121,10 +142,7 @@ private:
   uint8_t m_rbNum;
   mutable Time m_lastWindowUpdate;
   uint8_t m_timeGranularity;
-  mutable uint64_t m_currentStream;
-  mutable uint64_t m_lastStream;
   uint64_t m_streamSetSize;
-  mutable bool m_streamsAssigned;
   
 };
 
@@ -0,0 +1,245 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-mi-error-model.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestMiErrorModel");
+
+/**
+ * Reference outputs of LteMiErrorModel for a TB, recorded with the
+ * original implementation based on linear searches.
+ */
+struct TbReference
+{
+  double sinrDb;     ///< average SINR of the profile, in dB
+  uint8_t mcs;       ///< MCS of the TB
+  uint16_t size;     ///< size of the TB, in bytes
+  uint8_t nRetx;     ///< number of past transmissions
+  double tbler;      ///< expected TB error rate
+  double mi;         ///< expected MI of the TB
+};
+
+/**
+ * The SINR of RB i is sinrDb + (i mod 5) - 2 dB over 25 RBs, and the TB
+ * is allocated on the RBs with (i mod 3) != 2. Each past transmission of
+ * a retx has an MI of 0.6 and twice as many code bits as information bits.
+ */
+static const TbReference g_tbReferences[] = {
+  { -8.0, 0, 40, 0, 0.91498674050642059, 0.11352294117647059 },
+  { -7.5, 0, 400, 0, 0.10191403426168422, 0.12618288235294117 },
+  { -7.5, 0, 1500, 0, 0.090398719256469473, 0.12618288235294117 },
+  { -4.0, 4, 40, 0, 0.85105009193525771, 0.25196811764705884 },
+  { -4.0, 4, 400, 0, 0.87614602006576137, 0.25196811764705884 },
+  { 1.0, 9, 40, 0, 0.9036857252373135, 0.57005700000000004 },
+  { -10.0, 9, 40, 1, 0.42078521222658199, 0.074467941176470598 },
+  { 1.0, 9, 400, 0, 0.94079388968765509, 0.57005700000000004 },
+  { 1.5, 9, 1500, 0, 0.059436276193260085, 0.60810947058823539 },
+  { 3.0, 10, 40, 0, 0.6894665938569623, 0.36831435294117643 },
+  { -10.0, 10, 40, 1, 0.36800985464281222, 0.033200529411764712 },
+  { 3.0, 10, 400, 0, 0.70969283525667115, 0.36831435294117643 },
+  { -10.0, 10, 400, 1, 0.058375672028797843, 0.033200529411764712 },
+  { 3.5, 10, 1500, 0, 0.37694075182632325, 0.39379805882352942 },
+  { -9.0, 10, 1500, 1, 0.93598378751234856, 0.040626882352941172 },
+  { 5.0, 13, 40, 0, 0.83363403260341473, 0.47473729411764709 },
+  { 5.0, 13, 400, 0, 0.84517377220858592, 0.47473729411764709 },
+  { 5.5, 13, 1500, 0, 0.073825537760005777, 0.50311094117647059 },
+  { 9.5, 17, 40, 0, 0.68591880058997545, 0.49857552941176475 },
+  { -10.0, 17, 40, 1, 0.27413679666854129, 0.036455000000000008 },
+  { 9.5, 17, 400, 0, 0.57112116867110208, 0.49857552941176475 },
+  { 9.5, 17, 1500, 0, 0.92042885560580046, 0.49857552941176475 },
+  { -10.0, 17, 1500, 1, 0.077464905511556381, 0.036455000000000008 },
+  { 13.5, 22, 40, 0, 0.87197038936807214, 0.68343423529411762 },
+  { 13.5, 22, 400, 0, 0.91421875558961174, 0.68343423529411762 },
+  { 14.0, 22, 1500, 0, 0.28668311626551946, 0.70732252941176466 },
+  { 19.5, 28, 40, 0, 0.64398642962766273, 0.93376235294117638 },
+  { 19.5, 28, 400, 0, 0.64398642962766273, 0.93376235294117638 },
+  { 19.5, 28, 1500, 0, 0.75767396224806838, 0.93376235294117638 }
+};
+
+/**
+ * Reference PCFICH+PDCCH error rates over the same SINR profile, recorded
+ * with the original implementation.
+ */
+struct PdcchReference
+{
+  double sinrDb;     ///< average SINR of the profile, in dB
+  double errorRate;  ///< expected error rate
+};
+
+/// The PCFICH+PDCCH references.
+static const PdcchReference g_pdcchReferences[] = {
+  { -12.0, 0.92260200000000003 },
+  { -10.5, 0.92260200000000003 },
+  { -9.0, 0.61942900000000001 },
+  { -7.5, 0.373114 },
+  { -6.0, 0.15978700000000001 },
+  { -4.5, 0.054228499999999999 },
+  { -3.0, 0.0144636 },
+  { -1.5, 0.0026238500000000001 },
+  { 0.0, 0 },
+  { 6.0, 0 }
+};
+
+/// Number of RBs of the SINR profile.
+static const uint32_t NUM_RB = 25;
+
+/**
+ * \param sinrDb the average SINR in dB
+ * \return the SINR profile of the references
+ */
+static SpectrumValue
+CreateSinr (double sinrDb)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < NUM_RB; ++i)
+    {
+      freqs.push_back (2.0e9 + i * 180000.0);
+    }
+  SpectrumValue sinr (Create<SpectrumModel> (freqs));
+  for (uint32_t i = 0; i < NUM_RB; ++i)
+    {
+      sinr[i] = std::pow (10, (sinrDb + (i % 5) - 2) / 10);
+    }
+  return sinr;
+}
+
+/**
+ * Check the TB error rate and MI computed by LteMiErrorModel against
+ * a reference.
+ */
+class LteMiErrorModelTbTestCase : public TestCase
+{
+public:
+  /// \param ref the reference to be checked
+  LteMiErrorModelTbTestCase (const TbReference &ref);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param ref the reference
+   * \return the name of the test
+   */
+  static std::string BuildNameString (const TbReference &ref);
+
+  TbReference m_ref; ///< the reference to be checked
+};
+
+std::string
+LteMiErrorModelTbTestCase::BuildNameString (const TbReference &ref)
+{
+  std::ostringstream oss;
+  oss << "sinr " << ref.sinrDb << " dB, mcs " << (uint16_t) ref.mcs
+      << ", size " << ref.size << ", retx " << (uint16_t) ref.nRetx;
+  return oss.str ();
+}
+
+LteMiErrorModelTbTestCase::LteMiErrorModelTbTestCase (const TbReference &ref)
+  : TestCase (BuildNameString (ref)),
+    m_ref (ref)
+{
+}
+
+void
+LteMiErrorModelTbTestCase::DoRun (void)
+{
+  SpectrumValue sinr = CreateSinr (m_ref.sinrDb);
+  std::vector<int> map;
+  for (uint32_t i = 0; i < NUM_RB; ++i)
+    {
+      if (i % 3 != 2)
+        {
+          map.push_back (i);
+        }
+    }
+  HarqProcessInfoList_t history;
+  for (uint32_t i = 0; i < m_ref.nRetx; ++i)
+    {
+      HarqProcessInfoElement_t el;
+      el.m_mi = 0.6;
+      el.m_rv = 0;
+      el.m_infoBits = m_ref.size * 8;
+      el.m_codeBits = m_ref.size * 8 * 2;
+      history.push_back (el);
+    }
+  TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, m_ref.size, m_ref.mcs, history);
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.tbler, m_ref.tbler, 1e-9, "wrong TB error rate");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.mi, m_ref.mi, 1e-12, "wrong MI");
+
+  // same result when the MI is computed beforehand, as LteAmc does
+  double mi = LteMiErrorModel::Mib (sinr, map, m_ref.mcs);
+  stats = LteMiErrorModel::GetTbDecodificationStats (mi, m_ref.size, m_ref.mcs, history);
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.tbler, m_ref.tbler, 1e-9, "wrong TB error rate with precomputed MI");
+}
+
+/**
+ * Check the PCFICH+PDCCH error rate computed by LteMiErrorModel against
+ * the references.
+ */
+class LteMiErrorModelPdcchTestCase : public TestCase
+{
+public:
+  LteMiErrorModelPdcchTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiErrorModelPdcchTestCase::LteMiErrorModelPdcchTestCase ()
+  : TestCase ("PCFICH+PDCCH error rate")
+{
+}
+
+void
+LteMiErrorModelPdcchTestCase::DoRun (void)
+{
+  for (uint32_t i = 0; i < sizeof (g_pdcchReferences) / sizeof (PdcchReference); ++i)
+    {
+      double errorRate = LteMiErrorModel::GetPcfichPdcchError (CreateSinr (g_pdcchReferences[i].sinrDb));
+      NS_TEST_ASSERT_MSG_EQ_TOL (errorRate, g_pdcchReferences[i].errorRate, 1e-12,
+                                 "wrong error rate at " << g_pdcchReferences[i].sinrDb << " dB");
+    }
+}
+
+
+/**
+ * Regression tests of LteMiErrorModel.
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  for (uint32_t i = 0; i < sizeof (g_tbReferences) / sizeof (TbReference); ++i)
+    {
+      AddTestCase (new LteMiErrorModelTbTestCase (g_tbReferences[i]), TestCase::QUICK);
+    }
+  AddTestCase (new LteMiErrorModelPdcchTestCase (), TestCase::QUICK);
+}
+
+static LteMiErrorModelTestSuite lteMiErrorModelTestSuite;
@@ -0,0 +1,198 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/buildings-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-enb-phy.h"
+#include "ns3/lte-spectrum-phy.h"
+#include "ns3/radio-environment-map-helper.h"
+
+#include <fstream>
+#include <sstream>
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRadioEnvironmentMap");
+
+/**
+ * Generate the REM of a single eNB with a buildings propagation loss
+ * model with shadowing, in the default and in the offline mode, and a
+ * REM without shadowing. The map is noise-limited, so the difference
+ * between a map with shadowing and the map without shadowing is the
+ * shadowing drawn for each point. The test checks that both modes draw
+ * it independently for every point, with the same distribution.
+ */
+class LteRadioEnvironmentMapShadowingTestCase : public TestCase
+{
+public:
+  LteRadioEnvironmentMapShadowingTestCase ();
+  virtual ~LteRadioEnvironmentMapShadowingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Generate a REM.
+   * \param offline the value of the Offline attribute
+   * \param shadowSigma the standard deviation of the shadowing (dB)
+   * \return the SINR (dB) of every point of the map
+   */
+  std::vector<double> GenerateRem (bool offline, double shadowSigma);
+
+  /**
+   * \param sinr the SINR (dB) of every point of a map with shadowing
+   * \param reference the SINR (dB) of every point of the map without shadowing
+   * \param mean the mean of the shadowing
+   * \param stdDev the standard deviation of the shadowing
+   */
+  static void GetShadowing (const std::vector<double> &sinr, const std::vector<double> &reference,
+                            double &mean, double &stdDev);
+};
+
+LteRadioEnvironmentMapShadowingTestCase::LteRadioEnvironmentMapShadowingTestCase ()
+  : TestCase ("Check the shadowing of the default and offline REM")
+{
+}
+
+LteRadioEnvironmentMapShadowingTestCase::~LteRadioEnvironmentMapShadowingTestCase ()
+{
+}
+
+std::vector<double>
+LteRadioEnvironmentMapShadowingTestCase::GenerateRem (bool offline, double shadowSigma)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::OhBuildingsPropagationLossModel"));
+  lteHelper->SetPathlossModelAttribute ("ShadowSigmaOutdoor", DoubleValue (shadowSigma));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  BuildingsHelper::Install (enbNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  BuildingsHelper::MakeMobilityModelConsistent ();
+  Ptr<SpectrumChannel> dlChannel = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ()->GetPhy ()->GetDownlinkSpectrumPhy ()->GetChannel ();
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << dlChannel->GetId ();
+
+  std::string filename = CreateTempDirFilename (offline ? "rem-offline.out" : "rem.out");
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue (channelPath.str ()));
+  remHelper->SetAttribute ("OutputFile", StringValue (filename));
+  remHelper->SetAttribute ("XMin", DoubleValue (100.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (1000.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (10));
+  remHelper->SetAttribute ("YMin", DoubleValue (100.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (1000.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (10));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("Offline", BooleanValue (offline));
+  remHelper->Install ();
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<double> sinr;
+  std::ifstream file (filename.c_str ());
+  double x, y, z, value;
+  while (file >> x >> y >> z >> value)
+    {
+      // a point without any eNB is not counted
+      if (value > 0)
+        {
+          sinr.push_back (10 * std::log10 (value));
+        }
+    }
+  return sinr;
+}
+
+void
+LteRadioEnvironmentMapShadowingTestCase::GetShadowing (const std::vector<double> &sinr,
+                                                       const std::vector<double> &reference,
+                                                       double &mean, double &stdDev)
+{
+  double sum = 0;
+  double sumSquares = 0;
+  for (uint32_t i = 0; i < sinr.size (); ++i)
+    {
+      double shadowing = reference[i] - sinr[i];
+      sum += shadowing;
+      sumSquares += shadowing * shadowing;
+    }
+  mean = sum / sinr.size ();
+  stdDev = std::sqrt (sumSquares / sinr.size () - mean * mean);
+}
+
+void
+LteRadioEnvironmentMapShadowingTestCase::DoRun (void)
+{
+  const double sigma = 8.0;
+  std::vector<double> reference = GenerateRem (true, 0.0);
+  std::vector<double> online = GenerateRem (false, sigma);
+  std::vector<double> offline = GenerateRem (true, sigma);
+  NS_TEST_ASSERT_MSG_EQ (reference.size (), 100, "wrong number of points in the REM");
+  NS_TEST_ASSERT_MSG_EQ (online.size (), reference.size (), "wrong number of points in the default REM");
+  NS_TEST_ASSERT_MSG_EQ (offline.size (), reference.size (), "wrong number of points in the offline REM");
+
+  double onlineMean, onlineStdDev;
+  GetShadowing (online, reference, onlineMean, onlineStdDev);
+  double offlineMean, offlineStdDev;
+  GetShadowing (offline, reference, offlineMean, offlineStdDev);
+  NS_LOG_INFO ("default mode: mean " << onlineMean << " std dev " << onlineStdDev
+               << ", offline mode: mean " << offlineMean << " std dev " << offlineStdDev);
+
+  // a shadowing drawn once for the whole map would have no deviation
+  NS_TEST_EXPECT_MSG_EQ_TOL (onlineStdDev, sigma, 0.3 * sigma, "wrong shadowing deviation in the default REM");
+  NS_TEST_EXPECT_MSG_EQ_TOL (offlineStdDev, sigma, 0.3 * sigma, "wrong shadowing deviation in the offline REM");
+  NS_TEST_EXPECT_MSG_EQ_TOL (offlineStdDev, onlineStdDev, 0.3 * sigma, "different shadowing deviation in the two modes");
+  NS_TEST_EXPECT_MSG_EQ_TOL (offlineMean, onlineMean, 0.5 * sigma, "different shadowing mean in the two modes");
+}
+
+
+/**
+ * Test suite for the RadioEnvironmentMapHelper.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRadioEnvironmentMapShadowingTestCase, TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite lteRadioEnvironmentMapTestSuite;
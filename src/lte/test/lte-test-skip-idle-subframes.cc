@@ -0,0 +1,172 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestSkipIdleSubframes");
+
+/**
+ * A UE attaches to one of several idle cells at a given time. The test
+ * checks that the connection is established at the same time and with
+ * the same RNTI whether the idle cells skip their subframes or not, i.e.,
+ * that a cell resuming its subframes keeps the frame and subframe numbers
+ * that the random access procedure relies on.
+ */
+class LteSkipIdleSubframesTestCase : public TestCase
+{
+public:
+  /// \param attachTime the time at which the UE attaches
+  LteSkipIdleSubframesTestCase (Time attachTime);
+  virtual ~LteSkipIdleSubframesTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param attachTime the time at which the UE attaches
+   * \return the name of the test
+   */
+  static std::string BuildNameString (Time attachTime);
+
+  /**
+   * Run the scenario.
+   * \param skipIdleSubframes the value of LteEnbPhy::SkipIdleSubframes
+   */
+  void RunScenario (bool skipIdleSubframes);
+
+  /**
+   * Connection established trace sink.
+   * \param context the context
+   * \param imsi the IMSI
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   */
+  void ConnectionEstablished (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+
+  Time m_attachTime;       ///< time at which the UE attaches
+  Time m_connectionTime;   ///< time at which the UE is connected
+  uint16_t m_rnti;         ///< RNTI of the connected UE
+};
+
+std::string
+LteSkipIdleSubframesTestCase::BuildNameString (Time attachTime)
+{
+  std::ostringstream oss;
+  oss << "attach at " << attachTime.GetMicroSeconds () << " us";
+  return oss.str ();
+}
+
+LteSkipIdleSubframesTestCase::LteSkipIdleSubframesTestCase (Time attachTime)
+  : TestCase (BuildNameString (attachTime)),
+    m_attachTime (attachTime),
+    m_rnti (0)
+{
+}
+
+LteSkipIdleSubframesTestCase::~LteSkipIdleSubframesTestCase ()
+{
+}
+
+void
+LteSkipIdleSubframesTestCase::ConnectionEstablished (std::string context, uint64_t imsi,
+                                                     uint16_t cellId, uint16_t rnti)
+{
+  m_connectionTime = Simulator::Now ();
+  m_rnti = rnti;
+}
+
+void
+LteSkipIdleSubframesTestCase::RunScenario (bool skipIdleSubframes)
+{
+  Config::SetDefault ("ns3::LteEnbPhy::SkipIdleSubframes", BooleanValue (skipIdleSubframes));
+  // avoid PDCCH losses, whose random draws depend on the number of subframes
+  Config::SetDefault ("ns3::LteSpectrumPhy::CtrlErrorModelEnabled", BooleanValue (false));
+  m_connectionTime = Time ();
+  m_rnti = 0;
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (3);
+  ueNodes.Create (1);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (500.0),
+                                 "GridWidth", UintegerValue (3));
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  void (LteHelper::*attach) (Ptr<NetDevice>, Ptr<NetDevice>) = &LteHelper::Attach;
+  Simulator::Schedule (m_attachTime, attach, lteHelper, ueDevs.Get (0), enbDevs.Get (0));
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionEstablished",
+                   MakeCallback (&LteSkipIdleSubframesTestCase::ConnectionEstablished, this));
+
+  Simulator::Stop (m_attachTime + Seconds (0.3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+LteSkipIdleSubframesTestCase::DoRun (void)
+{
+  RunScenario (false);
+  Time connectionTime = m_connectionTime;
+  uint16_t rnti = m_rnti;
+  NS_TEST_ASSERT_MSG_NE (rnti, 0, "UE not connected without skipping idle subframes");
+
+  RunScenario (true);
+  NS_TEST_ASSERT_MSG_EQ (m_rnti, rnti, "UE connected with a different RNTI");
+  NS_TEST_ASSERT_MSG_EQ (m_connectionTime, connectionTime, "UE connected at a different time");
+}
+
+
+/**
+ * Test suite for the SkipIdleSubframes mode of LteEnbPhy.
+ */
+class LteSkipIdleSubframesTestSuite : public TestSuite
+{
+public:
+  LteSkipIdleSubframesTestSuite ();
+};
+
+LteSkipIdleSubframesTestSuite::LteSkipIdleSubframesTestSuite ()
+  : TestSuite ("lte-skip-idle-subframes", SYSTEM)
+{
+  // attach in a skipped subframe, at a frame boundary and in a subframe
+  // carrying the PSS
+  AddTestCase (new LteSkipIdleSubframesTestCase (MicroSeconds (333300)), TestCase::QUICK);
+  AddTestCase (new LteSkipIdleSubframesTestCase (MilliSeconds (500)), TestCase::QUICK);
+  AddTestCase (new LteSkipIdleSubframesTestCase (MicroSeconds (775100)), TestCase::QUICK);
+}
+
+static LteSkipIdleSubframesTestSuite lteSkipIdleSubframesTestSuite;
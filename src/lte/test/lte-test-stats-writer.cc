@@ -0,0 +1,233 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-stats-writer.h"
+#include "ns3/mac-stats-calculator.h"
+#include "ns3/phy-stats-calculator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestStatsWriter");
+
+/**
+ * \param filename the name of a file
+ * \return the content of the file
+ */
+static std::string
+ReadFile (std::string filename)
+{
+  std::ifstream ifs (filename.c_str (), std::ifstream::in | std::ifstream::binary);
+  std::ostringstream oss;
+  oss << ifs.rdbuf ();
+  return oss.str ();
+}
+
+/**
+ * \param filename the name of a binary stats file
+ * \return its text format
+ */
+static std::string
+ConvertFile (std::string filename)
+{
+  std::ostringstream oss;
+  LteStatsWriter::ConvertToText (filename, oss);
+  return oss.str ();
+}
+
+/**
+ * Write the same records, spanning several blocks, in the text and in the
+ * binary format, and check that the converted binary file is identical to
+ * the text file.
+ */
+class LteStatsWriterTestCase : public TestCase
+{
+public:
+  LteStatsWriterTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param filename the name of the file
+   * \param binary whether to use the binary format
+   */
+  void WriteRecords (std::string filename, bool binary);
+};
+
+LteStatsWriterTestCase::LteStatsWriterTestCase ()
+  : TestCase ("Binary file converted to the text format")
+{
+}
+
+void
+LteStatsWriterTestCase::WriteRecords (std::string filename, bool binary)
+{
+  LteStatsWriter writer;
+  writer.SetHeader ("% time\tu8\tu16\tu32\tu64\ti64\tlist\tlast");
+  writer.AddColumn (LteStatsWriter::DOUBLE);
+  writer.AddColumn (LteStatsWriter::UINT8);
+  writer.AddColumn (LteStatsWriter::UINT16);
+  writer.AddColumn (LteStatsWriter::UINT32);
+  writer.AddColumn (LteStatsWriter::UINT64);
+  writer.AddColumn (LteStatsWriter::INT64);
+  writer.AddColumn (LteStatsWriter::DOUBLE_LIST, ' ');
+  writer.AddColumn (LteStatsWriter::DOUBLE_LIST, '\t');
+  NS_TEST_ASSERT_MSG_EQ (writer.Open (filename, binary), true, "cannot open " << filename);
+
+  std::vector<double> list;
+  for (uint32_t i = 0; i < 40000; ++i)
+    {
+      writer.AddDouble (i / 1000.0 + 1e-7);
+      writer.AddUint (i % 256);
+      writer.AddUint (i % 65536);
+      writer.AddUint (i * 100003);
+      writer.AddUint (i * 0x100000001ULL);
+      writer.AddInt (-static_cast<int64_t> (i) * 3);
+      list.assign (i % 5, -1.5 * i);
+      writer.AddDoubles (list.begin (), list.end ());
+      list.assign (i % 3, 1e-9 * i);
+      writer.AddDoubles (list.begin (), list.end ());
+    }
+  writer.Close ();
+}
+
+void
+LteStatsWriterTestCase::DoRun (void)
+{
+  std::string textFilename = CreateTempDirFilename ("lte-stats.txt");
+  std::string binaryFilename = CreateTempDirFilename ("lte-stats.bin");
+  WriteRecords (textFilename, false);
+  WriteRecords (binaryFilename, true);
+
+  std::string text = ReadFile (textFilename);
+  NS_TEST_ASSERT_MSG_GT (text.size (), 2000000, "too few records");
+  NS_TEST_ASSERT_MSG_LT (ReadFile (binaryFilename).size (), text.size (), "binary file larger than the text file");
+  NS_TEST_ASSERT_MSG_EQ ((ConvertFile (binaryFilename) == text), true, "converted file differs from the text file");
+}
+
+/**
+ * Write the same MAC and PHY statistics in the text and in the binary
+ * format, and check that the converted binary files are identical to the
+ * text files.
+ */
+class LteStatsCalculatorBinaryOutputTestCase : public TestCase
+{
+public:
+  LteStatsCalculatorBinaryOutputTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param macFilename the name of the DL MAC statistics file
+   * \param interferenceFilename the name of the interference statistics file
+   * \param binary whether to use the binary format
+   */
+  void WriteStats (std::string macFilename, std::string interferenceFilename, bool binary);
+
+  /// the calculators, kept alive until the files are checked
+  std::vector<Ptr<LteStatsCalculator> > m_calculators;
+};
+
+LteStatsCalculatorBinaryOutputTestCase::LteStatsCalculatorBinaryOutputTestCase ()
+  : TestCase ("Stats calculators with BinaryOutput")
+{
+}
+
+void
+LteStatsCalculatorBinaryOutputTestCase::WriteStats (std::string macFilename,
+                                                    std::string interferenceFilename,
+                                                    bool binary)
+{
+  Ptr<MacStatsCalculator> macStats = CreateObject<MacStatsCalculator> ();
+  macStats->SetAttribute ("BinaryOutput", BooleanValue (binary));
+  macStats->SetAttribute ("DlOutputFilename", StringValue (macFilename));
+  Ptr<PhyStatsCalculator> phyStats = CreateObject<PhyStatsCalculator> ();
+  phyStats->SetAttribute ("BinaryOutput", BooleanValue (binary));
+  phyStats->SetAttribute ("UlInterferenceFilename", StringValue (interferenceFilename));
+
+  std::vector<double> frequencies;
+  for (uint32_t rb = 0; rb < 6; ++rb)
+    {
+      frequencies.push_back (2.1e9 + rb * 180e3);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      macStats->DlScheduling (1 + i % 3, 1 + i % 10, i / 10, i % 10, 1 + i % 10, i % 29, 100 + i, 0, 0);
+      Ptr<SpectrumValue> interference = Create<SpectrumValue> (model);
+      (*interference) = 1.234e-15 * (i + 1);
+      phyStats->ReportInterference (1 + i % 3, interference);
+    }
+  // the files are complete once the calculators are disposed, even
+  // though they are still referenced
+  macStats->Dispose ();
+  phyStats->Dispose ();
+  m_calculators.push_back (macStats);
+  m_calculators.push_back (phyStats);
+}
+
+void
+LteStatsCalculatorBinaryOutputTestCase::DoRun (void)
+{
+  std::string macText = CreateTempDirFilename ("DlMacStats.txt");
+  std::string macBinary = CreateTempDirFilename ("DlMacStats.bin");
+  std::string interferenceText = CreateTempDirFilename ("UlInterferenceStats.txt");
+  std::string interferenceBinary = CreateTempDirFilename ("UlInterferenceStats.bin");
+  WriteStats (macText, interferenceText, false);
+  WriteStats (macBinary, interferenceBinary, true);
+
+  // a header line and a line per record
+  std::string macContent = ReadFile (macText);
+  std::string interferenceContent = ReadFile (interferenceText);
+  NS_TEST_ASSERT_MSG_EQ (std::count (macContent.begin (), macContent.end (), '\n'), 101,
+                         "MAC statistics file not complete after Dispose");
+  NS_TEST_ASSERT_MSG_EQ (std::count (interferenceContent.begin (), interferenceContent.end (), '\n'), 101,
+                         "interference statistics file not complete after Dispose");
+  NS_TEST_ASSERT_MSG_EQ ((ConvertFile (macBinary) == ReadFile (macText)), true,
+                         "converted MAC statistics differ from the text file");
+  NS_TEST_ASSERT_MSG_EQ ((ConvertFile (interferenceBinary) == ReadFile (interferenceText)), true,
+                         "converted interference statistics differ from the text file");
+  m_calculators.clear ();
+}
+
+
+/**
+ * Test suite for the binary output of the LTE stats calculators.
+ */
+class LteStatsWriterTestSuite : public TestSuite
+{
+public:
+  LteStatsWriterTestSuite ();
+};
+
+LteStatsWriterTestSuite::LteStatsWriterTestSuite ()
+  : TestSuite ("lte-stats-writer", UNIT)
+{
+  AddTestCase (new LteStatsWriterTestCase (), TestCase::QUICK);
+  AddTestCase (new LteStatsCalculatorBinaryOutputTestCase (), TestCase::QUICK);
+}
+
+static LteStatsWriterTestSuite lteStatsWriterTestSuite;
@@ -0,0 +1,151 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/trace-fading-loss-model.h"
+
+#include <fstream>
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestTraceFading");
+
+/**
+ * Check that an ASCII fading trace and its binary conversion give the same
+ * received PSD, that the fading of each RB comes from the same sample of
+ * the trace and that unused RBs are left untouched.
+ */
+class LteTraceFadingTestCase : public TestCase
+{
+public:
+  LteTraceFadingTestCase ();
+  virtual ~LteTraceFadingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param fileName the trace to be used
+   * \return a fading model using the trace
+   */
+  Ptr<TraceFadingLossModel> CreateModel (std::string fileName);
+
+  static const uint8_t RB_NUM = 6;          ///< number of RBs of the trace
+  static const uint32_t SAMPLES_NUM = 1000; ///< number of samples of the trace
+};
+
+LteTraceFadingTestCase::LteTraceFadingTestCase ()
+  : TestCase ("ASCII and binary fading traces")
+{
+}
+
+LteTraceFadingTestCase::~LteTraceFadingTestCase ()
+{
+}
+
+Ptr<TraceFadingLossModel>
+LteTraceFadingTestCase::CreateModel (std::string fileName)
+{
+  Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel> ();
+  model->SetAttribute ("TraceFilename", StringValue (fileName));
+  model->SetAttribute ("TraceLength", TimeValue (Seconds (1.0)));
+  model->SetAttribute ("SamplesNum", UintegerValue (SAMPLES_NUM));
+  model->SetAttribute ("RbNum", UintegerValue (RB_NUM));
+  model->AssignStreams (1);
+  model->Initialize ();
+  return model;
+}
+
+void
+LteTraceFadingTestCase::DoRun (void)
+{
+  // sample j of RB i is -(i + j/100) dB
+  std::string asciiFile = CreateTempDirFilename ("fading-trace.fad");
+  std::string binaryFile = CreateTempDirFilename ("fading-trace.bin");
+  std::ofstream os (asciiFile.c_str ());
+  for (uint32_t i = 0; i < RB_NUM; ++i)
+    {
+      for (uint32_t j = 0; j < SAMPLES_NUM; ++j)
+        {
+          os << -(i + j / 100.0) << " ";
+        }
+      os << std::endl;
+    }
+  os.close ();
+  TraceFadingLossModel::ConvertTraceToBinary (asciiFile, binaryFile, RB_NUM, SAMPLES_NUM);
+
+  Ptr<TraceFadingLossModel> asciiModel = CreateModel (asciiFile);
+  Ptr<TraceFadingLossModel> binaryModel = CreateModel (binaryFile);
+
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < RB_NUM; ++i)
+    {
+      freqs.push_back (2.0e9 + i * 180000.0);
+    }
+  Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (Create<SpectrumModel> (freqs));
+  (*txPsd) = 1.0e-3;
+  (*txPsd)[2] = 0;
+
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<SpectrumValue> asciiRxPsd = asciiModel->CalcRxPowerSpectralDensity (txPsd, a, b);
+  Ptr<SpectrumValue> binaryRxPsd = binaryModel->CalcRxPowerSpectralDensity (txPsd, a, b);
+  Ptr<SpectrumValue> againRxPsd = asciiModel->CalcRxPowerSpectralDensity (txPsd, a, b);
+
+  double rb0Db = 10 * std::log10 ((*asciiRxPsd)[0] / (*txPsd)[0]);
+  NS_TEST_ASSERT_MSG_EQ ((rb0Db <= -0.01 + 1e-9) && (rb0Db >= -5.0 - 1e-9), true,
+                         "fading " << rb0Db << " dB not taken from the first window of the trace");
+  for (uint32_t i = 0; i < RB_NUM; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*asciiRxPsd)[i], (*binaryRxPsd)[i], "ASCII and binary traces differ on RB " << i);
+      NS_TEST_ASSERT_MSG_EQ ((*asciiRxPsd)[i], (*againRxPsd)[i], "channel realization changed on RB " << i);
+      if (i == 2)
+        {
+          NS_TEST_ASSERT_MSG_EQ ((*asciiRxPsd)[i], 0, "unused RB has been faded");
+          continue;
+        }
+      double rbDb = 10 * std::log10 ((*asciiRxPsd)[i] / (*txPsd)[i]);
+      NS_TEST_ASSERT_MSG_EQ_TOL (rbDb, rb0Db - i, 1e-9, "RB " << i << " uses a different sample");
+    }
+
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Test suite for TraceFadingLossModel.
+ */
+class LteTraceFadingTestSuite : public TestSuite
+{
+public:
+  LteTraceFadingTestSuite ();
+};
+
+LteTraceFadingTestSuite::LteTraceFadingTestSuite ()
+  : TestSuite ("lte-trace-fading", UNIT)
+{
+  AddTestCase (new LteTraceFadingTestCase (), TestCase::QUICK);
+}
+
+static LteTraceFadingTestSuite lteTraceFadingTestSuite;
@@ -289,6 +289,7 @@ RrcConnectionRequestTestCase::DoRun (void)
   // Remove header
   RrcConnectionRequestHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionRequestHeader> (destination,"DESTINATION");
@@ -337,6 +338,7 @@ RrcConnectionSetupTestCase::DoRun (void)
   // remove header
   RrcConnectionSetupHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionSetupHeader> (destination,"DESTINATION");
@@ -385,6 +387,7 @@ RrcConnectionSetupCompleteTestCase::DoRun (void)
   // Remove header
   RrcConnectionSetupCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionSetupCompleteHeader> (destination,"DESTINATION");
@@ -432,6 +435,7 @@ RrcConnectionReconfigurationCompleteTestCase::DoRun (void)
   // remove header
   RrcConnectionReconfigurationCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReconfigurationCompleteHeader> (destination,"DESTINATION");
@@ -589,6 +593,7 @@ RrcConnectionReconfigurationTestCase::DoRun (void)
   // remove header
   RrcConnectionReconfigurationHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReconfigurationHeader> (destination,"DESTINATION");
@@ -702,6 +707,7 @@ HandoverPreparationInfoTestCase::DoRun (void)
   // remove header
   HandoverPreparationInfoHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<HandoverPreparationInfoHeader> (destination,"DESTINATION");
@@ -758,6 +764,7 @@ RrcConnectionReestablishmentRequestTestCase::DoRun (void)
   // remove header
   RrcConnectionReestablishmentRequestHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentRequestHeader> (destination,"DESTINATION");
@@ -807,6 +814,7 @@ RrcConnectionReestablishmentTestCase::DoRun (void)
   // remove header
   RrcConnectionReestablishmentHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentHeader> (destination,"DESTINATION");
@@ -854,6 +862,7 @@ RrcConnectionReestablishmentCompleteTestCase::DoRun (void)
   // remove header
   RrcConnectionReestablishmentCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentCompleteHeader> (destination,"DESTINATION");
@@ -900,6 +909,7 @@ RrcConnectionRejectTestCase::DoRun (void)
   // remove header
   RrcConnectionRejectHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionRejectHeader> (destination,"DESTINATION");
@@ -962,6 +972,7 @@ MeasurementReportTestCase::DoRun (void)
   // remove header
   MeasurementReportHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "header not entirely removed");
 
   // Log destination info
   TestUtils::LogPacketInfo<MeasurementReportHeader> (destination,"DESTINATION");
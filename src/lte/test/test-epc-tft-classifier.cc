@@ -91,6 +91,9 @@ EpcTftClassifierTestCase::EpcTftClassifierTestCase (Ptr<EpcTftClassifier> c,
 
   m_udpHeader.SetSourcePort (sp);
   m_udpHeader.SetDestinationPort (dp);  
+
+  m_tcpHeader.SetSourcePort (sp);
+  m_tcpHeader.SetDestinationPort (dp);
 }
 
 EpcTftClassifierTestCase::~EpcTftClassifierTestCase ()
@@ -131,6 +134,14 @@ EpcTftClassifierTestCase::DoRun (void)
   NS_LOG_LOGIC (this << *udpPacket);
   uint32_t obtainedTftId = m_c ->Classify (udpPacket, m_d);
   NS_TEST_ASSERT_MSG_EQ (obtainedTftId, m_tftId, "bad classification of UDP packet");
+
+  Ptr<Packet> tcpPacket = Create<Packet> ();
+  m_ipHeader.SetProtocol (TcpL4Protocol::PROT_NUMBER);
+  tcpPacket->AddHeader (m_tcpHeader);
+  tcpPacket->AddHeader (m_ipHeader);
+  NS_LOG_LOGIC (this << *tcpPacket);
+  obtainedTftId = m_c ->Classify (tcpPacket, m_d);
+  NS_TEST_ASSERT_MSG_EQ (obtainedTftId, m_tftId, "bad classification of TCP packet");
 }
 
 
@@ -20,6 +20,7 @@
 #include "ns3/enum.h"
 #include "ns3/uinteger.h"
 #include "drop-tail-queue.h"
+#include "segmentation-offload-tag.h"
 
 namespace ns3 {
 
@@ -58,7 +59,8 @@ TypeId DropTailQueue::GetTypeId (void)
 DropTailQueue::DropTailQueue () :
   Queue (),
   m_packets (),
-  m_bytesInQueue (0)
+  m_bytesInQueue (0),
+  m_packetsInQueue (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -87,21 +89,26 @@ DropTailQueue::DoEnqueue (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << p);
 
-  if (m_mode == QUEUE_MODE_PACKETS && (m_packets.size () >= m_maxPackets))
+  // An offloaded super-segment occupies the queue as the wire packets it stands for
+  uint32_t nPackets = SegmentationOffloadTag::GetWirePackets (p);
+  uint32_t size = SegmentationOffloadTag::GetWireSize (p);
+
+  if (m_mode == QUEUE_MODE_PACKETS && (m_packetsInQueue + nPackets > m_maxPackets))
     {
       NS_LOG_LOGIC ("Queue full (at max packets) -- droppping pkt");
       Drop (p);
       return false;
     }
 
-  if (m_mode == QUEUE_MODE_BYTES && (m_bytesInQueue + p->GetSize () >= m_maxBytes))
+  if (m_mode == QUEUE_MODE_BYTES && (m_bytesInQueue + size >= m_maxBytes))
     {
       NS_LOG_LOGIC ("Queue full (packet would exceed max bytes) -- droppping pkt");
       Drop (p);
       return false;
     }
 
-  m_bytesInQueue += p->GetSize ();
+  m_bytesInQueue += size;
+  m_packetsInQueue += nPackets;
   m_packets.push (p);
 
   NS_LOG_LOGIC ("Number packets " << m_packets.size ());
@@ -123,7 +130,8 @@ DropTailQueue::DoDequeue (void)
 
   Ptr<Packet> p = m_packets.front ();
   m_packets.pop ();
-  m_bytesInQueue -= p->GetSize ();
+  m_bytesInQueue -= SegmentationOffloadTag::GetWireSize (p);
+  m_packetsInQueue -= SegmentationOffloadTag::GetWirePackets (p);
 
   NS_LOG_LOGIC ("Popped " << p);
 
@@ -72,6 +72,7 @@ private:
   uint32_t m_maxPackets;              //!< max packets in the queue
   uint32_t m_maxBytes;                //!< max bytes in the queue
   uint32_t m_bytesInQueue;            //!< actual bytes in the queue
+  uint32_t m_packetsInQueue;          //!< actual wire packets in the queue
   QueueMode m_mode;                   //!< queue mode (packets or bytes limited)
 };
 
@@ -246,6 +246,20 @@ Mac48Address Mac48Address::GetMulticast (Ipv6Address addr)
   return etherAddr;
 }
 
+size_t
+Mac48AddressHash::operator() (Mac48Address const &x) const
+{
+  uint8_t buf[6];
+  x.CopyTo (buf);
+  uint64_t v = 0;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      v = (v << 8) | buf[i];
+    }
+  // fold the OUI into the low bits, which are all that a 32-bit size_t keeps
+  return static_cast<size_t> (v ^ (v >> 24));
+}
+
 std::ostream& operator<< (std::ostream& os, const Mac48Address & address)
 {
   uint8_t ad[6];
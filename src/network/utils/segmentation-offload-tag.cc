@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "segmentation-offload-tag.h"
+#include "ns3/packet.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SegmentationOffloadTag");
+
+NS_OBJECT_ENSURE_REGISTERED (SegmentationOffloadTag);
+
+TypeId
+SegmentationOffloadTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SegmentationOffloadTag")
+    .SetParent<Tag> ()
+    .SetGroupName("Network")
+    .AddConstructor<SegmentationOffloadTag> ()
+  ;
+  return tid;
+}
+TypeId
+SegmentationOffloadTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+uint32_t
+SegmentationOffloadTag::GetSerializedSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return 6;
+}
+void
+SegmentationOffloadTag::Serialize (TagBuffer buf) const
+{
+  NS_LOG_FUNCTION (this << &buf);
+  buf.WriteU16 (m_segments);
+  buf.WriteU32 (m_payloadSize);
+}
+void
+SegmentationOffloadTag::Deserialize (TagBuffer buf)
+{
+  NS_LOG_FUNCTION (this << &buf);
+  m_segments = buf.ReadU16 ();
+  m_payloadSize = buf.ReadU32 ();
+}
+void
+SegmentationOffloadTag::Print (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  os << "Segments=" << m_segments << " PayloadSize=" << m_payloadSize;
+}
+SegmentationOffloadTag::SegmentationOffloadTag ()
+  : Tag (),
+    m_segments (1),
+    m_payloadSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag (uint16_t segments, uint32_t payloadSize)
+  : Tag (),
+    m_segments (segments),
+    m_payloadSize (payloadSize)
+{
+  NS_LOG_FUNCTION (this << segments << payloadSize);
+}
+
+void
+SegmentationOffloadTag::SetSegments (uint16_t segments)
+{
+  NS_LOG_FUNCTION (this << segments);
+  m_segments = segments;
+}
+uint16_t
+SegmentationOffloadTag::GetSegments (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_segments;
+}
+
+void
+SegmentationOffloadTag::SetPayloadSize (uint32_t payloadSize)
+{
+  NS_LOG_FUNCTION (this << payloadSize);
+  m_payloadSize = payloadSize;
+}
+uint32_t
+SegmentationOffloadTag::GetPayloadSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_payloadSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetWirePackets (Ptr<const Packet> p)
+{
+  SegmentationOffloadTag tag;
+  if (p->PeekPacketTag (tag))
+    {
+      return tag.m_segments;
+    }
+  return 1;
+}
+
+uint32_t
+SegmentationOffloadTag::GetWireSize (Ptr<const Packet> p)
+{
+  SegmentationOffloadTag tag;
+  uint32_t size = p->GetSize ();
+  if (p->PeekPacketTag (tag) && size >= tag.m_payloadSize)
+    {
+      return tag.m_payloadSize + tag.m_segments * (size - tag.m_payloadSize);
+    }
+  return size;
+}
+
+} // namespace ns3
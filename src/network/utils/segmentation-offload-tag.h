@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SEGMENTATION_OFFLOAD_TAG_H
+#define SEGMENTATION_OFFLOAD_TAG_H
+
+#include "ns3/tag.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief Marks a packet as an offloaded super-segment
+ *
+ * A transport protocol emulating segmentation offload (TSO) may hand down a
+ * single packet carrying the payload of several MSS-sized segments. The
+ * packet travels through the stack as one object, while the devices that
+ * understand this tag account for it as the train of wire packets it
+ * stands for: every wire packet repeats all the headers of the
+ * super-segment, i.e. everything except its payload.
+ *
+ * Packets without this tag are a single wire packet of their own size.
+ */
+class SegmentationOffloadTag : public Tag
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer buf) const;
+  virtual void Deserialize (TagBuffer buf);
+  virtual void Print (std::ostream &os) const;
+  SegmentationOffloadTag ();
+
+  /**
+   * Constructs a SegmentationOffloadTag
+   *
+   * \param segments number of wire packets the super-segment is made of
+   * \param payloadSize overall payload size (bytes) of the super-segment
+   */
+  SegmentationOffloadTag (uint16_t segments, uint32_t payloadSize);
+
+  /**
+   * \brief Set the number of wire packets the super-segment is made of
+   * \param segments the number of segments
+   */
+  void SetSegments (uint16_t segments);
+  /**
+   * \brief Get the number of wire packets the super-segment is made of
+   * \returns the number of segments
+   */
+  uint16_t GetSegments (void) const;
+  /**
+   * \brief Set the overall payload size of the super-segment
+   * \param payloadSize the payload size (bytes)
+   */
+  void SetPayloadSize (uint32_t payloadSize);
+  /**
+   * \brief Get the overall payload size of the super-segment
+   * \returns the payload size (bytes)
+   */
+  uint32_t GetPayloadSize (void) const;
+
+  /**
+   * \brief Get the number of wire packets a packet stands for
+   * \param p the packet
+   * \returns the number of segments in the tag, or 1 if the packet is not tagged
+   */
+  static uint32_t GetWirePackets (Ptr<const Packet> p);
+  /**
+   * \brief Get the number of bytes a packet occupies on the wire
+   *
+   * For a tagged packet, the headers (the packet size minus the payload)
+   * are counted once per segment.
+   *
+   * \param p the packet
+   * \returns the wire size (bytes), or the packet size if the packet is not tagged
+   */
+  static uint32_t GetWireSize (Ptr<const Packet> p);
+
+private:
+  uint16_t m_segments;    //!< Number of wire packets
+  uint32_t m_payloadSize; //!< Overall payload size
+};
+
+} // namespace ns3
+
+#endif /* SEGMENTATION_OFFLOAD_TAG_H */
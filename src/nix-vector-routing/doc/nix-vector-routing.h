@@ -30,9 +30,10 @@
  * when dealing with a large number of nodes.
  *
  * Currently, the ns-3 model of nix-vector routing supports IPv4 p2p links 
- * as well as CSMA links.  It does not (yet) provide support for 
+ * as well as CSMA links.  By default, it does not provide support for 
  * efficient adaptation to link failures.  It simply flushes all nix-vector 
- * routing caches. Finally, IPv6 is not supported.
+ * routing caches.  When the routes are precomputed (see below), only the 
+ * caches affected by a change are flushed.  Finally, IPv6 is not supported.
  *
  * \section api API and Usage
  *
@@ -52,6 +53,15 @@
  *    stack.SetRoutingHelper (list);
  *    stack.Install (allNodes);
  *
+ * Once the topology is built and the addresses assigned, the routes 
+ * between all the pairs of nodes can optionally be computed in advance, 
+ * in parallel:
+ *
+ *    Ipv4NixVectorRouting::PrecomputeRoutes ();
+ *
+ * This trades memory (four bytes per pair of nodes) for the run-time 
+ * BFS of every new source and destination pair.
+ *
  * \section impl Implementation
  *
  * ns-3 nix-vector-routing performs on-demand route computation using 
@@ -20,11 +20,18 @@
 
 #include <queue>
 #include <iomanip>
+#include <algorithm>
 
+#include "ns3/core-config.h"
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/names.h"
+#include "ns3/simulator.h"
 #include "ns3/ipv4-list-routing.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include <unistd.h>
+#endif /* HAVE_PTHREAD_H */
 
 #include "ipv4-nix-vector-routing.h"
 
@@ -35,6 +42,17 @@ NS_LOG_COMPONENT_DEFINE ("Ipv4NixVectorRouting");
 NS_OBJECT_ENSURE_REGISTERED (Ipv4NixVectorRouting);
 
 bool Ipv4NixVectorRouting::g_isCacheDirty = false;
+bool Ipv4NixVectorRouting::g_isPrecomputed = false;
+uint32_t Ipv4NixVectorRouting::g_nThreads = 1;
+uint32_t Ipv4NixVectorRouting::g_nNodes = 0;
+std::vector<std::vector<uint32_t> > Ipv4NixVectorRouting::g_bfsNeighbors;
+std::vector<std::vector<uint32_t> > Ipv4NixVectorRouting::g_nixNeighbors;
+std::vector<uint32_t> Ipv4NixVectorRouting::g_parents;
+std::vector<bool> Ipv4NixVectorRouting::g_isRowValid;
+std::map<Ipv4Address, uint32_t> Ipv4NixVectorRouting::g_addressToNode;
+
+/// Parent of the nodes not reached by the BFS
+static const uint32_t NO_PARENT = 0xffffffff;
 
 TypeId 
 Ipv4NixVectorRouting::GetTypeId (void)
@@ -148,6 +166,18 @@ Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetD
     }
   else
     {
+      // with the precomputed table, no BFS is needed
+      // unless a specific output device is requested
+      if (g_isPrecomputed && !oif)
+        {
+          if (BuildNixVectorFromTable (source->GetId (), destNode->GetId (), nixVector))
+            {
+              return nixVector;
+            }
+          NS_LOG_ERROR ("No routing path exists");
+          return 0;
+        }
+
       // otherwise proceed as normal 
       // and build the nix vector
       std::vector< Ptr<Node> > parentVector;
@@ -347,6 +377,17 @@ Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
 { 
   NS_LOG_FUNCTION_NOARGS ();
 
+  if (g_isPrecomputed)
+    {
+      std::map<Ipv4Address, uint32_t>::const_iterator it = g_addressToNode.find (dest);
+      if (it == g_addressToNode.end ())
+        {
+          NS_LOG_ERROR ("Couldn't find dest node given the IP" << dest);
+          return 0;
+        }
+      return NodeList::GetNode (it->second);
+    }
+
   NodeContainer allNodes = NodeContainer::GetGlobal ();
   Ptr<Node> destNode;
 
@@ -402,7 +443,7 @@ Ipv4NixVectorRouting::FindTotalNeighbors (void)
 }
 
 Ptr<BridgeNetDevice>
-Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd) const
+Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd)
 {
   NS_LOG_FUNCTION (nd);
 
@@ -720,21 +761,41 @@ Ipv4NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream) const
 void
 Ipv4NixVectorRouting::NotifyInterfaceUp (uint32_t i)
 {
+  if (g_isPrecomputed && m_node)
+    {
+      UpdateNodeTopology (m_node->GetId ());
+      return;
+    }
   g_isCacheDirty = true;
 }
 void
 Ipv4NixVectorRouting::NotifyInterfaceDown (uint32_t i)
 {
+  if (g_isPrecomputed && m_node)
+    {
+      UpdateNodeTopology (m_node->GetId ());
+      return;
+    }
   g_isCacheDirty = true;
 }
 void
 Ipv4NixVectorRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
+  if (g_isPrecomputed)
+    {
+      UpdateAddress (address.GetLocal ());
+      return;
+    }
   g_isCacheDirty = true;
 }
 void
 Ipv4NixVectorRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
+  if (g_isPrecomputed)
+    {
+      UpdateAddress (address.GetLocal ());
+      return;
+    }
   g_isCacheDirty = true;
 }
 
@@ -886,6 +947,353 @@ Ipv4NixVectorRouting::BFS (uint32_t numberOfNodes, Ptr<Node> source,
   return false;
 }
 
+void
+Ipv4NixVectorRouting::PrecomputeRoutes (uint32_t nThreads)
+{
+  NS_LOG_FUNCTION (nThreads);
+
+  uint32_t nNodes = NodeList::GetNNodes ();
+  g_nNodes = nNodes;
+
+  // Discover the neighbors once, for all the nodes
+  g_bfsNeighbors.assign (nNodes, std::vector<uint32_t> ());
+  g_nixNeighbors.assign (nNodes, std::vector<uint32_t> ());
+  g_addressToNode.clear ();
+  for (uint32_t n = 0; n < nNodes; n++)
+    {
+      BuildNodeAdjacency (n);
+
+      // the first node owning an address is the one used (see GetNodeByIp)
+      Ptr<Ipv4> ipv4 = NodeList::GetNode (n)->GetObject<Ipv4> ();
+      if (ipv4 == 0)
+        {
+          continue;
+        }
+      for (uint32_t i = 0; i < ipv4->GetNInterfaces (); i++)
+        {
+          for (uint32_t j = 0; j < ipv4->GetNAddresses (i); j++)
+            {
+              g_addressToNode.insert (std::make_pair (ipv4->GetAddress (i, j).GetLocal (), n));
+            }
+        }
+    }
+
+  if (nThreads == 0)
+    {
+#ifdef HAVE_PTHREAD_H
+      long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+      nThreads = nProcessors > 0 ? nProcessors : 1;
+#else
+      nThreads = 1;
+#endif /* HAVE_PTHREAD_H */
+    }
+  nThreads = std::max<uint32_t> (1, std::min (nThreads, nNodes));
+  g_nThreads = nThreads;
+
+  NS_LOG_LOGIC ("Computing the routes of " << nNodes << " nodes with " << nThreads << " threads");
+  g_parents.assign (static_cast<size_t> (nNodes) * nNodes, NO_PARENT);
+#ifdef HAVE_PTHREAD_H
+  if (nThreads > 1)
+    {
+      // The workers only touch the shared graph (read) and their own rows
+      std::vector<Ptr<SystemThread> > threads;
+      for (uint32_t t = 0; t < nThreads; t++)
+        {
+          threads.push_back (Create<SystemThread> (MakeBoundCallback (&Ipv4NixVectorRouting::ComputeParentRows, t, nThreads)));
+          threads.back ()->Start ();
+        }
+      for (uint32_t t = 0; t < nThreads; t++)
+        {
+          threads[t]->Join ();
+        }
+    }
+  else
+#endif /* HAVE_PTHREAD_H */
+    {
+      ComputeParentRows (0, 1);
+    }
+  g_isRowValid.assign (nNodes, true);
+  if (!g_isPrecomputed)
+    {
+      // the nodes of the next simulation in this process are not ours
+      Simulator::ScheduleDestroy (&Ipv4NixVectorRouting::ClearPrecomputedRoutes);
+    }
+  g_isPrecomputed = true;
+}
+
+void
+Ipv4NixVectorRouting::ClearPrecomputedRoutes (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  g_isPrecomputed = false;
+  g_isCacheDirty = false;
+  g_nThreads = 1;
+  g_nNodes = 0;
+  std::vector<std::vector<uint32_t> > ().swap (g_bfsNeighbors);
+  std::vector<std::vector<uint32_t> > ().swap (g_nixNeighbors);
+  std::vector<uint32_t> ().swap (g_parents);
+  std::vector<bool> ().swap (g_isRowValid);
+  g_addressToNode.clear ();
+}
+
+void
+Ipv4NixVectorRouting::BuildNodeAdjacency (uint32_t nodeId)
+{
+  NS_LOG_FUNCTION (nodeId);
+
+  Ptr<Node> node = NodeList::GetNode (nodeId);
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  std::vector<uint32_t> &bfsNeighbors = g_bfsNeighbors.at (nodeId);
+  std::vector<uint32_t> &nixNeighbors = g_nixNeighbors.at (nodeId);
+  bfsNeighbors.clear ();
+  nixNeighbors.clear ();
+
+  for (uint32_t i = 0; i < node->GetNDevices (); i++)
+    {
+      Ptr<NetDevice> localNetDevice = node->GetDevice (i);
+      Ptr<Channel> channel = localNetDevice->GetChannel ();
+      if (channel == 0)
+        {
+          continue;
+        }
+      NetDeviceContainer netDeviceContainer;
+      GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+
+      // same neighbor indexes as BuildNixVector
+      if (!localNetDevice->IsBridge ())
+        {
+          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+            {
+              nixNeighbors.push_back ((*iter)->GetNode ()->GetId ());
+            }
+        }
+
+      // same checks as BFS
+      bool isUp = localNetDevice->IsLinkUp ();
+      if (ipv4)
+        {
+          int32_t interfaceIndex = ipv4->GetInterfaceForDevice (localNetDevice);
+          isUp = isUp && interfaceIndex != -1 && ipv4->IsUp (interfaceIndex);
+        }
+      if (isUp)
+        {
+          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+            {
+              bfsNeighbors.push_back ((*iter)->GetNode ()->GetId ());
+            }
+        }
+    }
+}
+
+void
+Ipv4NixVectorRouting::ComputeParentRows (uint32_t first, uint32_t stride)
+{
+  // No logging here: this may run outside of the main thread
+  uint32_t nNodes = g_nNodes;
+  std::vector<uint32_t> greyNodeList;
+  greyNodeList.reserve (nNodes);
+
+  for (uint32_t source = first; source < nNodes; source += stride)
+    {
+      uint32_t *parents = &g_parents[static_cast<size_t> (source) * nNodes];
+      std::fill (parents, parents + nNodes, NO_PARENT);
+
+      // Same visiting order as BFS, without stopping at a destination
+      greyNodeList.clear ();
+      greyNodeList.push_back (source);
+      parents[source] = source;
+      for (uint32_t head = 0; head < greyNodeList.size (); head++)
+        {
+          const std::vector<uint32_t> &neighbors = g_bfsNeighbors[greyNodeList[head]];
+          for (std::vector<uint32_t>::const_iterator it = neighbors.begin (); it != neighbors.end (); it++)
+            {
+              if (parents[*it] == NO_PARENT)
+                {
+                  parents[*it] = greyNodeList[head];
+                  greyNodeList.push_back (*it);
+                }
+            }
+        }
+    }
+}
+
+bool
+Ipv4NixVectorRouting::BuildNixVectorFromTable (uint32_t source, uint32_t dest, Ptr<NixVector> nixVector)
+{
+  NS_LOG_FUNCTION (source << dest);
+
+  if (NodeList::GetNNodes () != g_nNodes)
+    {
+      NS_LOG_LOGIC ("Nodes added since the routes were computed, recompute them");
+      PrecomputeRoutes (g_nThreads);
+    }
+  if (!g_isRowValid[source])
+    {
+      NS_LOG_LOGIC ("Routes of node " << source << " invalidated, recompute them");
+      ComputeParentRows (source, g_nNodes);
+      g_isRowValid[source] = true;
+    }
+
+  const uint32_t *parents = &g_parents[static_cast<size_t> (source) * g_nNodes];
+  if (parents[dest] == NO_PARENT)
+    {
+      return false;
+    }
+
+  // Same hops, in the same order, as BuildNixVector
+  for (uint32_t node = dest; node != source; node = parents[node])
+    {
+      const std::vector<uint32_t> &neighbors = g_nixNeighbors[parents[node]];
+      uint32_t destId = 0;
+      for (uint32_t i = 0; i < neighbors.size (); i++)
+        {
+          if (neighbors[i] == node)
+            {
+              destId = i;
+            }
+        }
+      NS_LOG_LOGIC ("Adding Nix: " << destId << " with "
+                                   << nixVector->BitCount (neighbors.size ()) << " bits, for node " << parents[node]);
+      nixVector->AddNeighborIndex (destId, nixVector->BitCount (neighbors.size ()));
+    }
+  return true;
+}
+
+void
+Ipv4NixVectorRouting::UpdateNodeTopology (uint32_t nodeId)
+{
+  NS_LOG_FUNCTION (nodeId);
+
+  if (NodeList::GetNNodes () != g_nNodes)
+    {
+      // the routes are recomputed as a whole on the next lookup
+      g_isCacheDirty = true;
+      return;
+    }
+
+  std::vector<uint32_t> oldBfsNeighbors = g_bfsNeighbors[nodeId];
+  std::vector<uint32_t> oldNixNeighbors = g_nixNeighbors[nodeId];
+  BuildNodeAdjacency (nodeId);
+  const std::vector<uint32_t> &bfsNeighbors = g_bfsNeighbors[nodeId];
+  bool isBfsChanged = bfsNeighbors != oldBfsNeighbors;
+  bool isNixChanged = g_nixNeighbors[nodeId] != oldNixNeighbors;
+  if (!isBfsChanged && !isNixChanged)
+    {
+      NS_LOG_LOGIC ("Neighbors of node " << nodeId << " unchanged");
+      return;
+    }
+
+  std::vector<bool> isForwarder (g_nNodes, false);
+  for (uint32_t source = 0; source < g_nNodes; source++)
+    {
+      if (!g_isRowValid[source])
+        {
+          continue;
+        }
+      const uint32_t *parents = &g_parents[static_cast<size_t> (source) * g_nNodes];
+      if (parents[nodeId] == NO_PARENT)
+        {
+          // the node is never reached, so its neighbors are never visited
+          continue;
+        }
+
+      bool isAffected = (source == nodeId);
+
+      // the tree changes if the node was the parent of some other node...
+      for (uint32_t i = 0; !isAffected && i < oldBfsNeighbors.size (); i++)
+        {
+          isAffected = oldBfsNeighbors[i] != source && parents[oldBfsNeighbors[i]] == nodeId;
+        }
+
+      // ...or if a new neighbor may now be reached through it
+      if (!isAffected)
+        {
+          uint32_t depth = 0;
+          for (uint32_t n = nodeId; n != source; n = parents[n])
+            {
+              depth++;
+            }
+          for (uint32_t i = 0; !isAffected && i < bfsNeighbors.size (); i++)
+            {
+              uint32_t neighbor = bfsNeighbors[i];
+              if (std::find (oldBfsNeighbors.begin (), oldBfsNeighbors.end (), neighbor) != oldBfsNeighbors.end ())
+                {
+                  continue;
+                }
+              uint32_t neighborDepth = 0;
+              for (uint32_t n = neighbor; n != source && n != NO_PARENT; n = parents[n])
+                {
+                  neighborDepth++;
+                }
+              isAffected = parents[neighbor] == NO_PARENT || neighborDepth > depth;
+            }
+        }
+
+      if (isAffected)
+        {
+          NS_LOG_LOGIC ("Routes of node " << source << " invalidated");
+          g_isRowValid[source] = false;
+          Ptr<Ipv4NixVectorRouting> rp = NodeList::GetNode (source)->GetObject<Ipv4NixVectorRouting> ();
+          if (rp)
+            {
+              rp->FlushNixCache ();
+            }
+          // the nodes forwarding along the old tree may hold stale routes
+          for (uint32_t n = 0; n < g_nNodes; n++)
+            {
+              if (parents[n] != NO_PARENT)
+                {
+                  isForwarder[parents[n]] = true;
+                }
+            }
+        }
+    }
+
+  isForwarder[nodeId] = true;
+  for (uint32_t n = 0; n < g_nNodes; n++)
+    {
+      if (!isForwarder[n])
+        {
+          continue;
+        }
+      Ptr<Ipv4NixVectorRouting> rp = NodeList::GetNode (n)->GetObject<Ipv4NixVectorRouting> ();
+      if (rp)
+        {
+          rp->FlushIpv4RouteCache ();
+          rp->m_totalNeighbors = 0;
+        }
+    }
+}
+
+void
+Ipv4NixVectorRouting::UpdateAddress (Ipv4Address address)
+{
+  NS_LOG_FUNCTION (address);
+
+  // look up the owner as GetNodeByIp would do without the map
+  g_addressToNode.erase (address);
+  for (uint32_t n = 0; n < NodeList::GetNNodes (); n++)
+    {
+      Ptr<Ipv4> ipv4 = NodeList::GetNode (n)->GetObject<Ipv4> ();
+      if (ipv4 && ipv4->GetInterfaceForAddress (address) != -1)
+        {
+          g_addressToNode[address] = n;
+          break;
+        }
+    }
+
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); i++)
+    {
+      Ptr<Ipv4NixVectorRouting> rp = (*i)->GetObject<Ipv4NixVectorRouting> ();
+      if (rp)
+        {
+          rp->m_nixCache.erase (address);
+          rp->m_ipv4RouteCache.erase (address);
+        }
+    }
+}
+
 void 
 Ipv4NixVectorRouting::CheckCacheStateAndFlush (void) const
 {
@@ -893,6 +1301,10 @@ Ipv4NixVectorRouting::CheckCacheStateAndFlush (void) const
     {
       FlushGlobalNixRoutingCache ();
       g_isCacheDirty = false;
+      if (g_isPrecomputed)
+        {
+          PrecomputeRoutes (g_nThreads);
+        }
     }
 }
 
@@ -22,6 +22,7 @@
 #define IPV4_NIX_VECTOR_ROUTING_H
 
 #include <map>
+#include <vector>
 
 #include "ns3/channel.h"
 #include "ns3/node-container.h"
@@ -80,6 +81,27 @@ public:
    */
   void FlushGlobalNixRoutingCache (void) const;
 
+  /**
+   * @brief Precompute the routes between all the pairs of nodes
+   *
+   * Builds a compact adjacency graph of the whole topology, shared
+   * by all the nodes, and runs one BFS per source node over it.  The
+   * sources are spread over \p nThreads threads, when threading is
+   * available.  From then on, nix-vectors are built from the table
+   * of BFS parents instead of running a BFS per destination, unless
+   * a specific output device is requested.  A topology change only
+   * invalidates the sources whose shortest-path tree it may alter,
+   * and the caches of the nodes along those trees.
+   *
+   * The table takes four bytes per pair of nodes.  Nodes created
+   * afterwards cause the whole table to be rebuilt.  The table is
+   * released by Simulator::Destroy, after which the routes are
+   * computed on demand again.
+   *
+   * @param nThreads number of threads (0 means one per online processor)
+   */
+  static void PrecomputeRoutes (uint32_t nThreads = 0);
+
 private:
 
   /* flushes the cache which stores nix-vector based on
@@ -108,7 +130,7 @@ private:
 
   /* given a net-device returns all the adjacent net-devices,
    * essentially getting the neighbors on that channel */
-  void GetAdjacentNetDevices (Ptr<NetDevice>, Ptr<Channel>, NetDeviceContainer &);
+  static void GetAdjacentNetDevices (Ptr<NetDevice>, Ptr<Channel>, NetDeviceContainer &);
 
   /* iterates through the node list and finds the one
    * corresponding to the given Ipv4Address */
@@ -125,7 +147,7 @@ private:
   uint32_t FindTotalNeighbors (void);
 
   /* determine if the netdevice is bridged */
-  Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd) const;
+  static Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd);
 
 
   /* Nix index is with respect to the neighbors.  The net-device index must be
@@ -146,6 +168,32 @@ private:
             std::vector< Ptr<Node> > & parentVector,
             Ptr<NetDevice> oif);
 
+  /* fills the shared adjacency graph entries of the given node:
+   * the neighbors the BFS may go to (through devices that are up),
+   * and all the neighbors in nix-index order */
+  static void BuildNodeAdjacency (uint32_t nodeId);
+
+  /* runs the BFS over the shared graph for the sources
+   * first, first + stride, first + 2 * stride, ... and writes
+   * their rows of the parent table; safe to run in parallel */
+  static void ComputeParentRows (uint32_t first, uint32_t stride);
+
+  /* builds the nix-vector from the precomputed parent table,
+   * recomputing the row of the source if it was invalidated */
+  static bool BuildNixVectorFromTable (uint32_t source, uint32_t dest, Ptr<NixVector> nixVector);
+
+  /* rebuilds the adjacency of a node after a topology change and
+   * invalidates the sources and caches it affects */
+  static void UpdateNodeTopology (uint32_t nodeId);
+
+  /* releases the precomputed routes and returns to on-demand
+   * routing; scheduled to run on Simulator::Destroy */
+  static void ClearPrecomputedRoutes (void);
+
+  /* records the address in the address to node map, or forgets
+   * it, and flushes the cache entries of that address */
+  static void UpdateAddress (Ipv4Address address);
+
   void DoDispose (void);
 
   /* From Ipv4RoutingProtocol */
@@ -171,6 +219,30 @@ private:
    */
   static bool g_isCacheDirty;
 
+  /* true once PrecomputeRoutes has been called */
+  static bool g_isPrecomputed;
+
+  /* threads used by PrecomputeRoutes */
+  static uint32_t g_nThreads;
+
+  /* number of nodes in the shared graph */
+  static uint32_t g_nNodes;
+
+  /* per node, the neighbors the BFS visits, in visiting order */
+  static std::vector<std::vector<uint32_t> > g_bfsNeighbors;
+
+  /* per node, the neighbors in nix-index order */
+  static std::vector<std::vector<uint32_t> > g_nixNeighbors;
+
+  /* BFS parent of each node (columns) for each source (rows) */
+  static std::vector<uint32_t> g_parents;
+
+  /* rows of the parent table that are up to date */
+  static std::vector<bool> g_isRowValid;
+
+  /* node owning each address */
+  static std::map<Ipv4Address, uint32_t> g_addressToNode;
+
   /* Cache stores nix-vectors based on destination ip */
   mutable NixMap_t m_nixCache;
 
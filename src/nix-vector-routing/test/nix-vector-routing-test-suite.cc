@@ -0,0 +1,364 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/ipv4-nix-vector-helper.h"
+#include "ns3/ipv4-nix-vector-routing.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4.h"
+#include "ns3/nix-vector.h"
+#include "ns3/packet.h"
+
+using namespace ns3;
+
+/**
+ * Routes of every node towards every address of the topology, one
+ * string per pair holding the nix-vector, the gateway and the output
+ * device, or a mark when there is no route.
+ */
+typedef std::vector<std::string> RouteDump;
+
+/**
+ * Builds the test topologies out of SimpleNetDevices: channels with two
+ * devices in point-to-point mode stand for point-to-point links, and
+ * channels with more devices for shared (CSMA-like) segments.
+ */
+class NixTopology
+{
+public:
+  /**
+   * \param nNodes the number of nodes
+   */
+  NixTopology (uint32_t nNodes);
+
+  /**
+   * \param a the first node
+   * \param b the second node
+   * \returns the devices of the link
+   */
+  NetDeviceContainer AddLink (uint32_t a, uint32_t b);
+
+  /**
+   * \param members the nodes on the segment
+   * \returns the devices of the segment, in the order of \p members
+   */
+  NetDeviceContainer AddSegment (std::vector<uint32_t> members);
+
+  /**
+   * \param device a device of the topology
+   * \param up whether to bring the interface of the device up or down
+   */
+  void SetInterface (Ptr<NetDevice> device, bool up);
+
+  /**
+   * Flush the nix caches and ask every node for its route to every
+   * address.
+   * \returns the routes
+   */
+  RouteDump DumpRoutes (void);
+
+  NodeContainer m_nodes;               //!< the nodes
+  std::vector<Ipv4Address> m_addresses; //!< the addresses of the devices
+
+private:
+  /**
+   * \param devices the devices of a new link or segment
+   */
+  void Assign (NetDeviceContainer devices);
+
+  Ipv4AddressHelper m_addressHelper; //!< allocates one subnet per channel
+};
+
+NixTopology::NixTopology (uint32_t nNodes)
+{
+  m_nodes.Create (nNodes);
+  Ipv4NixVectorHelper nixRouting;
+  InternetStackHelper stack;
+  stack.SetRoutingHelper (nixRouting);
+  stack.Install (m_nodes);
+  m_addressHelper.SetBase ("10.1.0.0", "255.255.255.0");
+}
+
+NetDeviceContainer
+NixTopology::AddLink (uint32_t a, uint32_t b)
+{
+  SimpleNetDeviceHelper helper;
+  helper.SetNetDevicePointToPointMode (true);
+  NetDeviceContainer devices = helper.Install (NodeContainer (m_nodes.Get (a), m_nodes.Get (b)));
+  Assign (devices);
+  return devices;
+}
+
+NetDeviceContainer
+NixTopology::AddSegment (std::vector<uint32_t> members)
+{
+  SimpleNetDeviceHelper helper;
+  NodeContainer nodes;
+  for (std::vector<uint32_t>::const_iterator i = members.begin (); i != members.end (); i++)
+    {
+      nodes.Add (m_nodes.Get (*i));
+    }
+  NetDeviceContainer devices = helper.Install (nodes);
+  Assign (devices);
+  return devices;
+}
+
+void
+NixTopology::Assign (NetDeviceContainer devices)
+{
+  Ipv4InterfaceContainer interfaces = m_addressHelper.Assign (devices);
+  m_addressHelper.NewNetwork ();
+  for (uint32_t i = 0; i < interfaces.GetN (); i++)
+    {
+      m_addresses.push_back (interfaces.GetAddress (i));
+    }
+}
+
+void
+NixTopology::SetInterface (Ptr<NetDevice> device, bool up)
+{
+  Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+  int32_t interface = ipv4->GetInterfaceForDevice (device);
+  if (up)
+    {
+      ipv4->SetUp (interface);
+    }
+  else
+    {
+      ipv4->SetDown (interface);
+    }
+}
+
+RouteDump
+NixTopology::DumpRoutes (void)
+{
+  m_nodes.Get (0)->GetObject<Ipv4NixVectorRouting> ()->FlushGlobalNixRoutingCache ();
+
+  RouteDump dump;
+  for (uint32_t n = 0; n < m_nodes.GetN (); n++)
+    {
+      Ptr<Node> node = m_nodes.Get (n);
+      Ptr<Ipv4RoutingProtocol> routing = node->GetObject<Ipv4> ()->GetRoutingProtocol ();
+      for (std::vector<Ipv4Address>::const_iterator a = m_addresses.begin (); a != m_addresses.end (); a++)
+        {
+          if (node->GetObject<Ipv4> ()->GetInterfaceForAddress (*a) != -1)
+            {
+              continue;
+            }
+          Ptr<Packet> p = Create<Packet> ();
+          Ipv4Header header;
+          header.SetDestination (*a);
+          Socket::SocketErrno sockerr;
+          Ptr<Ipv4Route> route = routing->RouteOutput (p, header, 0, sockerr);
+
+          std::ostringstream oss;
+          oss << "node " << n << " to " << *a << ": ";
+          if (route == 0)
+            {
+              oss << "no route";
+            }
+          else
+            {
+              oss << *p->GetNixVector () << " via " << route->GetGateway ()
+                  << " dev " << route->GetOutputDevice ()->GetIfIndex ();
+            }
+          dump.push_back (oss.str ());
+        }
+    }
+  return dump;
+}
+
+/**
+ * Builds a ring of point-to-point links with two shared segments
+ * hanging off it, then takes down a link of the ring and a member of a
+ * segment and brings them back up, dumping the routes at each step.
+ *
+ * \param nThreads the number of threads to precompute the routes with,
+ *                 or 0 for on-demand routing
+ * \returns the routes before the change, after it and after the revert
+ */
+static std::vector<RouteDump>
+RunMixedTopology (uint32_t nThreads)
+{
+  NixTopology topology (10);
+  topology.AddLink (0, 1);
+  NetDeviceContainer link = topology.AddLink (1, 2);
+  topology.AddLink (2, 3);
+  topology.AddLink (3, 0);
+  topology.AddLink (4, 5);
+  topology.AddLink (8, 9);
+  std::vector<uint32_t> members;
+  members.push_back (2);
+  members.push_back (4);
+  members.push_back (6);
+  members.push_back (7);
+  NetDeviceContainer segment = topology.AddSegment (members);
+  members.clear ();
+  members.push_back (5);
+  members.push_back (7);
+  members.push_back (8);
+  topology.AddSegment (members);
+
+  if (nThreads > 0)
+    {
+      Ipv4NixVectorRouting::PrecomputeRoutes (nThreads);
+    }
+
+  std::vector<RouteDump> dumps;
+  dumps.push_back (topology.DumpRoutes ());
+  topology.SetInterface (link.Get (0), false);
+  topology.SetInterface (segment.Get (3), false);
+  dumps.push_back (topology.DumpRoutes ());
+  topology.SetInterface (link.Get (0), true);
+  topology.SetInterface (segment.Get (3), true);
+  dumps.push_back (topology.DumpRoutes ());
+
+  Simulator::Destroy ();
+  return dumps;
+}
+
+/**
+ * Routes of a star of point-to-point links, with the same number of
+ * nodes as the mixed topology but other addresses.
+ *
+ * \param precompute whether to precompute the routes
+ * \returns the routes
+ */
+static RouteDump
+RunStarTopology (bool precompute)
+{
+  NixTopology topology (10);
+  for (uint32_t n = 1; n < 10; n++)
+    {
+      topology.AddLink (n, 0);
+    }
+  if (precompute)
+    {
+      Ipv4NixVectorRouting::PrecomputeRoutes (1);
+    }
+  RouteDump dump = topology.DumpRoutes ();
+  Simulator::Destroy ();
+  return dump;
+}
+
+/**
+ * Compares the precomputed routes, with one and several threads,
+ * against the on-demand BFS, before and after interfaces go down and
+ * come back up.
+ */
+class NixPrecomputedRoutesTestCase : public TestCase
+{
+public:
+  NixPrecomputedRoutesTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+NixPrecomputedRoutesTestCase::NixPrecomputedRoutesTestCase ()
+  : TestCase ("Check precomputed nix-vectors against the on-demand BFS")
+{
+}
+
+void
+NixPrecomputedRoutesTestCase::DoRun (void)
+{
+  std::vector<RouteDump> reference = RunMixedTopology (0);
+  // 19 addresses, each unknown to the 9 nodes not owning it
+  NS_TEST_ASSERT_MSG_EQ (reference[0].size (), 9 * 19, "wrong number of routes");
+  NS_TEST_ASSERT_MSG_NE ((reference[0] == reference[1]), true, "taking the interfaces down changed no route");
+  NS_TEST_ASSERT_MSG_EQ ((reference[0] == reference[2]), true, "bringing the interfaces up did not restore the routes");
+
+  uint32_t threads[] = { 1, 4 };
+  const char *steps[] = { "initial", "interfaces down", "interfaces up" };
+  for (uint32_t t = 0; t < 2; t++)
+    {
+      std::vector<RouteDump> dumps = RunMixedTopology (threads[t]);
+      for (uint32_t step = 0; step < 3; step++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (dumps[step].size (), reference[step].size (), "wrong number of routes");
+          for (uint32_t i = 0; i < reference[step].size (); i++)
+            {
+              NS_TEST_EXPECT_MSG_EQ (dumps[step][i], reference[step][i],
+                                     steps[step] << " routes differ with " << threads[t] << " threads");
+            }
+        }
+    }
+}
+
+/**
+ * Checks that the precomputed routes of a simulation do not leak into
+ * the next simulation run in the same process.
+ */
+class NixPrecomputedRoutesDestroyTestCase : public TestCase
+{
+public:
+  NixPrecomputedRoutesDestroyTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+NixPrecomputedRoutesDestroyTestCase::NixPrecomputedRoutesDestroyTestCase ()
+  : TestCase ("Check that Simulator::Destroy releases the precomputed routes")
+{
+}
+
+void
+NixPrecomputedRoutesDestroyTestCase::DoRun (void)
+{
+  RouteDump reference = RunStarTopology (false);
+  RunMixedTopology (1);
+  RouteDump dump = RunStarTopology (false);
+  NS_TEST_ASSERT_MSG_EQ (dump.size (), reference.size (), "wrong number of routes");
+  for (uint32_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (dump[i], reference[i], "on-demand routes differ after a precomputed run");
+    }
+  dump = RunStarTopology (true);
+  for (uint32_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (dump[i], reference[i], "precomputed routes differ after a precomputed run");
+    }
+}
+
+/**
+ * Nix-vector routing test suite
+ */
+class NixVectorRoutingTestSuite : public TestSuite
+{
+public:
+  NixVectorRoutingTestSuite ();
+};
+
+NixVectorRoutingTestSuite::NixVectorRoutingTestSuite ()
+  : TestSuite ("nix-vector-routing", UNIT)
+{
+  AddTestCase (new NixPrecomputedRoutesTestCase, TestCase::QUICK);
+  AddTestCase (new NixPrecomputedRoutesDestroyTestCase, TestCase::QUICK);
+}
+
+static NixVectorRoutingTestSuite g_nixVectorRoutingTestSuite;
@@ -25,6 +25,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "point-to-point-net-device.h"
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
@@ -247,7 +248,14 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   m_currentPkt = p;
   m_phyTxBeginTrace (m_currentPkt);
 
-  Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
+  //
+  // An offloaded super-segment occupies the wire as the train of packets it
+  // stands for, each one with its own headers and interframe gap.  The
+  // channel delivers it at once when the last of them has been serialized.
+  //
+  uint32_t nPackets = SegmentationOffloadTag::GetWirePackets (p);
+  Time txTime = m_bps.CalculateBytesTxTime (SegmentationOffloadTag::GetWireSize (p))
+    + m_tInterframeGap * static_cast<int64_t> (nPackets - 1);
   Time txCompleteTime = txTime + m_tInterframeGap;
 
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
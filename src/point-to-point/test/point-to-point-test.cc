@@ -23,6 +23,8 @@
 #include "ns3/simulator.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -93,6 +95,108 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test class for the segmentation offload accounting of the PointToPoint model
+ *
+ * It sends back to back three super-segments, each one standing for three
+ * wire packets, over a link whose queue holds at most five wire packets.
+ * The first one is transmitted in the time of the three wire packets, the
+ * second one waits in the queue and the third one does not fit in it.
+ */
+class PointToPointOffloadTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointOffloadTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send one super-segment to the device specified
+   *
+   * \param device NetDevice to send to
+   */
+  void SendSuperSegment (Ptr<PointToPointNetDevice> device);
+
+  /**
+   * \brief Receive a packet
+   *
+   * \param device the receiving device
+   * \param p the packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from);
+
+  std::vector<Time> m_rxTimes; //!< Reception times
+};
+
+PointToPointOffloadTest::PointToPointOffloadTest ()
+  : TestCase ("PointToPoint segmentation offload")
+{
+}
+
+void
+PointToPointOffloadTest::SendSuperSegment (Ptr<PointToPointNetDevice> device)
+{
+  // Three segments of 1000 bytes, with a 40 bytes header each
+  Ptr<Packet> p = Create<Packet> (3040);
+  p->AddPacketTag (SegmentationOffloadTag (3, 3000));
+  device->Send (p, device->GetBroadcast (), 0x800);
+}
+
+bool
+PointToPointOffloadTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from)
+{
+  m_rxTimes.push_back (Simulator::Now ());
+  return true;
+}
+
+void
+PointToPointOffloadTest::DoRun (void)
+{
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+
+  devA->Attach (channel);
+  devA->SetAddress (Mac48Address::Allocate ());
+  devA->SetDataRate (DataRate ("8Mbps"));
+  Ptr<DropTailQueue> queue = CreateObject<DropTailQueue> ();
+  queue->SetAttribute ("MaxPackets", UintegerValue (5));
+  devA->SetQueue (queue);
+  devB->Attach (channel);
+  devB->SetAddress (Mac48Address::Allocate ());
+  devB->SetQueue (CreateObject<DropTailQueue> ());
+
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+  devB->SetReceiveCallback (MakeCallback (&PointToPointOffloadTest::Receive, this));
+
+  Simulator::Schedule (Seconds (1.0), &PointToPointOffloadTest::SendSuperSegment, this, devA);
+  Simulator::Schedule (Seconds (1.0), &PointToPointOffloadTest::SendSuperSegment, this, devA);
+  Simulator::Schedule (Seconds (1.0), &PointToPointOffloadTest::SendSuperSegment, this, devA);
+
+  Simulator::Run ();
+
+  // Each wire packet is 1000 bytes of payload, 40 bytes of header and 2 bytes of PPP header
+  Time superSegmentTxTime = MicroSeconds (3 * 1042);
+  NS_TEST_ASSERT_MSG_EQ (m_rxTimes.size (), 2, "The third super-segment should not fit in the queue");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_rxTimes[0], Seconds (1.0) + superSegmentTxTime, NanoSeconds (10), "Wrong transmission time");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_rxTimes[1], Seconds (1.0) + superSegmentTxTime * 2, NanoSeconds (10), "Wrong transmission time");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -109,6 +213,7 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointOffloadTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -0,0 +1,480 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pathloss-matrix-propagation-loss-model.h"
+#include "jakes-propagation-loss-model.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/pointer.h"
+#include "ns3/node.h"
+#include "ns3/mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PathlossMatrixPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (PathlossMatrixPropagationLossModel);
+
+/**
+ * \ingroup propagation
+ *
+ * Object aggregated to the mobility models known to path loss matrices,
+ * which removes the mobility model from the matrices when it is disposed.
+ * The matrices can then keep plain pointers to the mobility models.
+ */
+class PathlossMatrixEndpointTracker : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \param mobility the mobility model this object is aggregated to
+   */
+  PathlossMatrixEndpointTracker (MobilityModel *mobility = 0);
+
+  /**
+   * \param matrix a matrix to be notified of the disposal of the mobility model
+   */
+  void Add (const PathlossMatrixPropagationLossModel *matrix);
+
+  /**
+   * \param matrix a matrix not to be notified anymore
+   */
+  void Remove (const PathlossMatrixPropagationLossModel *matrix);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  MobilityModel *m_mobility; //!< the mobility model this object is aggregated to
+  /// the matrices to be notified
+  std::vector<const PathlossMatrixPropagationLossModel *> m_matrices;
+};
+
+NS_OBJECT_ENSURE_REGISTERED (PathlossMatrixEndpointTracker);
+
+TypeId
+PathlossMatrixEndpointTracker::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::PathlossMatrixEndpointTracker")
+    .SetParent<Object> ()
+    .SetGroupName ("Propagation")
+  ;
+  return tid;
+}
+
+PathlossMatrixEndpointTracker::PathlossMatrixEndpointTracker (MobilityModel *mobility)
+  : m_mobility (mobility)
+{
+}
+
+void
+PathlossMatrixEndpointTracker::Add (const PathlossMatrixPropagationLossModel *matrix)
+{
+  m_matrices.push_back (matrix);
+}
+
+void
+PathlossMatrixEndpointTracker::Remove (const PathlossMatrixPropagationLossModel *matrix)
+{
+  m_matrices.erase (std::remove (m_matrices.begin (), m_matrices.end (), matrix), m_matrices.end ());
+}
+
+void
+PathlossMatrixEndpointTracker::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<const PathlossMatrixPropagationLossModel *> matrices;
+  matrices.swap (m_matrices);
+  for (std::vector<const PathlossMatrixPropagationLossModel *>::const_iterator it = matrices.begin ();
+       it != matrices.end (); ++it)
+    {
+      (*it)->EvictEndpoint (m_mobility);
+    }
+  m_mobility = 0;
+  Object::DoDispose ();
+}
+
+/// Magic string at the beginning of a path loss matrix file.
+static const char g_pathlossMatrixMagic[8] = { 'n', 's', '3', 'p', 'l', 'm', '0', '1' };
+
+/// Header of a path loss matrix file, followed by the gains.
+struct PathlossMatrixHeader
+{
+  char magic[8];      ///< g_pathlossMatrixMagic
+  uint32_t gainsNum;  ///< number of gains
+  uint32_t reserved;  ///< padding, zero
+};
+
+/// A gain in a path loss matrix file.
+struct PathlossMatrixRecord
+{
+  uint32_t txNodeId;      ///< ID of the transmitter node
+  uint32_t rxNodeId;      ///< ID of the receiver node
+  double txPosition[3];   ///< position of the transmitter
+  double rxPosition[3];   ///< position of the receiver
+  double gainDb;          ///< the gain, in dB
+};
+
+/**
+ * \param a a position
+ * \param b another position
+ * \return true if both positions are exactly the same
+ */
+static bool
+IsSamePosition (const Vector &a, const Vector &b)
+{
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+TypeId
+PathlossMatrixPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::PathlossMatrixPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<PathlossMatrixPropagationLossModel> ()
+    .AddAttribute ("PropagationLossModel",
+                   "The model whose gains are stored in the matrix.",
+                   PointerValue (),
+                   MakePointerAccessor (&PathlossMatrixPropagationLossModel::SetPropagationLossModel,
+                                        &PathlossMatrixPropagationLossModel::GetPropagationLossModel),
+                   MakePointerChecker<PropagationLossModel> ())
+  ;
+  return tid;
+}
+
+PathlossMatrixPropagationLossModel::PathlossMatrixPropagationLossModel ()
+  : PropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PathlossMatrixPropagationLossModel::~PathlossMatrixPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+PathlossMatrixPropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+  m_model = 0;
+  PropagationLossModel::DoDispose ();
+}
+
+void
+PathlossMatrixPropagationLossModel::SetPropagationLossModel (Ptr<PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  // the gains of these models are drawn at every call, so the matrix
+  // would freeze them at their first value
+  for (Ptr<PropagationLossModel> next = model; next != 0; next = next->GetNext ())
+    {
+      NS_ABORT_MSG_IF (DynamicCast<RandomPropagationLossModel> (next) != 0
+                       || DynamicCast<NakagamiPropagationLossModel> (next) != 0
+                       || DynamicCast<JakesPropagationLossModel> (next) != 0,
+                       next->GetInstanceTypeId ().GetName ()
+                       << " draws a new gain at every call and cannot be stored in a path loss matrix");
+    }
+  m_model = model;
+  // the gains of the previous model are meaningless now
+  m_gains.clear ();
+}
+
+Ptr<PropagationLossModel>
+PathlossMatrixPropagationLossModel::GetPropagationLossModel (void) const
+{
+  return m_model;
+}
+
+void
+PathlossMatrixPropagationLossModel::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  // the callbacks were connected from a const method
+  const PathlossMatrixPropagationLossModel *self = this;
+  for (std::vector<Endpoint>::const_iterator it = m_endpoints.begin (); it != m_endpoints.end (); ++it)
+    {
+      if (it->mobility == 0)
+        {
+          continue;
+        }
+      if (it->stationary)
+        {
+          it->mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                       MakeCallback (&PathlossMatrixPropagationLossModel::CourseChange, self));
+        }
+      it->mobility->GetObject<PathlossMatrixEndpointTracker> ()->Remove (this);
+    }
+  m_endpoints.clear ();
+  m_freeEndpoints.clear ();
+  m_endpointIndex.clear ();
+  m_gains.clear ();
+  m_loadedGains.clear ();
+}
+
+uint32_t
+PathlossMatrixPropagationLossModel::GetEndpoint (Ptr<MobilityModel> mobility) const
+{
+  OpenHashMap<const MobilityModel *, uint32_t, MobilityModelHash>::const_iterator it = m_endpointIndex.find (PeekPointer (mobility));
+  if (it != m_endpointIndex.end ())
+    {
+      return it->second;
+    }
+  Endpoint endpoint;
+  endpoint.mobility = PeekPointer (mobility);
+  Ptr<Node> node = mobility->GetObject<Node> ();
+  endpoint.nodeId = (node != 0) ? node->GetId () : std::numeric_limits<uint32_t>::max ();
+  // a ConstantPositionMobilityModel notifies every change of its position,
+  // which is not the case of the mobility models moving by themselves
+  endpoint.stationary = (DynamicCast<ConstantPositionMobilityModel> (mobility) != 0);
+  if (endpoint.stationary)
+    {
+      mobility->TraceConnectWithoutContext ("CourseChange",
+                                            MakeCallback (&PathlossMatrixPropagationLossModel::CourseChange, this));
+    }
+  // the matrix does not reference the mobility model, and is told when
+  // it is disposed
+  Ptr<PathlossMatrixEndpointTracker> tracker = mobility->GetObject<PathlossMatrixEndpointTracker> ();
+  if (tracker == 0)
+    {
+      tracker = CreateObject<PathlossMatrixEndpointTracker> (PeekPointer (mobility));
+      mobility->AggregateObject (tracker);
+    }
+  tracker->Add (this);
+  uint32_t index;
+  if (m_freeEndpoints.empty ())
+    {
+      index = m_endpoints.size ();
+      m_endpoints.push_back (endpoint);
+    }
+  else
+    {
+      index = m_freeEndpoints.back ();
+      m_freeEndpoints.pop_back ();
+      m_endpoints[index] = endpoint;
+    }
+  NS_LOG_LOGIC (this << " mobility model " << mobility << " of node " << endpoint.nodeId
+                     << " has index " << index << " stationary " << endpoint.stationary);
+  m_endpointIndex[PeekPointer (mobility)] = index;
+  return index;
+}
+
+void
+PathlossMatrixPropagationLossModel::CourseChange (Ptr<const MobilityModel> mobility) const
+{
+  NS_LOG_FUNCTION (this << mobility);
+  OpenHashMap<const MobilityModel *, uint32_t, MobilityModelHash>::const_iterator it = m_endpointIndex.find (PeekPointer (mobility));
+  NS_ASSERT (it != m_endpointIndex.end ());
+  InvalidateGains (it->second);
+}
+
+void
+PathlossMatrixPropagationLossModel::InvalidateGains (uint32_t index) const
+{
+  if (index < m_gains.size ())
+    {
+      m_gains[index].clear ();
+    }
+  for (std::vector<std::vector<Gain> >::iterator rowIt = m_gains.begin (); rowIt != m_gains.end (); ++rowIt)
+    {
+      if (index < rowIt->size ())
+        {
+          (*rowIt)[index].valid = false;
+        }
+    }
+}
+
+void
+PathlossMatrixPropagationLossModel::EvictEndpoint (MobilityModel *mobility) const
+{
+  NS_LOG_FUNCTION (this << mobility);
+  OpenHashMap<const MobilityModel *, uint32_t, MobilityModelHash>::iterator it = m_endpointIndex.find (mobility);
+  NS_ASSERT (it != m_endpointIndex.end ());
+  uint32_t index = it->second;
+  m_endpointIndex.erase (it);
+  Endpoint &endpoint = m_endpoints[index];
+  if (endpoint.stationary)
+    {
+      mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                               MakeCallback (&PathlossMatrixPropagationLossModel::CourseChange, this));
+    }
+  InvalidateGains (index);
+  endpoint.mobility = 0;
+  endpoint.nodeId = std::numeric_limits<uint32_t>::max ();
+  endpoint.stationary = false;
+  m_freeEndpoints.push_back (index);
+}
+
+double
+PathlossMatrixPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                                   Ptr<MobilityModel> a,
+                                                   Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model != 0, "PathlossMatrixPropagationLossModel without a PropagationLossModel");
+  uint32_t tx = GetEndpoint (a);
+  uint32_t rx = GetEndpoint (b);
+  const Endpoint &txEndpoint = m_endpoints[tx];
+  const Endpoint &rxEndpoint = m_endpoints[rx];
+  if (!txEndpoint.stationary || !rxEndpoint.stationary)
+    {
+      return m_model->CalcRxPower (txPowerDbm, a, b);
+    }
+
+  if (tx >= m_gains.size ())
+    {
+      m_gains.resize (tx + 1);
+    }
+  std::vector<Gain> &row = m_gains[tx];
+  if (rx >= row.size ())
+    {
+      row.resize (rx + 1);
+    }
+  Gain &gain = row[rx];
+  if (!gain.valid)
+    {
+      OpenHashMap<std::pair<uint32_t, uint32_t>, LoadedGain>::const_iterator loadedIt =
+        m_loadedGains.find (std::make_pair (txEndpoint.nodeId, rxEndpoint.nodeId));
+      if (loadedIt != m_loadedGains.end ()
+          && IsSamePosition (loadedIt->second.txPosition, a->GetPosition ())
+          && IsSamePosition (loadedIt->second.rxPosition, b->GetPosition ()))
+        {
+          gain.gainDb = loadedIt->second.gainDb;
+        }
+      else
+        {
+          gain.gainDb = m_model->CalcRxPower (0, a, b);
+        }
+      gain.valid = true;
+      NS_LOG_LOGIC (this << " gain from node " << txEndpoint.nodeId << " to node "
+                         << rxEndpoint.nodeId << " = " << gain.gainDb << " dB");
+    }
+  return txPowerDbm + gain.gainDb;
+}
+
+int64_t
+PathlossMatrixPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  if (m_model == 0)
+    {
+      return 0;
+    }
+  return m_model->AssignStreams (stream);
+}
+
+void
+PathlossMatrixPropagationLossModel::Save (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  // the loaded gains not used in this run are saved as well, and the
+  // records are sorted by node IDs so that the file does not depend on
+  // the order of the transmissions
+  std::map<std::pair<uint32_t, uint32_t>, PathlossMatrixRecord> records;
+  for (OpenHashMap<std::pair<uint32_t, uint32_t>, LoadedGain>::const_iterator it = m_loadedGains.begin ();
+       it != m_loadedGains.end (); ++it)
+    {
+      PathlossMatrixRecord &record = records[it->first];
+      record.txNodeId = it->first.first;
+      record.rxNodeId = it->first.second;
+      record.txPosition[0] = it->second.txPosition.x;
+      record.txPosition[1] = it->second.txPosition.y;
+      record.txPosition[2] = it->second.txPosition.z;
+      record.rxPosition[0] = it->second.rxPosition.x;
+      record.rxPosition[1] = it->second.rxPosition.y;
+      record.rxPosition[2] = it->second.rxPosition.z;
+      record.gainDb = it->second.gainDb;
+    }
+  for (uint32_t tx = 0; tx < m_gains.size (); ++tx)
+    {
+      const Endpoint &txEndpoint = m_endpoints[tx];
+      if (txEndpoint.nodeId == std::numeric_limits<uint32_t>::max ())
+        {
+          continue;
+        }
+      for (uint32_t rx = 0; rx < m_gains[tx].size (); ++rx)
+        {
+          const Endpoint &rxEndpoint = m_endpoints[rx];
+          if (!m_gains[tx][rx].valid || rxEndpoint.nodeId == std::numeric_limits<uint32_t>::max ())
+            {
+              continue;
+            }
+          Vector txPosition = txEndpoint.mobility->GetPosition ();
+          Vector rxPosition = rxEndpoint.mobility->GetPosition ();
+          PathlossMatrixRecord &record = records[std::make_pair (txEndpoint.nodeId, rxEndpoint.nodeId)];
+          record.txNodeId = txEndpoint.nodeId;
+          record.rxNodeId = rxEndpoint.nodeId;
+          record.txPosition[0] = txPosition.x;
+          record.txPosition[1] = txPosition.y;
+          record.txPosition[2] = txPosition.z;
+          record.rxPosition[0] = rxPosition.x;
+          record.rxPosition[1] = rxPosition.y;
+          record.rxPosition[2] = rxPosition.z;
+          record.gainDb = m_gains[tx][rx].gainDb;
+        }
+    }
+
+  PathlossMatrixHeader header;
+  std::memcpy (header.magic, g_pathlossMatrixMagic, sizeof (g_pathlossMatrixMagic));
+  header.gainsNum = records.size ();
+  header.reserved = 0;
+  std::ofstream ofs (filename.c_str (), std::ofstream::out | std::ofstream::binary);
+  NS_ABORT_MSG_IF (!ofs.good (), "Cannot open " << filename);
+  ofs.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  for (std::map<std::pair<uint32_t, uint32_t>, PathlossMatrixRecord>::const_iterator it = records.begin ();
+       it != records.end (); ++it)
+    {
+      ofs.write (reinterpret_cast<const char *> (&it->second), sizeof (PathlossMatrixRecord));
+    }
+  NS_ABORT_MSG_IF (!ofs.good (), "Cannot write " << filename);
+}
+
+void
+PathlossMatrixPropagationLossModel::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ifstream ifs (filename.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_ABORT_MSG_IF (!ifs.good (), "Cannot open " << filename);
+  PathlossMatrixHeader header;
+  ifs.read (reinterpret_cast<char *> (&header), sizeof (header));
+  NS_ABORT_MSG_IF (!ifs.good () || std::memcmp (header.magic, g_pathlossMatrixMagic, sizeof (g_pathlossMatrixMagic)) != 0,
+                   filename << " is not a path loss matrix file");
+  m_loadedGains.reserve (m_loadedGains.size () + header.gainsNum);
+  for (uint32_t i = 0; i < header.gainsNum; ++i)
+    {
+      PathlossMatrixRecord record;
+      ifs.read (reinterpret_cast<char *> (&record), sizeof (record));
+      NS_ABORT_MSG_IF (!ifs.good (), "Path loss matrix file " << filename << " is truncated");
+      LoadedGain &loaded = m_loadedGains[std::make_pair (record.txNodeId, record.rxNodeId)];
+      loaded.txPosition = Vector (record.txPosition[0], record.txPosition[1], record.txPosition[2]);
+      loaded.rxPosition = Vector (record.rxPosition[0], record.rxPosition[1], record.rxPosition[2]);
+      loaded.gainDb = record.gainDb;
+    }
+  NS_LOG_INFO (this << " loaded " << header.gainsNum << " gains from " << filename);
+}
+
+} // namespace ns3
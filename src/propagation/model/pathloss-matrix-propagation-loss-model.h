@@ -0,0 +1,215 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PATHLOSS_MATRIX_PROPAGATION_LOSS_MODEL_H
+#define PATHLOSS_MATRIX_PROPAGATION_LOSS_MODEL_H
+
+#include <ns3/propagation-loss-model.h>
+#include <ns3/open-hash-map.h>
+#include <ns3/vector.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+class PathlossMatrixEndpointTracker;
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Matrix of the propagation gains computed by another model
+ *        between stationary nodes
+ *
+ * This model wraps another PropagationLossModel (the PropagationLossModel
+ * attribute) and keeps the gain it returns for every (transmitter,
+ * receiver) pair of stationary nodes in a dense matrix, so that a
+ * deployment with costly path loss models (e.g., the buildings models)
+ * computes each pair only once. A node is stationary if its mobility
+ * model is a ConstantPositionMobilityModel; the gains of a node are
+ * recomputed after each change of its position. For the other nodes,
+ * the wrapped model is called every time.
+ *
+ * The gains of the pairs whose mobility models are aggregated to a Node
+ * can be saved to a binary file and loaded in another run, in which
+ * case the wrapped model is not called for the pairs found in the file.
+ * A pair is identified by the IDs of its nodes, and the loaded gain is
+ * used only if both nodes are at the positions they had when the file
+ * was saved.
+ *
+ * The wrapped model must return the same gain for the same positions,
+ * as the models with a fixed shadowing per pair do, while models
+ * varying in time or drawing a random gain at every call would be frozen
+ * at their first value. SetPropagationLossModel () therefore aborts if
+ * the wrapped model, or a model chained to it, is a
+ * RandomPropagationLossModel, a NakagamiPropagationLossModel or a
+ * JakesPropagationLossModel. A gain is computed with a transmission
+ * power of 0 dBm, and the model must be independent of the transmission
+ * power.
+ *
+ * The matrix does not keep the mobility models alive: a mobility model
+ * and its gains are removed from the matrix when it is disposed, so that
+ * short-lived mobility models do not make the matrix grow.
+ */
+class PathlossMatrixPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  PathlossMatrixPropagationLossModel ();
+  virtual ~PathlossMatrixPropagationLossModel ();
+
+  /**
+   * \param model the model whose gains are stored in the matrix, which
+   *        must not draw a new gain at every call
+   */
+  void SetPropagationLossModel (Ptr<PropagationLossModel> model);
+
+  /**
+   * \return the model whose gains are stored in the matrix
+   */
+  Ptr<PropagationLossModel> GetPropagationLossModel (void) const;
+
+  /**
+   * Forget all the computed and loaded gains.
+   */
+  void Clear (void);
+
+  /**
+   * Save the gains computed or loaded so far between nodes, except the
+   * computed gains of the nodes already disposed.
+   *
+   * \param filename the name of the binary file
+   */
+  void Save (std::string filename) const;
+
+  /**
+   * Load gains saved by Save (), which are added to the matrix.
+   *
+   * \param filename the name of the binary file
+   */
+  void Load (std::string filename);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  friend class PathlossMatrixEndpointTracker;
+
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  PathlossMatrixPropagationLossModel (const PathlossMatrixPropagationLossModel &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  PathlossMatrixPropagationLossModel & operator = (const PathlossMatrixPropagationLossModel &);
+
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /**
+   * \param mobility a mobility model
+   * \return the index of the mobility model in the matrix, which is
+   *         added to the matrix if needed
+   */
+  uint32_t GetEndpoint (Ptr<MobilityModel> mobility) const;
+
+  /**
+   * Invalidate the gains of a node whose position changed.
+   * \param mobility the mobility model of the node
+   */
+  void CourseChange (Ptr<const MobilityModel> mobility) const;
+
+  /**
+   * Invalidate the gains from and to a mobility model.
+   * \param index the index of the mobility model in the matrix
+   */
+  void InvalidateGains (uint32_t index) const;
+
+  /**
+   * Remove a mobility model being disposed from the matrix, whose index
+   * is reused by the next mobility model.
+   * \param mobility the mobility model
+   */
+  void EvictEndpoint (MobilityModel *mobility) const;
+
+  /// A mobility model known to the matrix
+  struct Endpoint
+  {
+    MobilityModel *mobility;     //!< the mobility model, not referenced, or 0 if evicted
+    uint32_t nodeId;             //!< ID of the node, or UINT32_MAX if none
+    bool stationary;             //!< whether the gains can be stored
+  };
+
+  /// A gain of the matrix
+  struct Gain
+  {
+    Gain () : valid (false) {}
+    double gainDb; //!< the gain, in dB
+    bool valid;    //!< whether gainDb has been computed
+  };
+
+  /// A gain loaded from a file
+  struct LoadedGain
+  {
+    Vector txPosition; //!< the position of the transmitter
+    Vector rxPosition; //!< the position of the receiver
+    double gainDb;     //!< the gain, in dB
+  };
+
+  /// Hash of the mobility model pointers
+  struct MobilityModelHash
+  {
+    /**
+     * \param mobility a mobility model
+     * \return the hash of its address
+     */
+    size_t operator() (const MobilityModel *mobility) const
+    {
+      return reinterpret_cast<size_t> (mobility);
+    }
+  };
+
+  Ptr<PropagationLossModel> m_model; //!< the wrapped model
+
+  /// the mobility models known to the matrix, in order of index
+  mutable std::vector<Endpoint> m_endpoints;
+  /// indices of m_endpoints freed by evicted mobility models
+  mutable std::vector<uint32_t> m_freeEndpoints;
+  /// index of each mobility model in m_endpoints
+  mutable OpenHashMap<const MobilityModel *, uint32_t, MobilityModelHash> m_endpointIndex;
+  /// the gains, m_gains[tx][rx], rows are resized when needed
+  mutable std::vector<std::vector<Gain> > m_gains;
+  /// the gains loaded from files, indexed by (tx node ID, rx node ID)
+  OpenHashMap<std::pair<uint32_t, uint32_t>, LoadedGain> m_loadedGains;
+};
+
+} // namespace ns3
+
+#endif /* PATHLOSS_MATRIX_PROPAGATION_LOSS_MODEL_H */
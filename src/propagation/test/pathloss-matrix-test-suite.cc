@@ -0,0 +1,368 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/pathloss-matrix-propagation-loss-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/node.h>
+#include <ns3/simulator.h>
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("PathlossMatrixPropagationLossModelTest");
+
+/**
+ * \param position the initial position
+ * \param mobile whether the node moves by itself
+ * \return the mobility model of a new node
+ */
+static Ptr<MobilityModel>
+CreateNodeMobility (Vector position, bool mobile)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<MobilityModel> mobility;
+  if (mobile)
+    {
+      Ptr<ConstantVelocityMobilityModel> cvmm = CreateObject<ConstantVelocityMobilityModel> ();
+      cvmm->SetVelocity (Vector (10.0, 0.0, 0.0));
+      mobility = cvmm;
+    }
+  else
+    {
+      mobility = CreateObject<ConstantPositionMobilityModel> ();
+    }
+  mobility->SetPosition (position);
+  node->AggregateObject (mobility);
+  return mobility;
+}
+
+/**
+ * Deterministic model which counts its calls, so that the tests can tell
+ * whether a gain comes from the matrix.
+ */
+class CountingPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  CountingPropagationLossModel ();
+
+  /**
+   * \return the number of gains computed so far
+   */
+  uint32_t GetCalls (void) const;
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  mutable uint32_t m_calls; //!< number of gains computed so far
+};
+
+TypeId
+CountingPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CountingPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CountingPropagationLossModel> ()
+  ;
+  return tid;
+}
+
+CountingPropagationLossModel::CountingPropagationLossModel ()
+  : m_calls (0)
+{
+}
+
+uint32_t
+CountingPropagationLossModel::GetCalls (void) const
+{
+  return m_calls;
+}
+
+double
+CountingPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                             Ptr<MobilityModel> a,
+                                             Ptr<MobilityModel> b) const
+{
+  ++m_calls;
+  // not symmetric, so that both directions have their own gain
+  return txPowerDbm - 40.0 - 0.1 * a->GetDistanceFrom (b) - 0.01 * a->GetPosition ().x;
+}
+
+int64_t
+CountingPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  return 0;
+}
+
+/**
+ * Check that the matrix returns the gains of the wrapped model and
+ * stores the gains between stationary nodes only.
+ */
+class PathlossMatrixTestCase : public TestCase
+{
+public:
+  PathlossMatrixTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PathlossMatrixTestCase::PathlossMatrixTestCase ()
+  : TestCase ("Gains stored between stationary nodes")
+{
+}
+
+void
+PathlossMatrixTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateNodeMobility (Vector (0.0, 0.0, 30.0), false);
+  Ptr<MobilityModel> b = CreateNodeMobility (Vector (250.0, 40.0, 1.5), false);
+  Ptr<MobilityModel> c = CreateNodeMobility (Vector (-80.0, 10.0, 1.5), true);
+
+  // same gains as the wrapped model
+  Ptr<PropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<PathlossMatrixPropagationLossModel> matrix = CreateObject<PathlossMatrixPropagationLossModel> ();
+  matrix->SetPropagationLossModel (logDistance);
+  NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, b), logDistance->CalcRxPower (0.0, a, b), "wrong gain");
+  NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, b, a), logDistance->CalcRxPower (0.0, b, a), "wrong gain");
+  NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, b), logDistance->CalcRxPower (0.0, a, b), "wrong stored gain");
+  NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, c), logDistance->CalcRxPower (0.0, a, c), "wrong gain");
+
+  Ptr<CountingPropagationLossModel> counting = CreateObject<CountingPropagationLossModel> ();
+  matrix->SetPropagationLossModel (counting);
+  double gain = matrix->CalcRxPower (0.0, a, b);
+  NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, b), gain, "wrong stored gain");
+  NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (10.0, a, b), 10.0 + gain, "wrong transmission power");
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), 1, "gain not stored");
+  NS_TEST_ASSERT_MSG_NE (matrix->CalcRxPower (0.0, b, a), gain, "same gain in both directions");
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), 2, "gain of the other direction not computed");
+
+  // a node moving by itself is never stored
+  matrix->CalcRxPower (0.0, a, c);
+  matrix->CalcRxPower (0.0, a, c);
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), 4, "gain of a mobile node stored");
+
+  // the gains of a stationary node are recomputed when it is moved
+  b->SetPosition (Vector (260.0, 40.0, 1.5));
+  double newGain = matrix->CalcRxPower (0.0, a, b);
+  NS_TEST_ASSERT_MSG_NE (newGain, gain, "gain not recomputed after a move");
+  NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, b), newGain, "gain not stored after a move");
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), 5, "gain not stored after a move");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Check that the matrix returns the gains of the wrapped model after
+ * each move of the transmitter or of the receiver.
+ */
+class PathlossMatrixMoveTestCase : public TestCase
+{
+public:
+  PathlossMatrixMoveTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PathlossMatrixMoveTestCase::PathlossMatrixMoveTestCase ()
+  : TestCase ("Gains of the wrapped model after a move")
+{
+}
+
+void
+PathlossMatrixMoveTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateNodeMobility (Vector (0.0, 0.0, 30.0), false);
+  Ptr<MobilityModel> b = CreateNodeMobility (Vector (250.0, 40.0, 1.5), false);
+  Ptr<MobilityModel> c = CreateNodeMobility (Vector (-80.0, 10.0, 1.5), false);
+  Ptr<PropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<PathlossMatrixPropagationLossModel> matrix = CreateObject<PathlossMatrixPropagationLossModel> ();
+  matrix->SetPropagationLossModel (logDistance);
+
+  const Vector positions[] = { Vector (300.0, 40.0, 1.5), Vector (20.0, -500.0, 1.5), Vector (250.0, 40.0, 1.5) };
+  for (uint32_t i = 0; i < sizeof (positions) / sizeof (positions[0]); ++i)
+    {
+      // move the receiver of a -> b and the transmitter of b -> a
+      b->SetPosition (positions[i]);
+      NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, b), logDistance->CalcRxPower (0.0, a, b),
+                             "wrong gain after a move of the receiver");
+      NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, b, a), logDistance->CalcRxPower (0.0, b, a),
+                             "wrong gain after a move of the transmitter");
+      // the gains between the nodes which did not move are still valid
+      NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, c), logDistance->CalcRxPower (0.0, a, c),
+                             "wrong gain between nodes which did not move");
+      NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, c, b), logDistance->CalcRxPower (0.0, c, b),
+                             "wrong gain after a move of the receiver");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Check that the matrix does not keep the mobility models alive, and
+ * forgets the gains of a mobility model when it is disposed.
+ */
+class PathlossMatrixEvictionTestCase : public TestCase
+{
+public:
+  PathlossMatrixEvictionTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PathlossMatrixEvictionTestCase::PathlossMatrixEvictionTestCase ()
+  : TestCase ("Mobility models removed from the matrix when disposed")
+{
+}
+
+void
+PathlossMatrixEvictionTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateNodeMobility (Vector (0.0, 0.0, 30.0), false);
+  Ptr<CountingPropagationLossModel> counting = CreateObject<CountingPropagationLossModel> ();
+  Ptr<PathlossMatrixPropagationLossModel> matrix = CreateObject<PathlossMatrixPropagationLossModel> ();
+  matrix->SetPropagationLossModel (counting);
+
+  // a transient mobility model without a node, as used for a point of a REM
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      Ptr<MobilityModel> point = CreateObject<ConstantPositionMobilityModel> ();
+      point->SetPosition (Vector (100.0 + 10.0 * i, 0.0, 1.5));
+      uint32_t references = point->GetReferenceCount ();
+      double gain = matrix->CalcRxPower (0.0, a, point);
+      NS_TEST_ASSERT_MSG_EQ (point->GetReferenceCount (), references, "mobility model referenced by the matrix");
+      NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, point), gain, "wrong stored gain");
+      NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), i + 1, "gain not computed for a new mobility model");
+    }
+
+  // disposing a node removes its mobility model and its gains from the
+  // matrix, which then saves the same file as an empty matrix
+  Ptr<MobilityModel> b = CreateNodeMobility (Vector (250.0, 40.0, 1.5), false);
+  matrix->CalcRxPower (0.0, a, b);
+  b->GetObject<Node> ()->Dispose ();
+  b = 0;
+  std::string filename = CreateTempDirFilename ("pathloss-matrix-evicted.bin");
+  matrix->Save (filename);
+  std::string emptyFilename = CreateTempDirFilename ("pathloss-matrix-empty.bin");
+  CreateObject<PathlossMatrixPropagationLossModel> ()->Save (emptyFilename);
+  std::ifstream file (filename.c_str (), std::ifstream::binary | std::ifstream::ate);
+  std::ifstream emptyFile (emptyFilename.c_str (), std::ifstream::binary | std::ifstream::ate);
+  NS_TEST_ASSERT_MSG_EQ (file.tellg (), emptyFile.tellg (), "gain of a disposed node saved");
+
+  // the matrix can be disposed before the mobility models
+  matrix->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * Check that the gains saved to a file are used by another matrix as long
+ * as the nodes are at the saved positions.
+ */
+class PathlossMatrixFileTestCase : public TestCase
+{
+public:
+  PathlossMatrixFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PathlossMatrixFileTestCase::PathlossMatrixFileTestCase ()
+  : TestCase ("Gains saved to and loaded from a file")
+{
+}
+
+void
+PathlossMatrixFileTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateNodeMobility (Vector (0.0, 0.0, 30.0), false);
+  Ptr<MobilityModel> b = CreateNodeMobility (Vector (250.0, 40.0, 1.5), false);
+  Ptr<MobilityModel> c = CreateNodeMobility (Vector (-80.0, 10.0, 1.5), false);
+  std::string filename = CreateTempDirFilename ("pathloss-matrix.bin");
+
+  Ptr<CountingPropagationLossModel> counting = CreateObject<CountingPropagationLossModel> ();
+  Ptr<PathlossMatrixPropagationLossModel> saved = CreateObject<PathlossMatrixPropagationLossModel> ();
+  saved->SetPropagationLossModel (counting);
+  double gainAb = saved->CalcRxPower (0.0, a, b);
+  double gainAc = saved->CalcRxPower (0.0, a, c);
+  saved->Save (filename);
+
+  Ptr<PathlossMatrixPropagationLossModel> loaded = CreateObject<PathlossMatrixPropagationLossModel> ();
+  loaded->SetPropagationLossModel (counting);
+  loaded->Load (filename);
+  uint32_t calls = counting->GetCalls ();
+  NS_TEST_ASSERT_MSG_EQ (loaded->CalcRxPower (0.0, a, b), gainAb, "wrong loaded gain");
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), calls, "loaded gain not used");
+  loaded->CalcRxPower (0.0, b, a);
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), calls + 1, "gain loaded for a pair not saved");
+
+  // a node moved since the file was saved
+  c->SetPosition (Vector (-90.0, 10.0, 1.5));
+  NS_TEST_ASSERT_MSG_NE (loaded->CalcRxPower (0.0, a, c), gainAc, "loaded gain used at another position");
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), calls + 2, "loaded gain used at another position");
+
+  // the gains loaded and not used are saved again
+  Ptr<PathlossMatrixPropagationLossModel> resaved = CreateObject<PathlossMatrixPropagationLossModel> ();
+  resaved->SetPropagationLossModel (counting);
+  resaved->Load (filename);
+  resaved->Save (filename);
+  c->SetPosition (Vector (-80.0, 10.0, 1.5));
+  loaded = CreateObject<PathlossMatrixPropagationLossModel> ();
+  loaded->SetPropagationLossModel (counting);
+  loaded->Load (filename);
+  calls = counting->GetCalls ();
+  NS_TEST_ASSERT_MSG_EQ (loaded->CalcRxPower (0.0, a, b), gainAb, "gain lost when saved again");
+  NS_TEST_ASSERT_MSG_EQ (loaded->CalcRxPower (0.0, a, c), gainAc, "gain lost when saved again");
+  NS_TEST_ASSERT_MSG_EQ (counting->GetCalls (), calls, "gain lost when saved again");
+
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Test suite for the PathlossMatrixPropagationLossModel.
+ */
+class PathlossMatrixTestSuite : public TestSuite
+{
+public:
+  PathlossMatrixTestSuite ();
+};
+
+PathlossMatrixTestSuite::PathlossMatrixTestSuite ()
+  : TestSuite ("pathloss-matrix", UNIT)
+{
+  AddTestCase (new PathlossMatrixTestCase (), TestCase::QUICK);
+  AddTestCase (new PathlossMatrixMoveTestCase (), TestCase::QUICK);
+  AddTestCase (new PathlossMatrixEvictionTestCase (), TestCase::QUICK);
+  AddTestCase (new PathlossMatrixFileTestCase (), TestCase::QUICK);
+}
+
+static PathlossMatrixTestSuite pathlossMatrixTestSuite;
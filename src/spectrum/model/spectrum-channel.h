@@ -64,6 +64,18 @@ public:
    */
   virtual void AddSpectrumPropagationLossModel (Ptr<SpectrumPropagationLossModel> loss) = 0;
 
+  /**
+   * \return the single-frequency propagation loss model in use, or 0 if
+   * none has been set
+   */
+  virtual Ptr<PropagationLossModel> GetPropagationLossModel (void) = 0;
+
+  /**
+   * \return the frequency-dependent propagation loss model in use, or 0
+   * if none has been set
+   */
+  virtual Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void) = 0;
+
   /**
    * set the  propagation delay model to be used
    * \param delay Ptr to the propagation delay model to be used.
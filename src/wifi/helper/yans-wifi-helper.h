@@ -297,10 +297,12 @@ private:
                                     Ptr<NetDevice> nd,
                                     bool explicitFilename);
 
-  ObjectFactory m_phy;
-  ObjectFactory m_errorRateModel;
   Ptr<YansWifiChannel> m_channel;
   uint32_t m_pcapDlt;
+
+protected:
+  ObjectFactory m_phy;            //!< Factory of the PHY objects
+  ObjectFactory m_errorRateModel; //!< Factory of the error rate models
 };
 
 } //namespace ns3
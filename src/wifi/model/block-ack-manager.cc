@@ -31,12 +31,14 @@
 #include "wifi-mac-queue.h"
 #include "mac-tx-middle.h"
 #include "qos-utils.h"
+#include <cstring>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("BlockAckManager");
 
 BlockAckManager::Item::Item ()
+  : retryOrder (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -44,7 +46,8 @@ BlockAckManager::Item::Item ()
 BlockAckManager::Item::Item (Ptr<const Packet> packet, const WifiMacHeader &hdr, Time tStamp)
   : packet (packet),
     hdr (hdr),
-    timestamp (tStamp)
+    timestamp (tStamp),
+    retryOrder (0)
 {
   NS_LOG_FUNCTION (this << packet << hdr << tStamp);
 }
@@ -63,7 +66,61 @@ Bar::Bar (Ptr<const Packet> bar, Mac48Address recipient, uint8_t tid, bool immed
   NS_LOG_FUNCTION (this << bar << recipient << static_cast<uint32_t> (tid) << immediate);
 }
 
+BlockAckManager::SequenceBitmap::SequenceBitmap ()
+  : m_count (0)
+{
+  std::memset (m_bits, 0, sizeof (m_bits));
+}
+
+bool
+BlockAckManager::SequenceBitmap::IsSet (uint16_t seq) const
+{
+  seq %= 4096;
+  return (m_bits[seq >> 6] >> (seq & 63)) & 1;
+}
+
+bool
+BlockAckManager::SequenceBitmap::Set (uint16_t seq)
+{
+  seq %= 4096;
+  uint64_t mask = static_cast<uint64_t> (1) << (seq & 63);
+  if (m_bits[seq >> 6] & mask)
+    {
+      return false;
+    }
+  m_bits[seq >> 6] |= mask;
+  m_count++;
+  return true;
+}
+
+bool
+BlockAckManager::SequenceBitmap::Reset (uint16_t seq)
+{
+  seq %= 4096;
+  uint64_t mask = static_cast<uint64_t> (1) << (seq & 63);
+  if (!(m_bits[seq >> 6] & mask))
+    {
+      return false;
+    }
+  m_bits[seq >> 6] &= ~mask;
+  m_count--;
+  return true;
+}
+
+uint32_t
+BlockAckManager::SequenceBitmap::GetCount (void) const
+{
+  return m_count;
+}
+
+BlockAckManager::AgreementEntry::AgreementEntry (const OriginatorBlockAckAgreement &agreement)
+  : agreement (agreement)
+{
+}
+
 BlockAckManager::BlockAckManager ()
+  : m_nRetryPackets (0),
+    m_retryOrder (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -73,7 +130,7 @@ BlockAckManager::~BlockAckManager ()
   NS_LOG_FUNCTION (this);
   m_queue = 0;
   m_agreements.clear ();
-  m_retryPackets.clear ();
+  m_nRetryPackets = 0;
 }
 
 bool
@@ -95,13 +152,13 @@ BlockAckManager::ExistsAgreementInState (Mac48Address recipient, uint8_t tid,
       switch (state)
         {
         case OriginatorBlockAckAgreement::INACTIVE:
-          return it->second.first.IsInactive ();
+          return it->second.agreement.IsInactive ();
         case OriginatorBlockAckAgreement::ESTABLISHED:
-          return it->second.first.IsEstablished ();
+          return it->second.agreement.IsEstablished ();
         case OriginatorBlockAckAgreement::PENDING:
-          return it->second.first.IsPending ();
+          return it->second.agreement.IsPending ();
         case OriginatorBlockAckAgreement::UNSUCCESSFUL:
-          return it->second.first.IsUnsuccessful ();
+          return it->second.agreement.IsUnsuccessful ();
         default:
           NS_FATAL_ERROR ("Invalid state for block ack agreement");
         }
@@ -132,9 +189,7 @@ BlockAckManager::CreateAgreement (const MgtAddBaRequestHeader *reqHdr, Mac48Addr
       agreement.SetDelayedBlockAck ();
     }
   agreement.SetState (OriginatorBlockAckAgreement::PENDING);
-  PacketQueue queue (0);
-  std::pair<OriginatorBlockAckAgreement, PacketQueue> value (agreement, queue);
-  m_agreements.insert (std::make_pair (key, value));
+  m_agreements.insert (std::make_pair (key, AgreementEntry (agreement)));
   m_blockPackets (recipient, reqHdr->GetTid ());
 }
 
@@ -145,17 +200,7 @@ BlockAckManager::DestroyAgreement (Mac48Address recipient, uint8_t tid)
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   if (it != m_agreements.end ())
     {
-      for (std::list<PacketQueueI>::iterator i = m_retryPackets.begin (); i != m_retryPackets.end (); )
-        {
-          if ((*i)->hdr.GetAddr1 () == recipient && (*i)->hdr.GetQosTid () == tid)
-            {
-              i = m_retryPackets.erase (i);
-            }
-          else
-            {
-              i++;
-            }
-        }
+      m_nRetryPackets -= it->second.retrying.GetCount ();
       m_agreements.erase (it);
       //remove scheduled bar
       for (std::list<Bar>::iterator i = m_bars.begin (); i != m_bars.end (); )
@@ -180,7 +225,7 @@ BlockAckManager::UpdateAgreement (const MgtAddBaResponseHeader *respHdr, Mac48Ad
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   if (it != m_agreements.end ())
     {
-      OriginatorBlockAckAgreement& agreement = it->second.first;
+      OriginatorBlockAckAgreement& agreement = it->second.agreement;
       agreement.SetBufferSize (respHdr->GetBufferSize () + 1);
       agreement.SetTimeout (respHdr->GetTimeout ());
       agreement.SetAmsduSupport (respHdr->IsAmsduSupported ());
@@ -217,23 +262,26 @@ BlockAckManager::StorePacket (Ptr<const Packet> packet, const WifiMacHeader &hdr
   Item item (packet, hdr, tStamp);
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (it != m_agreements.end ());
-  PacketQueueI queueIt = it->second.second.begin ();
-  for (; queueIt != it->second.second.end (); )
+  PacketQueue &queue = it->second.packets;
+  /* The queue is ordered by sequence number and packets are nearly always
+     stored in transmission order, so look for the insertion point from
+     the tail. */
+  PacketQueueI queueIt = queue.end ();
+  while (queueIt != queue.begin ())
     {
-      if (((hdr.GetSequenceNumber () - queueIt->hdr.GetSequenceNumber () + 4096) % 4096) > 2047)
+      PacketQueueI prev = queueIt;
+      prev--;
+      if (((hdr.GetSequenceNumber () - prev->hdr.GetSequenceNumber () + 4096) % 4096) > 2047)
         {
-          queueIt = it->second.second.insert (queueIt, item);
-          break;
+          queueIt = prev;
         }
       else
         {
-          queueIt++;
+          break;
         }
     }
-  if (queueIt == it->second.second.end ())
-    {
-      it->second.second.push_back (item);
-    }
+  queue.insert (queueIt, item);
+  it->second.buffered.Set (hdr.GetSequenceNumber ());
 }
 
 void
@@ -241,7 +289,7 @@ BlockAckManager::CompleteAmpduExchange (Mac48Address recipient, uint8_t tid)
 {
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (it != m_agreements.end ());
-  OriginatorBlockAckAgreement &agreement = (*it).second.first;
+  OriginatorBlockAckAgreement &agreement = (*it).second.agreement;
   agreement.CompleteExchange ();
 }
 
@@ -250,74 +298,62 @@ BlockAckManager::GetNextPacket (WifiMacHeader &hdr)
 {
   NS_LOG_FUNCTION (this << &hdr);
   Ptr<const Packet> packet = 0;
-  uint8_t tid;
-  Mac48Address recipient;
   CleanupBuffers ();
-  if (!m_retryPackets.empty ())
+  if (m_nRetryPackets == 0)
+    {
+      return packet;
+    }
+  NS_LOG_DEBUG ("Retry buffer size is " << m_nRetryPackets);
+  AgreementsI agreement;
+  while ((agreement = GetNextRetryAgreement ()) != m_agreements.end ())
     {
-      NS_LOG_DEBUG ("Retry buffer size is " << m_retryPackets.size ());
-      std::list<PacketQueueI>::iterator it = m_retryPackets.begin ();
-      while (it != m_retryPackets.end ())
+      AgreementEntry &entry = agreement->second;
+      RetryQueue::iterator it = entry.retries.begin ();
+      if (!(*it)->hdr.IsQosData ())
         {
-          if ((*it)->hdr.IsQosData ())
-            {
-              tid = (*it)->hdr.GetQosTid ();
-            }
-          else
-            {
-              NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-            }
-          recipient = (*it)->hdr.GetAddr1 ();
-          AgreementsI agreement = m_agreements.find (std::make_pair (recipient, tid));
-          NS_ASSERT (agreement != m_agreements.end ());
-          if (QosUtilsIsOldPacket (agreement->second.first.GetStartingSequence (),(*it)->hdr.GetSequenceNumber ()))
-            {
-              //Standard says the originator should not send a packet with seqnum < winstart
-              NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << agreement->second.first.GetStartingSequence ());
-              agreement->second.second.erase ((*it));
-              it = m_retryPackets.erase (it);
-              continue;
-            }
-          else if ((*it)->hdr.GetSequenceNumber () > (agreement->second.first.GetStartingSequence () + 63) % 4096)
-            {
-              agreement->second.first.SetStartingSequence ((*it)->hdr.GetSequenceNumber ());
-            }
-          packet = (*it)->packet->Copy ();
-          hdr = (*it)->hdr;
-          hdr.SetRetry ();
-          NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
-          if (hdr.IsQosData ())
-            {
-              tid = hdr.GetQosTid ();
-            }
-          else
-            {
-              NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-            }
-          recipient = hdr.GetAddr1 ();
-          if (!agreement->second.first.IsHtSupported ()
-              && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
-                  || SwitchToBlockAckIfNeeded (recipient, tid, hdr.GetSequenceNumber ())))
-            {
-              hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
-            }
-          else
-            {
-              /* From section 9.10.3 in IEEE802.11e standard:
-               * In order to improve efficiency, originators using the Block Ack facility
-               * may send MPDU frames with the Ack Policy subfield in QoS control frames
-               * set to Normal Ack if only a few MPDUs are available for transmission.[...]
-               * When there are sufficient number of MPDUs, the originator may switch back to
-               * the use of Block Ack.
-               */
-              hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
-              AgreementsI i = m_agreements.find (std::make_pair (recipient, tid));
-              i->second.second.erase (*it);
-            }
-          it = m_retryPackets.erase (it);
-          NS_LOG_DEBUG ("Removed one packet, retry buffer size = " << m_retryPackets.size () );
-          break;
+          NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
+        }
+      if (QosUtilsIsOldPacket (entry.agreement.GetStartingSequence (),(*it)->hdr.GetSequenceNumber ()))
+        {
+          //Standard says the originator should not send a packet with seqnum < winstart
+          NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << entry.agreement.GetStartingSequence ());
+          PacketQueueI item = *it;
+          RemoveFromRetryQueue (entry, it);
+          ErasePacket (entry, item);
+          continue;
+        }
+      else if ((*it)->hdr.GetSequenceNumber () > (entry.agreement.GetStartingSequence () + 63) % 4096)
+        {
+          entry.agreement.SetStartingSequence ((*it)->hdr.GetSequenceNumber ());
+        }
+      PacketQueueI item = *it;
+      packet = item->packet->Copy ();
+      hdr = item->hdr;
+      hdr.SetRetry ();
+      NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
+      uint8_t tid = hdr.GetQosTid ();
+      Mac48Address recipient = hdr.GetAddr1 ();
+      RemoveFromRetryQueue (entry, it);
+      if (!entry.agreement.IsHtSupported ()
+          && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
+              || SwitchToBlockAckIfNeeded (recipient, tid, hdr.GetSequenceNumber ())))
+        {
+          hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
+        }
+      else
+        {
+          /* From section 9.10.3 in IEEE802.11e standard:
+           * In order to improve efficiency, originators using the Block Ack facility
+           * may send MPDU frames with the Ack Policy subfield in QoS control frames
+           * set to Normal Ack if only a few MPDUs are available for transmission.[...]
+           * When there are sufficient number of MPDUs, the originator may switch back to
+           * the use of Block Ack.
+           */
+          hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
+          ErasePacket (entry, item);
         }
+      NS_LOG_DEBUG ("Removed one packet, retry buffer size = " << m_nRetryPackets);
+      return packet;
     }
   return packet;
 }
@@ -331,50 +367,47 @@ BlockAckManager::PeekNextPacket (WifiMacHeader &hdr, Mac48Address recipient, uin
   CleanupBuffers ();
   AgreementsI agreement = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (agreement != m_agreements.end ());
-  std::list<PacketQueueI>::iterator it = m_retryPackets.begin ();
-  for (; it != m_retryPackets.end (); it++)
+  AgreementEntry &entry = agreement->second;
+  RetryQueue::iterator it = entry.retries.begin ();
+  while (it != entry.retries.end ())
     {
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid)
+      if (QosUtilsIsOldPacket (entry.agreement.GetStartingSequence (),(*it)->hdr.GetSequenceNumber ()))
         {
-          if (QosUtilsIsOldPacket (agreement->second.first.GetStartingSequence (),(*it)->hdr.GetSequenceNumber ()))
-            {
-              //standard says the originator should not send a packet with seqnum < winstart
-              NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << agreement->second.first.GetStartingSequence ());
-              agreement->second.second.erase ((*it));
-              it = m_retryPackets.erase (it);
-              it--;
-              continue;
-            }
-          else if ((*it)->hdr.GetSequenceNumber () > (agreement->second.first.GetStartingSequence () + 63) % 4096)
-            {
-              agreement->second.first.SetStartingSequence ((*it)->hdr.GetSequenceNumber ());
-            }
-          packet = (*it)->packet->Copy ();
-          hdr = (*it)->hdr;
-          hdr.SetRetry ();
-          *tstamp = (*it)->timestamp;
-          NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
-          Mac48Address recipient = hdr.GetAddr1 ();
-          if (!agreement->second.first.IsHtSupported ()
-              && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
-                  || SwitchToBlockAckIfNeeded (recipient, tid, hdr.GetSequenceNumber ())))
-            {
-              hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
-            }
-          else
-            {
-              /* From section 9.10.3 in IEEE802.11e standard:
-               * In order to improve efficiency, originators using the Block Ack facility
-               * may send MPDU frames with the Ack Policy subfield in QoS control frames
-               * set to Normal Ack if only a few MPDUs are available for transmission.[...]
-               * When there are sufficient number of MPDUs, the originator may switch back to
-               * the use of Block Ack.
-               */
-              hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
-            }
-          NS_LOG_DEBUG ("Peeked one packet from retry buffer size = " << m_retryPackets.size () );
-          return packet;
+          //standard says the originator should not send a packet with seqnum < winstart
+          NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << entry.agreement.GetStartingSequence ());
+          PacketQueueI item = *it;
+          it = RemoveFromRetryQueue (entry, it);
+          ErasePacket (entry, item);
+          continue;
         }
+      else if ((*it)->hdr.GetSequenceNumber () > (entry.agreement.GetStartingSequence () + 63) % 4096)
+        {
+          entry.agreement.SetStartingSequence ((*it)->hdr.GetSequenceNumber ());
+        }
+      packet = (*it)->packet->Copy ();
+      hdr = (*it)->hdr;
+      hdr.SetRetry ();
+      *tstamp = (*it)->timestamp;
+      NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
+      if (!entry.agreement.IsHtSupported ()
+          && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
+              || SwitchToBlockAckIfNeeded (recipient, tid, hdr.GetSequenceNumber ())))
+        {
+          hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
+        }
+      else
+        {
+          /* From section 9.10.3 in IEEE802.11e standard:
+           * In order to improve efficiency, originators using the Block Ack facility
+           * may send MPDU frames with the Ack Policy subfield in QoS control frames
+           * set to Normal Ack if only a few MPDUs are available for transmission.[...]
+           * When there are sufficient number of MPDUs, the originator may switch back to
+           * the use of Block Ack.
+           */
+          hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
+        }
+      NS_LOG_DEBUG ("Peeked one packet from retry buffer size = " << m_nRetryPackets);
+      return packet;
     }
   return packet;
 }
@@ -382,21 +415,20 @@ BlockAckManager::PeekNextPacket (WifiMacHeader &hdr, Mac48Address recipient, uin
 bool
 BlockAckManager::RemovePacket (uint8_t tid, Mac48Address recipient, uint16_t seqnumber)
 {
-
-  std::list<PacketQueueI>::iterator it = m_retryPackets.begin ();
-  for (; it != m_retryPackets.end (); it++)
+  AgreementsI agreement = m_agreements.find (std::make_pair (recipient, tid));
+  if (agreement == m_agreements.end () || !agreement->second.retrying.IsSet (seqnumber))
+    {
+      return false;
+    }
+  AgreementEntry &entry = agreement->second;
+  for (RetryQueue::iterator it = entry.retries.begin (); it != entry.retries.end (); it++)
     {
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid && (*it)->hdr.GetSequenceNumber () == seqnumber)
+      if ((*it)->hdr.GetSequenceNumber () == seqnumber)
         {
-          WifiMacHeader hdr = (*it)->hdr;
-          uint8_t tid = hdr.GetQosTid ();
-          Mac48Address recipient = hdr.GetAddr1 ();
-
-          AgreementsI i = m_agreements.find (std::make_pair (recipient, tid));
-          i->second.second.erase ((*it));
-
-          m_retryPackets.erase (it);
-          NS_LOG_DEBUG ("Removed Packet from retry queue = " << hdr.GetSequenceNumber () << " " << (uint32_t) tid << " " << recipient << " Buffer Size = " << m_retryPackets.size ());
+          PacketQueueI item = *it;
+          RemoveFromRetryQueue (entry, it);
+          ErasePacket (entry, item);
+          NS_LOG_DEBUG ("Removed Packet from retry queue = " << seqnumber << " " << (uint32_t) tid << " " << recipient << " Buffer Size = " << m_nRetryPackets);
           return true;
         }
     }
@@ -420,30 +452,18 @@ bool
 BlockAckManager::HasPackets (void) const
 {
   NS_LOG_FUNCTION (this);
-  return (m_retryPackets.size () > 0 || m_bars.size () > 0);
+  return (m_nRetryPackets > 0 || m_bars.size () > 0);
 }
 
 uint32_t
 BlockAckManager::GetNBufferedPackets (Mac48Address recipient, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << recipient << static_cast<uint32_t> (tid));
-  uint32_t nPackets = 0;
-  if (ExistsAgreement (recipient, tid))
-    {
-      AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
-      PacketQueueCI queueIt = (*it).second.second.begin ();
-      uint16_t currentSeq = 0;
-      while (queueIt != (*it).second.second.end ())
-        {
-          currentSeq = (*queueIt).hdr.GetSequenceNumber ();
-          nPackets++;
-          /* a fragmented packet must be counted as one packet */
-          while (queueIt != (*it).second.second.end () && (*queueIt).hdr.GetSequenceNumber () == currentSeq)
-            {
-              queueIt++;
-            }
-        }
-      return nPackets;
+  AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
+  if (it != m_agreements.end ())
+    {
+      /* fragments share a sequence number, so a fragmented packet is counted as one packet */
+      return it->second.buffered.GetCount ();
     }
   return 0;
 }
@@ -452,31 +472,12 @@ uint32_t
 BlockAckManager::GetNRetryNeededPackets (Mac48Address recipient, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << recipient << static_cast<uint32_t> (tid));
-  uint32_t nPackets = 0;
-  uint16_t currentSeq = 0;
-  if (ExistsAgreement (recipient, tid))
+  AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
+  if (it != m_agreements.end ())
     {
-      std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-      while (it != m_retryPackets.end ())
-        {
-          if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid)
-            {
-              currentSeq = (*it)->hdr.GetSequenceNumber ();
-              nPackets++;
-              /* a fragmented packet must be counted as one packet */
-              while (it != m_retryPackets.end () && (*it)->hdr.GetSequenceNumber () == currentSeq)
-                {
-                  it++;
-                }
-            }
-          //go to next packet
-          if (it != m_retryPackets.end ())
-            {
-              it++;
-            }
-        }
+      return it->second.retrying.GetCount ();
     }
-  return nPackets;
+  return 0;
 }
 
 void
@@ -494,19 +495,11 @@ BlockAckManager::SetWifiRemoteStationManager (Ptr<WifiRemoteStationManager> mana
 }
 
 bool
-BlockAckManager::AlreadyExists (uint16_t currentSeq, Mac48Address recipient, uint8_t tid)
+BlockAckManager::AlreadyExists (uint16_t currentSeq, Mac48Address recipient, uint8_t tid) const
 {
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  while (it != m_retryPackets.end ())
-    {
-      NS_LOG_FUNCTION (this << (*it)->hdr.GetType ());
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid && currentSeq == (*it)->hdr.GetSequenceNumber ())
-        {
-          return true;
-        }
-      it++;
-    }
-  return false;
+  NS_LOG_FUNCTION (this << currentSeq << recipient << static_cast<uint32_t> (tid));
+  AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
+  return (it != m_agreements.end () && it->second.retrying.IsSet (currentSeq));
 }
 
 void
@@ -521,28 +514,29 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
         {
           bool foundFirstLost = false;
           AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
-          PacketQueueI queueEnd = it->second.second.end ();
+          AgreementEntry &entry = it->second;
+          PacketQueueI queueEnd = entry.packets.end ();
 
-          if (it->second.first.m_inactivityEvent.IsRunning ())
+          if (entry.agreement.m_inactivityEvent.IsRunning ())
             {
               /* Upon reception of a block ack frame, the inactivity timer at the
                  originator must be reset.
                  For more details see section 11.5.3 in IEEE802.11e standard */
-              it->second.first.m_inactivityEvent.Cancel ();
-              Time timeout = MicroSeconds (1024 * it->second.first.GetTimeout ());
-              it->second.first.m_inactivityEvent = Simulator::Schedule (timeout,
-                                                                        &BlockAckManager::InactivityTimeout,
-                                                                        this,
-                                                                        recipient, tid);
+              entry.agreement.m_inactivityEvent.Cancel ();
+              Time timeout = MicroSeconds (1024 * entry.agreement.GetTimeout ());
+              entry.agreement.m_inactivityEvent = Simulator::Schedule (timeout,
+                                                                       &BlockAckManager::InactivityTimeout,
+                                                                       this,
+                                                                       recipient, tid);
             }
           if (blockAck->IsBasic ())
             {
-              for (PacketQueueI queueIt = it->second.second.begin (); queueIt != queueEnd; )
+              for (PacketQueueI queueIt = entry.packets.begin (); queueIt != queueEnd; )
                 {
                   if (blockAck->IsFragmentReceived ((*queueIt).hdr.GetSequenceNumber (),
                                                     (*queueIt).hdr.GetFragmentNumber ()))
                     {
-                      queueIt = it->second.second.erase (queueIt);
+                      queueIt = ErasePacket (entry, queueIt);
                     }
                   else
                     {
@@ -550,21 +544,16 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
                         {
                           foundFirstLost = true;
                           sequenceFirstLost = (*queueIt).hdr.GetSequenceNumber ();
-                          (*it).second.first.SetStartingSequence (sequenceFirstLost);
+                          entry.agreement.SetStartingSequence (sequenceFirstLost);
                         }
-
-                      if (!AlreadyExists ((*queueIt).hdr.GetSequenceNumber (),recipient,tid))
-                        {
-                          InsertInRetryQueue (queueIt);
-                        }
-
+                      InsertInRetryQueue (entry, queueIt);
                       queueIt++;
                     }
                 }
             }
           else if (blockAck->IsCompressed ())
             {
-              for (PacketQueueI queueIt = it->second.second.begin (); queueIt != queueEnd; )
+              for (PacketQueueI queueIt = entry.packets.begin (); queueIt != queueEnd; )
                 {
                   if (blockAck->IsPacketReceived ((*queueIt).hdr.GetSequenceNumber ()))
                     {
@@ -578,7 +567,7 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
                             {
                               m_txOkCallback ((*queueIt).hdr);
                             }
-                          queueIt = it->second.second.erase (queueIt);
+                          queueIt = ErasePacket (entry, queueIt);
                         }
                     }
                   else
@@ -587,7 +576,7 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
                         {
                           foundFirstLost = true;
                           sequenceFirstLost = (*queueIt).hdr.GetSequenceNumber ();
-                          (*it).second.first.SetStartingSequence (sequenceFirstLost);
+                          entry.agreement.SetStartingSequence (sequenceFirstLost);
                         }
                       //notify remote station of unsuccessful transmission
                       m_stationManager->ReportDataFailed ((*queueIt).hdr.GetAddr1 (), &(*queueIt).hdr);
@@ -595,10 +584,7 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
                         {
                           m_txFailedCallback ((*queueIt).hdr);
                         }
-                      if (!AlreadyExists ((*queueIt).hdr.GetSequenceNumber (),recipient,tid))
-                        {
-                          InsertInRetryQueue (queueIt);
-                        }
+                      InsertInRetryQueue (entry, queueIt);
                       queueIt++;
                     }
                 }
@@ -607,7 +593,7 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
           if ((foundFirstLost && !SwitchToBlockAckIfNeeded (recipient, tid, sequenceFirstLost))
               || (!foundFirstLost && !SwitchToBlockAckIfNeeded (recipient, tid, newSeq)))
             {
-              it->second.first.CompleteExchange ();
+              entry.agreement.CompleteExchange ();
             }
         }
     }
@@ -637,11 +623,11 @@ BlockAckManager::ScheduleBlockAckReqIfNeeded (Mac48Address recipient, uint8_t ti
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (it != m_agreements.end ());
 
-  if ((*it).second.first.IsBlockAckRequestNeeded ()
+  if ((*it).second.agreement.IsBlockAckRequestNeeded ()
       || (GetNRetryNeededPackets (recipient, tid) == 0
           && m_queue->GetNPacketsByTidAndAddress (tid, WifiMacHeader::ADDR1, recipient) == 0))
     {
-      OriginatorBlockAckAgreement &agreement = (*it).second.first;
+      OriginatorBlockAckAgreement &agreement = (*it).second.agreement;
       agreement.CompleteExchange ();
 
       CtrlBAckRequestHeader reqHdr;
@@ -680,8 +666,8 @@ BlockAckManager::NotifyAgreementEstablished (Mac48Address recipient, uint8_t tid
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (it != m_agreements.end ());
 
-  it->second.first.SetState (OriginatorBlockAckAgreement::ESTABLISHED);
-  it->second.first.SetStartingSequence (startingSeq);
+  it->second.agreement.SetState (OriginatorBlockAckAgreement::ESTABLISHED);
+  it->second.agreement.SetStartingSequence (startingSeq);
 }
 
 void
@@ -692,7 +678,7 @@ BlockAckManager::NotifyAgreementUnsuccessful (Mac48Address recipient, uint8_t ti
   NS_ASSERT (it != m_agreements.end ());
   if (it != m_agreements.end ())
     {
-      it->second.first.SetState (OriginatorBlockAckAgreement::UNSUCCESSFUL);
+      it->second.agreement.SetState (OriginatorBlockAckAgreement::UNSUCCESSFUL);
     }
 }
 
@@ -705,21 +691,21 @@ BlockAckManager::NotifyMpduTransmission (Mac48Address recipient, uint8_t tid, ui
   NS_ASSERT (it != m_agreements.end ());
 
   uint16_t nextSeq;
-  if (GetNRetryNeededPackets (recipient, tid) > 0)
+  if (!it->second.retries.empty ())
     {
-      nextSeq = GetSeqNumOfNextRetryPacket (recipient, tid);
+      nextSeq = it->second.retries.front ()->hdr.GetSequenceNumber ();
     }
   else
     {
       nextSeq = nextSeqNumber;
     }
-  it->second.first.NotifyMpduTransmission (nextSeq);
+  it->second.agreement.NotifyMpduTransmission (nextSeq);
   if (policy == WifiMacHeader::BLOCK_ACK)
     {
       bar = ScheduleBlockAckReqIfNeeded (recipient, tid);
       if (bar != 0)
         {
-          Bar request (bar, recipient, tid, it->second.first.IsImmediateBlockAck ());
+          Bar request (bar, recipient, tid, it->second.agreement.IsImmediateBlockAck ());
           m_bars.push_back (request);
         }
     }
@@ -762,9 +748,10 @@ BlockAckManager::HasOtherFragments (uint16_t sequenceNumber) const
 {
   NS_LOG_FUNCTION (this << sequenceNumber);
   bool retVal = false;
-  if (m_retryPackets.size () > 0)
+  AgreementsCI it = GetNextRetryAgreement ();
+  if (it != m_agreements.end ())
     {
-      Item next = *(m_retryPackets.front ());
+      const Item &next = *(it->second.retries.front ());
       if (next.hdr.GetSequenceNumber () == sequenceNumber)
         {
           retVal = true;
@@ -778,9 +765,10 @@ BlockAckManager::GetNextPacketSize (void) const
 {
   NS_LOG_FUNCTION (this);
   uint32_t size = 0;
-  if (m_retryPackets.size () > 0)
+  AgreementsCI it = GetNextRetryAgreement ();
+  if (it != m_agreements.end ())
     {
-      Item next = *(m_retryPackets.front ());
+      const Item &next = *(it->second.retries.front ());
       size = next.packet->GetSize ();
     }
   return size;
@@ -792,7 +780,7 @@ bool BlockAckManager::NeedBarRetransmission (uint8_t tid, uint16_t seqNumber, Ma
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (it != m_agreements.end ());
   CleanupBuffers ();
-  if ((seqNumber + 63) < it->second.first.GetStartingSequence ())
+  if ((seqNumber + 63) < it->second.agreement.GetStartingSequence ())
     {
       return false;
     }
@@ -806,41 +794,40 @@ void
 BlockAckManager::CleanupBuffers (void)
 {
   NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
   for (AgreementsI j = m_agreements.begin (); j != m_agreements.end (); j++)
     {
-      if (j->second.second.empty ())
+      AgreementEntry &entry = j->second;
+      if (entry.packets.empty ())
         {
           continue;
         }
-      Time now = Simulator::Now ();
-      PacketQueueI end = j->second.second.begin ();
-      for (PacketQueueI i = j->second.second.begin (); i != j->second.second.end (); i++)
+      PacketQueueI end = entry.packets.begin ();
+      for (PacketQueueI i = entry.packets.begin (); i != entry.packets.end (); i++)
         {
           if (i->timestamp + m_maxDelay > now)
             {
               end = i;
               break;
             }
-          else
+          else if (entry.retrying.IsSet (i->hdr.GetSequenceNumber ()))
             {
               /* remove retry packet iterator if it's present in retry queue */
-              for (std::list<PacketQueueI>::iterator it = m_retryPackets.begin (); it != m_retryPackets.end (); )
+              for (RetryQueue::iterator it = entry.retries.begin (); it != entry.retries.end (); it++)
                 {
-                  if ((*it)->hdr.GetAddr1 () == j->second.first.GetPeer ()
-                      && (*it)->hdr.GetQosTid () == j->second.first.GetTid ()
-                      && (*it)->hdr.GetSequenceNumber () == i->hdr.GetSequenceNumber ())
+                  if ((*it)->hdr.GetSequenceNumber () == i->hdr.GetSequenceNumber ())
                     {
-                      it = m_retryPackets.erase (it);
-                    }
-                  else
-                    {
-                      it++;
+                      RemoveFromRetryQueue (entry, it);
+                      break;
                     }
                 }
             }
         }
-      j->second.second.erase (j->second.second.begin (), end);
-      j->second.first.SetStartingSequence (end->hdr.GetSequenceNumber ());
+      while (entry.packets.begin () != end)
+        {
+          ErasePacket (entry, entry.packets.begin ());
+        }
+      entry.agreement.SetStartingSequence (end->hdr.GetSequenceNumber ());
     }
 }
 
@@ -883,14 +870,10 @@ uint16_t
 BlockAckManager::GetSeqNumOfNextRetryPacket (Mac48Address recipient, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << recipient << static_cast<uint32_t> (tid));
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  while (it != m_retryPackets.end ())
+  AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
+  if (it != m_agreements.end () && !it->second.retries.empty ())
     {
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid)
-        {
-          return (*it)->hdr.GetSequenceNumber ();
-        }
-      it++;
+      return it->second.retries.front ()->hdr.GetSequenceNumber ();
     }
   return 4096;
 }
@@ -908,32 +891,110 @@ BlockAckManager::SetTxFailedCallback (TxFailed callback)
 }
 
 void
-BlockAckManager::InsertInRetryQueue (PacketQueueI item)
+BlockAckManager::InsertInRetryQueue (AgreementEntry &entry, PacketQueueI item)
 {
-  NS_LOG_INFO ("Adding to retry queue " << (*item).hdr.GetSequenceNumber ());
-  if (m_retryPackets.size () == 0)
+  uint16_t seq = item->hdr.GetSequenceNumber ();
+  if (!entry.retrying.Set (seq))
     {
-      m_retryPackets.push_back (item);
+      /* a packet with this sequence number is already waiting for retransmission */
+      return;
     }
-  else
+  NS_LOG_INFO ("Adding to retry queue " << seq);
+  /* Lost packets are reported in sequence number order, so the insertion
+     point is normally the tail. */
+  RetryQueue::iterator it = entry.retries.end ();
+  while (it != entry.retries.begin ())
+    {
+      RetryQueue::iterator prev = it;
+      prev--;
+      if (((seq - (*prev)->hdr.GetSequenceNumber () + 4096) % 4096) > 2047)
+        {
+          it = prev;
+        }
+      else
+        {
+          break;
+        }
+    }
+  entry.retries.insert (it, item);
+  item->retryOrder = m_retryOrder++;
+  m_nRetryPackets++;
+}
+
+BlockAckManager::RetryQueue::iterator
+BlockAckManager::RemoveFromRetryQueue (AgreementEntry &entry, RetryQueue::iterator it)
+{
+  entry.retrying.Reset ((*it)->hdr.GetSequenceNumber ());
+  m_nRetryPackets--;
+  return entry.retries.erase (it);
+}
+
+BlockAckManager::PacketQueueI
+BlockAckManager::ErasePacket (AgreementEntry &entry, PacketQueueI item)
+{
+  uint16_t seq = item->hdr.GetSequenceNumber ();
+  if (entry.retrying.IsSet (seq))
     {
-      for (std::list<PacketQueueI>::iterator it = m_retryPackets.begin (); it != m_retryPackets.end (); )
+      for (RetryQueue::iterator it = entry.retries.begin (); it != entry.retries.end (); it++)
         {
-          if (((item->hdr.GetSequenceNumber () - (*it)->hdr.GetSequenceNumber () + 4096) % 4096) > 2047)
+          if (*it == item)
             {
-              it = m_retryPackets.insert (it, item);
+              RemoveFromRetryQueue (entry, it);
               break;
             }
-          else
-            {
-              it++;
-              if (it == m_retryPackets.end ())
-                {
-                  m_retryPackets.push_back (item);
-                }
-            }
         }
     }
+  /* fragments of a packet are adjacent in the queue */
+  PacketQueueI next = item;
+  next++;
+  bool lastOfSeq = (next == entry.packets.end () || next->hdr.GetSequenceNumber () != seq);
+  if (lastOfSeq && item != entry.packets.begin ())
+    {
+      PacketQueueI prev = item;
+      prev--;
+      lastOfSeq = (prev->hdr.GetSequenceNumber () != seq);
+    }
+  if (lastOfSeq)
+    {
+      entry.buffered.Reset (seq);
+    }
+  return entry.packets.erase (item);
+}
+
+BlockAckManager::AgreementsI
+BlockAckManager::GetNextRetryAgreement (void)
+{
+  AgreementsI next = m_agreements.end ();
+  if (m_nRetryPackets == 0)
+    {
+      return next;
+    }
+  for (AgreementsI it = m_agreements.begin (); it != m_agreements.end (); it++)
+    {
+      if (it->second.retries.empty ())
+        {
+          continue;
+        }
+      if (next == m_agreements.end ())
+        {
+          next = it;
+          continue;
+        }
+      const Item &head = *it->second.retries.front ();
+      const Item &best = *next->second.retries.front ();
+      uint16_t distance = (head.hdr.GetSequenceNumber () - best.hdr.GetSequenceNumber () + 4096) % 4096;
+      if (distance > 2047 || (distance == 0 && head.retryOrder < best.retryOrder))
+        {
+          next = it;
+        }
+    }
+  return next;
+}
+
+BlockAckManager::AgreementsCI
+BlockAckManager::GetNextRetryAgreement (void) const
+{
+  return const_cast<BlockAckManager *> (this)->GetNextRetryAgreement ();
 }
 
 } //namespace ns3
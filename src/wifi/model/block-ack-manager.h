@@ -312,7 +312,7 @@ public:
   /**
    * Checks if the packet already exists in the retransmit queue or not if it does then it doesn't add it again
    */
-  bool AlreadyExists (uint16_t currentSeq, Mac48Address recipient, uint8_t tid);
+  bool AlreadyExists (uint16_t currentSeq, Mac48Address recipient, uint8_t tid) const;
   /**
    * Remove a packet after you peek in the queue and get it
    */
@@ -382,21 +382,73 @@ private:
    * typedef for a const iterator for PacketQueue.
    */
   typedef std::list<Item>::const_iterator PacketQueueCI;
+  /**
+   * typedef for a list of iterators to stored packets that need retransmission.
+   */
+  typedef std::list<PacketQueueI> RetryQueue;
+
+  /**
+   * A bitmap indexed by 12-bit sequence number. Since sequence numbers
+   * wrap around modulo 4096 the bitmap is a circular window over the
+   * whole sequence number space; it is a fixed-size member so that
+   * setting, clearing and testing a bit never allocates.
+   */
+  class SequenceBitmap
+  {
+  public:
+    SequenceBitmap ();
+    /**
+     * \param seq a sequence number
+     * \return true if the bit for <i>seq</i> is set
+     */
+    bool IsSet (uint16_t seq) const;
+    /**
+     * \param seq a sequence number
+     * \return true if the bit was not already set
+     */
+    bool Set (uint16_t seq);
+    /**
+     * \param seq a sequence number
+     * \return true if the bit was set
+     */
+    bool Reset (uint16_t seq);
+    /**
+     * \return the number of bits set
+     */
+    uint32_t GetCount (void) const;
+  private:
+    uint64_t m_bits[64];
+    uint32_t m_count;
+  };
+
+  /**
+   * Per-agreement state: the agreement itself, the packets waiting to be
+   * acknowledged by block ack (ordered by sequence number), the iterators
+   * into that queue of the packets that need retransmission (also ordered
+   * by sequence number, at most one per sequence number) and two bitmaps
+   * recording which sequence numbers are present in either queue.
+   */
+  struct AgreementEntry
+  {
+    AgreementEntry (const OriginatorBlockAckAgreement &agreement);
+    OriginatorBlockAckAgreement agreement;
+    PacketQueue packets;
+    RetryQueue retries;
+    SequenceBitmap buffered;
+    SequenceBitmap retrying;
+  };
   /**
    * typedef for a map between MAC address and block ACK agreement.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> > Agreements;
+  typedef std::map<std::pair<Mac48Address, uint8_t>, AgreementEntry> Agreements;
   /**
    * typedef for an iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::iterator AgreementsI;
+  typedef std::map<std::pair<Mac48Address, uint8_t>, AgreementEntry>::iterator AgreementsI;
   /**
    * typedef for a const iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::const_iterator AgreementsCI;
+  typedef std::map<std::pair<Mac48Address, uint8_t>, AgreementEntry>::const_iterator AgreementsCI;
 
   /**
    * A struct for packet, Wifi header, and timestamp.
@@ -411,14 +463,49 @@ private:
     Ptr<const Packet> packet;
     WifiMacHeader hdr;
     Time timestamp;
+    uint64_t retryOrder; //!< order of insertion in the retransmission queue
   };
   /**
-   * \param item
+   * \param entry the agreement the packet belongs to
+   * \param item the packet
    *
-   * Insert item in retransmission queue.
+   * Insert item in retransmission queue, unless a packet with the same
+   * sequence number is already there.
    * This method ensures packets are retransmitted in the correct order.
    */
-  void InsertInRetryQueue (PacketQueueI item);
+  void InsertInRetryQueue (AgreementEntry &entry, PacketQueueI item);
+  /**
+   * \param entry the agreement the retry queue belongs to
+   * \param it the retry queue element to remove
+   *
+   * \return the retry queue element following the removed one
+   */
+  RetryQueue::iterator RemoveFromRetryQueue (AgreementEntry &entry, RetryQueue::iterator it);
+  /**
+   * \param entry the agreement the packet belongs to
+   * \param item the packet to erase
+   *
+   * \return the packet following the erased one
+   *
+   * Erase a packet from the queue of an agreement, dropping any reference
+   * to it from the retransmission queue.
+   */
+  PacketQueueI ErasePacket (AgreementEntry &entry, PacketQueueI item);
+  /**
+   * \return the agreement whose retransmission queue is served next,
+   *         or m_agreements.end () if no packet needs retransmission
+   *
+   * The agreements are served in the order of a single retransmission
+   * queue sorted by sequence number: the first packets of their queues
+   * are compared by sequence number, and packets with the same sequence
+   * number are served in the order they were reported lost.
+   */
+  AgreementsI GetNextRetryAgreement (void);
+  /**
+   * \return the agreement whose retransmission queue is served next,
+   *         or m_agreements.end () if no packet needs retransmission
+   */
+  AgreementsCI GetNextRetryAgreement (void) const;
 
   /**
    * This data structure contains, for each block ack agreement (recipient, tid), a set of packets
@@ -429,11 +516,12 @@ private:
   Agreements m_agreements;
 
   /**
-   * This list contains all iterators to stored packets that need to be retransmitted.
+   * The total number of packets, across all agreements, that need to be retransmitted.
    * A packet needs retransmission if it's indicated as not correctly received in a block ack
    * frame.
    */
-  std::list<PacketQueueI> m_retryPackets;
+  uint32_t m_nRetryPackets;
+  uint64_t m_retryOrder; //!< retryOrder of the next packet reported lost
   std::list<Bar> m_bars;
 
   uint8_t m_blockAckThreshold;
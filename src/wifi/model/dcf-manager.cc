@@ -296,6 +296,16 @@ private:
  *      Implement the DCF manager of all DCF state holders
  ****************************************************************/
 
+DcfManager::TimerCounts DcfManager::m_totalTimerCounts;
+
+DcfManager::TimerCounts::TimerCounts ()
+  : scheduled (0),
+    cancelled (0),
+    expired (0),
+    idle (0)
+{
+}
+
 DcfManager::DcfManager ()
   : m_lastAckTimeoutEnd (MicroSeconds (0)),
     m_lastCtsTimeoutEnd (MicroSeconds (0)),
@@ -313,6 +323,7 @@ DcfManager::DcfManager ()
     m_lastSwitchingDuration (MicroSeconds (0)),
     m_rxing (false),
     m_sleeping (false),
+    m_lazyBackoff (false),
     m_slotTimeUs (0),
     m_sifs (Seconds (0.0)),
     m_phyListener (0),
@@ -393,6 +404,19 @@ DcfManager::GetEifsNoDifs () const
   return m_eifsNoDifs;
 }
 
+void
+DcfManager::SetLazyBackoff (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  m_lazyBackoff = enable;
+}
+
+bool
+DcfManager::GetLazyBackoff (void) const
+{
+  return m_lazyBackoff;
+}
+
 void
 DcfManager::Add (DcfState *dcf)
 {
@@ -504,7 +528,7 @@ DcfManager::RequestAccess (DcfState *state)
   DoRestartAccessTimeoutIfNeeded ();
 }
 
-void
+bool
 DcfManager::DoGrantAccess (void)
 {
   NS_LOG_FUNCTION (this);
@@ -553,18 +577,25 @@ DcfManager::DoGrantAccess (void)
             {
               (*k)->NotifyInternalCollision ();
             }
-          break;
+          return true;
         }
       i++;
     }
+  return false;
 }
 
 void
 DcfManager::AccessTimeout (void)
 {
   NS_LOG_FUNCTION (this);
+  m_timerCounts.expired++;
+  m_totalTimerCounts.expired++;
   UpdateBackoff ();
-  DoGrantAccess ();
+  if (!DoGrantAccess ())
+    {
+      m_timerCounts.idle++;
+      m_totalTimerCounts.idle++;
+    }
   DoRestartAccessTimeoutIfNeeded ();
 }
 
@@ -649,6 +680,11 @@ void
 DcfManager::DoRestartAccessTimeoutIfNeeded (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_lazyBackoff && m_rxing)
+    {
+      //the end of the reception will restart the timer
+      return;
+    }
   /**
    * Is there a DcfState which needs to access the medium, and,
    * if there is one, how many slots for AIFS+backoff does it require ?
@@ -675,16 +711,46 @@ DcfManager::DoRestartAccessTimeoutIfNeeded (void)
       if (m_accessTimeout.IsRunning ()
           && Simulator::GetDelayLeft (m_accessTimeout) > expectedBackoffDelay)
         {
-          m_accessTimeout.Cancel ();
+          CancelAccessTimeout ();
         }
       if (m_accessTimeout.IsExpired ())
         {
+          m_timerCounts.scheduled++;
+          m_totalTimerCounts.scheduled++;
           m_accessTimeout = Simulator::Schedule (expectedBackoffDelay,
                                                  &DcfManager::AccessTimeout, this);
         }
     }
 }
 
+void
+DcfManager::CancelAccessTimeout (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_timerCounts.cancelled++;
+  m_totalTimerCounts.cancelled++;
+  if (m_lazyBackoff)
+    {
+      Simulator::Remove (m_accessTimeout);
+    }
+  else
+    {
+      m_accessTimeout.Cancel ();
+    }
+}
+
+DcfManager::TimerCounts
+DcfManager::GetTimerCounts (void) const
+{
+  return m_timerCounts;
+}
+
+DcfManager::TimerCounts
+DcfManager::GetTotalTimerCounts (void)
+{
+  return m_totalTimerCounts;
+}
+
 void
 DcfManager::NotifyRxStartNow (Time duration)
 {
@@ -694,6 +760,10 @@ DcfManager::NotifyRxStartNow (Time duration)
   m_lastRxStart = Simulator::Now ();
   m_lastRxDuration = duration;
   m_rxing = true;
+  if (m_lazyBackoff && m_accessTimeout.IsRunning ())
+    {
+      CancelAccessTimeout ();
+    }
 }
 
 void
@@ -704,6 +774,10 @@ DcfManager::NotifyRxEndOkNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = true;
   m_rxing = false;
+  if (m_lazyBackoff)
+    {
+      DoRestartAccessTimeoutIfNeeded ();
+    }
 }
 
 void
@@ -714,6 +788,10 @@ DcfManager::NotifyRxEndErrorNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = false;
   m_rxing = false;
+  if (m_lazyBackoff)
+    {
+      DoRestartAccessTimeoutIfNeeded ();
+    }
 }
 
 void
@@ -734,6 +812,11 @@ DcfManager::NotifyTxStartNow (Time duration)
   UpdateBackoff ();
   m_lastTxStart = Simulator::Now ();
   m_lastTxDuration = duration;
+  if (m_lazyBackoff)
+    {
+      //a reception may have been interrupted
+      DoRestartAccessTimeoutIfNeeded ();
+    }
 }
 
 void
@@ -782,7 +865,7 @@ DcfManager::NotifySwitchingStartNow (Time duration)
   //Cancel timeout
   if (m_accessTimeout.IsRunning ())
     {
-      m_accessTimeout.Cancel ();
+      CancelAccessTimeout ();
     }
 
   //Reset backoffs
@@ -814,7 +897,7 @@ DcfManager::NotifySleepNow (void)
   //Cancel timeout
   if (m_accessTimeout.IsRunning ())
     {
-      m_accessTimeout.Cancel ();
+      CancelAccessTimeout ();
     }
 
   //Reset backoffs
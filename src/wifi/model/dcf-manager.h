@@ -300,6 +300,25 @@ public:
    * \return value set previously using SetEifsNoDifs.
    */
   Time GetEifsNoDifs () const;
+  /**
+   * \param enable whether the access timer is suspended during receptions
+   *
+   * By default, the access timer always runs until the earliest end of
+   * backoff which is known when it is scheduled, and is rescheduled when
+   * it expires while the medium is busy, which happens at least once
+   * per frame heard during a backoff.  In the lazy mode, the timer is
+   * removed when a reception starts and scheduled again at the end of
+   * the reception, when the slots consumed before the reception are
+   * accounted for and the end of the backoff is known: most of these
+   * useless expirations disappear, and a cancelled timer never stays in
+   * the scheduler, so that there is at most one pending timer.  The
+   * access is granted at exactly the same times in both modes.
+   */
+  void SetLazyBackoff (bool enable);
+  /**
+   * \return whether the access timer is suspended during receptions
+   */
+  bool GetLazyBackoff (void) const;
 
   /**
    * \param dcf a new DcfState.
@@ -403,6 +422,28 @@ public:
    */
   void NotifyCtsTimeoutResetNow ();
 
+  /**
+   * Counters of the access timer of a DcfManager, which expires at the
+   * earliest end of backoff of its DcfStates.
+   */
+  struct TimerCounts
+  {
+    TimerCounts ();
+    uint64_t scheduled; //!< number of access timers scheduled
+    uint64_t cancelled; //!< number of access timers cancelled before expiring
+    uint64_t expired;   //!< number of access timers which expired
+    uint64_t idle;      //!< number of expired access timers which granted no access
+  };
+  /**
+   * \return the counters of the access timer of this DcfManager
+   */
+  TimerCounts GetTimerCounts (void) const;
+  /**
+   * \return the sum of the counters of the access timers of all the
+   *         DcfManager instances created so far
+   */
+  static TimerCounts GetTotalTimerCounts (void);
+
 
 private:
   /**
@@ -501,8 +542,14 @@ private:
   void AccessTimeout (void);
   /**
    * Grant access to DCF
+   *
+   * \return true if access was granted to a DcfState
+   */
+  bool DoGrantAccess (void);
+  /**
+   * Cancel the pending access timeout.
    */
-  void DoGrantAccess (void);
+  void CancelAccessTimeout (void);
   /**
    * Check if the device is busy sending or receiving,
    * or NAV busy.
@@ -534,12 +581,15 @@ private:
   Time m_lastSwitchingDuration;
   bool m_rxing;
   bool m_sleeping;
+  bool m_lazyBackoff;
   Time m_eifsNoDifs;
   EventId m_accessTimeout;
   uint32_t m_slotTimeUs;
   Time m_sifs;
   PhyListener* m_phyListener;
   LowDcfListener* m_lowListener;
+  TimerCounts m_timerCounts;
+  static TimerCounts m_totalTimerCounts;
 };
 
 } //namespace ns3
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include <cmath>
+#include <limits>
+#include "error-rate-table.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ErrorRateTable");
+
+const double ErrorRateTable::MIN_SNR_DB = -10.0;
+const double ErrorRateTable::MAX_SNR_DB = 50.0;
+const double ErrorRateTable::STEP_DB = 0.05;
+const double ErrorRateTable::MAX_ERROR = 1e-3;
+
+/**
+ * \param analytical the model
+ * \param mode the Wi-Fi mode
+ * \param snrDb the SNR, in dB
+ * \return ln(-ln s), where s is the success rate of a single bit
+ */
+static double
+GetLogLogSuccessRate (ErrorRateTable::ChunkSuccessRateCallback const &analytical,
+                      WifiMode mode, double snrDb)
+{
+  double s = analytical (mode, std::pow (10.0, snrDb / 10.0), 1);
+  // s == 1 gives -inf and s == 0 gives +inf
+  return std::log (-std::log (s));
+}
+
+/**
+ * \param y a value of the table
+ * \return true if y is neither infinite nor NaN
+ */
+static bool
+IsFinite (double y)
+{
+  return y == y && std::fabs (y) != std::numeric_limits<double>::infinity ();
+}
+
+ErrorRateTable::ErrorRateTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ErrorRateTable::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_tables.clear ();
+}
+
+ErrorRateTable::Table const &
+ErrorRateTable::GetTable (WifiMode mode, ChunkSuccessRateCallback const &analytical)
+{
+  uint32_t uid = mode.GetUid ();
+  if (uid >= m_tables.size ())
+    {
+      m_tables.resize (uid + 1);
+    }
+  Table &table = m_tables[uid];
+  if (table.y.empty ())
+    {
+      uint32_t n = static_cast<uint32_t> ((MAX_SNR_DB - MIN_SNR_DB) / STEP_DB + 0.5) + 1;
+      table.y.reserve (n);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          table.y.push_back (GetLogLogSuccessRate (analytical, mode, MIN_SNR_DB + i * STEP_DB));
+        }
+      table.analytical.resize (n - 1);
+      uint32_t nAnalytical = 0;
+      for (uint32_t i = 0; i + 1 < n; i++)
+        {
+          double y0 = table.y[i];
+          double y1 = table.y[i + 1];
+          if (IsFinite (y0) && IsFinite (y1))
+            {
+              double middle = GetLogLogSuccessRate (analytical, mode, MIN_SNR_DB + (i + 0.5) * STEP_DB);
+              table.analytical[i] = !(std::fabs (middle - (y0 + y1) / 2) <= MAX_ERROR);
+            }
+          else
+            {
+              // constant cells (s == 0 or s == 1 at both ends) are exact
+              table.analytical[i] = (y0 != y1);
+            }
+          nAnalytical += table.analytical[i];
+        }
+      NS_LOG_DEBUG ("built table for " << mode << ": " << nAnalytical <<
+                    " of " << n - 1 << " cells left to the analytical model");
+    }
+  return table;
+}
+
+double
+ErrorRateTable::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits,
+                                     ChunkSuccessRateCallback const &analytical)
+{
+  if (nbits == 0)
+    {
+      return 1.0;
+    }
+  double snrDb = 10.0 * std::log10 (snr);
+  if (!(snrDb >= MIN_SNR_DB && snrDb < MAX_SNR_DB))
+    {
+      return analytical (mode, snr, nbits);
+    }
+  Table const &table = GetTable (mode, analytical);
+  double pos = (snrDb - MIN_SNR_DB) / STEP_DB;
+  uint32_t i = static_cast<uint32_t> (pos);
+  if (i >= table.analytical.size () || table.analytical[i])
+    {
+      return analytical (mode, snr, nbits);
+    }
+  double y0 = table.y[i];
+  double y1 = table.y[i + 1];
+  double y = (y0 == y1) ? y0 : y0 + (pos - i) * (y1 - y0);
+  return std::exp (-static_cast<double> (nbits) * std::exp (y));
+}
+
+} //namespace ns3
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "fast-wifi-phy.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FastWifiPhy");
+
+NS_OBJECT_ENSURE_REGISTERED (FastWifiPhy);
+
+TypeId
+FastWifiPhy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FastWifiPhy")
+    .SetParent<YansWifiPhy> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<FastWifiPhy> ()
+    .AddAttribute ("CaptureThreshold",
+                   "The minimum ratio (dB) between the power of a frame and the "
+                   "strongest interference during the frame for the frame to be "
+                   "received.",
+                   DoubleValue (4.0),
+                   MakeDoubleAccessor (&FastWifiPhy::SetCaptureThreshold,
+                                       &FastWifiPhy::GetCaptureThreshold),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+FastWifiPhy::FastWifiPhy ()
+  : m_captureThresholdDb (4.0),
+    m_captureRatio (std::pow (10.0, 0.4))
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FastWifiPhy::~FastWifiPhy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FastWifiPhy::SetCaptureThreshold (double threshold)
+{
+  NS_LOG_FUNCTION (this << threshold);
+  m_captureThresholdDb = threshold;
+  m_captureRatio = std::pow (10.0, threshold / 10.0);
+}
+
+double
+FastWifiPhy::GetCaptureThreshold (void) const
+{
+  return m_captureThresholdDb;
+}
+
+struct InterferenceHelper::SnrPer
+FastWifiPhy::CalculateSnrPer (Ptr<InterferenceHelper::Event> event, WifiMode mode, Time duration) const
+{
+  double interferenceW = m_interference.CalculateMaxInterferenceW (event);
+  struct InterferenceHelper::SnrPer snrPer;
+  snrPer.snr = m_interference.CalculateSnr (event->GetRxPowerW (), interferenceW, mode);
+  if (interferenceW * m_captureRatio > event->GetRxPowerW ())
+    {
+      NS_LOG_DEBUG ("collision: signal(W)=" << event->GetRxPowerW () << ", interference(W)=" << interferenceW);
+      snrPer.per = 1.0;
+    }
+  else
+    {
+      snrPer.per = 1.0 - m_interference.CalculateChunkSuccessRate (snrPer.snr, duration, mode);
+    }
+  return snrPer;
+}
+
+struct InterferenceHelper::SnrPer
+FastWifiPhy::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event)
+{
+  WifiMode payloadMode = event->GetPayloadMode ();
+  WifiPreamble preamble = event->GetPreambleType ();
+  //L-SIG and HT-SIG are both sent with the header mode
+  Time duration = WifiPhy::GetPlcpHeaderDuration (payloadMode, preamble)
+    + WifiPhy::GetPlcpHtSigHeaderDuration (preamble);
+  return CalculateSnrPer (event, WifiPhy::GetPlcpHeaderMode (payloadMode, preamble), duration);
+}
+
+struct InterferenceHelper::SnrPer
+FastWifiPhy::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event)
+{
+  WifiMode payloadMode = event->GetPayloadMode ();
+  WifiPreamble preamble = event->GetPreambleType ();
+  Time payloadStart = event->GetStartTime ()
+    + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble)
+    + WifiPhy::GetPlcpHeaderDuration (payloadMode, preamble)
+    + WifiPhy::GetPlcpHtSigHeaderDuration (preamble)
+    + WifiPhy::GetPlcpHtTrainingSymbolDuration (preamble, event->GetTxVector ());
+  return CalculateSnrPer (event, payloadMode, event->GetEndTime () - payloadStart);
+}
+
+} //namespace ns3
@@ -162,6 +162,20 @@ InterferenceHelper::Add (uint32_t size, WifiTxVector txVector,
   return event;
 }
 
+void
+InterferenceHelper::AddForeignSignal (Time duration, double rxPowerW)
+{
+  //the signal is not decodable, so only its power and duration matter
+  WifiTxVector fakeTxVector;
+  Ptr<InterferenceHelper::Event> event;
+  event = Create<InterferenceHelper::Event> (0,
+                                             fakeTxVector,
+                                             WIFI_PREAMBLE_NONE,
+                                             duration,
+                                             rxPowerW);
+  AppendEvent (event);
+}
+
 
 void
 InterferenceHelper::SetNoiseFigure (double value)
@@ -191,17 +205,18 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW)
 {
   Time now = Simulator::Now ();
-  double noiseInterferenceW = 0.0;
+  double noiseInterferenceW = m_firstPower;
   Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  NiTimeline::const_iterator i = m_niChanges.begin ();
+  NiTimeline::const_iterator nowIterator = m_niChanges.lower_bound (now);
+  for (; i != nowIterator; i++)
     {
-      noiseInterferenceW += i->GetDelta ();
-      end = i->GetTime ();
-      if (end < now)
-        {
-          continue;
-        }
+      noiseInterferenceW += i->second;
+    }
+  for (; i != m_niChanges.end (); i++)
+    {
+      noiseInterferenceW += i->second;
+      end = i->first;
       if (noiseInterferenceW < energyW)
         {
           break;
@@ -216,20 +231,10 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
   Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
-        {
-          m_firstPower += i->GetDelta ();
-        }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
-    }
-  else
-    {
-      AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      CollectGarbage (now);
     }
+  AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
   AddNiChangeEvent (NiChange (event->GetEndTime (), -event->GetRxPowerW ()));
-
 }
 
 
@@ -253,15 +258,19 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
 {
   double noiseInterference = m_firstPower;
   NS_ASSERT (m_rxing);
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
+  NS_ASSERT (!m_niChanges.empty ());
+  //the received event is always at the head of the timeline, so only the
+  //changes which happened during its reception are visited
+  ni->push_back (NiChange (event->GetStartTime (), noiseInterference));
+  NiTimeline::const_iterator i = m_niChanges.begin ();
+  for (i++; i != m_niChanges.end (); i++)
     {
-      if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
+      if ((event->GetEndTime () == i->first) && event->GetRxPowerW () == -i->second)
         {
           break;
         }
-      ni->push_back (*i);
+      ni->push_back (NiChange (i->first, i->second));
     }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference));
   ni->push_back (NiChange (event->GetEndTime (), 0));
   return noiseInterference;
 }
@@ -575,6 +584,28 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> ev
   return snrPer;
 }
 
+double
+InterferenceHelper::CalculateMaxInterferenceW (Ptr<Event> event) const
+{
+  double powerW = m_firstPower;
+  NiTimeline::const_iterator i = m_niChanges.begin ();
+  //all the changes up to the start of the event, including the event
+  //itself and any other signal starting at the same time
+  NiTimeline::const_iterator start = m_niChanges.upper_bound (event->GetStartTime ());
+  for (; i != start; i++)
+    {
+      powerW += i->second;
+    }
+  double maxPowerW = powerW;
+  NiTimeline::const_iterator end = m_niChanges.lower_bound (event->GetEndTime ());
+  for (; i != end; i++)
+    {
+      powerW += i->second;
+      maxPowerW = std::max (maxPowerW, powerW);
+    }
+  return std::max (maxPowerW - event->GetRxPowerW (), 0.0);
+}
+
 void
 InterferenceHelper::EraseEvents (void)
 {
@@ -583,16 +614,23 @@ InterferenceHelper::EraseEvents (void)
   m_firstPower = 0.0;
 }
 
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::GetPosition (Time moment)
+void
+InterferenceHelper::AddNiChangeEvent (NiChange change)
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
+  //a multimap inserts after any existing change with the same time
+  m_niChanges.insert (std::make_pair (change.GetTime (), change.GetDelta ()));
 }
 
 void
-InterferenceHelper::AddNiChangeEvent (NiChange change)
+InterferenceHelper::CollectGarbage (Time moment)
 {
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  NS_ASSERT (!m_rxing);
+  NiTimeline::iterator end = m_niChanges.upper_bound (moment);
+  for (NiTimeline::const_iterator i = m_niChanges.begin (); i != end; i++)
+    {
+      m_firstPower += i->second;
+    }
+  m_niChanges.erase (m_niChanges.begin (), end);
 }
 
 void
@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <vector>
 #include <list>
+#include <map>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -182,6 +183,14 @@ private:
   Ptr<InterferenceHelper::Event> Add (uint32_t size, WifiTxVector txVector,
                                       enum WifiPreamble preamble,
                                       Time duration, double rxPower);
+  /**
+   * Add a signal which cannot be received, e.g. a transmission of another
+   * technology, so that it is accounted for as interference.
+   *
+   * \param duration the duration of the signal
+   * \param rxPower the received power (W)
+   */
+  void AddForeignSignal (Time duration, double rxPower);
 
   /**
    * Calculate the SNIR at the start of the plcp payload and accumulate
@@ -201,6 +210,39 @@ private:
    * \return struct of SNR and PER
    */
   struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event);
+  /**
+   * Find the strongest noise and interference from the other signals
+   * while the given event is received, without integrating the SINR of
+   * each chunk.  Only the signals already known are taken into account.
+   *
+   * \param event the event of the frame being received
+   *
+   * \return the maximum of the sum of the powers (W) of the other signals
+   *         during the event
+   */
+  double CalculateMaxInterferenceW (Ptr<Event> event) const;
+  /**
+   * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
+   * (Mode is not currently used)
+   *
+   * \param signal
+   * \param noiseInterference
+   * \param mode
+   *
+   * \return SNR in liear ratio
+   */
+  double CalculateSnr (double signal, double noiseInterference, WifiMode mode) const;
+  /**
+   * Calculate the success rate of the chunk given the SINR, duration, and Wi-Fi mode.
+   * The duration and mode are used to calculate how many bits are present in the chunk.
+   *
+   * \param snir SINR
+   * \param duration
+   * \param mode
+   *
+   * \return the success rate
+   */
+  double CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode) const;
 
   /**
    * Notify that RX has started.
@@ -259,6 +301,12 @@ private:
    * typedef for a vector of NiChanges
    */
   typedef std::vector <NiChange> NiChanges;
+  /**
+   * Power timeline: the delta of every pending noise/interference change,
+   * keyed by the time it takes effect.  Changes at the same time keep their
+   * insertion order.
+   */
+  typedef std::multimap<Time, double> NiTimeline;
   /**
    * typedef for a list of Events
    */
@@ -279,28 +327,6 @@ private:
    * \return noise and interference power
    */
   double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
-  /**
-   * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
-   * (Mode is not currently used)
-   *
-   * \param signal
-   * \param noiseInterference
-   * \param mode
-   *
-   * \return SNR in liear ratio
-   */
-  double CalculateSnr (double signal, double noiseInterference, WifiMode mode) const;
-  /**
-   * Calculate the success rate of the chunk given the SINR, duration, and Wi-Fi mode.
-   * The duration and mode are used to calculate how many bits are present in the chunk.
-   *
-   * \param snir SINR
-   * \param duration
-   * \param mode
-   *
-   * \return the success rate
-   */
-  double CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode) const;
   /**
    * Calculate the error rate of the given plcp payload. The plcp payload can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
@@ -325,17 +351,23 @@ private:
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel;
   /// Experimental: needed for energy duration calculation
-  NiChanges m_niChanges;
-  double m_firstPower;
+  NiTimeline m_niChanges;
+  double m_firstPower; /**< sum of the deltas already folded out of m_niChanges */
   bool m_rxing;
-  /// Returns an iterator to the first nichange, which is later than moment
-  NiChanges::iterator GetPosition (Time moment);
   /**
-   * Add NiChange to the list at the appropriate position.
+   * Add NiChange to the timeline at the appropriate position.
    *
    * \param change
    */
   void AddNiChangeEvent (NiChange change);
+  /**
+   * Fold every change up to and including moment into m_firstPower and
+   * drop it from the timeline.  Only valid while no reception is ongoing,
+   * since the received event must remain at the head of the timeline.
+   *
+   * \param moment
+   */
+  void CollectGarbage (Time moment);
 };
 
 } //namespace ns3
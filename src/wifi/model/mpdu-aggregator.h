@@ -58,6 +58,19 @@ public:
    * specified how and if <i>packet</i> can be added to <i>aggregatedPacket</i>.
    */
   virtual bool Aggregate (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket) = 0;
+  /**
+   * \param packetSize size of the MPDU (MAC header, body and FCS) we want to account for.
+   * \param aggregatedPacket Packet standing for the A-MPDU being built.
+   *
+   * \return true if an MPDU of <i>packetSize</i> bytes can be aggregated to <i>aggregatedPacket</i>, false otherwise.
+   *
+   * Same as Aggregate, except that <i>aggregatedPacket</i> only grows by the length of
+   * the A-MPDU subframe (header, MPDU and padding) and its content is left undefined.
+   * This is meant for callers that keep the MPDUs themselves elsewhere and only need
+   * the A-MPDU length, such as MacLow which sends the MPDUs held in its aggregate queue:
+   * no MPDU is copied into <i>aggregatedPacket</i>.
+   */
+  virtual bool AggregateLength (uint32_t packetSize, Ptr<Packet> aggregatedPacket) = 0;
   /**
    * Adds A-MPDU subframe header and padding to each MPDU that is part of an A-MPDU before it is sent.
    */
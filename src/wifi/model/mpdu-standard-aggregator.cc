@@ -81,6 +81,21 @@ MpduStandardAggregator::Aggregate (Ptr<const Packet> packet, Ptr<Packet> aggrega
   return false;
 }
 
+bool
+MpduStandardAggregator::AggregateLength (uint32_t packetSize, Ptr<Packet> aggregatedPacket)
+{
+  NS_LOG_FUNCTION (this << packetSize);
+  uint32_t padding = CalculatePadding (aggregatedPacket);
+  uint32_t actualSize = aggregatedPacket->GetSize ();
+
+  if ((4 + packetSize + actualSize + padding) <= m_maxAmpduLength)
+    {
+      aggregatedPacket->AddAtEnd (Create<Packet> (padding + 4 + packetSize));
+      return true;
+    }
+  return false;
+}
+
 void
 MpduStandardAggregator::AddHeaderAndPad (Ptr<Packet> packet, bool last)
 {
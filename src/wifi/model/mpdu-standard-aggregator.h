@@ -47,6 +47,17 @@ public:
    * Returns true if <i>packet</i> can be aggregated to <i>aggregatedPacket</i>, false otherwise.
    */
   virtual bool Aggregate (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket);
+  /**
+   * \param packetSize size of the MPDU we want to account for in <i>aggregatedPacket</i>.
+   * \param aggregatedPacket packet standing for the A-MPDU being built.
+   *
+   * \return true if an MPDU of <i>packetSize</i> bytes can be aggregated to <i>aggregatedPacket</i>,
+   *         false otherwise.
+   *
+   * The subframe is appended as zero-filled virtual bytes, which the packet buffer
+   * merges with the virtual bytes already at its end without allocating or copying.
+   */
+  virtual bool AggregateLength (uint32_t packetSize, Ptr<Packet> aggregatedPacket);
   /**
    * Adds A-MPDU subframe header and padding to each MPDU that is part of an A-MPDU before it is sent.
    */
@@ -46,7 +46,7 @@ MsduAggregator::Deaggregate (Ptr<Packet> aggregatedPacket)
   DeaggregatedMsdus set;
 
   AmsduSubframeHeader hdr;
-  Ptr<Packet> extractedMsdu = Create<Packet> ();
+  Ptr<Packet> extractedMsdu;
   uint32_t maxSize = aggregatedPacket->GetSize ();
   uint16_t extractedLength;
   uint32_t padding;
@@ -56,6 +56,15 @@ MsduAggregator::Deaggregate (Ptr<Packet> aggregatedPacket)
     {
       deserialized += aggregatedPacket->RemoveHeader (hdr);
       extractedLength = hdr.GetLength ();
+      if (aggregatedPacket->GetSize () < extractedLength + hdr.GetSerializedSize ())
+        {
+          /* last subframe: no other subframe header fits after it, so hand out
+             the aggregate itself, stripped of any padding, instead of a fragment */
+          aggregatedPacket->RemoveAtEnd (aggregatedPacket->GetSize () - extractedLength);
+          std::pair<Ptr<Packet>, AmsduSubframeHeader> packetHdr (aggregatedPacket, hdr);
+          set.push_back (packetHdr);
+          break;
+        }
       extractedMsdu = aggregatedPacket->CreateFragment (0, static_cast<uint32_t> (extractedLength));
       aggregatedPacket->RemoveAtStart (extractedLength);
       deserialized += extractedLength;
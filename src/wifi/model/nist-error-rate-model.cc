@@ -23,6 +23,7 @@
 #include "nist-error-rate-model.h"
 #include "wifi-phy.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 
 namespace ns3 {
 
@@ -37,12 +38,39 @@ NistErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<NistErrorRateModel> ()
+    .AddAttribute ("UseLookupTable",
+                   "Interpolate the chunk success rate in a per-mode table "
+                   "of the analytical model, built at the first use of each "
+                   "mode and shared by all the instances, instead of "
+                   "evaluating the model for every chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NistErrorRateModel::m_useLookupTable),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel ()
+  : m_useLookupTable (false)
 {
+  m_analytical = MakeCallback (&NistErrorRateModel::GetAnalyticalChunkSuccessRate, this);
+}
+
+ErrorRateTable &
+NistErrorRateModel::GetLookupTable (void)
+{
+  static ErrorRateTable table;
+  return table;
+}
+
+double
+NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+{
+  if (m_useLookupTable)
+    {
+      return GetLookupTable ().GetChunkSuccessRate (mode, snr, nbits, m_analytical);
+    }
+  return GetAnalyticalChunkSuccessRate (mode, snr, nbits);
 }
 
 double
@@ -213,7 +241,7 @@ NistErrorRateModel::GetFec64QamBer (double snr, uint32_t nbits,
 }
 
 double
-NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+NistErrorRateModel::GetAnalyticalChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
 {
   if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
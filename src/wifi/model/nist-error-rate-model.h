@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include "wifi-mode.h"
 #include "error-rate-model.h"
+#include "error-rate-table.h"
 #include "dsss-error-rate-model.h"
 
 namespace ns3 {
@@ -45,8 +46,26 @@ public:
 
   virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
 
+  /**
+   * \brief Get the table shared by all the instances of this model
+   * which use a lookup table.
+   *
+   * \return the lookup table
+   */
+  static ErrorRateTable & GetLookupTable (void);
+
 
 private:
+  /**
+   * Compute the chunk success rate from the analytical model.
+   *
+   * \param mode the Wi-Fi mode the chunk is sent
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double GetAnalyticalChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
   /**
    * Return the coded BER for the given p and b.
    *
@@ -132,6 +151,9 @@ private:
    */
   double GetFec64QamBer (double snr, uint32_t nbits,
                          uint32_t bValue) const;
+
+  bool m_useLookupTable; //!< whether to interpolate in the lookup table
+  ErrorRateTable::ChunkSuccessRateCallback m_analytical; //!< bound GetAnalyticalChunkSuccessRate
 };
 
 } //namespace ns3
@@ -280,6 +280,19 @@ RegularWifiMac::GetCtsToSelfSupported () const
   return m_low->GetCtsToSelfSupported ();
 }
 
+void
+RegularWifiMac::SetLazyBackoff (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  m_dcfManager->SetLazyBackoff (enable);
+}
+
+bool
+RegularWifiMac::GetLazyBackoff (void) const
+{
+  return m_dcfManager->GetLazyBackoff ();
+}
+
 void
 RegularWifiMac::SetSlot (Time slotTime)
 {
@@ -664,6 +677,13 @@ RegularWifiMac::GetTypeId (void)
                    MakeBooleanAccessor (&RegularWifiMac::SetCtsToSelfSupported,
                                         &RegularWifiMac::GetCtsToSelfSupported),
                    MakeBooleanChecker ())
+    .AddAttribute ("LazyBackoff",
+                   "Do not keep the channel access timer armed while a reception is in progress; "
+                   "backoff is recomputed from the medium state when the reception ends",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RegularWifiMac::SetLazyBackoff,
+                                        &RegularWifiMac::GetLazyBackoff),
+                   MakeBooleanChecker ())
     .AddAttribute ("DcaTxop", "The DcaTxop object",
                    PointerValue (),
                    MakePointerAccessor (&RegularWifiMac::GetDcaTxop),
@@ -128,6 +128,20 @@ public:
    *         false otherwise.
    */
   bool GetCtsToSelfSupported () const;
+  /**
+   * Enable or disable lazy backoff in the DcfManager.
+   *
+   * \param enable true to defer backoff timers while receiving,
+   *               false otherwise
+   *
+   * \sa DcfManager::SetLazyBackoff
+   */
+  void SetLazyBackoff (bool enable);
+  /**
+   * \return true if the DcfManager uses lazy backoff,
+   *         false otherwise.
+   */
+  bool GetLazyBackoff (void) const;
   /**
    * \return the MAC address associated to this MAC layer.
    */
@@ -0,0 +1,299 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "spectrum-wifi-phy.h"
+#include "wifi-spectrum-phy-interface.h"
+#include "wifi-spectrum-signal-parameters.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/net-device.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include <cmath>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpectrumWifiPhy");
+
+NS_OBJECT_ENSURE_REGISTERED (SpectrumWifiPhy);
+
+TypeId
+SpectrumWifiPhy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SpectrumWifiPhy")
+    .SetParent<YansWifiPhy> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<SpectrumWifiPhy> ()
+  ;
+  return tid;
+}
+
+SpectrumWifiPhy::SpectrumWifiPhy ()
+  : m_registered (false)
+{
+  NS_LOG_FUNCTION (this);
+  m_spectrumPhy = CreateObject<WifiSpectrumPhyInterface> ();
+  m_spectrumPhy->SetSpectrumWifiPhy (this);
+}
+
+SpectrumWifiPhy::~SpectrumWifiPhy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SpectrumWifiPhy::DoInitialize (void)
+{
+  NS_LOG_FUNCTION (this);
+  YansWifiPhy::DoInitialize ();
+  ResetSpectrumModel ();
+}
+
+void
+SpectrumWifiPhy::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_spectrumChannel = 0;
+  if (m_spectrumPhy != 0)
+    {
+      m_spectrumPhy->Dispose ();
+      m_spectrumPhy = 0;
+    }
+  m_rxSpectrumModel = 0;
+  m_antenna = 0;
+  YansWifiPhy::DoDispose ();
+}
+
+void
+SpectrumWifiPhy::SetChannel (Ptr<SpectrumChannel> channel)
+{
+  NS_LOG_FUNCTION (this << channel);
+  if (channel != m_spectrumChannel)
+    {
+      m_spectrumChannel = channel;
+      m_registered = false;
+    }
+  if (m_rxSpectrumModel != 0)
+    {
+      ResetSpectrumModel ();
+    }
+}
+
+Ptr<Channel>
+SpectrumWifiPhy::GetChannel (void) const
+{
+  return m_spectrumChannel;
+}
+
+void
+SpectrumWifiPhy::SetAntenna (Ptr<AntennaModel> antenna)
+{
+  m_antenna = antenna;
+}
+
+Ptr<AntennaModel>
+SpectrumWifiPhy::GetRxAntenna (void) const
+{
+  return m_antenna;
+}
+
+Ptr<const SpectrumModel>
+SpectrumWifiPhy::GetRxSpectrumModel (void) const
+{
+  return m_rxSpectrumModel;
+}
+
+Ptr<WifiSpectrumPhyInterface>
+SpectrumWifiPhy::GetSpectrumPhy (void) const
+{
+  return m_spectrumPhy;
+}
+
+void
+SpectrumWifiPhy::SetChannelNumber (uint16_t nch)
+{
+  NS_LOG_FUNCTION (this << nch);
+  YansWifiPhy::SetChannelNumber (nch);
+  if (m_rxSpectrumModel != 0)
+    {
+      ResetSpectrumModel ();
+    }
+}
+
+void
+SpectrumWifiPhy::ConfigureStandard (enum WifiPhyStandard standard)
+{
+  NS_LOG_FUNCTION (this << standard);
+  YansWifiPhy::ConfigureStandard (standard);
+  if (m_rxSpectrumModel != 0)
+    {
+      ResetSpectrumModel ();
+    }
+}
+
+double
+SpectrumWifiPhy::GetRxBandwidth (void) const
+{
+  if (GetChannelBonding ())
+    {
+      return 40e6;
+    }
+  double bandwidth = 0;
+  for (uint32_t i = 0; i < GetNModes (); i++)
+    {
+      bandwidth = std::max (bandwidth, (double)GetMode (i).GetBandwidth ());
+    }
+  return bandwidth > 0 ? bandwidth : 20e6;
+}
+
+void
+SpectrumWifiPhy::ResetSpectrumModel (void)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<const SpectrumModel> model = GetSpectrumModel ((uint32_t)GetChannelFrequencyMhz (), GetRxBandwidth ());
+  m_rxSpectrumModel = model;
+  if (m_spectrumChannel == 0)
+    {
+      return;
+    }
+  //SingleModelSpectrumChannel::AddRx does not look for a previous entry,
+  //so the PHY is registered once with it.  MultiModelSpectrumChannel
+  //replaces the previous entry and has to be told about the new model.
+  if (!m_registered || DynamicCast<MultiModelSpectrumChannel> (m_spectrumChannel) != 0)
+    {
+      m_spectrumChannel->AddRx (m_spectrumPhy);
+      m_registered = true;
+    }
+}
+
+Ptr<const SpectrumModel>
+SpectrumWifiPhy::GetSpectrumModel (uint32_t centerFrequency, double bandwidth)
+{
+  typedef std::map<std::pair<uint32_t, uint64_t>, Ptr<const SpectrumModel> > Models;
+  static Models models;
+  std::pair<uint32_t, uint64_t> key (centerFrequency, (uint64_t)bandwidth);
+  Models::const_iterator it = models.find (key);
+  if (it != models.end ())
+    {
+      return it->second;
+    }
+  //one band per OFDM subcarrier of a 20 MHz channel, and at least 64 bands
+  uint32_t nBands = std::max<uint32_t> (64, (uint32_t)(bandwidth / 312500 + 0.5));
+  double bandWidth = bandwidth / nBands;
+  double fl = centerFrequency * 1e6 - bandwidth / 2;
+  Bands bands;
+  for (uint32_t i = 0; i < nBands; i++)
+    {
+      BandInfo info;
+      info.fl = fl + i * bandWidth;
+      info.fc = info.fl + bandWidth / 2;
+      info.fh = info.fl + bandWidth;
+      bands.push_back (info);
+    }
+  Ptr<const SpectrumModel> model = Create<SpectrumModel> (bands);
+  models.insert (std::make_pair (key, model));
+  return model;
+}
+
+Ptr<SpectrumValue>
+SpectrumWifiPhy::GetTxPowerSpectralDensity (Ptr<const SpectrumModel> model,
+                                            uint32_t centerFrequency,
+                                            double txBandwidth,
+                                            double txPowerW)
+{
+  //the power spectral densities of 1 W are cached by channel and width
+  //only, and scaled by the transmission power
+  typedef std::pair<std::pair<SpectrumModelUid_t, uint32_t>, uint64_t> PsdKey;
+  typedef std::map<PsdKey, Ptr<const SpectrumValue> > Psds;
+  static Psds psds;
+  PsdKey key (std::make_pair (model->GetUid (), centerFrequency), (uint64_t)txBandwidth);
+  Psds::const_iterator it = psds.find (key);
+  if (it == psds.end ())
+    {
+      //flat over the bands covered by the transmission, so that the
+      //integral of the power spectral density is the transmission power
+      double fl = centerFrequency * 1e6 - txBandwidth / 2;
+      double fh = centerFrequency * 1e6 + txBandwidth / 2;
+      Ptr<SpectrumValue> unit = Create<SpectrumValue> (model);
+      double occupied = 0;
+      for (Bands::const_iterator i = model->Begin (); i != model->End (); i++)
+        {
+          if (i->fc >= fl && i->fc <= fh)
+            {
+              occupied += i->fh - i->fl;
+            }
+        }
+      NS_ASSERT (occupied > 0);
+      Values::iterator v = unit->ValuesBegin ();
+      for (Bands::const_iterator i = model->Begin (); i != model->End (); i++, v++)
+        {
+          *v = (i->fc >= fl && i->fc <= fh) ? 1.0 / occupied : 0;
+        }
+      it = psds.insert (std::make_pair (key, unit)).first;
+    }
+  Ptr<SpectrumValue> psd = it->second->Copy ();
+  *psd *= txPowerW;
+  return psd;
+}
+
+void
+SpectrumWifiPhy::StartTx (Ptr<const Packet> packet, double txPowerDbm, WifiTxVector txVector,
+                          enum WifiPreamble preamble, struct mpduInfo aMpdu, Time txDuration)
+{
+  NS_LOG_FUNCTION (this << packet << txPowerDbm << txVector.GetMode () << preamble << txDuration);
+  NS_ASSERT_MSG (m_rxSpectrumModel != 0, "SpectrumWifiPhy used before being initialized");
+  NS_ASSERT_MSG (m_spectrumChannel != 0, "SpectrumWifiPhy is not attached to a SpectrumChannel");
+  double txPowerW = std::pow (10.0, txPowerDbm / 10.0) / 1000.0;
+  uint32_t frequency = (uint32_t)GetChannelFrequencyMhz ();
+  Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
+  txParams->duration = txDuration;
+  txParams->psd = GetTxPowerSpectralDensity (m_rxSpectrumModel, frequency,
+                                             txVector.GetMode ().GetBandwidth (), txPowerW);
+  txParams->txPhy = m_spectrumPhy;
+  txParams->txAntenna = m_antenna;
+  txParams->packet = packet->Copy ();
+  txParams->txVector = txVector;
+  txParams->preamble = preamble;
+  txParams->aMpdu = aMpdu;
+  txParams->frequency = frequency;
+  m_spectrumChannel->StartTx (txParams);
+}
+
+void
+SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
+{
+  NS_LOG_FUNCTION (this << rxParams);
+  double rxPowerW = Integral (*(rxParams->psd));
+  if (rxPowerW <= 0)
+    {
+      NS_LOG_LOGIC ("signal does not overlap with the channel");
+      return;
+    }
+  double rxPowerDbm = 10.0 * std::log10 (rxPowerW * 1000.0);
+  Ptr<WifiSpectrumSignalParameters> wifiRxParams = DynamicCast<WifiSpectrumSignalParameters> (rxParams);
+  if (wifiRxParams == 0 || wifiRxParams->frequency != (uint32_t)GetChannelFrequencyMhz ())
+    {
+      NS_LOG_DEBUG ("received a signal which cannot be decoded (power=" << rxPowerDbm << "dBm)");
+      StartReceiveForeignSignal (rxPowerDbm, rxParams->duration);
+      return;
+    }
+  StartReceivePreambleAndHeader (wifiRxParams->packet, rxPowerDbm, wifiRxParams->txVector,
+                                 wifiRxParams->preamble, wifiRxParams->aMpdu, rxParams->duration);
+}
+
+} //namespace ns3
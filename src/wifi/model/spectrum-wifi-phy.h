@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SPECTRUM_WIFI_PHY_H
+#define SPECTRUM_WIFI_PHY_H
+
+#include <map>
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/antenna-model.h"
+#include "yans-wifi-phy.h"
+
+namespace ns3 {
+
+class WifiSpectrumPhyInterface;
+
+/**
+ * \brief 802.11 PHY layer attached to a SpectrumChannel
+ * \ingroup wifi
+ *
+ * This PHY shares the reception state machine, the interference model
+ * and the error rate models of YansWifiPhy, but it is attached to a
+ * SpectrumChannel (usually a MultiModelSpectrumChannel), so that Wi-Fi
+ * devices can share the medium with other spectrum-aware models such as
+ * LteSpectrumPhy or WaveformGenerator.
+ *
+ * Frames are transmitted with a flat power spectral density over the
+ * bandwidth of their mode.  The received power of every signal is
+ * obtained by summing its power spectral density over the bands of the
+ * receiver: frames of another SpectrumWifiPhy on the same channel are
+ * received as with YansWifiPhy, while any other signal only adds to the
+ * interference and may make the CCA busy.
+ *
+ * All the PHYs tuned to the same channel share the same SpectrumModel,
+ * and the shape of the transmit power spectral densities is cached by
+ * channel and width, so that a single channel shared by thousands of
+ * devices does not need any spectrum conversion for Wi-Fi to Wi-Fi
+ * transmissions.
+ */
+class SpectrumWifiPhy : public YansWifiPhy
+{
+public:
+  static TypeId GetTypeId (void);
+
+  SpectrumWifiPhy ();
+  virtual ~SpectrumWifiPhy ();
+
+  /**
+   * Set the SpectrumChannel this SpectrumWifiPhy is to be connected to.
+   *
+   * \param channel the SpectrumChannel this SpectrumWifiPhy is to be connected to
+   */
+  void SetChannel (Ptr<SpectrumChannel> channel);
+  /**
+   * Set the antenna model used to transmit and receive.
+   *
+   * \param antenna the antenna model
+   */
+  void SetAntenna (Ptr<AntennaModel> antenna);
+  /**
+   * \return the antenna model used to receive, or 0
+   */
+  Ptr<AntennaModel> GetRxAntenna (void) const;
+  /**
+   * \return the SpectrumModel of the channel this PHY is tuned to, or
+   *         0 before the PHY is initialized
+   */
+  Ptr<const SpectrumModel> GetRxSpectrumModel (void) const;
+  /**
+   * \return the SpectrumPhy registered with the SpectrumChannel on
+   *         behalf of this PHY
+   */
+  Ptr<WifiSpectrumPhyInterface> GetSpectrumPhy (void) const;
+  /**
+   * Start receiving a signal from the SpectrumChannel.
+   *
+   * \param rxParams the parameters of the signal
+   */
+  void StartRx (Ptr<SpectrumSignalParameters> rxParams);
+  /**
+   * \return the bandwidth (Hz) received by this PHY
+   */
+  double GetRxBandwidth (void) const;
+
+  /**
+   * \param centerFrequency the center frequency of the channel (MHz)
+   * \param bandwidth the bandwidth of the channel (Hz)
+   *
+   * \return the SpectrumModel shared by all the PHYs with this channel
+   */
+  static Ptr<const SpectrumModel> GetSpectrumModel (uint32_t centerFrequency, double bandwidth);
+  /**
+   * \param model a SpectrumModel returned by GetSpectrumModel
+   * \param centerFrequency the center frequency of the channel (MHz)
+   * \param txBandwidth the bandwidth of the transmission (Hz)
+   * \param txPowerW the transmission power (W)
+   *
+   * \return the power spectral density of the transmission
+   */
+  static Ptr<SpectrumValue> GetTxPowerSpectralDensity (Ptr<const SpectrumModel> model,
+                                                       uint32_t centerFrequency,
+                                                       double txBandwidth,
+                                                       double txPowerW);
+
+  // inherited from YansWifiPhy
+  virtual void SetChannelNumber (uint16_t id);
+  virtual Ptr<Channel> GetChannel (void) const;
+  virtual void ConfigureStandard (enum WifiPhyStandard standard);
+
+
+protected:
+  virtual void DoInitialize (void);
+  virtual void DoDispose (void);
+  virtual void StartTx (Ptr<const Packet> packet, double txPowerDbm, WifiTxVector txVector,
+                        enum WifiPreamble preamble, struct mpduInfo aMpdu, Time txDuration);
+
+
+private:
+  /**
+   * Update the SpectrumModel after a change of channel or standard and
+   * register with the SpectrumChannel if needed.
+   */
+  void ResetSpectrumModel (void);
+
+  Ptr<SpectrumChannel> m_spectrumChannel;           //!< SpectrumChannel this PHY is connected to
+  bool m_registered;                                //!< Whether m_spectrumPhy was added to m_spectrumChannel
+  Ptr<WifiSpectrumPhyInterface> m_spectrumPhy;      //!< SpectrumPhy registered with m_spectrumChannel
+  Ptr<const SpectrumModel> m_rxSpectrumModel;       //!< SpectrumModel of the current channel
+  Ptr<AntennaModel> m_antenna;                      //!< Antenna model
+};
+
+} //namespace ns3
+
+#endif /* SPECTRUM_WIFI_PHY_H */
@@ -30,12 +30,28 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (WifiMacQueue);
 
+const uint32_t WifiMacQueue::NONE;
+
+WifiMacQueue::Item::Item ()
+  : prev (NONE),
+    next (NONE),
+    flowPrev (NONE),
+    flowNext (NONE),
+    generation (0)
+{
+}
+
 WifiMacQueue::Item::Item (Ptr<const Packet> packet,
                           const WifiMacHeader &hdr,
                           Time tstamp)
   : packet (packet),
     hdr (hdr),
-    tstamp (tstamp)
+    tstamp (tstamp),
+    prev (NONE),
+    next (NONE),
+    flowPrev (NONE),
+    flowNext (NONE),
+    generation (0)
 {
 }
 
@@ -59,7 +75,9 @@ WifiMacQueue::GetTypeId (void)
 }
 
 WifiMacQueue::WifiMacQueue ()
-  : m_size (0)
+  : m_head (NONE),
+    m_tail (NONE),
+    m_size (0)
 {
 }
 
@@ -100,47 +118,41 @@ WifiMacQueue::Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
     {
       return;
     }
-  Time now = Simulator::Now ();
-  m_queue.push_back (Item (packet, hdr, now));
-  m_size++;
+  Insert (packet, hdr, false);
 }
 
 void
 WifiMacQueue::Cleanup (void)
 {
-  if (m_queue.empty ())
-    {
-      return;
-    }
-
   Time now = Simulator::Now ();
-  uint32_t n = 0;
-  for (PacketQueueI i = m_queue.begin (); i != m_queue.end (); )
+  //packets are timestamped in order of arrival, so the expired ones are at
+  //the front of m_expiry; entries of packets which already left the queue
+  //are dropped on the way
+  while (!m_expiry.empty ())
     {
-      if (i->tstamp + m_maxDelay > now)
-        {
-          i++;
-        }
-      else
+      uint32_t index = m_expiry.front ().first;
+      if (m_items[index].generation == m_expiry.front ().second)
         {
-          i = m_queue.erase (i);
-          n++;
+          if (m_items[index].tstamp + m_maxDelay > now)
+            {
+              break;
+            }
+          Erase (index);
         }
+      m_expiry.pop_front ();
     }
-  m_size -= n;
 }
 
 Ptr<const Packet>
 WifiMacQueue::Dequeue (WifiMacHeader *hdr)
 {
   Cleanup ();
-  if (!m_queue.empty ())
+  if (m_head != NONE)
     {
-      Item i = m_queue.front ();
-      m_queue.pop_front ();
-      m_size--;
-      *hdr = i.hdr;
-      return i.packet;
+      Ptr<const Packet> packet = m_items[m_head].packet;
+      *hdr = m_items[m_head].hdr;
+      Erase (m_head);
+      return packet;
     }
   return 0;
 }
@@ -149,11 +161,10 @@ Ptr<const Packet>
 WifiMacQueue::Peek (WifiMacHeader *hdr)
 {
   Cleanup ();
-  if (!m_queue.empty ())
+  if (m_head != NONE)
     {
-      Item i = m_queue.front ();
-      *hdr = i.hdr;
-      return i.packet;
+      *hdr = m_items[m_head].hdr;
+      return m_items[m_head].packet;
     }
   return 0;
 }
@@ -163,27 +174,15 @@ WifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                                       WifiMacHeader::AddressType type, Mac48Address dest)
 {
   Cleanup ();
-  Ptr<const Packet> packet = 0;
-  if (!m_queue.empty ())
+  uint32_t index = Find (tid, type, dest);
+  if (index != NONE)
     {
-      PacketQueueI it;
-      for (it = m_queue.begin (); it != m_queue.end (); ++it)
-        {
-          if (it->hdr.IsQosData ())
-            {
-              if (GetAddressForPacket (type, it) == dest
-                  && it->hdr.GetQosTid () == tid)
-                {
-                  packet = it->packet;
-                  *hdr = it->hdr;
-                  m_queue.erase (it);
-                  m_size--;
-                  break;
-                }
-            }
-        }
+      Ptr<const Packet> packet = m_items[index].packet;
+      *hdr = m_items[index].hdr;
+      Erase (index);
+      return packet;
     }
-  return packet;
+  return 0;
 }
 
 Ptr<const Packet>
@@ -191,22 +190,12 @@ WifiMacQueue::PeekByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                                    WifiMacHeader::AddressType type, Mac48Address dest, Time *timestamp)
 {
   Cleanup ();
-  if (!m_queue.empty ())
+  uint32_t index = Find (tid, type, dest);
+  if (index != NONE)
     {
-      PacketQueueI it;
-      for (it = m_queue.begin (); it != m_queue.end (); ++it)
-        {
-          if (it->hdr.IsQosData ())
-            {
-              if (GetAddressForPacket (type, it) == dest
-                  && it->hdr.GetQosTid () == tid)
-                {
-                  *hdr = it->hdr;
-                  *timestamp = it->tstamp;
-                  return it->packet;
-                }
-            }
-        }
+      *hdr = m_items[index].hdr;
+      *timestamp = m_items[index].tstamp;
+      return m_items[index].packet;
     }
   return 0;
 }
@@ -215,7 +204,7 @@ bool
 WifiMacQueue::IsEmpty (void)
 {
   Cleanup ();
-  return m_queue.empty ();
+  return m_head == NONE;
 }
 
 uint32_t
@@ -227,38 +216,198 @@ WifiMacQueue::GetSize (void)
 void
 WifiMacQueue::Flush (void)
 {
-  m_queue.erase (m_queue.begin (), m_queue.end ());
+  m_items.clear ();
+  m_free.clear ();
+  m_flows.clear ();
+  m_expiry.clear ();
+  m_head = NONE;
+  m_tail = NONE;
   m_size = 0;
 }
 
 Mac48Address
-WifiMacQueue::GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it)
+WifiMacQueue::GetAddressForPacket (enum WifiMacHeader::AddressType type, const struct Item &item) const
 {
   if (type == WifiMacHeader::ADDR1)
     {
-      return it->hdr.GetAddr1 ();
+      return item.hdr.GetAddr1 ();
     }
   if (type == WifiMacHeader::ADDR2)
     {
-      return it->hdr.GetAddr2 ();
+      return item.hdr.GetAddr2 ();
     }
   if (type == WifiMacHeader::ADDR3)
     {
-      return it->hdr.GetAddr3 ();
+      return item.hdr.GetAddr3 ();
     }
   return 0;
 }
 
+uint64_t
+WifiMacQueue::GetFlowKey (Mac48Address addr, uint8_t tid)
+{
+  uint8_t buffer[6];
+  addr.CopyTo (buffer);
+  uint64_t key = 0;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  return (key << 8) | tid;
+}
+
+uint32_t
+WifiMacQueue::Find (uint8_t tid, WifiMacHeader::AddressType type, Mac48Address addr) const
+{
+  if (type == WifiMacHeader::ADDR1)
+    {
+      Flows::const_iterator flow = m_flows.find (GetFlowKey (addr, tid));
+      return flow != m_flows.end () ? flow->second.head : NONE;
+    }
+  for (uint32_t i = m_head; i != NONE; i = m_items[i].next)
+    {
+      if (m_items[i].hdr.IsQosData ()
+          && GetAddressForPacket (type, m_items[i]) == addr
+          && m_items[i].hdr.GetQosTid () == tid)
+        {
+          return i;
+        }
+    }
+  return NONE;
+}
+
+uint32_t
+WifiMacQueue::FindFirstAvailable (const QosBlockedDestinations *blockedPackets) const
+{
+  for (uint32_t i = m_head; i != NONE; i = m_items[i].next)
+    {
+      if (!m_items[i].hdr.IsQosData ()
+          || !blockedPackets->IsBlocked (m_items[i].hdr.GetAddr1 (), m_items[i].hdr.GetQosTid ()))
+        {
+          return i;
+        }
+    }
+  return NONE;
+}
+
+void
+WifiMacQueue::Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, bool front)
+{
+  uint32_t index;
+  if (m_free.empty ())
+    {
+      index = m_items.size ();
+      m_items.push_back (Item ());
+    }
+  else
+    {
+      index = m_free.back ();
+      m_free.pop_back ();
+    }
+  Item &item = m_items[index];
+  item.packet = packet;
+  item.hdr = hdr;
+  item.tstamp = Simulator::Now ();
+  if (front)
+    {
+      item.prev = NONE;
+      item.next = m_head;
+      (m_head != NONE ? m_items[m_head].prev : m_tail) = index;
+      m_head = index;
+    }
+  else
+    {
+      item.prev = m_tail;
+      item.next = NONE;
+      (m_tail != NONE ? m_items[m_tail].next : m_head) = index;
+      m_tail = index;
+    }
+  item.flowPrev = NONE;
+  item.flowNext = NONE;
+  if (hdr.IsQosData ())
+    {
+      Flows::iterator it = m_flows.find (GetFlowKey (hdr.GetAddr1 (), hdr.GetQosTid ()));
+      if (it == m_flows.end ())
+        {
+          Flow flow;
+          flow.head = index;
+          flow.tail = index;
+          flow.n = 1;
+          m_flows.insert (std::make_pair (GetFlowKey (hdr.GetAddr1 (), hdr.GetQosTid ()), flow));
+        }
+      else if (front)
+        {
+          item.flowNext = it->second.head;
+          m_items[it->second.head].flowPrev = index;
+          it->second.head = index;
+          it->second.n++;
+        }
+      else
+        {
+          item.flowPrev = it->second.tail;
+          m_items[it->second.tail].flowNext = index;
+          it->second.tail = index;
+          it->second.n++;
+        }
+    }
+  m_expiry.push_back (std::make_pair (index, item.generation));
+  m_size++;
+  if (m_expiry.size () > 2 * m_size + 16)
+    {
+      CompactExpiry ();
+    }
+}
+
+void
+WifiMacQueue::CompactExpiry (void)
+{
+  //a packet staying long at the front of m_expiry keeps Cleanup from
+  //dropping the entries of the packets which left after it
+  Expiry::iterator out = m_expiry.begin ();
+  for (Expiry::const_iterator in = m_expiry.begin (); in != m_expiry.end (); ++in)
+    {
+      if (m_items[in->first].generation == in->second)
+        {
+          *out++ = *in;
+        }
+    }
+  m_expiry.erase (out, m_expiry.end ());
+}
+
+void
+WifiMacQueue::Erase (uint32_t index)
+{
+  Item &item = m_items[index];
+  (item.prev != NONE ? m_items[item.prev].next : m_head) = item.next;
+  (item.next != NONE ? m_items[item.next].prev : m_tail) = item.prev;
+  if (item.hdr.IsQosData ())
+    {
+      Flows::iterator it = m_flows.find (GetFlowKey (item.hdr.GetAddr1 (), item.hdr.GetQosTid ()));
+      NS_ASSERT (it != m_flows.end ());
+      if (--it->second.n == 0)
+        {
+          m_flows.erase (it);
+        }
+      else
+        {
+          (item.flowPrev != NONE ? m_items[item.flowPrev].flowNext : it->second.head) = item.flowNext;
+          (item.flowNext != NONE ? m_items[item.flowNext].flowPrev : it->second.tail) = item.flowPrev;
+        }
+    }
+  item.packet = 0;
+  item.generation++;
+  m_free.push_back (index);
+  m_size--;
+}
+
 bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
-  PacketQueueI it = m_queue.begin ();
-  for (; it != m_queue.end (); it++)
+  for (uint32_t i = m_head; i != NONE; i = m_items[i].next)
     {
-      if (it->packet == packet)
+      if (m_items[i].packet == packet)
         {
-          m_queue.erase (it);
-          m_size--;
+          Erase (i);
           return true;
         }
     }
@@ -273,9 +422,7 @@ WifiMacQueue::PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr)
     {
       return;
     }
-  Time now = Simulator::Now ();
-  m_queue.push_front (Item (packet, hdr, now));
-  m_size++;
+  Insert (packet, hdr, true);
 }
 
 uint32_t
@@ -283,19 +430,18 @@ WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, WifiMacHeader::AddressTyp
                                           Mac48Address addr)
 {
   Cleanup ();
+  if (type == WifiMacHeader::ADDR1)
+    {
+      Flows::const_iterator flow = m_flows.find (GetFlowKey (addr, tid));
+      return flow != m_flows.end () ? flow->second.n : 0;
+    }
   uint32_t nPackets = 0;
-  if (!m_queue.empty ())
+  for (uint32_t i = m_head; i != NONE; i = m_items[i].next)
     {
-      PacketQueueI it;
-      for (it = m_queue.begin (); it != m_queue.end (); it++)
+      if (GetAddressForPacket (type, m_items[i]) == addr
+          && m_items[i].hdr.IsQosData () && m_items[i].hdr.GetQosTid () == tid)
         {
-          if (GetAddressForPacket (type, it) == addr)
-            {
-              if (it->hdr.IsQosData () && it->hdr.GetQosTid () == tid)
-                {
-                  nPackets++;
-                }
-            }
+          nPackets++;
         }
     }
   return nPackets;
@@ -306,21 +452,16 @@ WifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
                                      const QosBlockedDestinations *blockedPackets)
 {
   Cleanup ();
-  Ptr<const Packet> packet = 0;
-  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+  uint32_t index = FindFirstAvailable (blockedPackets);
+  if (index != NONE)
     {
-      if (!it->hdr.IsQosData ()
-          || !blockedPackets->IsBlocked (it->hdr.GetAddr1 (), it->hdr.GetQosTid ()))
-        {
-          *hdr = it->hdr;
-          timestamp = it->tstamp;
-          packet = it->packet;
-          m_queue.erase (it);
-          m_size--;
-          return packet;
-        }
+      Ptr<const Packet> packet = m_items[index].packet;
+      *hdr = m_items[index].hdr;
+      timestamp = m_items[index].tstamp;
+      Erase (index);
+      return packet;
     }
-  return packet;
+  return 0;
 }
 
 Ptr<const Packet>
@@ -328,15 +469,12 @@ WifiMacQueue::PeekFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
                                   const QosBlockedDestinations *blockedPackets)
 {
   Cleanup ();
-  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+  uint32_t index = FindFirstAvailable (blockedPackets);
+  if (index != NONE)
     {
-      if (!it->hdr.IsQosData ()
-          || !blockedPackets->IsBlocked (it->hdr.GetAddr1 (), it->hdr.GetQosTid ()))
-        {
-          *hdr = it->hdr;
-          timestamp = it->tstamp;
-          return it->packet;
-        }
+      *hdr = m_items[index].hdr;
+      timestamp = m_items[index].tstamp;
+      return m_items[index].packet;
     }
   return 0;
 }
@@ -23,11 +23,13 @@
 #ifndef WIFI_MAC_QUEUE_H
 #define WIFI_MAC_QUEUE_H
 
-#include <list>
+#include <vector>
+#include <deque>
 #include <utility>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/open-hash-map.h"
 #include "wifi-mac-header.h"
 
 namespace ns3 {
@@ -47,6 +49,13 @@ class QosBlockedDestinations;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * QoS data packets are also linked in one sub-queue per TID and
+ * receiver, so that the operations used by block ack agreements and
+ * aggregation (e.g. PeekByTidAndAddress with ADDR1) do not depend on
+ * the depth of the queue.  Since packets are timestamped in order of
+ * arrival, expired packets are found from the front of an expiry list
+ * and Cleanup only visits the packets it drops.
  */
 class WifiMacQueue : public Object
 {
@@ -230,6 +239,7 @@ protected:
    */
   struct Item
   {
+    Item ();
     /**
      * Create a struct with the given parameters.
      *
@@ -243,31 +253,101 @@ protected:
     Ptr<const Packet> packet; //!< Actual packet
     WifiMacHeader hdr;        //!< Wifi MAC header associated with the packet
     Time tstamp;              //!< timestamp when the packet arrived at the queue
+    uint32_t prev;            //!< previous item in the queue
+    uint32_t next;            //!< next item in the queue
+    uint32_t flowPrev;        //!< previous item with the same TID and receiver
+    uint32_t flowNext;        //!< next item with the same TID and receiver
+    uint32_t generation;      //!< incremented each time the slot is released
+  };
+
+  /**
+   * The QoS data items queued for a given TID and receiver (ADDR1),
+   * linked through Item::flowPrev and Item::flowNext in queue order.
+   */
+  struct Flow
+  {
+    uint32_t head; //!< first item of the flow
+    uint32_t tail; //!< last item of the flow
+    uint32_t n;    //!< number of items in the flow
   };
 
   /**
-   * typedef for packet (struct Item) queue.
+   * typedef for the pool of items; items are linked by their index.
    */
-  typedef std::list<struct Item> PacketQueue;
+  typedef std::vector<struct Item> Items;
   /**
-   * typedef for packet (struct Item) queue reverse iterator.
+   * typedef for the index of the flows, see GetFlowKey.
    */
-  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
+  typedef OpenHashMap<uint64_t, struct Flow> Flows;
   /**
-   * typedef for packet (struct Item) queue iterator.
+   * typedef for the expiry list: (item, generation) in order of arrival.
    */
-  typedef std::list<struct Item>::iterator PacketQueueI;
+  typedef std::deque<std::pair<uint32_t, uint32_t> > Expiry;
+
+  /// Index of a missing item
+  static const uint32_t NONE = 0xffffffff;
+
   /**
-   * Return the appropriate address for the given packet (given by PacketQueue iterator).
+   * Return the appropriate address for the given packet.
    *
    * \param type
-   * \param it
+   * \param item
    *
    * \return the address
    */
-  Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it);
+  Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, const struct Item &item) const;
+  /**
+   * \param addr the receiver
+   * \param tid the TID
+   *
+   * \return the key of the flow in m_flows
+   */
+  static uint64_t GetFlowKey (Mac48Address addr, uint8_t tid);
+  /**
+   * Find the first QoS data item with the given TID and address.
+   *
+   * \param tid
+   * \param type
+   * \param addr
+   *
+   * \return the index of the item or NONE
+   */
+  uint32_t Find (uint8_t tid, WifiMacHeader::AddressType type, Mac48Address addr) const;
+  /**
+   * Find the first item which is not a QoS data item for a blocked destination.
+   *
+   * \param blockedPackets
+   *
+   * \return the index of the item or NONE
+   */
+  uint32_t FindFirstAvailable (const QosBlockedDestinations *blockedPackets) const;
+  /**
+   * Store a packet in a free item and link it at the front or at the back
+   * of the queue.
+   *
+   * \param packet
+   * \param hdr
+   * \param front
+   */
+  void Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, bool front);
+  /**
+   * Unlink an item from the queue and release it.
+   *
+   * \param index
+   */
+  void Erase (uint32_t index);
+  /**
+   * Drop the entries of m_expiry whose packets already left the queue,
+   * keeping the order of the others.
+   */
+  void CompactExpiry (void);
 
-  PacketQueue m_queue; //!< Packet (struct Item) queue
+  Items m_items;                   //!< Storage of the queued packets
+  std::vector<uint32_t> m_free;    //!< Free entries of m_items
+  uint32_t m_head;                 //!< First item of the queue
+  uint32_t m_tail;                 //!< Last item of the queue
+  Flows m_flows;                   //!< QoS data items by TID and receiver
+  Expiry m_expiry;                 //!< Items in order of arrival, for Cleanup
   uint32_t m_size;     //!< Current queue size
   uint32_t m_maxSize;  //!< Queue capacity
   Time m_maxDelay;     //!< Time to live for packets in the queue
@@ -30,7 +30,6 @@
 namespace ns3 {
 
 class WifiRemoteStationManager;
-class WifiChannel;
 class WifiPhy;
 class WifiMac;
 
@@ -139,11 +138,11 @@ private:
    */
   void LinkDown (void);
   /**
-   * Return the WifiChannel this device is connected to.
+   * Return the Channel this device is connected to.
    *
-   * \return WifiChannel
+   * \return Channel
    */
-  Ptr<WifiChannel> DoGetChannel (void) const;
+  Ptr<Channel> DoGetChannel (void) const;
   /**
    * Complete the configuration of this Wi-Fi device by
    * connecting all lower components (e.g. MAC, WifiRemoteStation) together.
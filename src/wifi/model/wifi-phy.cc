@@ -333,37 +333,129 @@ WifiPhy::GetPlcpPreambleDuration (WifiMode payloadMode, WifiPreamble preamble)
     }
 }
 
-Time
-WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, WifiPreamble preamble, double frequency, uint8_t packetType, uint8_t incFlag)
+const WifiPhy::TxDurationParameters &
+WifiPhy::GetTxDurationParameters (WifiTxVector txVector, WifiPreamble preamble)
 {
   WifiMode payloadMode = txVector.GetMode ();
-  NS_LOG_FUNCTION (size << payloadMode);
+  uint64_t key = (static_cast<uint64_t> (payloadMode.GetUid ()) << 24)
+    | (static_cast<uint64_t> (preamble) << 16)
+    | (static_cast<uint64_t> (txVector.GetNss ()) << 8)
+    | (static_cast<uint64_t> (txVector.GetNess ()) << 1)
+    | (txVector.IsStbc () ? 1 : 0);
+  TxDurationCache::const_iterator it = m_txDurationCache.find (key);
+  if (it != m_txDurationCache.end ())
+    {
+      return it->second;
+    }
 
-  switch (payloadMode.GetModulationClass ())
+  NS_LOG_FUNCTION (this << payloadMode << preamble);
+  TxDurationParameters params;
+  params.modulationClass = payloadMode.GetModulationClass ();
+  params.preambleAndHeader = GetPlcpPreambleDuration (payloadMode, preamble)
+    + GetPlcpHeaderDuration (payloadMode, preamble)
+    + GetPlcpHtSigHeaderDuration (preamble)
+    + GetPlcpHtTrainingSymbolDuration (preamble, txVector);
+  params.symbolDuration = Seconds (0);
+  params.numDataBitsPerSymbol = 0;
+  params.stbc = 1;
+  params.dataRate = payloadMode.GetDataRate ();
+
+  switch (params.modulationClass)
     {
     case WIFI_MOD_CLASS_OFDM:
     case WIFI_MOD_CLASS_ERP_OFDM:
       {
         //(Section 18.3.2.4 "Timing related parameters" Table 18-5 "Timing-related parameters"; IEEE Std 802.11-2012
         //corresponds to T_{SYM} in the table)
-        Time symbolDuration;
         switch (payloadMode.GetBandwidth ())
           {
           case 20000000:
           default:
-            symbolDuration = MicroSeconds (4);
+            params.symbolDuration = MicroSeconds (4);
             break;
           case 10000000:
-            symbolDuration = MicroSeconds (8);
+            params.symbolDuration = MicroSeconds (8);
             break;
           case 5000000:
-            symbolDuration = MicroSeconds (16);
+            params.symbolDuration = MicroSeconds (16);
             break;
           }
 
         //(Section 18.3.2.3 "Modulation-dependent parameters" Table 18-4 "Modulation-dependent parameters"; IEEE Std 802.11-2012)
         //corresponds to N_{DBPS} in the table
-        double numDataBitsPerSymbol = payloadMode.GetDataRate () * symbolDuration.GetNanoSeconds () / 1e9;
+        params.numDataBitsPerSymbol = payloadMode.GetDataRate () * params.symbolDuration.GetNanoSeconds () / 1e9;
+        break;
+      }
+    case WIFI_MOD_CLASS_HT:
+      {
+        //if short GI data rate is used then symbol duration is 3.6us else symbol duration is 4us
+        //In the future has to create a stationmanager that only uses these data rates if sender and reciever support GI
+        if (payloadMode.GetUniqueName () == "OfdmRate135MbpsBW40MHzShGi" || payloadMode.GetUniqueName () == "OfdmRate65MbpsBW20MHzShGi" )
+          {
+            params.symbolDuration = NanoSeconds (3600);
+          }
+        else
+          {
+            switch (payloadMode.GetDataRate () / (txVector.GetNss ()))
+              {
+              //shortGi
+              case 7200000:
+              case 14400000:
+              case 21700000:
+              case 28900000:
+              case 43300000:
+              case 57800000:
+              case 72200000:
+              case 15000000:
+              case 30000000:
+              case 45000000:
+              case 60000000:
+              case 90000000:
+              case 120000000:
+              case 150000000:
+                params.symbolDuration = NanoSeconds (3600);
+                break;
+              default:
+                params.symbolDuration = MicroSeconds (4);
+              }
+          }
+
+        if (txVector.IsStbc ())
+          {
+            params.stbc = 2;
+          }
+
+        params.numDataBitsPerSymbol = payloadMode.GetDataRate () * txVector.GetNss () * params.symbolDuration.GetNanoSeconds () / 1e9;
+        break;
+      }
+    case WIFI_MOD_CLASS_DSSS:
+      break;
+    default:
+      NS_FATAL_ERROR ("unsupported modulation class");
+    }
+  return m_txDurationCache.insert (std::make_pair (key, params)).first->second;
+}
+
+void
+WifiPhy::InvalidateTxDurationCache (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_txDurationCache.clear ();
+}
+
+Time
+WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, WifiPreamble preamble, double frequency, uint8_t packetType, uint8_t incFlag)
+{
+  const TxDurationParameters &params = GetTxDurationParameters (txVector, preamble);
+  NS_LOG_FUNCTION (size << txVector.GetMode ());
+
+  switch (params.modulationClass)
+    {
+    case WIFI_MOD_CLASS_OFDM:
+    case WIFI_MOD_CLASS_ERP_OFDM:
+      {
+        Time symbolDuration = params.symbolDuration;
+        double numDataBitsPerSymbol = params.numDataBitsPerSymbol;
 
         //(Section 18.3.5.4 "Pad bits (PAD)" Equation 18-11; IEEE Std 802.11-2012)
         uint32_t numSymbols;
@@ -411,7 +503,7 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, WifiPreamble
           }
 
         //Add signal extension for ERP PHY
-        if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM)
+        if (params.modulationClass == WIFI_MOD_CLASS_ERP_OFDM)
           {
             return Time (numSymbols * symbolDuration) + MicroSeconds (6);
           }
@@ -422,55 +514,15 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, WifiPreamble
       }
     case WIFI_MOD_CLASS_HT:
       {
-        Time symbolDuration;
-        double m_Stbc;
-        //if short GI data rate is used then symbol duration is 3.6us else symbol duration is 4us
-        //In the future has to create a stationmanager that only uses these data rates if sender and reciever support GI
-        if (payloadMode.GetUniqueName () == "OfdmRate135MbpsBW40MHzShGi" || payloadMode.GetUniqueName () == "OfdmRate65MbpsBW20MHzShGi" )
-          {
-            symbolDuration = NanoSeconds (3600);
-          }
-        else
-          {
-            switch (payloadMode.GetDataRate () / (txVector.GetNss ()))
-              {
-              //shortGi
-              case 7200000:
-              case 14400000:
-              case 21700000:
-              case 28900000:
-              case 43300000:
-              case 57800000:
-              case 72200000:
-              case 15000000:
-              case 30000000:
-              case 45000000:
-              case 60000000:
-              case 90000000:
-              case 120000000:
-              case 150000000:
-                symbolDuration = NanoSeconds (3600);
-                break;
-              default:
-                symbolDuration = MicroSeconds (4);
-              }
-          }
-
-        if (txVector.IsStbc ())
-          {
-            m_Stbc = 2;
-          }
-        else
-          {
-            m_Stbc = 1;
-          }
+        Time symbolDuration = params.symbolDuration;
+        double m_Stbc = params.stbc;
 
         //check tables 20-35 and 20-36 in the standard to get cases when nes =2
         double Nes = 1;
 
         //IEEE Std 802.11n, section 20.3.11, equation (20-32)
         uint32_t numSymbols;
-        double numDataBitsPerSymbol = payloadMode.GetDataRate () * txVector.GetNss () * symbolDuration.GetNanoSeconds () / 1e9;
+        double numDataBitsPerSymbol = params.numDataBitsPerSymbol;
 
         if (packetType == 1 && preamble != WIFI_PREAMBLE_NONE)
           {
@@ -527,9 +579,9 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, WifiPreamble
     case WIFI_MOD_CLASS_DSSS:
       //(Section 17.2.3.6 "Long PLCP LENGTH field"; IEEE Std 802.11-2012)
       NS_LOG_LOGIC (" size=" << size
-                             << " mode=" << payloadMode
-                             << " rate=" << payloadMode.GetDataRate ());
-      return MicroSeconds (lrint (ceil ((size * 8.0) / (payloadMode.GetDataRate () / 1.0e6))));
+                             << " mode=" << txVector.GetMode ()
+                             << " rate=" << params.dataRate);
+      return MicroSeconds (lrint (ceil ((size * 8.0) / (params.dataRate / 1.0e6))));
     default:
       NS_FATAL_ERROR ("unsupported modulation class");
       return MicroSeconds (0);
@@ -539,12 +591,7 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, WifiPreamble
 Time
 WifiPhy::CalculatePlcpPreambleAndHeaderDuration (WifiTxVector txVector, WifiPreamble preamble)
 {
-  WifiMode payloadMode = txVector.GetMode ();
-  Time duration = GetPlcpPreambleDuration (payloadMode, preamble)
-    + GetPlcpHeaderDuration (payloadMode, preamble)
-    + GetPlcpHtSigHeaderDuration (preamble)
-    + GetPlcpHtTrainingSymbolDuration (preamble, txVector);
-  return duration;
+  return GetTxDurationParameters (txVector, preamble).preambleAndHeader;
 }
 
 Time
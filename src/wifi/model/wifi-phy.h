@@ -22,6 +22,7 @@
 #define WIFI_PHY_H
 
 #include <stdint.h>
+#include <map>
 #include "ns3/callback.h"
 #include "ns3/packet.h"
 #include "ns3/object.h"
@@ -35,7 +36,7 @@
 
 namespace ns3 {
 
-class WifiChannel;
+class Channel;
 class NetDevice;
 
 struct signalNoiseDbm
@@ -534,11 +535,11 @@ public:
   virtual void ConfigureStandard (enum WifiPhyStandard standard) = 0;
 
   /**
-   * Return the WifiChannel this WifiPhy is connected to.
+   * Return the Channel this WifiPhy is connected to.
    *
-   * \return the WifiChannel this WifiPhy is connected to
+   * \return the Channel this WifiPhy is connected to
    */
-  virtual Ptr<WifiChannel> GetChannel (void) const = 0;
+  virtual Ptr<Channel> GetChannel (void) const = 0;
 
   /**
    * Return a WifiMode for DSSS at 1Mbps.
@@ -1157,7 +1158,39 @@ public:
   virtual void SetChannelBonding (bool channelbonding) = 0;
 
 
+protected:
+  /**
+   * Forget the PPDU duration parameters computed so far. Subclasses call this
+   * whenever the standard or the operating frequency is reconfigured.
+   */
+  void InvalidateTxDurationCache (void);
+
+
 private:
+  /**
+   * The size-independent parameters needed to compute the duration of a PPDU.
+   * They only depend on the payload mode, the preamble, the number of spatial
+   * and extension streams and STBC, and are cached by GetTxDurationParameters
+   * so that CalculateTxDuration does not walk the preamble and symbol timing
+   * tables (nor compare mode names) on every call.
+   */
+  struct TxDurationParameters
+  {
+    enum WifiModulationClass modulationClass; //!< modulation class of the payload mode
+    Time preambleAndHeader;       //!< duration of the PLCP preamble and header
+    Time symbolDuration;          //!< duration of a payload OFDM symbol (OFDM, ERP-OFDM and HT)
+    double numDataBitsPerSymbol;  //!< number of data bits per payload OFDM symbol (OFDM, ERP-OFDM and HT)
+    double stbc;                  //!< 2 if STBC is used, 1 otherwise (HT)
+    uint64_t dataRate;            //!< data rate of the payload mode (DSSS)
+  };
+  /**
+   * \param txVector the TXVECTOR used for the transmission
+   * \param preamble the type of preamble used for the transmission
+   *
+   * \return the duration parameters for this combination, computed on first use
+   */
+  const TxDurationParameters & GetTxDurationParameters (WifiTxVector txVector, WifiPreamble preamble);
+
   /**
    * The trace source fired when a packet begins the transmission process on
    * the medium.
@@ -1231,6 +1264,13 @@ private:
 
   uint32_t m_totalAmpduNumSymbols; //!< Number of symbols previously transmitted for the MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
   uint32_t m_totalAmpduSize;       //!< Total size of the previously transmitted MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
+
+  /**
+   * typedef for a map from a packed (mode, preamble, Nss, Ness, STBC) key
+   * to the corresponding PPDU duration parameters.
+   */
+  typedef std::map<uint64_t, TxDurationParameters> TxDurationCache;
+  TxDurationCache m_txDurationCache; //!< PPDU duration parameters computed so far
 };
 
 /**
@@ -28,6 +28,7 @@
 #include "ns3/packet.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
+#include "ns3/open-hash-map.h"
 #include "wifi-mode.h"
 #include "wifi-tx-vector.h"
 #include "ht-capabilities.h"
@@ -930,6 +931,15 @@ private:
    * \return WifiRemoteStation corresponding to the address
    */
   WifiRemoteStation* Lookup (Mac48Address address, const WifiMacHeader *header) const;
+  /**
+   * Pack an address and a TID into the key of the station index.
+   *
+   * \param address the address of the station
+   * \param tid the TID
+   *
+   * \return the key of the station in m_stationIndex
+   */
+  static uint64_t GetStationKey (Mac48Address address, uint8_t tid);
 
   WifiMode GetControlAnswerMode (Mac48Address address, WifiMode reqMode);
 
@@ -964,6 +974,14 @@ private:
    * A vector of WifiRemoteStationStates
    */
   typedef std::vector <WifiRemoteStationState *> StationStates;
+  /**
+   * An index of WifiRemoteStationStates by address
+   */
+  typedef OpenHashMap <Mac48Address, WifiRemoteStationState *, Mac48AddressHash> StationStateIndex;
+  /**
+   * An index of WifiRemoteStations by (address, TID), see GetStationKey
+   */
+  typedef OpenHashMap <uint64_t, WifiRemoteStation *> StationIndex;
 
   /**
    * This is a pointer to the WifiPhy associated with this
@@ -996,6 +1014,8 @@ private:
 
   StationStates m_states;  //!< States of known stations
   Stations m_stations;     //!< Information for each known stations
+  StationStateIndex m_stateIndex; //!< m_states indexed by address
+  StationIndex m_stationIndex;    //!< m_stations indexed by (address, TID)
 
   WifiMode m_defaultTxMode; //!< The default transmission mode
   uint8_t m_defaultTxMcs;   //!< The default transmission modulation-coding scheme (MCS)
@@ -0,0 +1,53 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "wifi-spectrum-signal-parameters.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiSpectrumSignalParameters");
+
+WifiSpectrumSignalParameters::WifiSpectrumSignalParameters ()
+  : preamble (WIFI_PREAMBLE_LONG),
+    frequency (0)
+{
+  NS_LOG_FUNCTION (this);
+  aMpdu.packetType = 0;
+  aMpdu.referenceNumber = 0;
+}
+
+WifiSpectrumSignalParameters::WifiSpectrumSignalParameters (const WifiSpectrumSignalParameters& p)
+  : SpectrumSignalParameters (p),
+    txVector (p.txVector),
+    preamble (p.preamble),
+    aMpdu (p.aMpdu),
+    frequency (p.frequency)
+{
+  NS_LOG_FUNCTION (this << &p);
+  packet = p.packet->Copy ();
+}
+
+Ptr<SpectrumSignalParameters>
+WifiSpectrumSignalParameters::Copy ()
+{
+  NS_LOG_FUNCTION (this);
+  return Create<WifiSpectrumSignalParameters> (*this);
+}
+
+} // namespace ns3
@@ -23,6 +23,7 @@
 #include "yans-error-rate-model.h"
 #include "wifi-phy.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 
 namespace ns3 {
 
@@ -37,12 +38,39 @@ YansErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<YansErrorRateModel> ()
+    .AddAttribute ("UseLookupTable",
+                   "Interpolate the chunk success rate in a per-mode table "
+                   "of the analytical model, built at the first use of each "
+                   "mode and shared by all the instances, instead of "
+                   "evaluating the model for every chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansErrorRateModel::m_useLookupTable),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 YansErrorRateModel::YansErrorRateModel ()
+  : m_useLookupTable (false)
 {
+  m_analytical = MakeCallback (&YansErrorRateModel::GetAnalyticalChunkSuccessRate, this);
+}
+
+ErrorRateTable &
+YansErrorRateModel::GetLookupTable (void)
+{
+  static ErrorRateTable table;
+  return table;
+}
+
+double
+YansErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+{
+  if (m_useLookupTable)
+    {
+      return GetLookupTable ().GetChunkSuccessRate (mode, snr, nbits, m_analytical);
+    }
+  return GetAnalyticalChunkSuccessRate (mode, snr, nbits);
 }
 
 double
@@ -180,7 +208,7 @@ YansErrorRateModel::GetFecQamBer (double snr, uint32_t nbits,
 }
 
 double
-YansErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+YansErrorRateModel::GetAnalyticalChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
 {
   if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
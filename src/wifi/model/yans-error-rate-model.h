@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include "wifi-mode.h"
 #include "error-rate-model.h"
+#include "error-rate-table.h"
 #include "dsss-error-rate-model.h"
 
 namespace ns3 {
@@ -62,8 +63,26 @@ public:
 
   virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
 
+  /**
+   * \brief Get the table shared by all the instances of this model
+   * which use a lookup table.
+   *
+   * \return the lookup table
+   */
+  static ErrorRateTable & GetLookupTable (void);
+
 
 private:
+  /**
+   * Compute the chunk success rate from the analytical model.
+   *
+   * \param mode the Wi-Fi mode the chunk is sent
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double GetAnalyticalChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
   /**
    * Return the logarithm of the given value to base 2.
    *
@@ -162,6 +181,9 @@ private:
                        uint32_t phyRate,
                        uint32_t m, uint32_t dfree,
                        uint32_t adFree, uint32_t adFreePlusOne) const;
+
+  bool m_useLookupTable; //!< whether to interpolate in the lookup table
+  ErrorRateTable::ChunkSuccessRateCallback m_analytical; //!< bound GetAnalyticalChunkSuccessRate
 };
 
 } //namespace ns3
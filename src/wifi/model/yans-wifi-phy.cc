@@ -218,6 +218,7 @@ void
 YansWifiPhy::ConfigureStandard (enum WifiPhyStandard standard)
 {
   NS_LOG_FUNCTION (this << standard);
+  InvalidateTxDurationCache ();
   switch (standard)
     {
     case WIFI_PHY_STANDARD_80211a:
@@ -399,7 +400,7 @@ YansWifiPhy::CalculateSnr (WifiMode txMode, double ber) const
   return m_interference.GetErrorRateModel ()->CalculateSnr (txMode, ber);
 }
 
-Ptr<WifiChannel>
+Ptr<Channel>
 YansWifiPhy::GetChannel (void) const
 {
   return m_channel;
@@ -712,6 +713,35 @@ maybeCcaBusy:
     }
 }
 
+void
+YansWifiPhy::StartReceiveForeignSignal (double rxPowerDbm, Time rxDuration)
+{
+  NS_LOG_FUNCTION (this << rxPowerDbm << rxDuration);
+  double rxPowerW = DbmToW (rxPowerDbm + m_rxGainDb);
+  m_interference.AddForeignSignal (rxDuration, rxPowerW);
+  if (m_state->IsStateSleep ())
+    {
+      return;
+    }
+  Time delayUntilCcaEnd = m_interference.GetEnergyDuration (m_ccaMode1ThresholdW);
+  if (!delayUntilCcaEnd.IsZero ())
+    {
+      m_state->SwitchMaybeToCcaBusy (delayUntilCcaEnd);
+    }
+}
+
+struct InterferenceHelper::SnrPer
+YansWifiPhy::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event)
+{
+  return m_interference.CalculatePlcpHeaderSnrPer (event);
+}
+
+struct InterferenceHelper::SnrPer
+YansWifiPhy::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event)
+{
+  return m_interference.CalculatePlcpPayloadSnrPer (event);
+}
+
 void
 YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
                                  WifiTxVector txVector,
@@ -726,7 +756,7 @@ YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
   WifiMode txMode = txVector.GetMode ();
 
   struct InterferenceHelper::SnrPer snrPer;
-  snrPer = m_interference.CalculatePlcpHeaderSnrPer (event);
+  snrPer = CalculatePlcpHeaderSnrPer (event);
 
   NS_LOG_DEBUG ("snr(dB)=" << RatioToDb(snrPer.snr) << ", per=" << snrPer.per);
 
@@ -793,7 +823,14 @@ YansWifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, WifiPr
   aMpdu.referenceNumber = mpduReferenceNumber;
   NotifyMonitorSniffTx (packet, (uint16_t)GetChannelFrequencyMhz (), GetChannelNumber (), dataRate500KbpsUnits, preamble, txVector, aMpdu);
   m_state->SwitchToTx (txDuration, packet, GetPowerDbm (txVector.GetTxPowerLevel ()), txVector, preamble);
-  m_channel->Send (this, packet, GetPowerDbm (txVector.GetTxPowerLevel ()) + m_txGainDb, txVector, preamble, aMpdu, txDuration);
+  StartTx (packet, GetPowerDbm (txVector.GetTxPowerLevel ()) + m_txGainDb, txVector, preamble, aMpdu, txDuration);
+}
+
+void
+YansWifiPhy::StartTx (Ptr<const Packet> packet, double txPowerDbm, WifiTxVector txVector,
+                      enum WifiPreamble preamble, struct mpduInfo aMpdu, Time txDuration)
+{
+  m_channel->Send (this, packet, txPowerDbm, txVector, preamble, aMpdu, txDuration);
 }
 
 uint32_t
@@ -1088,7 +1125,7 @@ YansWifiPhy::EndReceive (Ptr<Packet> packet, enum WifiPreamble preamble, struct
   NS_ASSERT (event->GetEndTime () == Simulator::Now ());
 
   struct InterferenceHelper::SnrPer snrPer;
-  snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  snrPer = CalculatePlcpPayloadSnrPer (event);
   m_interference.NotifyRxEnd ();
 
   if (m_plcpSuccess == true)
@@ -1145,6 +1182,7 @@ void
 YansWifiPhy::SetFrequency (uint32_t freq)
 {
   m_channelStartingFrequency = freq;
+  InvalidateTxDurationCache ();
 }
 
 void
@@ -299,7 +299,7 @@ public:
   virtual bool IsModeSupported (WifiMode mode) const;
   virtual bool IsMcsSupported (WifiMode mode);
   virtual double CalculateSnr (WifiMode txMode, double ber) const;
-  virtual Ptr<WifiChannel> GetChannel (void) const;
+  virtual Ptr<Channel> GetChannel (void) const;
 
   virtual void ConfigureStandard (enum WifiPhyStandard standard);
 
@@ -411,10 +411,60 @@ public:
   virtual WifiMode McsToWifiMode (uint8_t mcs);
 
 
-private:
+protected:
   virtual void DoInitialize (void);
   virtual void DoDispose (void);
 
+  /**
+   * Hand a frame over to the channel.  The state of the PHY has already
+   * been switched to TX; by default the frame is sent through the
+   * YansWifiChannel.
+   *
+   * \param packet the packet to send
+   * \param txPowerDbm the transmission power, including the tx gain
+   * \param txVector the TXVECTOR of the packet
+   * \param preamble the preamble type of the packet
+   * \param aMpdu the type of the packet (0 is not A-MPDU, 1 is a MPDU that is part of an A-MPDU and 2 is the last MPDU in an A-MPDU)
+   *        and the A-MPDU reference number (must be a different value for each A-MPDU but the same for each subframe within one A-MPDU)
+   * \param txDuration the duration of the transmission
+   */
+  virtual void StartTx (Ptr<const Packet> packet, double txPowerDbm, WifiTxVector txVector,
+                        enum WifiPreamble preamble, struct mpduInfo aMpdu, Time txDuration);
+  /**
+   * Account for the energy of a signal which cannot be decoded by this
+   * PHY, e.g. a transmission of another technology: it only contributes
+   * to the interference and may make the CCA busy.
+   *
+   * \param rxPowerDbm the received power, without the rx gain
+   * \param rxDuration the duration of the signal
+   */
+  void StartReceiveForeignSignal (double rxPowerDbm, Time rxDuration);
+  /**
+   * Compute the SNR and the error rate of the PLCP header of a frame
+   * being received.  By default, the SINR of every chunk of the header
+   * is integrated by the InterferenceHelper.
+   *
+   * \param event the event of the frame being received
+   *
+   * \return the SNR and PER of the PLCP header
+   */
+  virtual struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event);
+  /**
+   * Compute the SNR and the error rate of the payload of a frame at the
+   * end of its reception.  By default, the SINR of every chunk of the
+   * payload is integrated by the InterferenceHelper.
+   *
+   * \param event the event of the frame being received
+   *
+   * \return the SNR and PER of the payload
+   */
+  virtual struct InterferenceHelper::SnrPer CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event);
+
+  InterferenceHelper m_interference;    //!< InterferenceHelper tracking the signals on the medium
+
+
+private:
+
   /**
    * Configure YansWifiPhy with appropriate channel frequency and
    * supported rates for 802.11a standard.
@@ -573,7 +623,6 @@ private:
   Ptr<UniformRandomVariable> m_random;  //!< Provides uniform random variables.
   double m_channelStartingFrequency;    //!< Standard-dependent center frequency of 0-th channel in MHz
   Ptr<WifiPhyStateHelper> m_state;      //!< Pointer to WifiPhyStateHelper
-  InterferenceHelper m_interference;    //!< Pointer to InterferenceHelper
   Time m_channelSwitchDelay;            //!< Time required to switch between channel
   uint16_t m_mpdusNum;                  //!< carries the number of expected mpdus that are part of an A-MPDU
   bool m_plcpSuccess;                   //!< Flag if the PLCP of the packet or the first MPDU in an A-MPDU has been received
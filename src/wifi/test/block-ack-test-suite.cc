@@ -22,7 +22,15 @@
 #include "ns3/log.h"
 #include "ns3/qos-utils.h"
 #include "ns3/ctrl-headers.h"
+#include "ns3/mgt-headers.h"
+#include "ns3/block-ack-manager.h"
+#include "ns3/mac-tx-middle.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/simulator.h"
 #include <list>
+#include <vector>
 
 using namespace ns3;
 
@@ -275,6 +283,370 @@ CtrlBAckResponseHeaderTest::DoRun (void)
 }
 
 
+/**
+ * Base class of the tests of the originator side of block ack: sets up a
+ * BlockAckManager, establishes agreements, stores the packets sent under
+ * them and feeds the block acks back.
+ */
+class OriginatorBlockAckTest : public TestCase
+{
+public:
+  /**
+   * \param name the name of the test
+   */
+  OriginatorBlockAckTest (std::string name);
+  virtual ~OriginatorBlockAckTest ();
+
+protected:
+  /**
+   * \param type the type of the block acks
+   */
+  void Setup (enum BlockAckType type);
+  /**
+   * \param recipient the recipient of the agreement
+   * \param startingSeq the starting sequence of the agreement
+   */
+  void Establish (Mac48Address recipient, uint16_t startingSeq);
+  /**
+   * \param recipient the recipient of the packet
+   * \param seq the sequence number of the packet
+   * \param frag the fragment number of the packet
+   */
+  void Store (Mac48Address recipient, uint16_t seq, uint8_t frag = 0);
+  /**
+   * \param startingSeq the starting sequence of the block ack
+   * \returns a block ack of the type of the test acknowledging no packet
+   */
+  CtrlBAckResponseHeader CreateBlockAck (uint16_t startingSeq) const;
+  /**
+   * \param recipient the recipient sending the block ack
+   * \param blockAck the block ack
+   */
+  void Ack (Mac48Address recipient, const CtrlBAckResponseHeader &blockAck);
+  /**
+   * Retransmit all the packets waiting for retransmission.
+   *
+   * \returns the recipient and the sequence number of the packets the
+   *          manager retransmits, in order
+   */
+  std::vector<std::pair<Mac48Address, uint16_t> > DrainRetries (void);
+
+  BlockAckManager *m_manager; //!< the manager under test
+  MacTxMiddle *m_txMiddle;    //!< the sequence number allocator
+  Ptr<WifiMacQueue> m_queue;  //!< the queue of the packets not sent yet
+  enum BlockAckType m_type;   //!< the type of the block acks
+  static const uint8_t m_tid = 0; //!< the TID of the agreements
+};
+
+OriginatorBlockAckTest::OriginatorBlockAckTest (std::string name)
+  : TestCase (name),
+    m_manager (0),
+    m_txMiddle (0)
+{
+}
+
+OriginatorBlockAckTest::~OriginatorBlockAckTest ()
+{
+  delete m_manager;
+  delete m_txMiddle;
+}
+
+static void
+BlockAckNoop (Mac48Address recipient, uint8_t tid)
+{
+}
+
+void
+OriginatorBlockAckTest::Setup (enum BlockAckType type)
+{
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  Ptr<WifiRemoteStationManager> stationManager = CreateObject<ConstantRateWifiManager> ();
+  stationManager->SetupPhy (phy);
+  m_txMiddle = new MacTxMiddle ();
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_type = type;
+
+  m_manager = new BlockAckManager ();
+  m_manager->SetWifiRemoteStationManager (stationManager);
+  m_manager->SetTxMiddle (m_txMiddle);
+  m_manager->SetQueue (m_queue);
+  m_manager->SetBlockAckType (type);
+  m_manager->SetBlockAckThreshold (0);
+  m_manager->SetMaxPacketDelay (Seconds (10));
+  m_manager->SetBlockDestinationCallback (MakeCallback (&BlockAckNoop));
+  m_manager->SetUnblockDestinationCallback (MakeCallback (&BlockAckNoop));
+}
+
+void
+OriginatorBlockAckTest::Establish (Mac48Address recipient, uint16_t startingSeq)
+{
+  MgtAddBaRequestHeader reqHdr;
+  reqHdr.SetImmediateBlockAck ();
+  reqHdr.SetTid (m_tid);
+  reqHdr.SetBufferSize (0);
+  reqHdr.SetTimeout (0);
+  reqHdr.SetStartingSequence (startingSeq);
+  reqHdr.SetAmsduSupport (false);
+  m_manager->CreateAgreement (&reqHdr, recipient);
+
+  MgtAddBaResponseHeader respHdr;
+  respHdr.SetImmediateBlockAck ();
+  respHdr.SetTid (m_tid);
+  respHdr.SetBufferSize (63);
+  respHdr.SetTimeout (0);
+  respHdr.SetAmsduSupport (false);
+  m_manager->UpdateAgreement (&respHdr, recipient);
+}
+
+void
+OriginatorBlockAckTest::Store (Mac48Address recipient, uint16_t seq, uint8_t frag)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetAddr1 (recipient);
+  hdr.SetQosTid (m_tid);
+  hdr.SetSequenceNumber (seq);
+  hdr.SetFragmentNumber (frag);
+  m_manager->StorePacket (Create<Packet> (100), hdr, Simulator::Now ());
+}
+
+CtrlBAckResponseHeader
+OriginatorBlockAckTest::CreateBlockAck (uint16_t startingSeq) const
+{
+  CtrlBAckResponseHeader blockAck;
+  blockAck.SetType (m_type);
+  blockAck.SetTidInfo (m_tid);
+  blockAck.SetStartingSequence (startingSeq);
+  return blockAck;
+}
+
+void
+OriginatorBlockAckTest::Ack (Mac48Address recipient, const CtrlBAckResponseHeader &blockAck)
+{
+  m_manager->NotifyGotBlockAck (&blockAck, recipient, WifiMode ("OfdmRate6Mbps"));
+}
+
+std::vector<std::pair<Mac48Address, uint16_t> >
+OriginatorBlockAckTest::DrainRetries (void)
+{
+  std::vector<std::pair<Mac48Address, uint16_t> > retries;
+  WifiMacHeader hdr;
+  while (m_manager->HasPackets ())
+    {
+      Ptr<const Packet> packet = m_manager->GetNextPacket (hdr);
+      if (packet == 0)
+        {
+          break;
+        }
+      NS_TEST_EXPECT_MSG_EQ (hdr.IsRetry (), true, "retransmitted packet without the retry flag");
+      retries.push_back (std::make_pair (hdr.GetAddr1 (), hdr.GetSequenceNumber ()));
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_manager->HasPackets (), false, "packets left in the retry queue");
+  return retries;
+}
+
+
+/**
+ * A compressed block ack acknowledging part of the packets: the others
+ * stay buffered and are retransmitted in sequence order.
+ */
+class PartialBlockAckTest : public OriginatorBlockAckTest
+{
+public:
+  PartialBlockAckTest ();
+private:
+  virtual void DoRun (void);
+};
+
+PartialBlockAckTest::PartialBlockAckTest ()
+  : OriginatorBlockAckTest ("Check the retransmissions after a partial block ack")
+{
+}
+
+void
+PartialBlockAckTest::DoRun (void)
+{
+  Mac48Address recipient ("00:00:00:00:00:01");
+  Setup (COMPRESSED_BLOCK_ACK);
+  Establish (recipient, 10);
+  for (uint16_t seq = 10; seq < 18; seq++)
+    {
+      Store (recipient, seq);
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_manager->GetNBufferedPackets (recipient, m_tid), 8, "packets not buffered");
+
+  CtrlBAckResponseHeader blockAck = CreateBlockAck (10);
+  blockAck.SetReceivedPacket (10);
+  blockAck.SetReceivedPacket (11);
+  blockAck.SetReceivedPacket (13);
+  blockAck.SetReceivedPacket (14);
+  blockAck.SetReceivedPacket (16);
+  Ack (recipient, blockAck);
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNBufferedPackets (recipient, m_tid), 3, "acknowledged packets still buffered");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNRetryNeededPackets (recipient, m_tid), 3, "wrong number of packets to retransmit");
+
+  std::vector<std::pair<Mac48Address, uint16_t> > retries = DrainRetries ();
+  NS_TEST_ASSERT_MSG_EQ (retries.size (), 3, "wrong number of retransmissions");
+  NS_TEST_EXPECT_MSG_EQ (retries[0].second, 12, "wrong retransmission order");
+  NS_TEST_EXPECT_MSG_EQ (retries[1].second, 15, "wrong retransmission order");
+  NS_TEST_EXPECT_MSG_EQ (retries[2].second, 17, "wrong retransmission order");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNRetryNeededPackets (recipient, m_tid), 0, "retry queue not emptied");
+  // packets sent under block ack stay buffered until acknowledged
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNBufferedPackets (recipient, m_tid), 3, "retransmitted packets not buffered");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * A basic block ack missing fragments of an MSDU: the MSDU stays buffered
+ * and is queued once for retransmission, however many fragments it lost.
+ */
+class FragmentBlockAckTest : public OriginatorBlockAckTest
+{
+public:
+  FragmentBlockAckTest ();
+private:
+  virtual void DoRun (void);
+};
+
+FragmentBlockAckTest::FragmentBlockAckTest ()
+  : OriginatorBlockAckTest ("Check the retransmission of fragments sharing a sequence number")
+{
+}
+
+void
+FragmentBlockAckTest::DoRun (void)
+{
+  Mac48Address recipient ("00:00:00:00:00:01");
+  Setup (BASIC_BLOCK_ACK);
+  Establish (recipient, 20);
+  for (uint8_t frag = 0; frag < 3; frag++)
+    {
+      Store (recipient, 20, frag);
+    }
+  Store (recipient, 21);
+  Store (recipient, 22);
+
+  CtrlBAckResponseHeader blockAck = CreateBlockAck (20);
+  blockAck.SetReceivedFragment (20, 0);
+  blockAck.SetReceivedFragment (21, 0);
+  Ack (recipient, blockAck);
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNBufferedPackets (recipient, m_tid), 2, "wrong number of buffered MSDUs");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNRetryNeededPackets (recipient, m_tid), 2, "lost fragments queued more than once");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->HasOtherFragments (20), true, "fragments of 20 not pending");
+
+  std::vector<std::pair<Mac48Address, uint16_t> > retries = DrainRetries ();
+  NS_TEST_ASSERT_MSG_EQ (retries.size (), 2, "wrong number of retransmissions");
+  NS_TEST_EXPECT_MSG_EQ (retries[0].second, 20, "wrong retransmission order");
+  NS_TEST_EXPECT_MSG_EQ (retries[1].second, 22, "wrong retransmission order");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Packets lost across the 4095 -> 0 wrap of the sequence numbers are
+ * retransmitted in transmission order.
+ */
+class SequenceWrapBlockAckTest : public OriginatorBlockAckTest
+{
+public:
+  SequenceWrapBlockAckTest ();
+private:
+  virtual void DoRun (void);
+};
+
+SequenceWrapBlockAckTest::SequenceWrapBlockAckTest ()
+  : OriginatorBlockAckTest ("Check the retransmissions across the sequence number wrap")
+{
+}
+
+void
+SequenceWrapBlockAckTest::DoRun (void)
+{
+  Mac48Address recipient ("00:00:00:00:00:01");
+  Setup (COMPRESSED_BLOCK_ACK);
+  Establish (recipient, 4093);
+  for (uint16_t seq = 4093; seq != 3; seq = (seq + 1) % 4096)
+    {
+      Store (recipient, seq);
+    }
+
+  CtrlBAckResponseHeader blockAck = CreateBlockAck (4093);
+  blockAck.SetReceivedPacket (4093);
+  blockAck.SetReceivedPacket (4095);
+  blockAck.SetReceivedPacket (1);
+  Ack (recipient, blockAck);
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNBufferedPackets (recipient, m_tid), 3, "acknowledged packets still buffered");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNRetryNeededPackets (recipient, m_tid), 3, "wrong number of packets to retransmit");
+
+  std::vector<std::pair<Mac48Address, uint16_t> > retries = DrainRetries ();
+  NS_TEST_ASSERT_MSG_EQ (retries.size (), 3, "wrong number of retransmissions");
+  NS_TEST_EXPECT_MSG_EQ (retries[0].second, 4094, "wrong retransmission order");
+  NS_TEST_EXPECT_MSG_EQ (retries[1].second, 0, "wrong retransmission order");
+  NS_TEST_EXPECT_MSG_EQ (retries[2].second, 2, "wrong retransmission order");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * With two agreements, the lost packets are retransmitted in sequence
+ * number order across the agreements, and packets with the same sequence
+ * number in the order they were reported lost.
+ */
+class TwoAgreementsRetryOrderTest : public OriginatorBlockAckTest
+{
+public:
+  TwoAgreementsRetryOrderTest ();
+private:
+  virtual void DoRun (void);
+};
+
+TwoAgreementsRetryOrderTest::TwoAgreementsRetryOrderTest ()
+  : OriginatorBlockAckTest ("Check the retransmission order with two agreements")
+{
+}
+
+void
+TwoAgreementsRetryOrderTest::DoRun (void)
+{
+  Mac48Address a ("00:00:00:00:00:01");
+  Mac48Address b ("00:00:00:00:00:02");
+  Setup (COMPRESSED_BLOCK_ACK);
+  Establish (a, 5);
+  Establish (b, 3);
+  Store (a, 5);
+  Store (a, 6);
+  Store (a, 7);
+  Store (b, 3);
+  Store (b, 4);
+  Store (b, 6);
+  Store (b, 8);
+
+  // a loses all its packets, then b loses all but the first
+  CtrlBAckResponseHeader blockAck = CreateBlockAck (5);
+  Ack (a, blockAck);
+  blockAck = CreateBlockAck (3);
+  blockAck.SetReceivedPacket (3);
+  Ack (b, blockAck);
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNRetryNeededPackets (a, m_tid), 3, "wrong number of packets to retransmit");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNRetryNeededPackets (b, m_tid), 3, "wrong number of packets to retransmit");
+
+  std::vector<std::pair<Mac48Address, uint16_t> > retries = DrainRetries ();
+  NS_TEST_ASSERT_MSG_EQ (retries.size (), 6, "wrong number of retransmissions");
+  std::pair<Mac48Address, uint16_t> expected[] = {
+    std::make_pair (b, 4), std::make_pair (a, 5), std::make_pair (a, 6),
+    std::make_pair (b, 6), std::make_pair (a, 7), std::make_pair (b, 8)
+  };
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (retries[i].first, expected[i].first, "wrong recipient of retransmission " << i);
+      NS_TEST_EXPECT_MSG_EQ (retries[i].second, expected[i].second, "wrong sequence number of retransmission " << i);
+    }
+  Simulator::Destroy ();
+}
+
+
 class BlockAckTestSuite : public TestSuite
 {
 public:
@@ -287,6 +659,10 @@ BlockAckTestSuite::BlockAckTestSuite ()
   AddTestCase (new PacketBufferingCaseA, TestCase::QUICK);
   AddTestCase (new PacketBufferingCaseB, TestCase::QUICK);
   AddTestCase (new CtrlBAckResponseHeaderTest, TestCase::QUICK);
+  AddTestCase (new PartialBlockAckTest, TestCase::QUICK);
+  AddTestCase (new FragmentBlockAckTest, TestCase::QUICK);
+  AddTestCase (new SequenceWrapBlockAckTest, TestCase::QUICK);
+  AddTestCase (new TwoAgreementsRetryOrderTest, TestCase::QUICK);
 }
 
 static BlockAckTestSuite g_blockAckTestSuite;
@@ -62,7 +62,10 @@ private:
 class DcfManagerTest : public TestCase
 {
 public:
-  DcfManagerTest ();
+  /**
+   * \param lazy whether to run every scenario with DcfManager::SetLazyBackoff
+   */
+  DcfManagerTest (bool lazy = false);
   virtual void DoRun (void);
 
   void NotifyAccessGranted (uint32_t i);
@@ -105,6 +108,7 @@ private:
   DcfManager *m_dcfManager;
   DcfStates m_dcfStates;
   uint32_t m_ackTimeoutValue;
+  bool m_lazy;
 };
 
 DcfStateTest::DcfStateTest (DcfManagerTest *test, uint32_t i)
@@ -153,8 +157,9 @@ DcfStateTest::DoNotifyWakeUp (void)
 {
 }
 
-DcfManagerTest::DcfManagerTest ()
-  : TestCase ("DcfManager")
+DcfManagerTest::DcfManagerTest (bool lazy)
+  : TestCase (lazy ? "DcfManager (lazy backoff)" : "DcfManager"),
+    m_lazy (lazy)
 {
 }
 
@@ -239,6 +244,7 @@ DcfManagerTest::StartTest (uint64_t slotTime, uint64_t sifs, uint64_t eifsNoDifs
   m_dcfManager->SetSlot (MicroSeconds (slotTime));
   m_dcfManager->SetSifs (MicroSeconds (sifs));
   m_dcfManager->SetEifsNoDifs (MicroSeconds (eifsNoDifsNoSifs + sifs));
+  m_dcfManager->SetLazyBackoff (m_lazy);
   m_ackTimeoutValue = ackTimeoutValue;
 }
 
@@ -703,6 +709,7 @@ DcfTestSuite::DcfTestSuite ()
   : TestSuite ("devices-wifi-dcf", UNIT)
 {
   AddTestCase (new DcfManagerTest, TestCase::QUICK);
+  AddTestCase (new DcfManagerTest (true), TestCase::QUICK);
 }
 
 static DcfTestSuite g_dcfTestSuite;
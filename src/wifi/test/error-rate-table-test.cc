@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include <cmath>
+#include <ns3/test.h>
+#include <ns3/boolean.h>
+#include <ns3/object-factory.h>
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+
+using namespace ns3;
+
+/**
+ * Compare the tabulated chunk success rate of an error rate model with
+ * its analytical value, for all the 802.11a/b/g/n 20 MHz modes, at SNRs
+ * that fall between the grid points and on both sides of the grid.
+ */
+class ErrorRateTableTest : public TestCase
+{
+public:
+  /**
+   * \param name the name of the test case
+   * \param model the model to check, which must not use the table
+   */
+  ErrorRateTableTest (std::string name, Ptr<ErrorRateModel> model);
+  virtual ~ErrorRateTableTest ();
+
+private:
+  virtual void DoRun (void);
+  Ptr<ErrorRateModel> m_model;
+};
+
+ErrorRateTableTest::ErrorRateTableTest (std::string name, Ptr<ErrorRateModel> model)
+  : TestCase ("Check the lookup table of " + name + " against the analytical model"),
+    m_model (model)
+{
+}
+
+ErrorRateTableTest::~ErrorRateTableTest ()
+{
+}
+
+void
+ErrorRateTableTest::DoRun (void)
+{
+  std::vector<WifiMode> modes;
+  modes.push_back (WifiPhy::GetDsssRate1Mbps ());
+  modes.push_back (WifiPhy::GetDsssRate2Mbps ());
+  modes.push_back (WifiPhy::GetDsssRate5_5Mbps ());
+  modes.push_back (WifiPhy::GetDsssRate11Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate6Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate9Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate12Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate18Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate24Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate36Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate48Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate54Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate58_5MbpsBW20MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate65MbpsBW20MHz ());
+
+  uint32_t nbits[] = { 1, 8 * 14, 8 * 100, 8 * 1500 };
+
+  ObjectFactory factory;
+  factory.SetTypeId (m_model->GetInstanceTypeId ());
+  factory.Set ("UseLookupTable", BooleanValue (true));
+  Ptr<ErrorRateModel> tabulated = factory.Create<ErrorRateModel> ();
+
+  for (std::vector<WifiMode>::const_iterator mode = modes.begin (); mode != modes.end (); mode++)
+    {
+      double maxError = 0;
+      // an irrational step, so that the SNRs do not line up with the grid
+      for (double snrDb = -12.0; snrDb < 52.0; snrDb += 0.01 * M_PI)
+        {
+          double snr = std::pow (10.0, snrDb / 10.0);
+          for (uint32_t i = 0; i < sizeof (nbits) / sizeof (nbits[0]); i++)
+            {
+              double expected = m_model->GetChunkSuccessRate (*mode, snr, nbits[i]);
+              double actual = tabulated->GetChunkSuccessRate (*mode, snr, nbits[i]);
+              maxError = std::max (maxError, std::fabs (actual - expected));
+            }
+        }
+      NS_TEST_EXPECT_MSG_LT (maxError, 5e-4, "tabulated success rate of " << *mode << " is off by " << maxError);
+    }
+}
+
+class ErrorRateTableTestSuite : public TestSuite
+{
+public:
+  ErrorRateTableTestSuite ();
+};
+
+ErrorRateTableTestSuite::ErrorRateTableTestSuite ()
+  : TestSuite ("devices-wifi-error-rate-table", UNIT)
+{
+  AddTestCase (new ErrorRateTableTest ("NistErrorRateModel", CreateObject<NistErrorRateModel> ()), TestCase::QUICK);
+  AddTestCase (new ErrorRateTableTest ("YansErrorRateModel", CreateObject<YansErrorRateModel> ()), TestCase::QUICK);
+}
+
+static ErrorRateTableTestSuite g_errorRateTableTestSuite;
@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/boolean.h"
+#include "ns3/object-factory.h"
+#include "ns3/fast-wifi-phy.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/constant-position-mobility-model.h"
+
+using namespace ns3;
+
+/**
+ * Run the same exchange with a YansWifiPhy and a FastWifiPhy receiver
+ * and check that both receive the same frames: two transmitters A and
+ * B send a frame each, B starting a given time after A, and the
+ * received power of both frames at the receiver is set with a
+ * MatrixPropagationLossModel.
+ */
+class FastWifiPhyValidationTest : public TestCase
+{
+public:
+  /**
+   * \param name the name of the scenario
+   * \param rxPowerA the received power (dBm) of the frames of A
+   * \param rxPowerB the received power (dBm) of the frames of B, or 0 if B does not transmit
+   * \param offsetB the start time of the frames of B relative to A
+   * \param expectedA the number of frames of A that should be received
+   * \param expectedB the number of frames of B that should be received
+   */
+  FastWifiPhyValidationTest (std::string name, double rxPowerA, double rxPowerB, Time offsetB,
+                             uint32_t expectedA, uint32_t expectedB);
+  virtual ~FastWifiPhyValidationTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run the scenario with a receiver of the given type.
+   *
+   * \param phyType the TypeId name of the PHY of the receiver
+   */
+  void RunScenario (std::string phyType);
+  Ptr<YansWifiPhy> CreatePhy (std::string phyType, Ptr<YansWifiChannel> channel, Ptr<MobilityModel> mobility);
+  void Send (Ptr<YansWifiPhy> phy, uint32_t size);
+  void Receive (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+
+  double m_rxPowerA;
+  double m_rxPowerB;
+  Time m_offsetB;
+  uint32_t m_expectedA;
+  uint32_t m_expectedB;
+  uint32_t m_receivedA;
+  uint32_t m_receivedB;
+};
+
+static const uint32_t N_FRAMES = 20;
+static const uint32_t SIZE_A = 1000;
+static const uint32_t SIZE_B = 1200;
+static const double TX_POWER = 16.0206;
+
+FastWifiPhyValidationTest::FastWifiPhyValidationTest (std::string name, double rxPowerA, double rxPowerB, Time offsetB,
+                                                      uint32_t expectedA, uint32_t expectedB)
+  : TestCase ("Compare FastWifiPhy with YansWifiPhy: " + name),
+    m_rxPowerA (rxPowerA),
+    m_rxPowerB (rxPowerB),
+    m_offsetB (offsetB),
+    m_expectedA (expectedA),
+    m_expectedB (expectedB)
+{
+}
+
+FastWifiPhyValidationTest::~FastWifiPhyValidationTest ()
+{
+}
+
+Ptr<YansWifiPhy>
+FastWifiPhyValidationTest::CreatePhy (std::string phyType, Ptr<YansWifiChannel> channel, Ptr<MobilityModel> mobility)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (phyType);
+  Ptr<YansWifiPhy> phy = factory.Create<YansWifiPhy> ();
+  Ptr<NistErrorRateModel> error = CreateObject<NistErrorRateModel> ();
+  error->SetAttribute ("UseLookupTable", BooleanValue (true));
+  phy->SetErrorRateModel (error);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  phy->SetChannel (channel);
+  phy->Initialize ();
+  return phy;
+}
+
+void
+FastWifiPhyValidationTest::Send (Ptr<YansWifiPhy> phy, uint32_t size)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetTxPowerLevel (0);
+  txVector.SetNss (1);
+  phy->SendPacket (Create<Packet> (size), txVector, WIFI_PREAMBLE_LONG, 0, 0);
+}
+
+void
+FastWifiPhyValidationTest::Receive (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  if (packet->GetSize () == SIZE_A)
+    {
+      m_receivedA++;
+    }
+  else if (packet->GetSize () == SIZE_B)
+    {
+      m_receivedB++;
+    }
+}
+
+void
+FastWifiPhyValidationTest::RunScenario (std::string phyType)
+{
+  m_receivedA = 0;
+  m_receivedB = 0;
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  Ptr<MatrixPropagationLossModel> loss = CreateObject<MatrixPropagationLossModel> ();
+  loss->SetDefaultLoss (200);
+  channel->SetPropagationLossModel (loss);
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  Ptr<MobilityModel> mobilityA = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> mobilityB = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityModel> mobilityRx = CreateObject<ConstantPositionMobilityModel> ();
+  loss->SetLoss (mobilityA, mobilityRx, TX_POWER - m_rxPowerA);
+  loss->SetLoss (mobilityB, mobilityRx, TX_POWER - m_rxPowerB);
+
+  Ptr<YansWifiPhy> a = CreatePhy ("ns3::YansWifiPhy", channel, mobilityA);
+  Ptr<YansWifiPhy> b = CreatePhy ("ns3::YansWifiPhy", channel, mobilityB);
+  Ptr<YansWifiPhy> rx = CreatePhy (phyType, channel, mobilityRx);
+  rx->SetReceiveOkCallback (MakeCallback (&FastWifiPhyValidationTest::Receive, this));
+
+  for (uint32_t i = 0; i < N_FRAMES; i++)
+    {
+      Time start = MilliSeconds (10 * (i + 1));
+      Simulator::Schedule (start, &FastWifiPhyValidationTest::Send, this, a, SIZE_A);
+      if (m_rxPowerB != 0)
+        {
+          Simulator::Schedule (start + m_offsetB, &FastWifiPhyValidationTest::Send, this, b, SIZE_B);
+        }
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  a->Dispose ();
+  b->Dispose ();
+  rx->Dispose ();
+}
+
+void
+FastWifiPhyValidationTest::DoRun (void)
+{
+  RunScenario ("ns3::YansWifiPhy");
+  NS_TEST_ASSERT_MSG_EQ (m_receivedA, m_expectedA, "YansWifiPhy: unexpected number of frames of A");
+  NS_TEST_ASSERT_MSG_EQ (m_receivedB, m_expectedB, "YansWifiPhy: unexpected number of frames of B");
+
+  RunScenario ("ns3::FastWifiPhy");
+  NS_TEST_ASSERT_MSG_EQ (m_receivedA, m_expectedA, "FastWifiPhy: unexpected number of frames of A");
+  NS_TEST_ASSERT_MSG_EQ (m_receivedB, m_expectedB, "FastWifiPhy: unexpected number of frames of B");
+}
+
+/**
+ * \brief Fast Wifi PHY Test Suite
+ */
+class FastWifiPhyTestSuite : public TestSuite
+{
+public:
+  FastWifiPhyTestSuite ();
+};
+
+FastWifiPhyTestSuite::FastWifiPhyTestSuite ()
+  : TestSuite ("wifi-fast-phy", UNIT)
+{
+  AddTestCase (new FastWifiPhyValidationTest ("strong frame without interference",
+                                              -60, 0, Seconds (0), N_FRAMES, 0), TestCase::QUICK);
+  AddTestCase (new FastWifiPhyValidationTest ("frame below the energy detection threshold",
+                                              -100, 0, Seconds (0), 0, 0), TestCase::QUICK);
+  AddTestCase (new FastWifiPhyValidationTest ("collision of two frames with the same power",
+                                              -60, -60, Seconds (0), 0, 0), TestCase::QUICK);
+  AddTestCase (new FastWifiPhyValidationTest ("capture of a frame by a much weaker interferer",
+                                              -60, -90, MicroSeconds (20), N_FRAMES, 0), TestCase::QUICK);
+  AddTestCase (new FastWifiPhyValidationTest ("weak frame hit by a much stronger frame",
+                                              -85, -55, MicroSeconds (20), 0, 0), TestCase::QUICK);
+  AddTestCase (new FastWifiPhyValidationTest ("interferer during the payload only",
+                                              -60, -62, MicroSeconds (500), 0, 0), TestCase::QUICK);
+}
+
+static FastWifiPhyTestSuite g_fastWifiPhyTestSuite;
@@ -0,0 +1,299 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <cmath>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/spectrum-wifi-phy.h"
+#include "ns3/wifi-spectrum-phy-interface.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/friis-spectrum-propagation-loss.h"
+#include "ns3/constant-position-mobility-model.h"
+
+using namespace ns3;
+
+/**
+ * Attach SpectrumWifiPhy objects to a MultiModelSpectrumChannel and
+ * check that frames are received by the PHYs tuned to the channel of
+ * the transmitter only, and that a signal of another technology makes
+ * the CCA busy without being received.
+ */
+class SpectrumWifiPhyTest : public TestCase
+{
+public:
+  SpectrumWifiPhyTest ();
+  virtual ~SpectrumWifiPhyTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param channelNumber the channel the PHY is tuned to
+   * \param x the position of the PHY
+   * \return a new PHY attached to m_channel
+   */
+  Ptr<SpectrumWifiPhy> CreatePhy (uint16_t channelNumber, double x);
+  void Receive (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  void Send (Ptr<SpectrumWifiPhy> phy, uint32_t size);
+  void SendForeignSignal (Ptr<SpectrumWifiPhy> phy, double powerDbm, Time duration);
+  void CheckCcaBusy (Ptr<SpectrumWifiPhy> phy, bool busy);
+
+  Ptr<MultiModelSpectrumChannel> m_channel;
+  uint32_t m_received;
+  uint32_t m_receivedBytes;
+};
+
+SpectrumWifiPhyTest::SpectrumWifiPhyTest ()
+  : TestCase ("Check the SpectrumWifiPhy on a shared SpectrumChannel"),
+    m_received (0),
+    m_receivedBytes (0)
+{
+}
+
+SpectrumWifiPhyTest::~SpectrumWifiPhyTest ()
+{
+}
+
+Ptr<SpectrumWifiPhy>
+SpectrumWifiPhyTest::CreatePhy (uint16_t channelNumber, double x)
+{
+  Ptr<SpectrumWifiPhy> phy = CreateObject<SpectrumWifiPhy> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (Vector (x, 0, 0));
+  phy->SetMobility (mobility);
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  phy->SetChannelNumber (channelNumber);
+  phy->SetChannel (m_channel);
+  phy->Initialize ();
+  return phy;
+}
+
+void
+SpectrumWifiPhyTest::Receive (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_received++;
+  m_receivedBytes += packet->GetSize ();
+}
+
+void
+SpectrumWifiPhyTest::Send (Ptr<SpectrumWifiPhy> phy, uint32_t size)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetTxPowerLevel (0);
+  txVector.SetNss (1);
+  phy->SendPacket (Create<Packet> (size), txVector, WIFI_PREAMBLE_LONG, 0, 0);
+}
+
+void
+SpectrumWifiPhyTest::SendForeignSignal (Ptr<SpectrumWifiPhy> phy, double powerDbm, Time duration)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->duration = duration;
+  params->psd = Create<SpectrumValue> (phy->GetRxSpectrumModel ());
+  //spread the power evenly over the bands of the receiver
+  double powerW = std::pow (10.0, powerDbm / 10.0) / 1000.0;
+  (*params->psd) = powerW / (phy->GetRxBandwidth ());
+  phy->GetSpectrumPhy ()->StartRx (params);
+}
+
+void
+SpectrumWifiPhyTest::CheckCcaBusy (Ptr<SpectrumWifiPhy> phy, bool busy)
+{
+  NS_TEST_EXPECT_MSG_EQ (phy->IsStateCcaBusy (), busy, "unexpected CCA state at " << Simulator::Now ());
+}
+
+void
+SpectrumWifiPhyTest::DoRun (void)
+{
+  m_channel = CreateObject<MultiModelSpectrumChannel> ();
+  m_channel->AddSpectrumPropagationLossModel (CreateObject<FriisSpectrumPropagationLossModel> ());
+
+  Ptr<SpectrumWifiPhy> tx = CreatePhy (36, 0);
+  Ptr<SpectrumWifiPhy> rx = CreatePhy (36, 10);
+  Ptr<SpectrumWifiPhy> other = CreatePhy (40, 10);
+  rx->SetReceiveOkCallback (MakeCallback (&SpectrumWifiPhyTest::Receive, this));
+  other->SetReceiveOkCallback (MakeCallback (&SpectrumWifiPhyTest::Receive, this));
+
+  NS_TEST_ASSERT_MSG_EQ (tx->GetRxSpectrumModel (), rx->GetRxSpectrumModel (),
+                         "PHYs on the same channel should share their SpectrumModel");
+  NS_TEST_ASSERT_MSG_NE (tx->GetRxSpectrumModel (), other->GetRxSpectrumModel (),
+                         "PHYs on different channels should not share their SpectrumModel");
+
+  //a frame is received by the PHY on the same channel only
+  Simulator::Schedule (Seconds (1), &SpectrumWifiPhyTest::Send, this, tx, 1000);
+
+  //a foreign signal above the CCA threshold makes the CCA busy for its
+  //duration, and one below the threshold does not
+  Simulator::Schedule (Seconds (2), &SpectrumWifiPhyTest::SendForeignSignal, this, rx, -50, MilliSeconds (1));
+  Simulator::Schedule (Seconds (2) + MicroSeconds (500), &SpectrumWifiPhyTest::CheckCcaBusy, this, rx, true);
+  Simulator::Schedule (Seconds (2) + MilliSeconds (2), &SpectrumWifiPhyTest::CheckCcaBusy, this, rx, false);
+  Simulator::Schedule (Seconds (3), &SpectrumWifiPhyTest::SendForeignSignal, this, rx, -110, MilliSeconds (1));
+  Simulator::Schedule (Seconds (3) + MicroSeconds (500), &SpectrumWifiPhyTest::CheckCcaBusy, this, rx, false);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_received, 1, "the frame should be received once");
+  NS_TEST_ASSERT_MSG_EQ (m_receivedBytes, 1000, "unexpected size of the received frame");
+
+  Simulator::Destroy ();
+  tx->Dispose ();
+  rx->Dispose ();
+  other->Dispose ();
+  m_channel = 0;
+}
+
+/**
+ * Change the channel of a SpectrumWifiPhy attached to a
+ * SpectrumChannel after it is initialized, and check that it is still
+ * registered once with the channel, i.e., that it receives every frame
+ * once.
+ */
+class SpectrumWifiPhyRetuneTest : public TestCase
+{
+public:
+  SpectrumWifiPhyRetuneTest (Ptr<SpectrumChannel> channel, std::string name);
+  virtual ~SpectrumWifiPhyRetuneTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param channelNumber the channel the PHY is tuned to
+   * \param x the position of the PHY
+   * \return a new PHY attached to m_channel
+   */
+  Ptr<SpectrumWifiPhy> CreatePhy (uint16_t channelNumber, double x);
+  void Receive (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  void RxBegin (Ptr<const Packet> packet);
+  void RxDrop (Ptr<const Packet> packet);
+  void Send (Ptr<SpectrumWifiPhy> phy);
+
+  Ptr<SpectrumChannel> m_channel;
+  uint32_t m_received;
+  uint32_t m_rxBegin;
+  uint32_t m_rxDrop;
+};
+
+SpectrumWifiPhyRetuneTest::SpectrumWifiPhyRetuneTest (Ptr<SpectrumChannel> channel, std::string name)
+  : TestCase ("Check that a SpectrumWifiPhy changing channel is registered once with a " + name),
+    m_channel (channel),
+    m_received (0),
+    m_rxBegin (0),
+    m_rxDrop (0)
+{
+}
+
+SpectrumWifiPhyRetuneTest::~SpectrumWifiPhyRetuneTest ()
+{
+}
+
+Ptr<SpectrumWifiPhy>
+SpectrumWifiPhyRetuneTest::CreatePhy (uint16_t channelNumber, double x)
+{
+  Ptr<SpectrumWifiPhy> phy = CreateObject<SpectrumWifiPhy> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (Vector (x, 0, 0));
+  phy->SetMobility (mobility);
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  phy->SetChannelNumber (channelNumber);
+  phy->SetChannel (m_channel);
+  phy->Initialize ();
+  return phy;
+}
+
+void
+SpectrumWifiPhyRetuneTest::Receive (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_received++;
+}
+
+void
+SpectrumWifiPhyRetuneTest::RxBegin (Ptr<const Packet> packet)
+{
+  m_rxBegin++;
+}
+
+void
+SpectrumWifiPhyRetuneTest::RxDrop (Ptr<const Packet> packet)
+{
+  m_rxDrop++;
+}
+
+void
+SpectrumWifiPhyRetuneTest::Send (Ptr<SpectrumWifiPhy> phy)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetTxPowerLevel (0);
+  txVector.SetNss (1);
+  phy->SendPacket (Create<Packet> (1000), txVector, WIFI_PREAMBLE_LONG, 0, 0);
+}
+
+void
+SpectrumWifiPhyRetuneTest::DoRun (void)
+{
+  m_channel->AddSpectrumPropagationLossModel (CreateObject<FriisSpectrumPropagationLossModel> ());
+
+  Ptr<SpectrumWifiPhy> tx = CreatePhy (36, 0);
+  Ptr<SpectrumWifiPhy> rx = CreatePhy (36, 10);
+  rx->SetReceiveOkCallback (MakeCallback (&SpectrumWifiPhyRetuneTest::Receive, this));
+  rx->TraceConnectWithoutContext ("PhyRxBegin", MakeCallback (&SpectrumWifiPhyRetuneTest::RxBegin, this));
+  rx->TraceConnectWithoutContext ("PhyRxDrop", MakeCallback (&SpectrumWifiPhyRetuneTest::RxDrop, this));
+
+  //go to another channel and back, and attach the PHY to the same
+  //channel again, so that the spectrum model of the PHY is reset several
+  //times
+  Simulator::Schedule (MilliSeconds (100), &SpectrumWifiPhy::SetChannelNumber, rx, 40);
+  Simulator::Schedule (MilliSeconds (200), &SpectrumWifiPhy::SetChannelNumber, rx, 36);
+  Simulator::Schedule (MilliSeconds (300), &SpectrumWifiPhy::SetChannel, rx, m_channel);
+
+  Simulator::Schedule (Seconds (1), &SpectrumWifiPhyRetuneTest::Send, this, tx);
+  Simulator::Schedule (Seconds (2), &SpectrumWifiPhyRetuneTest::Send, this, tx);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxBegin, 2, "every frame should reach the receiver once");
+  NS_TEST_ASSERT_MSG_EQ (m_rxDrop, 0, "no copy of a frame should be dropped");
+  NS_TEST_ASSERT_MSG_EQ (m_received, 2, "every frame should be received");
+
+  Simulator::Destroy ();
+  tx->Dispose ();
+  rx->Dispose ();
+  m_channel = 0;
+}
+
+/**
+ * \brief Spectrum Wifi PHY Test Suite
+ */
+class SpectrumWifiPhyTestSuite : public TestSuite
+{
+public:
+  SpectrumWifiPhyTestSuite ();
+};
+
+SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite ()
+  : TestSuite ("wifi-spectrum-phy", UNIT)
+{
+  AddTestCase (new SpectrumWifiPhyTest, TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyRetuneTest (CreateObject<SingleModelSpectrumChannel> (), "SingleModelSpectrumChannel"), TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyRetuneTest (CreateObject<MultiModelSpectrumChannel> (), "MultiModelSpectrumChannel"), TestCase::QUICK);
+}
+
+static SpectrumWifiPhyTestSuite g_spectrumWifiPhyTestSuite;
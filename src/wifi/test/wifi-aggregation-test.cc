@@ -26,6 +26,8 @@
 #include "ns3/mac-low.h"
 #include "ns3/edca-txop-n.h"
 #include "ns3/yans-wifi-phy.h"
+#include "ns3/mpdu-aggregator.h"
+#include "ns3/msdu-aggregator.h"
 
 using namespace ns3;
 
@@ -176,6 +178,170 @@ TwoLevelAggregationTest::DoRun (void)
 }
 
 
+//-----------------------------------------------------------------------------
+/**
+ * Fill a packet of the given size with bytes depending on its index, so
+ * that the subframes of an aggregate can be told apart.
+ */
+static Ptr<Packet>
+CreateFilledPacket (uint32_t size, uint8_t index)
+{
+  std::vector<uint8_t> buffer (size);
+  for (uint32_t i = 0; i < size; i++)
+    {
+      buffer[i] = static_cast<uint8_t> (index * 31 + i);
+    }
+  return Create<Packet> (size > 0 ? &buffer[0] : 0, size);
+}
+
+/**
+ * \return whether the packet holds the bytes of CreateFilledPacket (size, index)
+ */
+static bool
+CheckFilledPacket (Ptr<const Packet> packet, uint32_t size, uint8_t index)
+{
+  if (packet->GetSize () != size)
+    {
+      return false;
+    }
+  std::vector<uint8_t> buffer (size);
+  packet->CopyData (size > 0 ? &buffer[0] : 0, size);
+  for (uint32_t i = 0; i < size; i++)
+    {
+      if (buffer[i] != static_cast<uint8_t> (index * 31 + i))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+class AmpduAggregationTest : public TestCase
+{
+public:
+  AmpduAggregationTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AmpduAggregationTest::AmpduAggregationTest ()
+  : TestCase ("Check that AggregateLength matches A-MPDU aggregation and that A-MPDUs are deaggregated")
+{
+}
+
+void
+AmpduAggregationTest::DoRun (void)
+{
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::MpduStandardAggregator");
+  factory.Set ("MaxAmpduSize", UintegerValue (4000));
+  Ptr<MpduAggregator> aggregator = factory.Create<MpduAggregator> ();
+
+  /*
+   * Aggregate the same MPDUs, whose sizes are not all multiple of 4 and
+   * some of them shorter than an A-MSDU subframe header, with Aggregate and
+   * AggregateLength until the maximum size is reached.  Both should accept
+   * the same MPDUs and give the same A-MPDU length.
+   */
+  uint32_t sizes[] = {1526, 101, 64, 1030, 999, 3, 1, 250, 250};
+  uint32_t nSizes = sizeof (sizes) / sizeof (sizes[0]);
+  Ptr<Packet> ampdu = Create<Packet> ();
+  Ptr<Packet> ampduLength = Create<Packet> ();
+  uint32_t nAggregated = 0;
+  for (uint32_t i = 0; i < nSizes; i++)
+    {
+      bool aggregated = aggregator->Aggregate (CreateFilledPacket (sizes[i], i), ampdu);
+      bool aggregatedLength = aggregator->AggregateLength (sizes[i], ampduLength);
+      NS_TEST_EXPECT_MSG_EQ (aggregatedLength, aggregated, "AggregateLength and Aggregate disagree on MPDU " << i);
+      NS_TEST_EXPECT_MSG_EQ (ampduLength->GetSize (), ampdu->GetSize (), "wrong A-MPDU length after MPDU " << i);
+      if (aggregated)
+        {
+          NS_TEST_EXPECT_MSG_EQ (nAggregated, i, "an MPDU was aggregated after a refused one");
+          nAggregated++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_LT (nAggregated, nSizes, "the maximum A-MPDU size should be reached");
+  NS_TEST_ASSERT_MSG_GT (nAggregated, 2, "too few MPDUs aggregated");
+
+  /*
+   * Deaggregate the A-MPDU: every MPDU is found back with its content,
+   * the last one through the path handing out the aggregate itself.
+   */
+  MpduAggregator::DeaggregatedMpdus mpdus = MpduAggregator::Deaggregate (ampdu);
+  NS_TEST_ASSERT_MSG_EQ (mpdus.size (), nAggregated, "wrong number of deaggregated MPDUs");
+  uint32_t index = 0;
+  for (MpduAggregator::DeaggregatedMpdusCI i = mpdus.begin (); i != mpdus.end (); i++, index++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (i->second.GetLength (), sizes[index], "wrong length in subframe header " << index);
+      NS_TEST_EXPECT_MSG_EQ (CheckFilledPacket (i->first, sizes[index], index), true, "wrong content of MPDU " << index);
+    }
+
+  /*
+   * MacLow sends every subframe in its own packet, padded unless it is the
+   * last one: a single padded subframe is deaggregated without its padding.
+   */
+  for (uint32_t last = 0; last < 2; last++)
+    {
+      Ptr<Packet> subframe = CreateFilledPacket (101, 7);
+      aggregator->AddHeaderAndPad (subframe, last == 1);
+      NS_TEST_EXPECT_MSG_EQ (subframe->GetSize (), last ? 105 : 108, "wrong subframe size");
+      mpdus = MpduAggregator::Deaggregate (subframe);
+      NS_TEST_ASSERT_MSG_EQ (mpdus.size (), 1, "wrong number of deaggregated MPDUs");
+      NS_TEST_EXPECT_MSG_EQ (CheckFilledPacket (mpdus.begin ()->first, 101, 7), true, "wrong content of the MPDU");
+    }
+}
+
+//-----------------------------------------------------------------------------
+class AmsduDeaggregationTest : public TestCase
+{
+public:
+  AmsduDeaggregationTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AmsduDeaggregationTest::AmsduDeaggregationTest ()
+  : TestCase ("Check that A-MSDUs are deaggregated")
+{
+}
+
+void
+AmsduDeaggregationTest::DoRun (void)
+{
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::MsduStandardAggregator");
+  factory.Set ("MaxAmsduSize", UintegerValue (7935));
+  Ptr<MsduAggregator> aggregator = factory.Create<MsduAggregator> ();
+  Mac48Address src ("00:00:00:00:00:01");
+  Mac48Address dest ("00:00:00:00:00:02");
+
+  /*
+   * Aggregate MSDUs with and without padding, some of them shorter than an
+   * A-MSDU subframe header, and check that every MSDU is found back with
+   * its content, the last one through the path handing out the aggregate
+   * itself.
+   */
+  uint32_t sizes[] = {1500, 61, 2, 5};
+  uint32_t nSizes = sizeof (sizes) / sizeof (sizes[0]);
+  Ptr<Packet> amsdu = Create<Packet> ();
+  for (uint32_t i = 0; i < nSizes; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (aggregator->Aggregate (CreateFilledPacket (sizes[i], i), amsdu, src, dest), true,
+                             "aggregation of MSDU " << i << " failed");
+    }
+
+  MsduAggregator::DeaggregatedMsdus msdus = MsduAggregator::Deaggregate (amsdu);
+  NS_TEST_ASSERT_MSG_EQ (msdus.size (), nSizes, "wrong number of deaggregated MSDUs");
+  uint32_t index = 0;
+  for (MsduAggregator::DeaggregatedMsdusCI i = msdus.begin (); i != msdus.end (); i++, index++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (i->second.GetSourceAddr (), src, "wrong source address of MSDU " << index);
+      NS_TEST_EXPECT_MSG_EQ (CheckFilledPacket (i->first, sizes[index], index), true, "wrong content of MSDU " << index);
+    }
+}
+
 //-----------------------------------------------------------------------------
 class WifiAggregationTestSuite : public TestSuite
 {
@@ -187,6 +353,8 @@ WifiAggregationTestSuite::WifiAggregationTestSuite ()
   : TestSuite ("aggregation-wifi", UNIT)
 {
   AddTestCase (new TwoLevelAggregationTest, TestCase::QUICK);
+  AddTestCase (new AmpduAggregationTest, TestCase::QUICK);
+  AddTestCase (new AmsduDeaggregationTest, TestCase::QUICK);
 }
 
 static WifiAggregationTestSuite g_wifiAggregationTestSuite;
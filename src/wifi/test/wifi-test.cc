@@ -40,6 +40,8 @@
 #include "ns3/config.h"
 #include "ns3/boolean.h"
 #include "ns3/string.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/qos-blocked-destinations.h"
 
 using namespace ns3;
 
@@ -214,6 +216,127 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------
+class WifiMacQueueTest : public TestCase
+{
+public:
+  WifiMacQueueTest () : TestCase ("WifiMacQueue per-TID and receiver sub-queues")
+  {
+  }
+  virtual void DoRun (void);
+
+private:
+  WifiMacHeader MakeHeader (Mac48Address addr1, uint8_t tid, bool qos) const;
+  void Enqueue (Ptr<Packet> packet, WifiMacHeader hdr);
+  void Churn (void);
+  void CheckExpired (void);
+
+  Ptr<WifiMacQueue> m_queue;
+  Mac48Address m_a;
+  Mac48Address m_b;
+};
+
+WifiMacHeader
+WifiMacQueueTest::MakeHeader (Mac48Address addr1, uint8_t tid, bool qos) const
+{
+  WifiMacHeader hdr;
+  hdr.SetType (qos ? WIFI_MAC_QOSDATA : WIFI_MAC_DATA);
+  hdr.SetAddr1 (addr1);
+  if (qos)
+    {
+      hdr.SetQosTid (tid);
+    }
+  return hdr;
+}
+
+void
+WifiMacQueueTest::Enqueue (Ptr<Packet> packet, WifiMacHeader hdr)
+{
+  m_queue->Enqueue (packet, hdr);
+}
+
+void
+WifiMacQueueTest::Churn (void)
+{
+  //packets passing through while older ones stay queued must not pile up
+  //in the expiry list, nor disturb the expiry of the older ones
+  WifiMacHeader hdr;
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      Ptr<Packet> packet = Create<Packet> (10);
+      m_queue->Enqueue (packet, MakeHeader (m_b, 3, true));
+      NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (&hdr, 3, WifiMacHeader::ADDR1, m_b), packet, "churn packet");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetSize (), 3, "older packets are still queued");
+}
+
+void
+WifiMacQueueTest::CheckExpired (void)
+{
+  //only the packet enqueued at 300ms is still alive at 700ms
+  NS_TEST_EXPECT_MSG_EQ (m_queue->IsEmpty (), false, "the last packet has not expired");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetSize (), 1, "the older packets have expired");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (1, WifiMacHeader::ADDR1, m_a), 0, "expired packets left their sub-queue");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (2, WifiMacHeader::ADDR1, m_b), 1, "live packet is in its sub-queue");
+}
+
+void
+WifiMacQueueTest::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxSize (10);
+  m_queue->SetMaxDelay (MilliSeconds (500));
+  m_a = Mac48Address ("00:00:00:00:00:01");
+  m_b = Mac48Address ("00:00:00:00:00:02");
+
+  std::vector<Ptr<Packet> > p;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      p.push_back (Create<Packet> (100 + i));
+    }
+  m_queue->Enqueue (p[0], MakeHeader (m_a, 1, true));
+  m_queue->Enqueue (p[1], MakeHeader (m_b, 1, true));
+  m_queue->Enqueue (p[2], MakeHeader (m_a, 1, true));
+  m_queue->Enqueue (p[3], MakeHeader (m_a, 2, true));
+  m_queue->Enqueue (p[4], MakeHeader (m_a, 0, false));
+  m_queue->PushFront (p[5], MakeHeader (m_a, 1, true));
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetSize (), 6, "all packets are queued");
+
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (1, WifiMacHeader::ADDR1, m_a), 3, "sub-queue (a, 1)");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (1, WifiMacHeader::ADDR1, m_b), 1, "sub-queue (b, 1)");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (2, WifiMacHeader::ADDR1, m_a), 1, "sub-queue (a, 2)");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, m_a), 0, "non-QoS data is not counted");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (1, WifiMacHeader::ADDR2, m_a), 0, "no packet from a");
+
+  WifiMacHeader hdr;
+  Time tstamp;
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (&hdr, 1, WifiMacHeader::ADDR1, m_a, &tstamp), p[5], "pushed front packet comes first");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Remove (p[0]), true, "remove from the middle of a sub-queue");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Remove (p[0]), false, "already removed");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (&hdr, 1, WifiMacHeader::ADDR1, m_a), p[5], "first of (a, 1)");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (&hdr, 1, WifiMacHeader::ADDR1, m_a), p[2], "second of (a, 1)");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (&hdr, 1, WifiMacHeader::ADDR1, m_a), 0, "(a, 1) is empty");
+
+  QosBlockedDestinations blocked;
+  blocked.Block (m_b, 1);
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekFirstAvailable (&hdr, tstamp, &blocked), p[3], "(b, 1) is blocked");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Dequeue (&hdr), p[1], "queue order");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueFirstAvailable (&hdr, tstamp, &blocked), p[3], "queue order");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Dequeue (&hdr), p[4], "queue order");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->IsEmpty (), true, "queue is empty");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetSize (), 0, "queue is empty");
+
+  Simulator::Schedule (MilliSeconds (100), &WifiMacQueueTest::Enqueue, this, p[0], MakeHeader (m_a, 1, true));
+  Simulator::Schedule (MilliSeconds (150), &WifiMacQueueTest::Enqueue, this, p[1], MakeHeader (m_a, 1, true));
+  Simulator::Schedule (MilliSeconds (300), &WifiMacQueueTest::Enqueue, this, p[2], MakeHeader (m_b, 2, true));
+  Simulator::Schedule (MilliSeconds (400), &WifiMacQueueTest::Churn, this);
+  Simulator::Schedule (MilliSeconds (700), &WifiMacQueueTest::CheckExpired, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_queue = 0;
+}
+
+
 //-----------------------------------------------------------------------------
 /**
  * See \bugid{991}
@@ -634,6 +757,7 @@ WifiTestSuite::WifiTestSuite ()
 {
   AddTestCase (new WifiTest, TestCase::QUICK);
   AddTestCase (new QosUtilsIsOldPacketTest, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueTest, TestCase::QUICK);
   AddTestCase (new InterferenceHelperSequenceTest, TestCase::QUICK); //Bug 991
   AddTestCase (new Bug555TestCase, TestCase::QUICK); //Bug 555
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
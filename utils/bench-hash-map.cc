@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/open-hash-map.h"
+#include "ns3/sgi-hashmap.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/mac48-address.h"
+#include <iostream>
+#include <vector>
+#include <map>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+
+/*
+ * Compare the lookup throughput of OpenHashMap with the containers it
+ * replaces, using the keys of the per-packet lookups of the stack: a
+ * subnet of IPv4 addresses (ARP cache) and a set of MAC addresses.
+ */
+
+static std::vector<Ipv4Address>
+MakeIpv4Keys (uint32_t nKeys)
+{
+  std::vector<Ipv4Address> keys;
+  for (uint32_t i = 0; i < nKeys; i++)
+    {
+      keys.push_back (Ipv4Address (0x0a000001 + i));
+    }
+  return keys;
+}
+
+static std::vector<Mac48Address>
+MakeMacKeys (uint32_t nKeys)
+{
+  std::vector<Mac48Address> keys;
+  for (uint32_t i = 0; i < nKeys; i++)
+    {
+      keys.push_back (Mac48Address::Allocate ());
+    }
+  return keys;
+}
+
+/*
+ * Fill a map with the keys, then look up n keys in a pseudo-random
+ * order.  Returns the elapsed time of the lookups only.
+ */
+template <typename Map, typename Key>
+static uint64_t
+runLookups (std::vector<Key> const &keys, uint32_t n, uint32_t *sum)
+{
+  Map map;
+  for (uint32_t i = 0; i < keys.size (); i++)
+    {
+      map[keys[i]] = i;
+    }
+  uint32_t state = 1;
+  uint32_t total = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      state = state * 1664525 + 1013904223;
+      typename Map::const_iterator it = map.find (keys[(state >> 8) % keys.size ()]);
+      total += it->second;
+    }
+  uint64_t deltaMs = time.End ();
+  // keep the lookups from being optimized out
+  *sum += total;
+  return deltaMs;
+}
+
+template <typename Map, typename Key>
+static void
+runBench (std::vector<Key> const &keys, uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint32_t sum = 0;
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      minDelay = std::min (minDelay, runLookups<Map> (keys, n, &sum));
+    }
+  double ls = n;
+  ls *= 1000;
+  ls /= std::max<uint64_t> (minDelay, 1);
+  std::cout << ls << " lookups/s"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << "\t(checksum " << sum << ")"
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t nKeys = 1000;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark OpenHashMap lookups against std::map and sgi::hash_map");
+  cmd.AddValue ("n", "number of lookups", n);
+  cmd.AddValue ("keys", "number of keys in the map", nKeys);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || nKeys == 0)
+    {
+      std::cerr << "Error-- number of lookups must be specified " <<
+        "by command-line argument --n=(number of lookups)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-hash-map with n=" << n << " keys=" << nKeys << std::endl;
+
+  std::vector<Ipv4Address> ipv4Keys = MakeIpv4Keys (nKeys);
+  runBench<std::map<Ipv4Address, uint32_t> > (ipv4Keys, n, minIterations, "Ipv4Address std::map");
+  runBench<sgi::hash_map<Ipv4Address, uint32_t, Ipv4AddressHash> > (ipv4Keys, n, minIterations, "Ipv4Address sgi::hash_map");
+  runBench<OpenHashMap<Ipv4Address, uint32_t, Ipv4AddressHash> > (ipv4Keys, n, minIterations, "Ipv4Address OpenHashMap");
+
+  std::vector<Mac48Address> macKeys = MakeMacKeys (nKeys);
+  runBench<std::map<Mac48Address, uint32_t> > (macKeys, n, minIterations, "Mac48Address std::map");
+  runBench<sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash> > (macKeys, n, minIterations, "Mac48Address sgi::hash_map");
+  runBench<OpenHashMap<Mac48Address, uint32_t, Mac48AddressHash> > (macKeys, n, minIterations, "Mac48Address OpenHashMap");
+
+  return 0;
+}
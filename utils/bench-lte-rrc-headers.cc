@@ -0,0 +1,304 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/lte-rrc-sap.h"
+#include "ns3/lte-rrc-header.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+
+/*
+ * Measure the cost of the ASN.1 encoding and decoding of the RRC
+ * messages exchanged during a X2 handover when LteRrcProtocolReal is
+ * used: the measurement report of the UE, the handover preparation
+ * information sent to the target eNB, the handover command and the
+ * reconfiguration complete sent to the target eNB. Every message is
+ * added to a packet and removed from it as LteRrcProtocolReal does,
+ * including the peek of the message type of the UL DCCH messages.
+ */
+
+static LteRrcSap::MeasConfig
+MakeMeasConfig (void)
+{
+  LteRrcSap::MeasConfig measConfig;
+  measConfig.haveQuantityConfig = true;
+  measConfig.quantityConfig.filterCoefficientRSRP = 4;
+  measConfig.quantityConfig.filterCoefficientRSRQ = 4;
+  measConfig.haveMeasGapConfig = false;
+  measConfig.haveSmeasure = false;
+  measConfig.haveSpeedStatePars = false;
+
+  LteRrcSap::MeasObjectToAddMod measObject;
+  measObject.measObjectId = 1;
+  measObject.measObjectEutra.carrierFreq = 100;
+  measObject.measObjectEutra.allowedMeasBandwidth = 25;
+  measObject.measObjectEutra.presenceAntennaPort1 = false;
+  measObject.measObjectEutra.neighCellConfig = 0;
+  measObject.measObjectEutra.offsetFreq = 0;
+  measObject.measObjectEutra.haveCellForWhichToReportCGI = false;
+  measConfig.measObjectToAddModList.push_back (measObject);
+
+  // A2, A4 and A3 events, as configured by the handover algorithms
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      LteRrcSap::ReportConfigToAddMod reportConfig;
+      reportConfig.reportConfigId = i + 1;
+      reportConfig.reportConfigEutra.triggerType = LteRrcSap::ReportConfigEutra::EVENT;
+      if (i == 0)
+        {
+          reportConfig.reportConfigEutra.eventId = LteRrcSap::ReportConfigEutra::EVENT_A2;
+        }
+      else if (i == 1)
+        {
+          reportConfig.reportConfigEutra.eventId = LteRrcSap::ReportConfigEutra::EVENT_A4;
+        }
+      else
+        {
+          reportConfig.reportConfigEutra.eventId = LteRrcSap::ReportConfigEutra::EVENT_A3;
+        }
+      reportConfig.reportConfigEutra.threshold1.choice = LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ;
+      reportConfig.reportConfigEutra.threshold1.range = 30;
+      reportConfig.reportConfigEutra.threshold2.choice = LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ;
+      reportConfig.reportConfigEutra.threshold2.range = 0;
+      reportConfig.reportConfigEutra.reportOnLeave = false;
+      reportConfig.reportConfigEutra.a3Offset = 2;
+      reportConfig.reportConfigEutra.hysteresis = 6;
+      reportConfig.reportConfigEutra.timeToTrigger = 256;
+      reportConfig.reportConfigEutra.purpose = LteRrcSap::ReportConfigEutra::REPORT_STRONGEST_CELLS;
+      reportConfig.reportConfigEutra.triggerQuantity = LteRrcSap::ReportConfigEutra::RSRQ;
+      reportConfig.reportConfigEutra.reportQuantity = LteRrcSap::ReportConfigEutra::BOTH;
+      reportConfig.reportConfigEutra.maxReportCells = 8;
+      reportConfig.reportConfigEutra.reportInterval = LteRrcSap::ReportConfigEutra::MS480;
+      reportConfig.reportConfigEutra.reportAmount = 255;
+      measConfig.reportConfigToAddModList.push_back (reportConfig);
+
+      LteRrcSap::MeasIdToAddMod measId;
+      measId.measId = i + 1;
+      measId.measObjectId = 1;
+      measId.reportConfigId = i + 1;
+      measConfig.measIdToAddModList.push_back (measId);
+    }
+  return measConfig;
+}
+
+static LteRrcSap::RadioResourceConfigDedicated
+MakeRadioResourceConfigDedicated (void)
+{
+  LteRrcSap::RadioResourceConfigDedicated rrcd;
+  LteRrcSap::SrbToAddMod srb;
+  srb.srbIdentity = 1;
+  srb.logicalChannelConfig.priority = 1;
+  srb.logicalChannelConfig.prioritizedBitRateKbps = 100;
+  srb.logicalChannelConfig.bucketSizeDurationMs = 100;
+  srb.logicalChannelConfig.logicalChannelGroup = 0;
+  rrcd.srbToAddModList.push_back (srb);
+  for (uint8_t i = 0; i < 2; i++)
+    {
+      LteRrcSap::DrbToAddMod drb;
+      drb.epsBearerIdentity = i + 1;
+      drb.drbIdentity = i + 1;
+      drb.logicalChannelIdentity = i + 3;
+      drb.rlcConfig.choice = LteRrcSap::RlcConfig::AM;
+      drb.logicalChannelConfig.priority = 9 + i;
+      drb.logicalChannelConfig.prioritizedBitRateKbps = 256;
+      drb.logicalChannelConfig.bucketSizeDurationMs = 100;
+      drb.logicalChannelConfig.logicalChannelGroup = 1;
+      rrcd.drbToAddModList.push_back (drb);
+    }
+  rrcd.havePhysicalConfigDedicated = true;
+  rrcd.physicalConfigDedicated.haveSoundingRsUlConfigDedicated = true;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.type = LteRrcSap::SoundingRsUlConfigDedicated::SETUP;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsBandwidth = 0;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsConfigIndex = 17;
+  rrcd.physicalConfigDedicated.haveAntennaInfoDedicated = true;
+  rrcd.physicalConfigDedicated.antennaInfo.transmissionMode = 0;
+  rrcd.physicalConfigDedicated.havePdschConfigDedicated = true;
+  rrcd.physicalConfigDedicated.pdschConfigDedicated.pa = LteRrcSap::PdschConfigDedicated::dB0;
+  return rrcd;
+}
+
+/// The messages of a handover.
+struct HandoverMessages
+{
+  LteRrcSap::MeasurementReport measurementReport;
+  LteRrcSap::HandoverPreparationInfo handoverPreparationInfo;
+  LteRrcSap::RrcConnectionReconfiguration handoverCommand;
+  LteRrcSap::RrcConnectionReconfigurationCompleted reconfigurationCompleted;
+};
+
+static HandoverMessages
+MakeMessages (void)
+{
+  HandoverMessages m;
+  m.measurementReport.measResults.measId = 3;
+  m.measurementReport.measResults.rsrpResult = 50;
+  m.measurementReport.measResults.rsrqResult = 20;
+  m.measurementReport.measResults.haveMeasResultNeighCells = true;
+  for (uint16_t i = 0; i < 4; i++)
+    {
+      LteRrcSap::MeasResultEutra neighbour;
+      neighbour.physCellId = 2 + i;
+      neighbour.haveCgiInfo = false;
+      neighbour.haveRsrpResult = true;
+      neighbour.rsrpResult = 55 - i;
+      neighbour.haveRsrqResult = true;
+      neighbour.rsrqResult = 25 - i;
+      m.measurementReport.measResults.measResultListEutra.push_back (neighbour);
+    }
+
+  LteRrcSap::AsConfig &asConfig = m.handoverPreparationInfo.asConfig;
+  asConfig.sourceMeasConfig = MakeMeasConfig ();
+  asConfig.sourceRadioResourceConfig = MakeRadioResourceConfigDedicated ();
+  asConfig.sourceUeIdentity = 7;
+  asConfig.sourceMasterInformationBlock.dlBandwidth = 25;
+  asConfig.sourceMasterInformationBlock.systemFrameNumber = 0;
+  asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity = 0;
+  asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.cellIdentity = 1;
+  asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIndication = false;
+  asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIdentity = 0;
+  asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  asConfig.sourceSystemInformationBlockType2.freqInfo.ulCarrierFreq = 18100;
+  asConfig.sourceSystemInformationBlockType2.freqInfo.ulBandwidth = 25;
+  asConfig.sourceDlCarrierFreq = 100;
+
+  LteRrcSap::RrcConnectionReconfiguration &command = m.handoverCommand;
+  command.rrcTransactionIdentifier = 1;
+  command.haveMeasConfig = true;
+  command.measConfig = MakeMeasConfig ();
+  command.haveMobilityControlInfo = true;
+  command.mobilityControlInfo.targetPhysCellId = 2;
+  command.mobilityControlInfo.haveCarrierFreq = true;
+  command.mobilityControlInfo.carrierFreq.dlCarrierFreq = 100;
+  command.mobilityControlInfo.carrierFreq.ulCarrierFreq = 18100;
+  command.mobilityControlInfo.haveCarrierBandwidth = true;
+  command.mobilityControlInfo.carrierBandwidth.dlBandwidth = 25;
+  command.mobilityControlInfo.carrierBandwidth.ulBandwidth = 25;
+  command.mobilityControlInfo.newUeIdentity = 9;
+  command.mobilityControlInfo.haveRachConfigDedicated = true;
+  command.mobilityControlInfo.rachConfigDedicated.raPreambleIndex = 60;
+  command.mobilityControlInfo.rachConfigDedicated.raPrachMaskIndex = 0;
+  command.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  command.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  command.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  command.haveRadioResourceConfigDedicated = true;
+  command.radioResourceConfigDedicated = MakeRadioResourceConfigDedicated ();
+
+  m.reconfigurationCompleted.rrcTransactionIdentifier = 1;
+  return m;
+}
+
+/*
+ * Add the header of a message to an empty packet, then remove it as the
+ * receiver does, after peeking the message type if typeHeader is not null,
+ * and fold the bytes on the air into the checksum.
+ */
+template <typename H, typename M>
+static void
+EncodeDecode (H &source, H &destination, M const &msg, Header *typeHeader, uint32_t *sum)
+{
+  source.SetMessage (msg);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (source);
+  uint8_t buffer[1024];
+  uint32_t size = std::min<uint32_t> (packet->CopyData (buffer, sizeof (buffer)), sizeof (buffer));
+  for (uint32_t i = 0; i < size; i++)
+    {
+      *sum = *sum * 31 + buffer[i];
+    }
+  if (typeHeader != 0)
+    {
+      packet->PeekHeader (*typeHeader);
+    }
+  packet->RemoveHeader (destination);
+  *sum += packet->GetSize ();
+}
+
+static uint64_t
+runHandovers (HandoverMessages const &m, uint32_t n, uint32_t *sum)
+{
+  uint32_t total = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // every handover uses new headers, as LteRrcProtocolReal does
+      RrcUlDcchMessage ulDcchMessage;
+      MeasurementReportHeader measurementReport, measurementReportRx;
+      EncodeDecode (measurementReport, measurementReportRx, m.measurementReport, &ulDcchMessage, &total);
+      total += measurementReportRx.GetMessage ().measResults.measResultListEutra.size ();
+
+      HandoverPreparationInfoHeader preparationInfo, preparationInfoRx;
+      EncodeDecode (preparationInfo, preparationInfoRx, m.handoverPreparationInfo, 0, &total);
+      total += preparationInfoRx.GetAsConfig ().sourceUeIdentity;
+
+      RrcConnectionReconfigurationHeader command, commandRx;
+      EncodeDecode (command, commandRx, m.handoverCommand, 0, &total);
+      total += commandRx.GetMobilityControlInfo ().newUeIdentity;
+
+      RrcConnectionReconfigurationCompleteHeader complete, completeRx;
+      EncodeDecode (complete, completeRx, m.reconfigurationCompleted, &ulDcchMessage, &total);
+      total += completeRx.GetRrcTransactionIdentifier ();
+    }
+  uint64_t deltaMs = time.End ();
+  *sum += total;
+  return deltaMs;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the ASN.1 encoding and decoding of the RRC messages of a X2 handover");
+  cmd.AddValue ("n", "number of handovers", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of handovers must be specified " <<
+        "by command-line argument --n=(number of handovers)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-rrc-headers with n=" << n << std::endl;
+
+  HandoverMessages messages = MakeMessages ();
+  uint32_t sum = 0;
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      minDelay = std::min (minDelay, runHandovers (messages, n, &sum));
+    }
+  double fs = n;
+  fs *= 1000;
+  fs /= std::max<uint64_t> (minDelay, 1);
+  std::cout << fs << " handovers/s"
+            << " (" << minDelay << " ms elapsed)"
+            << "\t(checksum " << sum << ")"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/qos-wifi-mac-helper.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/dcf-manager.h"
+#include "ns3/qos-tag.h"
+#include "ns3/packet.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/*
+ * Count the access timer events of the DcfManagers of a saturated
+ * 802.11a ad hoc network: every station but the first one keeps its
+ * four EDCA queues busy with frames for the first station.
+ */
+
+static uint32_t g_received = 0;
+
+static bool
+Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  g_received++;
+  return true;
+}
+
+static void
+Send (Ptr<NetDevice> device, Address destination, uint8_t tid, Time interval)
+{
+  Ptr<Packet> packet = Create<Packet> (1000);
+  packet->AddPacketTag (QosTag (tid));
+  device->Send (packet, destination, 0x88b5);
+  Simulator::Schedule (interval, &Send, device, destination, tid, interval);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nStations = 50;
+  double duration = 2.0;
+  double interval = 500;
+  bool lazy = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Count the access timer events of the DcfManagers of a saturated ad hoc network");
+  cmd.AddValue ("stations", "number of stations", nStations);
+  cmd.AddValue ("time", "simulated time (s)", duration);
+  cmd.AddValue ("interval", "interval between two frames of a queue (us)", interval);
+  cmd.AddValue ("lazy", "use the lazy backoff mode of the DcfManagers", lazy);
+  cmd.Parse (argc, argv);
+
+  if (nStations < 2)
+    {
+      std::cerr << "Error-- at least two stations are needed" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-wifi-dcf-manager with stations=" << nStations
+            << " time=" << duration << " interval=" << interval << " lazy=" << lazy << std::endl;
+
+  Config::SetDefault ("ns3::RegularWifiMac::LazyBackoff", BooleanValue (lazy));
+
+  NodeContainer nodes;
+  nodes.Create (nStations);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::RandomDiscPositionAllocator",
+                                 "Rho", StringValue ("ns3::UniformRandomVariable[Min=0|Max=10]"));
+  mobility.Install (nodes);
+
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate54Mbps"));
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (YansWifiChannelHelper::Default ().Create ());
+  QosWifiMacHelper mac = QosWifiMacHelper::Default ();
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  devices.Get (0)->SetReceiveCallback (MakeCallback (&Receive));
+  Address sink = devices.Get (0)->GetAddress ();
+  for (uint32_t i = 1; i < nStations; i++)
+    {
+      //one tid per access category
+      uint8_t tids[] = { 1, 0, 5, 7 };
+      for (uint32_t j = 0; j < 4; j++)
+        {
+          Simulator::Schedule (MicroSeconds (i * 7 + j), &Send, devices.Get (i), sink, tids[j],
+                               MicroSeconds (interval));
+        }
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+  uint64_t elapsed = time.End ();
+  Simulator::Destroy ();
+
+  DcfManager::TimerCounts counts = DcfManager::GetTotalTimerCounts ();
+  std::cout << "access timers: scheduled=" << counts.scheduled
+            << " cancelled=" << counts.cancelled
+            << " expired=" << counts.expired
+            << " idle=" << counts.idle << std::endl;
+  std::cout << g_received << " frames received (" << elapsed << " ms elapsed)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/object-factory.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/adhoc-wifi-mac.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/packet.h"
+#include <iostream>
+#include <vector>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+
+/*
+ * Measure the per-frame cost of the station lookups done by a
+ * WifiRemoteStationManager on an access point serving a large BSS:
+ * every iteration picks a station in a pseudo-random order, asks the
+ * rate control for the tx vector of a data frame and reports its
+ * acknowledgement.
+ */
+
+static Ptr<WifiRemoteStationManager>
+MakeManager (std::string typeId, std::vector<Mac48Address> const &stations)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (typeId);
+  Ptr<WifiRemoteStationManager> manager = factory.Create<WifiRemoteStationManager> ();
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  Ptr<AdhocWifiMac> mac = CreateObject<AdhocWifiMac> ();
+  mac->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  manager->SetupPhy (phy);
+  manager->SetupMac (mac);
+  for (uint32_t i = 0; i < stations.size (); i++)
+    {
+      manager->AddAllSupportedModes (stations[i]);
+      manager->RecordGotAssocTxOk (stations[i]);
+    }
+  return manager;
+}
+
+static uint64_t
+runFrames (Ptr<WifiRemoteStationManager> manager, std::vector<Mac48Address> const &stations,
+           uint32_t n, uint32_t *sum)
+{
+  WifiMacHeader header;
+  header.SetType (WIFI_MAC_QOSDATA);
+  header.SetQosTid (0);
+  Ptr<Packet> packet = Create<Packet> (1000);
+  uint32_t size = packet->GetSize () + header.GetSize () + 4;
+  uint32_t state = 1;
+  uint32_t total = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      state = state * 1664525 + 1013904223;
+      Mac48Address address = stations[(state >> 8) % stations.size ()];
+      header.SetQosTid ((state >> 4) & 0x3);
+      WifiTxVector txVector = manager->GetDataTxVector (address, &header, packet, size);
+      manager->ReportDataOk (address, &header, 20.0, txVector.GetMode (), 20.0);
+      total += txVector.GetMode ().GetUid ();
+    }
+  uint64_t deltaMs = time.End ();
+  // keep the lookups from being optimized out
+  *sum += total;
+  return deltaMs;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t nStations = 500;
+  uint32_t minIterations = 1;
+  std::string manager = "ns3::ArfWifiManager";
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the station lookups of a WifiRemoteStationManager in a large BSS");
+  cmd.AddValue ("n", "number of frames", n);
+  cmd.AddValue ("stations", "number of associated stations", nStations);
+  cmd.AddValue ("manager", "TypeId of the remote station manager", manager);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || nStations == 0)
+    {
+      std::cerr << "Error-- number of frames must be specified " <<
+        "by command-line argument --n=(number of frames)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-wifi-station-manager with n=" << n
+            << " stations=" << nStations << " manager=" << manager << std::endl;
+
+  std::vector<Mac48Address> stations;
+  for (uint32_t i = 0; i < nStations; i++)
+    {
+      stations.push_back (Mac48Address::Allocate ());
+    }
+
+  uint32_t sum = 0;
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      minDelay = std::min (minDelay, runFrames (MakeManager (manager, stations), stations, n, &sum));
+    }
+  double fs = n;
+  fs *= 1000;
+  fs /= std::max<uint64_t> (minDelay, 1);
+  std::cout << fs << " frames/s"
+            << " (" << minDelay << " ms elapsed)"
+            << "\t(checksum " << sum << ")"
+            << std::endl;
+  return 0;
+}
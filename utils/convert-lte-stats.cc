@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/lte-stats-writer.h"
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+/*
+ * Convert a statistics file written by the LTE stats calculators with
+ * the BinaryOutput attribute set into the text file they write by
+ * default, e.g.:
+ *
+ *   ./waf --run "convert-lte-stats --input=DlMacStats.bin --output=DlMacStats.txt"
+ *
+ * The text is written to the standard output if no output file is given.
+ */
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "binary file written by a LTE stats calculator", input);
+  cmd.AddValue ("output", "text file to write (standard output if empty)", output);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      std::cerr << "No input file given, see --PrintHelp" << std::endl;
+      return 1;
+    }
+
+  if (output.empty ())
+    {
+      LteStatsWriter::ConvertToText (input, std::cout);
+      return 0;
+    }
+
+  std::ofstream ofs (output.c_str ());
+  if (!ofs.is_open ())
+    {
+      std::cerr << "Cannot open " << output << std::endl;
+      return 1;
+    }
+  LteStatsWriter::ConvertToText (input, ofs);
+  return 0;
+}